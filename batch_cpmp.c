@@ -0,0 +1,446 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   batch_cpmp.c
+ * @brief  batch solving of many capacitated p-median instances in one process
+ * @author Christian Puchert
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "batch_cpmp.h"
+#include "cpmpplugins.h"
+#include "pricer_cpmp.h"
+
+
+#define BATCH_MAXLINELEN       4096     /**< maximal length of a line of the list file                                  */
+#define BATCH_MAXWORKERS       1024     /**< maximal number of parallel workers                                         */
+
+
+/*
+ * Data structures
+ */
+
+/** data shared by the workers of a batch */
+struct BatchData
+{
+   char**                filenames;          /* instance files                                                              */
+   int                   nfilenames;         /* number of instance files                                                    */
+   int                   next;               /* index of the next instance to solve                                         */
+   FILE*                 resultfile;         /* result file                                                                 */
+   pthread_mutex_t       mutex;              /* mutex protecting next, resultfile, stop and retcode                         */
+   SCIP_Bool             stop;               /* should the workers stop, e.g. after a user interrupt?                       */
+   SCIP_RETCODE          retcode;            /* first error of a worker                                                     */
+   int                   nsolved;            /* number of instances solved                                                  */
+   int                   nreaderrors;        /* number of instances which could not be read                                 */
+};
+typedef struct BatchData BATCHDATA;
+
+/** worker of a batch */
+struct BatchWorker
+{
+   SCIP*                 scip;               /* SCIP of the worker                                                          */
+   BATCHDATA*            batchdata;          /* data shared by the workers                                                  */
+   pthread_t             thread;             /* thread of the worker                                                        */
+};
+typedef struct BatchWorker BATCHWORKER;
+
+
+/*
+ * Local methods
+ */
+
+/** reads the instance files of a list file */
+static
+SCIP_RETCODE readList(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   const char*           listfilename,       /* name of the list file                                */
+   char***               filenames,          /* pointer to store the instance files                  */
+   int*                  nfilenames          /* pointer to store the number of instance files        */
+   )
+{
+   char line[BATCH_MAXLINELEN];
+   FILE* file;
+   int size;
+
+   *filenames = NULL;
+   *nfilenames = 0;
+   size = 0;
+
+   file = fopen(listfilename, "r");
+   if( file == NULL )
+   {
+      SCIPerrorMessage("cannot open list file <%s>\n", listfilename);
+      return SCIP_NOFILE;
+   }
+
+   while( fgets(line, (int)sizeof(line), file) != NULL )
+   {
+      char* start;
+      int len;
+
+      /* strip leading and trailing white space */
+      start = line;
+      while( *start == ' ' || *start == '\t' )
+         ++start;
+      len = (int)strlen(start);
+      while( len > 0 && (start[len-1] == '\n' || start[len-1] == '\r' || start[len-1] == ' ' || start[len-1] == '\t') )
+         start[--len] = '\0';
+
+      if( len == 0 || start[0] == '#' )
+         continue;
+
+      if( *nfilenames >= size )
+      {
+         size = SCIPcalcMemGrowSize(scip, *nfilenames + 1);
+         SCIP_CALL( SCIPreallocMemoryArray(scip, filenames, size) );
+      }
+      SCIP_CALL( SCIPduplicateMemoryArray(scip, &(*filenames)[*nfilenames], start, len + 1) );
+      ++(*nfilenames);
+   }
+
+   fclose(file);
+
+   return SCIP_OKAY;
+}
+
+/** frees the instance files of a list file */
+static
+void freeList(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   char***               filenames,          /* pointer to the instance files                        */
+   int                   nfilenames          /* number of instance files                             */
+   )
+{
+   int i;
+
+   for( i = 0; i < nfilenames; ++i )
+      SCIPfreeMemoryArray(scip, &(*filenames)[i]);
+   SCIPfreeMemoryArrayNull(scip, filenames);
+}
+
+/** returns a short name of the solving status */
+static
+const char* getStatusName(
+   SCIP_STATUS           status              /* solving status                                       */
+   )
+{
+   switch( status )
+   {
+   case SCIP_STATUS_OPTIMAL:
+      return "optimal";
+   case SCIP_STATUS_INFEASIBLE:
+      return "infeasible";
+   case SCIP_STATUS_UNBOUNDED:
+   case SCIP_STATUS_INFORUNBD:
+      return "unbounded";
+   case SCIP_STATUS_TIMELIMIT:
+      return "timelimit";
+   case SCIP_STATUS_NODELIMIT:
+   case SCIP_STATUS_TOTALNODELIMIT:
+   case SCIP_STATUS_STALLNODELIMIT:
+      return "nodelimit";
+   case SCIP_STATUS_MEMLIMIT:
+      return "memlimit";
+   case SCIP_STATUS_GAPLIMIT:
+      return "gaplimit";
+   case SCIP_STATUS_SOLLIMIT:
+   case SCIP_STATUS_BESTSOLLIMIT:
+      return "sollimit";
+   case SCIP_STATUS_USERINTERRUPT:
+      return "interrupt";
+   default:
+      return "unknown";
+   }
+}
+
+/** returns the name of an instance file without its directories */
+static
+const char* getInstanceName(
+   const char*           filename            /* instance file                                        */
+   )
+{
+   const char* name;
+
+   name = strrchr(filename, '/');
+
+   return name != NULL ? name + 1 : filename;
+}
+
+/** reads and solves one instance, writes its result line and frees the problem again; errors of reading are reported
+ *  in the result line, all other errors are returned
+ */
+static
+SCIP_RETCODE solveInstance(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   BATCHDATA*            batchdata,          /* data shared by the workers                           */
+   const char*           filename            /* instance file                                        */
+   )
+{
+   SCIP_CLOCK* readclock;
+   SCIP_RETCODE retcode;
+   char line[BATCH_MAXLINELEN];
+
+   assert(SCIPgetStage(scip) == SCIP_STAGE_INIT);
+
+   SCIP_CALL( SCIPcreateWallClock(scip, &readclock) );
+   SCIP_CALL( SCIPstartClock(scip, readclock) );
+   retcode = SCIPreadProb(scip, filename, NULL);
+   SCIP_CALL( SCIPstopClock(scip, readclock) );
+
+   if( retcode != SCIP_OKAY )
+   {
+      (void) SCIPsnprintf(line, (int)sizeof(line), "%-32s %-10s %16s %16s %10s %10.2f %10s %10s %10s %10s\n",
+         getInstanceName(filename), "readerror", "-", "-", "-", SCIPgetClockTime(scip, readclock), "-", "-", "-", "-");
+   }
+   else
+   {
+      const CPMP_PRICERSTATS* stats;
+      char gap[SCIP_MAXSTRLEN];
+
+      SCIP_CALL( SCIPsolve(scip) );
+
+      stats = SCIPpricerCpmpGetStats(scip);
+      assert(stats != NULL);
+
+      if( SCIPisInfinity(scip, SCIPgetGap(scip)) )
+         (void) SCIPsnprintf(gap, (int)sizeof(gap), "-");
+      else
+         (void) SCIPsnprintf(gap, (int)sizeof(gap), "%.4f", SCIPgetGap(scip));
+
+      (void) SCIPsnprintf(line, (int)sizeof(line), "%-32s %-10s %16.9g %16.9g %10s %10.2f %10.2f %10" SCIP_LONGINT_FORMAT
+         " %10" SCIP_LONGINT_FORMAT " %10" SCIP_LONGINT_FORMAT "\n", getInstanceName(filename),
+         getStatusName(SCIPgetStatus(scip)), SCIPgetPrimalbound(scip), SCIPgetDualbound(scip), gap,
+         SCIPgetClockTime(scip, readclock), SCIPgetSolvingTime(scip), SCIPgetNTotalNodes(scip),
+         stats->nrounds + stats->nfarkasrounds, stats->ncolumns);
+   }
+
+   (void) pthread_mutex_lock(&batchdata->mutex);
+   fputs(line, batchdata->resultfile);
+   fflush(batchdata->resultfile);
+   if( retcode != SCIP_OKAY )
+      ++batchdata->nreaderrors;
+   else
+   {
+      ++batchdata->nsolved;
+      if( SCIPgetStatus(scip) == SCIP_STATUS_USERINTERRUPT )
+         batchdata->stop = TRUE;
+   }
+   (void) pthread_mutex_unlock(&batchdata->mutex);
+
+   SCIP_CALL( SCIPfreeClock(scip, &readclock) );
+   SCIP_CALL( SCIPfreeProb(scip) );
+
+   return SCIP_OKAY;
+}
+
+/** solves instances of the list until all are taken, the batch is stopped or an error occurs */
+static
+void runWorker(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   BATCHDATA*            batchdata           /* data shared by the workers                           */
+   )
+{
+   while( TRUE ) /*lint !e716*/
+   {
+      SCIP_RETCODE retcode;
+      int i;
+
+      (void) pthread_mutex_lock(&batchdata->mutex);
+      if( batchdata->stop || batchdata->next >= batchdata->nfilenames )
+         i = -1;
+      else
+         i = batchdata->next++;
+      (void) pthread_mutex_unlock(&batchdata->mutex);
+
+      if( i < 0 )
+         break;
+
+      retcode = solveInstance(scip, batchdata, batchdata->filenames[i]);
+      if( retcode != SCIP_OKAY )
+      {
+         SCIPerrorMessage("error <%d> while solving <%s>\n", retcode, batchdata->filenames[i]);
+
+         (void) pthread_mutex_lock(&batchdata->mutex);
+         if( batchdata->retcode == SCIP_OKAY )
+            batchdata->retcode = retcode;
+         batchdata->stop = TRUE;
+         (void) pthread_mutex_unlock(&batchdata->mutex);
+         break;
+      }
+   }
+}
+
+/** thread function of a parallel worker */
+static
+void* workerThread(
+   void*                 arg                 /* worker                                               */
+   )
+{
+   BATCHWORKER* worker;
+
+   worker = (BATCHWORKER*)arg;
+   runWorker(worker->scip, worker->batchdata);
+
+   return NULL;
+}
+
+/** creates the SCIP of a parallel worker with the cpmp plugins and the parameter settings of the given SCIP */
+static
+SCIP_RETCODE createWorkerScip(
+   SCIP*                 scip,               /* SCIP data structure whose settings are copied        */
+   SCIP**                workerscip          /* pointer to store the SCIP of the worker              */
+   )
+{
+   SCIP_CALL( SCIPcreate(workerscip) );
+   SCIP_CALL( SCIPincludeCpmpPlugins(*workerscip) );
+   SCIP_CALL( SCIPcopyParamSettings(scip, *workerscip) );
+
+   /* the workers would all write to the same checkpoint, trace and capture files */
+   SCIP_CALL( SCIPsetStringParam(*workerscip, "cpmp/checkpoint/file", "") );
+   SCIP_CALL( SCIPsetStringParam(*workerscip, "pricers/cpmp/tracefile", "") );
+   SCIP_CALL( SCIPsetStringParam(*workerscip, "pricers/cpmp/capturefile", "") );
+
+   /* the workers would only interleave their logs; the result lines are all that is reported */
+   SCIPsetMessagehdlrQuiet(*workerscip, TRUE);
+
+   return SCIP_OKAY;
+}
+
+
+/*
+ * Interface methods
+ */
+
+/** solves the instances of a list file and writes one result line per instance (name, status, primal bound, dual
+ *  bound, gap, reading time, solving time, nodes, pricing rounds and columns) to the result file, or to standard
+ *  output if resultfilename is NULL; a user interrupt stops the batch after the current instances
+ */
+SCIP_RETCODE SCIPsolveBatchCpmp(
+   SCIP*                 scip,               /**< SCIP data structure with the cpmp plugins */
+   const char*           listfilename,       /**< name of the file listing the instance files */
+   const char*           resultfilename,     /**< name of the result file, or NULL for standard output */
+   int                   nworkers            /**< number of parallel workers */
+   )
+{
+   BATCHDATA batchdata;
+
+   assert(scip != NULL);
+   assert(listfilename != NULL);
+   assert(nworkers >= 1);
+
+   nworkers = MIN(nworkers, BATCH_MAXWORKERS);
+
+   SCIP_CALL( readList(scip, listfilename, &batchdata.filenames, &batchdata.nfilenames) );
+
+   if( resultfilename != NULL )
+   {
+      batchdata.resultfile = fopen(resultfilename, "w");
+      if( batchdata.resultfile == NULL )
+      {
+         SCIPerrorMessage("cannot create result file <%s>\n", resultfilename);
+         freeList(scip, &batchdata.filenames, batchdata.nfilenames);
+         return SCIP_FILECREATEERROR;
+      }
+   }
+   else
+      batchdata.resultfile = stdout;
+
+   batchdata.next = 0;
+   batchdata.stop = FALSE;
+   batchdata.retcode = SCIP_OKAY;
+   batchdata.nsolved = 0;
+   batchdata.nreaderrors = 0;
+   (void) pthread_mutex_init(&batchdata.mutex, NULL);
+
+   fprintf(batchdata.resultfile, "%-32s %-10s %16s %16s %10s %10s %10s %10s %10s %10s\n", "# instance", "status",
+      "primal", "dual", "gap", "readtime", "time", "nodes", "rounds", "columns");
+
+   nworkers = MIN(nworkers, batchdata.nfilenames);
+
+   if( nworkers <= 1 )
+   {
+      /* reuse the given SCIP; its current problem is given up */
+      if( SCIPgetStage(scip) != SCIP_STAGE_INIT )
+      {
+         SCIP_CALL( SCIPfreeProb(scip) );
+      }
+      runWorker(scip, &batchdata);
+   }
+   else
+   {
+      BATCHWORKER* workers;
+      int nstarted;
+      int w;
+
+      SCIP_CALL( SCIPallocBufferArray(scip, &workers, nworkers) );
+
+      /* set up all SCIPs before starting any thread, since the parameters of scip are read while copying */
+      for( w = 0; w < nworkers && batchdata.retcode == SCIP_OKAY; ++w )
+      {
+         workers[w].scip = NULL;
+         workers[w].batchdata = &batchdata;
+         batchdata.retcode = createWorkerScip(scip, &workers[w].scip);
+      }
+      nworkers = w;
+
+      nstarted = 0;
+      if( batchdata.retcode == SCIP_OKAY )
+      {
+         for( ; nstarted < nworkers; ++nstarted )
+         {
+            if( pthread_create(&workers[nstarted].thread, NULL, workerThread, &workers[nstarted]) != 0 )
+            {
+               SCIPerrorMessage("cannot start worker thread %d\n", nstarted);
+               break;
+            }
+         }
+
+         /* without any thread, nothing would be solved */
+         if( nstarted == 0 )
+            batchdata.retcode = SCIP_ERROR;
+      }
+
+      for( w = 0; w < nstarted; ++w )
+         (void) pthread_join(workers[w].thread, NULL);
+
+      for( w = nworkers - 1; w >= 0; --w )
+      {
+         if( workers[w].scip != NULL )
+         {
+            SCIP_CALL( SCIPfree(&workers[w].scip) );
+         }
+      }
+
+      SCIPfreeBufferArray(scip, &workers);
+   }
+
+   (void) pthread_mutex_destroy(&batchdata.mutex);
+
+   if( resultfilename != NULL )
+      fclose(batchdata.resultfile);
+
+   SCIPinfoMessage(scip, NULL, "batch: %d of %d instances solved, %d could not be read%s\n", batchdata.nsolved,
+      batchdata.nfilenames, batchdata.nreaderrors, batchdata.stop ? ", stopped early" : "");
+
+   freeList(scip, &batchdata.filenames, batchdata.nfilenames);
+
+   return batchdata.retcode;
+}
@@ -0,0 +1,59 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   batch_cpmp.h
+ * @brief  batch solving of many capacitated p-median instances in one process
+ * @author Christian Puchert
+ *
+ * The instances of a list file (one file name per line; empty lines and lines starting with '#' are skipped) are
+ * solved one after another, and one result line is written per instance. With a single worker, the given SCIP is
+ * reused: its problem is freed and the next instance is read into it, so that plugins and settings are set up only
+ * once. With several workers, each worker thread gets its own SCIP with the cpmp plugins and a copy of the parameter
+ * settings of the given SCIP, and takes the next unsolved instance of the list whenever it is done; the result lines
+ * are then written in the order in which the instances finish. Parallel workers require a SCIP library with
+ * thread-safe memory management (e.g., built with PARASCIP=true or with a TPI).
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __CPMP_BATCH_CPMP_H__
+#define __CPMP_BATCH_CPMP_H__
+
+
+#include <stdio.h>
+
+#include "scip/scip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** solves the instances of a list file and writes one result line per instance (name, status, primal bound, dual
+ *  bound, gap, reading time, solving time, nodes, pricing rounds and columns) to the result file, or to standard
+ *  output if resultfilename is NULL; a user interrupt stops the batch after the current instances
+ */
+EXTERN
+SCIP_RETCODE SCIPsolveBatchCpmp(
+   SCIP*                 scip,               /**< SCIP data structure with the cpmp plugins */
+   const char*           listfilename,       /**< name of the file listing the instance files */
+   const char*           resultfilename,     /**< name of the result file, or NULL for standard output */
+   int                   nworkers            /**< number of parallel workers */
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
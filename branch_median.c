@@ -0,0 +1,187 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   branch_median.c
+ * @ingroup BRANCHINGRULES
+ * @brief  median branching rule
+ * @author Christian Puchert
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+
+#include "branch_median.h"
+#include "cons_median.h"
+#include "pub_probdata.h"
+#include "pub_vardata.h"
+
+/**@name Branching rule properties
+ *
+ * @{
+ */
+
+#define BRANCHRULE_NAME            "Median"
+#define BRANCHRULE_DESC            "median branching rule"
+#define BRANCHRULE_PRIORITY        40000
+#define BRANCHRULE_MAXDEPTH        -1
+#define BRANCHRULE_MAXBOUNDDIST    1.0
+
+/**@} */
+
+/*
+ * Local methods
+ */
+
+/** choose a median to branch on, or find out that all medians are integrally open or closed:
+ *  we choose the median whose opening, i.e. the total value of its columns, is closest to one half
+ */
+static
+SCIP_RETCODE chooseMedian(
+   SCIP*                 scip,               /* SCIP data structure                                                  */
+   int*                  median              /* pointer to store a median to branch on, or -1 if there is none       */
+   )
+{
+   SCIP_VAR** vars;
+   int nvars;
+   int nlocations;
+   SCIP_Real* openings;                      /* for each median, the total value of its columns                      */
+   SCIP_Real bestscore;
+
+   int i;
+
+   SCIP_CALL( SCIPgetVarsData(scip, &vars, &nvars, NULL, NULL, NULL, NULL) );
+   nlocations = SCIPprobdataGetNLocations(scip);
+
+   SCIP_CALL( SCIPallocClearBufferArray(scip, &openings, nlocations) );
+
+   for( i = 0; i < nvars; ++i )
+   {
+      SCIP_Real solval;
+
+      solval = SCIPgetSolVal(scip, NULL, vars[i]);
+      if( !SCIPisZero(scip, solval) )
+         openings[SCIPvarGetMedian(vars[i])] += solval;
+   }
+
+   *median = -1;
+   bestscore = 0.0;
+   for( i = 0; i < nlocations; ++i )
+   {
+      SCIP_Real frac;
+      SCIP_Real score;
+
+      if( SCIPisFeasIntegral(scip, openings[i]) )
+         continue;
+
+      frac = openings[i] - SCIPfloor(scip, openings[i]);
+      score = MIN(frac, 1.0 - frac);
+
+      SCIPdebugMessage("   -> median %d: opening = %g\n", i+1, openings[i]);
+
+      if( score > bestscore )
+      {
+         *median = i;
+         bestscore = score;
+      }
+   }
+
+   SCIPfreeBufferArray(scip, &openings);
+
+   return SCIP_OKAY;
+}
+
+/** branch on a median: create two child nodes, closing the median in the first and opening it in the second one */
+static
+SCIP_RETCODE performBranching(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   int                   median              /* the median to branch on                              */
+   )
+{
+   SCIP_NODE* childnode;
+   SCIP_CONS* childcons;
+   char name[SCIP_MAXSTRLEN];
+
+   SCIP_CALL( SCIPcreateChild(scip, &childnode, 0.0, SCIPgetLocalTransEstimate(scip)) );
+
+   (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "MedianClosed_%d", median+1);
+   SCIP_CALL( SCIPcreateConsMedian(scip, &childcons, name, median, CPMP_MEDIAN_CLOSED, childnode) );
+   SCIP_CALL( SCIPaddConsNode(scip, childnode, childcons, NULL) );
+   SCIP_CALL( SCIPreleaseCons(scip, &childcons) );
+
+   SCIP_CALL( SCIPcreateChild(scip, &childnode, 0.0, SCIPgetLocalTransEstimate(scip)) );
+
+   (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "MedianOpen_%d", median+1);
+   SCIP_CALL( SCIPcreateConsMedian(scip, &childcons, name, median, CPMP_MEDIAN_OPEN, childnode) );
+   SCIP_CALL( SCIPaddConsNode(scip, childnode, childcons, NULL) );
+   SCIP_CALL( SCIPreleaseCons(scip, &childcons) );
+
+   return SCIP_OKAY;
+}
+
+/**@name Callback methods
+ *
+ * @{
+ */
+
+/** branching execution method for fractional LP solutions */
+static
+SCIP_DECL_BRANCHEXECLP(branchExeclpMedian)
+{  /*lint --e{715}*/
+   int median;
+
+   SCIPdebugMessage("Solved LP in node %"SCIP_LONGINT_FORMAT":\n", SCIPnodeGetNumber(SCIPgetCurrentNode(scip)));
+
+   SCIP_CALL( chooseMedian(scip, &median) );
+
+   if( median == -1 )
+      *result = SCIP_DIDNOTFIND;
+   else
+   {
+      SCIPdebugMessage("Chosen median %d\n", median+1);
+
+      SCIP_CALL( performBranching(scip, median) );
+      *result = SCIP_BRANCHED;
+   }
+
+   return SCIP_OKAY;
+}
+
+/**@} */
+
+/**@name Interface methods
+ *
+ * @{
+ */
+
+/** creates the median branching rule and includes it in SCIP */
+SCIP_RETCODE SCIPincludeBranchruleMedian(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_BRANCHRULE* branchrule;
+
+   branchrule = NULL;
+   /* include branching rule */
+   SCIP_CALL( SCIPincludeBranchruleBasic(scip, &branchrule, BRANCHRULE_NAME, BRANCHRULE_DESC, BRANCHRULE_PRIORITY, BRANCHRULE_MAXDEPTH,
+         BRANCHRULE_MAXBOUNDDIST, NULL) );
+   assert(branchrule != NULL);
+
+   SCIP_CALL( SCIPsetBranchruleExecLp(scip, branchrule, branchExeclpMedian) );
+
+   return SCIP_OKAY;
+}
+
+/**@} */
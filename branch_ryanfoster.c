@@ -0,0 +1,269 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   branch_ryanfoster.c
+ * @ingroup BRANCHINGRULES
+ * @brief  Ryan-Foster branching rule
+ * @author Christian Puchert
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+
+#include "branch_ryanfoster.h"
+#include "cons_samediff.h"
+#include "pub_probdata.h"
+#include "pub_vardata.h"
+
+/**@name Branching rule properties
+ *
+ * @{
+ */
+
+#define BRANCHRULE_NAME            "Ryanfoster"
+#define BRANCHRULE_DESC            "Ryan-Foster branching rule on location pairs"
+#define BRANCHRULE_PRIORITY        30000
+#define BRANCHRULE_MAXDEPTH        -1
+#define BRANCHRULE_MAXBOUNDDIST    1.0
+
+/**@} */
+
+/*
+ * Local methods
+ */
+
+/** choose a pair of locations to branch on, or find out that every pair is integrally together or apart:
+ *  we choose the pair whose total value of common columns is closest to one half; for each location, the values
+ *  of its partners are accumulated over the columns in the support of the LP solution which contain it
+ */
+static
+SCIP_RETCODE choosePair(
+   SCIP*                 scip,               /* SCIP data structure                                                  */
+   int*                  location1,          /* pointer to store the first location, or -1 if there is no pair       */
+   int*                  location2           /* pointer to store the second location                                 */
+   )
+{
+   SCIP_VAR** vars;
+   int nvars;
+   int nlocations;
+   int* beg;                                 /* start of the list of support columns of each location                */
+   int* cols;                                /* support columns containing each location                             */
+   SCIP_VAR** solvars;                       /* variables with nonzero solution value                                */
+   SCIP_Real* solvals;                       /* their solution values                                                */
+   int nsolvars;
+   SCIP_Real* together;                      /* for the current location, total value of the columns shared with each other location */
+   int* partners;                            /* locations with a nonzero entry in together                           */
+   int npartners;
+   SCIP_Real bestscore;
+
+   int i;
+   int j;
+   int k;
+
+   SCIP_CALL( SCIPgetVarsData(scip, &vars, &nvars, NULL, NULL, NULL, NULL) );
+   nlocations = SCIPprobdataGetNLocations(scip);
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &solvars, nvars) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &solvals, nvars) );
+   SCIP_CALL( SCIPallocClearBufferArray(scip, &beg, nlocations + 1) );
+   SCIP_CALL( SCIPallocClearBufferArray(scip, &together, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &partners, nlocations) );
+
+   /* collect the support columns for each location */
+   nsolvars = 0;
+   for( i = 0; i < nvars; ++i )
+   {
+      int* members;
+      int nmembers;
+      SCIP_Real solval;
+
+      solval = SCIPgetSolVal(scip, NULL, vars[i]);
+      if( SCIPisZero(scip, solval) )
+         continue;
+
+      solvars[nsolvars] = vars[i];
+      solvals[nsolvars] = solval;
+      ++nsolvars;
+
+      nmembers = SCIPvarGetNLocations(vars[i]);
+      members = SCIPvarGetLocations(vars[i]);
+      for( j = 0; j < nmembers; ++j )
+         ++beg[members[j] + 1];
+   }
+   for( i = 0; i < nlocations; ++i )
+      beg[i + 1] += beg[i];
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &cols, MAX(beg[nlocations], 1)) );
+   for( i = 0; i < nsolvars; ++i )
+   {
+      int* members;
+      int nmembers;
+
+      nmembers = SCIPvarGetNLocations(solvars[i]);
+      members = SCIPvarGetLocations(solvars[i]);
+      for( j = 0; j < nmembers; ++j )
+         cols[beg[members[j]]++] = i;
+   }
+   for( i = nlocations; i > 0; --i )
+      beg[i] = beg[i - 1];
+   beg[0] = 0;
+
+   /* for each location, accumulate the values of its partners with a larger index */
+   *location1 = -1;
+   *location2 = -1;
+   bestscore = 0.0;
+   for( i = 0; i < nlocations; ++i )
+   {
+      npartners = 0;
+      for( j = beg[i]; j < beg[i + 1]; ++j )
+      {
+         int* members;
+         int nmembers;
+
+         nmembers = SCIPvarGetNLocations(solvars[cols[j]]);
+         members = SCIPvarGetLocations(solvars[cols[j]]);
+         for( k = 0; k < nmembers; ++k )
+         {
+            if( members[k] <= i )
+               continue;
+
+            if( together[members[k]] == 0.0 )
+               partners[npartners++] = members[k];
+            together[members[k]] += solvals[cols[j]];
+         }
+      }
+
+      for( k = 0; k < npartners; ++k )
+      {
+         SCIP_Real value;
+
+         value = together[partners[k]];
+         together[partners[k]] = 0.0;
+
+         if( !SCIPisFeasIntegral(scip, value) )
+         {
+            SCIP_Real frac;
+            SCIP_Real score;
+
+            frac = value - SCIPfloor(scip, value);
+            score = MIN(frac, 1.0 - frac);
+
+            if( score > bestscore )
+            {
+               *location1 = i;
+               *location2 = partners[k];
+               bestscore = score;
+            }
+         }
+      }
+   }
+
+   SCIPfreeBufferArray(scip, &cols);
+   SCIPfreeBufferArray(scip, &partners);
+   SCIPfreeBufferArray(scip, &together);
+   SCIPfreeBufferArray(scip, &beg);
+   SCIPfreeBufferArray(scip, &solvals);
+   SCIPfreeBufferArray(scip, &solvars);
+
+   return SCIP_OKAY;
+}
+
+/** branch on a pair of locations: create two child nodes, requiring them to be in the same cluster in the first
+ *  and in different clusters in the second one
+ */
+static
+SCIP_RETCODE performBranching(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   int                   location1,          /* first location of the pair                           */
+   int                   location2           /* second location of the pair                          */
+   )
+{
+   SCIP_NODE* childnode;
+   SCIP_CONS* childcons;
+   char name[SCIP_MAXSTRLEN];
+
+   SCIP_CALL( SCIPcreateChild(scip, &childnode, 0.0, SCIPgetLocalTransEstimate(scip)) );
+
+   (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "Same_%d_%d", location1+1, location2+1);
+   SCIP_CALL( SCIPcreateConsSamediff(scip, &childcons, name, location1, location2, CPMP_SAMEDIFF_SAME, childnode) );
+   SCIP_CALL( SCIPaddConsNode(scip, childnode, childcons, NULL) );
+   SCIP_CALL( SCIPreleaseCons(scip, &childcons) );
+
+   SCIP_CALL( SCIPcreateChild(scip, &childnode, 0.0, SCIPgetLocalTransEstimate(scip)) );
+
+   (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "Differ_%d_%d", location1+1, location2+1);
+   SCIP_CALL( SCIPcreateConsSamediff(scip, &childcons, name, location1, location2, CPMP_SAMEDIFF_DIFFER, childnode) );
+   SCIP_CALL( SCIPaddConsNode(scip, childnode, childcons, NULL) );
+   SCIP_CALL( SCIPreleaseCons(scip, &childcons) );
+
+   return SCIP_OKAY;
+}
+
+/**@name Callback methods
+ *
+ * @{
+ */
+
+/** branching execution method for fractional LP solutions */
+static
+SCIP_DECL_BRANCHEXECLP(branchExeclpRyanfoster)
+{  /*lint --e{715}*/
+   int location1;
+   int location2;
+
+   SCIPdebugMessage("Solved LP in node %"SCIP_LONGINT_FORMAT":\n", SCIPnodeGetNumber(SCIPgetCurrentNode(scip)));
+
+   SCIP_CALL( choosePair(scip, &location1, &location2) );
+
+   if( location1 == -1 )
+      *result = SCIP_DIDNOTFIND;
+   else
+   {
+      SCIPdebugMessage("Chosen pair (%d, %d)\n", location1+1, location2+1);
+
+      SCIP_CALL( performBranching(scip, location1, location2) );
+      *result = SCIP_BRANCHED;
+   }
+
+   return SCIP_OKAY;
+}
+
+/**@} */
+
+/**@name Interface methods
+ *
+ * @{
+ */
+
+/** creates the Ryan-Foster branching rule and includes it in SCIP */
+SCIP_RETCODE SCIPincludeBranchruleRyanfoster(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_BRANCHRULE* branchrule;
+
+   branchrule = NULL;
+   /* include branching rule */
+   SCIP_CALL( SCIPincludeBranchruleBasic(scip, &branchrule, BRANCHRULE_NAME, BRANCHRULE_DESC, BRANCHRULE_PRIORITY, BRANCHRULE_MAXDEPTH,
+         BRANCHRULE_MAXBOUNDDIST, NULL) );
+   assert(branchrule != NULL);
+
+   SCIP_CALL( SCIPsetBranchruleExecLp(scip, branchrule, branchExeclpRyanfoster) );
+
+   return SCIP_OKAY;
+}
+
+/**@} */
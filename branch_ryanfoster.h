@@ -0,0 +1,47 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   branch_ryanfoster.h
+ * @ingroup BRANCHINGRULES
+ * @brief  Ryan-Foster branching rule
+ * @author Christian Puchert
+ *
+ * This branching rule branches on a pair of locations which are fractionally contained in the same cluster: in one
+ * child, they must be in the same cluster, in the other one, they must be in different clusters.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __CPMP_BRANCH_RYANFOSTER_H__
+#define __CPMP_BRANCH_RYANFOSTER_H__
+
+
+#include "scip/scip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** creates the Ryan-Foster branching rule and includes it in SCIP */
+EXTERN
+SCIP_RETCODE SCIPincludeBranchruleRyanfoster(
+   SCIP*                 scip                /**< SCIP data structure */
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
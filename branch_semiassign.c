@@ -28,6 +28,7 @@
 #include "branch_semiassign.h"
 #include "cons_semiassign.h"
 #include "pricer_cpmp.h"
+#include "prof_cpmp.h"
 #include "pub_probdata.h"
 #include "pub_vardata.h"
 
@@ -44,21 +45,63 @@
 
 /**@} */
 
+/**@name Default parameter values
+ *
+ * @{
+ */
+
+#define DEFAULT_SCORING            'f'  /**< scoring: 'f'ractionality, 'p'seudocosts, 's'trong branching, 'r'eliability */
+#define DEFAULT_SBCANDS            8    /**< maximal number of candidate locations evaluated by strong branching      */
+#define DEFAULT_SBMAXPRICEROUNDS   10   /**< maximal number of pricing rounds per strong branching child (-1: none)    */
+#define DEFAULT_RELIABILITY        4    /**< number of pseudocost observations after which a location is reliable    */
+
+/**@} */
+
+/*
+ * Data structures
+ */
+
+/** branching rule data */
+struct SCIP_BranchruleData
+{
+   char                  scoring;            /* scoring: 'f'ractionality, 'p'seudocosts, 's'trong branching, 'r'eliability */
+   int                   sbcands;            /* maximal number of candidate locations evaluated by strong branching      */
+   int                   sbmaxpricerounds;   /* maximal number of pricing rounds per strong branching child (-1: none)    */
+   int                   reliability;        /* number of pseudocost observations after which a location is reliable    */
+
+   SCIP_Real*            pscostsums;         /* for each location, sum of the observed bound gains per removed assignment */
+   int*                  pscostcounts;       /* for each location, number of pseudocost observations                     */
+   SCIP_Real             pscosttotal;        /* sum of all observed bound gains per removed assignment                   */
+   int                   pscostntotal;       /* total number of pseudocost observations                                  */
+   SCIP_Longint          lastlearnednode;    /* number of the last node whose bound gain has been learned                */
+   int                   nlocations;         /* number of locations the pseudocost arrays are allocated for              */
+};
+
 /*
  * Local methods
  */
 
-/** for each pair of locations, compute the (possibly fractional) assignment value */
+/** for each location, compute the (possibly fractional) assignment values of its medians as a sparse list;
+ *  only the variables with nonzero solution value are considered, and the entries of a location are stored in
+ *  medians[beg[location]], ..., medians[beg[location+1]-1] together with their values
+ */
 static
 SCIP_RETCODE computeAssignments(
    SCIP*                 scip,               /* SCIP data structure                                  */
    SCIP_SOL*             sol,                /* solution to be checked, or NULL for LP solution      */
-   SCIP_Real**           assignments         /* matrix of location-median assignments                */
+   int*                  beg,                /* array of size nlocations+1 to store the list starts  */
+   int**                 medians,            /* pointer to store the array of assigned medians       */
+   SCIP_Real**           values,             /* pointer to store the array of assignment values      */
+   int*                  nentries            /* pointer to store the number of entries               */
    )
 {
    int nlocations;
    SCIP_VAR** vars;
    int nvars;
+   SCIP_VAR** solvars;                       /* variables with nonzero solution value                */
+   SCIP_Real* solvals;                       /* their solution values                                */
+   int nsolvars;
+   int* pos;                                 /* next free position in the list of each location      */
 
    int i;
    int j;
@@ -66,64 +109,114 @@ SCIP_RETCODE computeAssignments(
    SCIP_CALL( SCIPgetVarsData(scip, &vars, &nvars, NULL, NULL, NULL, NULL) );
    nlocations = SCIPprobdataGetNLocations(scip);
 
-   for( i = 0; i < nlocations; ++i )
-      for( j = 0; j < nlocations; ++j )
-         assignments[i][j] = 0.0;
-   
-   /* ****************************************************************************************************
-    * TODO: calculate the assignment value for each location-median pair.
-    * i.e., assignments[i][j] should describe the (possible fractional) assignment value of
-    * median j to location i.
-    * This is done by looping over the master variables.
-    *
-    * NOTE: For implementational reasons reasons, the location is the *first* index here
-    * and the median the *second*!
-    * ****************************************************************************************************
-    */
+   SCIP_CALL( SCIPallocBufferArray(scip, &solvars, nvars) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &solvals, nvars) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &pos, nlocations) );
+
+   /* count the entries of each location, considering only variables in the support of the solution */
+   BMSclearMemoryArray(beg, nlocations + 1);
+   nsolvars = 0;
    for( i = 0; i < nvars; ++i )
    {
-      int cluster = SCIPvarGetMedian(vars[i]);
+      int* members;
+      int nmembers;
+      SCIP_Real solval;
 
-      int nmembers = SCIPvarGetNLocations(vars[i]);
+      solval = SCIPgetSolVal(scip, sol, vars[i]);
+      if( SCIPisZero(scip, solval) )
+         continue;
 
-      int* memebers = SCIPvarGetLocations(vars[i]);
+      solvars[nsolvars] = vars[i];
+      solvals[nsolvars] = solval;
+      ++nsolvars;
 
-      for ( j = 0; j < nmembers; ++j ) assignments[memebers[j]][cluster] += SCIPgetSolVal(scip, sol, vars[i]);
+      nmembers = SCIPvarGetNLocations(vars[i]);
+      members = SCIPvarGetLocations(vars[i]);
+      for( j = 0; j < nmembers; ++j )
+         ++beg[members[j] + 1];
    }
-   return SCIP_OKAY;
-}
-
-/** for each location, sort the potential medians by nonincreasing value of fractional assignment */
-static
-void sortMedians(
-   SCIP*                 scip,               /* SCIP data structure                                                     */
-   int**                 sortedids,          /* for each location, the array of medians sorted by fractional assignment */
-   SCIP_Real**           assignments         /* matrix of location-median assignments                                   */
-   )
-{
-   int nlocations;
+   for( i = 0; i < nlocations; ++i )
+      beg[i + 1] += beg[i];
 
-   int i;
+   SCIP_CALL( SCIPallocBufferArray(scip, medians, MAX(beg[nlocations], 1)) );
+   SCIP_CALL( SCIPallocBufferArray(scip, values, MAX(beg[nlocations], 1)) );
 
-   nlocations = SCIPprobdataGetNLocations(scip);
+   /* fill in the entries */
+   BMScopyMemoryArray(pos, beg, nlocations);
+   for( i = 0; i < nsolvars; ++i )
+   {
+      int* members;
+      int nmembers;
+      int median;
+
+      median = SCIPvarGetMedian(solvars[i]);
+      nmembers = SCIPvarGetNLocations(solvars[i]);
+      members = SCIPvarGetLocations(solvars[i]);
+      for( j = 0; j < nmembers; ++j )
+      {
+         (*medians)[pos[members[j]]] = median;
+         (*values)[pos[members[j]]] = solvals[i];
+         ++pos[members[j]];
+      }
+   }
 
+   /* several columns of the same median may contain a location; merge their entries */
+   *nentries = 0;
    for( i = 0; i < nlocations; ++i )
    {
-      SCIPsortDownRealInt(assignments[i], sortedids[i], nlocations);
+      int first;
+      int last;
+
+      first = beg[i];
+      last = beg[i + 1];
+      beg[i] = *nentries;
+
+      SCIPsortIntReal(&(*medians)[first], &(*values)[first], last - first);
+      for( j = first; j < last; ++j )
+      {
+         if( *nentries > beg[i] && (*medians)[*nentries - 1] == (*medians)[j] )
+            (*values)[*nentries - 1] += (*values)[j];
+         else
+         {
+            (*medians)[*nentries] = (*medians)[j];
+            (*values)[*nentries] = (*values)[j];
+            ++(*nentries);
+         }
+      }
    }
+   beg[nlocations] = *nentries;
+
+   SCIPfreeBufferArray(scip, &pos);
+   SCIPfreeBufferArray(scip, &solvals);
+   SCIPfreeBufferArray(scip, &solvars);
 
-   return;
+   return SCIP_OKAY;
+}
+
+/** sort the assigned medians of a location by nonincreasing value of fractional assignment */
+static
+void sortMedians(
+   int*                  medians,            /* assigned medians of the location                     */
+   SCIP_Real*            values,             /* assignment values                                    */
+   int                   nassigned           /* number of assigned medians                           */
+   )
+{
+   SCIPsortDownRealInt(values, medians, nassigned);
 }
 
 /** choose a location to branch on, or find out that the given assignments are feasible:
  *  we choose a location for which the number of fractionally assigned medians is maximal;
  *  in case of ties, we choose the location for which the total fractional assignment value
  *  of every second median is closest to half the total fractional assignment value of all medians.
+ *  The medians are counted in the order of nonincreasing assignment value, as they are split between
+ *  the children in computeChildForbidden(); only the lists of locations that can still be chosen are sorted.
  */
 static
 SCIP_RETCODE chooseLocation(
    SCIP*                 scip,               /* SCIP data structure                                                    */
-   SCIP_Real**           assignments,        /* matrix of location-median assignments                                  */
+   int*                  beg,                /* start of the list of each location                                     */
+   int*                  medians,            /* assigned medians                                                       */
+   SCIP_Real*            values,             /* assignment values                                                      */
    int*                  location            /* pointer to store a location to branch on, or -1 in case of feasibility */
    )
 {
@@ -136,7 +229,7 @@ SCIP_RETCODE chooseLocation(
                                                 and the total fractional assignment of every second median                 */
 
    int i;
-   int median;
+   int k;
 
    SCIPdebugMessage("Choose a location to branch on\n");
 
@@ -153,21 +246,30 @@ SCIP_RETCODE chooseLocation(
       totfrac = 0.0;
       halffrac = 0.0;
 
-      /* ****************************************************************************************************
-       * TODO: for each location, calculate
+      /* for each location, calculate
        *   * to how many medians it is assigned fractionally
        *   * the sum of all fractional assignments
-       *   * the sum of all fractional assignments to an even median
-       * ****************************************************************************************************
+       *   * the sum of all fractional assignments to a median of even rank
+       * medians which are not in the list of the location are not assigned at all
        */
+      for( k = beg[i]; k < beg[i + 1]; ++k )
+      {
+         if( !SCIPisFeasIntegral(scip, values[k]) )
+            nfracmedians += 1;
+      }
 
-      for ( median = 0; median < nlocations; ++median )
+      /* only the locations which can still be chosen need the ranks of their medians */
+      if( nfracmedians == 0 || nfracmedians < maxnfracmedians )
+         continue;
+
+      sortMedians(&medians[beg[i]], &values[beg[i]], beg[i + 1] - beg[i]);
+      for( k = beg[i]; k < beg[i + 1]; ++k )
       {
-         if ( !SCIPisFeasIntegral(scip, assignments[i][median] ) )
+         if( !SCIPisFeasIntegral(scip, values[k]) )
          {
-           nfracmedians += 1;
-           totfrac += assignments[i][median];
-           if ( (median % 2) == 0 ) halffrac += assignments[i][median];
+            totfrac += values[k];
+            if( ((k - beg[i]) % 2) == 0 )
+               halffrac += values[k];
          }
       }
 
@@ -185,84 +287,470 @@ SCIP_RETCODE chooseLocation(
    return SCIP_OKAY;
 }
 
-/** branch on a location: create two child nodes and forbid assigning them to the medians alternately in the two nodes */
+/** computes the assignments which are forbidden in the two children of a location: the medians are taken in the order
+ *  of nonincreasing assignment value, followed by the unassigned medians, and forbidden alternately in the two children
+ */
 static
-SCIP_RETCODE performBranching(
+void computeChildForbidden(
    SCIP*                 scip,               /* SCIP data structure                                  */
-   int*                  sortedids,          /* array of medians sorted by fractional assignment     */
-   SCIP_Real*            assignments,        /* array of median assignments                          */
-   int                   location            /* the location to branch on                            */
+   int*                  medians,            /* assigned medians, sorted by fractional assignment    */
+   SCIP_Real*            values,             /* assignment values                                    */
+   int                   nassigned,          /* number of assigned medians                           */
+   int                   location,           /* the location to branch on                            */
+   SCIP_Bool*            assigned,           /* scratch array of size nlocations, all FALSE on entry and on exit */
+   SCIP_Bool*            leftforbidden,      /* array to store the forbidden medians of the left child  */
+   SCIP_Bool*            rightforbidden      /* array to store the forbidden medians of the right child */
    )
 {
-   SCIP_NODE* childnode;
-   SCIP_CONS* childcons;
-   char name[SCIP_MAXSTRLEN];
-
-   SCIP_Bool* leftforbidden;
-   SCIP_Bool* rightforbidden;
    int nlocations;
+   int median;
 
    int i;
 
    nlocations = SCIPprobdataGetNLocations(scip);
 
-   SCIP_CALL( SCIPallocBufferArray(scip, &leftforbidden, nlocations) );
-   SCIP_CALL( SCIPallocBufferArray(scip, &rightforbidden, nlocations) );
    BMSclearMemoryArray(leftforbidden, nlocations);
    BMSclearMemoryArray(rightforbidden, nlocations);
 
-   /* loop over all potential medians */
+   /* loop over all potential medians, the assigned ones first */
+   for( i = 0; i < nassigned; ++i )
+      assigned[medians[i]] = TRUE;
+   median = -1;
    for( i = 0; i < nlocations; ++i )
    {
-      assert(!SCIPisFeasIntegral(scip, assignments[sortedids[i]]) || SCIPisFeasZero(scip, assignments[sortedids[i]]));
+      if( i < nassigned )
+      {
+         assert(!SCIPisZero(scip, values[i]));
+         median = medians[i];
+      }
+      else
+      {
+         /* next unassigned median in the order of the indices */
+         do
+            ++median;
+         while( assigned[median] );
+      }
 
       /* ignore already forbidden assignments, such that the child constraints only store newly forbidden assignments;
        * otherwise, this could lead to an error when deactivating a constraint
        */
-      if( SCIPpricerCpmpIsAssignmentForbidden(scip, sortedids[i], location) )
+      if( SCIPpricerCpmpIsAssignmentForbidden(scip, median, location) )
          continue;
 
-      /* ****************************************************************************************************
-       * TODO: fill the 'leftforbidden' and 'rightforbidden' arrays which describe which medians
-       * cannot be assigned to the location in the left and right node, respectively;
-       * note that the medians are forbidden alternately
-       * ****************************************************************************************************
-       */
+      /* the medians are forbidden alternately */
       if ( (i % 2) == 1 )
       {
-         leftforbidden[sortedids[i]] = 0;
-         rightforbidden[sortedids[i]] = 1;
+         leftforbidden[median] = 0;
+         rightforbidden[median] = 1;
       }
       else
       {
-         leftforbidden[sortedids[i]] = 1;
-         rightforbidden[sortedids[i]] = 0;
+         leftforbidden[median] = 1;
+         rightforbidden[median] = 0;
       }
    }
 
-   /* ****************************************************************************************************
-    * TODO: create the two child nodes as well as a semiassignment constraint for each of them
-    *
-    * NOTE: The constraints must be explicitly added to the node and then be released.
-    * ****************************************************************************************************
+   for( i = 0; i < nassigned; ++i )
+      assigned[medians[i]] = FALSE;
+}
+
+/** computes the assignment value that is removed in each child of a location, see computeChildForbidden(); only the
+ *  assigned medians contribute, so this takes time linear in their number
+ */
+static
+void computeChildMasses(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   int*                  medians,            /* assigned medians, sorted by fractional assignment    */
+   SCIP_Real*            values,             /* assignment values                                    */
+   int                   nassigned,          /* number of assigned medians                           */
+   int                   location,           /* the location to branch on                            */
+   SCIP_Real*            leftmass,           /* pointer to store the assignment value removed in the left child  */
+   SCIP_Real*            rightmass           /* pointer to store the assignment value removed in the right child */
+   )
+{
+   int i;
+
+   *leftmass = 0.0;
+   *rightmass = 0.0;
+
+   for( i = 0; i < nassigned; ++i )
+   {
+      if( SCIPpricerCpmpIsAssignmentForbidden(scip, medians[i], location) )
+         continue;
+
+      if( (i % 2) == 1 )
+         *rightmass += values[i];
+      else
+         *leftmass += values[i];
+   }
+}
+
+/** adds an observed bound gain of a child of a location to its pseudocosts */
+static
+void updatePseudocost(
+   SCIP_BRANCHRULEDATA*  branchruledata,     /* branching rule data                                  */
+   int                   location,           /* location that was branched on                        */
+   SCIP_Real             gain,               /* increase of the LP value in the child                */
+   SCIP_Real             fracmass            /* assignment value removed in the child                */
+   )
+{
+   SCIP_Real unitgain;
+
+   if( fracmass <= 0.0 || gain == SCIP_INVALID ) /*lint !e777*/
+      return;
+
+   unitgain = MAX(gain, 0.0) / fracmass;
+
+   branchruledata->pscostsums[location] += unitgain;
+   ++branchruledata->pscostcounts[location];
+   branchruledata->pscosttotal += unitgain;
+   ++branchruledata->pscostntotal;
+}
+
+/** learns the bound gain of the current node w.r.t. its parent, if it was created by this branching rule */
+static
+void learnPseudocosts(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_BRANCHRULEDATA*  branchruledata      /* branching rule data                                  */
+   )
+{
+   SCIP_NODE* node;
+   SCIP_CONS* cons;
+   SCIP_Real parentbound;
+
+   node = SCIPgetCurrentNode(scip);
+   if( SCIPnodeGetNumber(node) == branchruledata->lastlearnednode )
+      return;
+   branchruledata->lastlearnednode = SCIPnodeGetNumber(node);
+
+   cons = SCIPfindConsSemiassign(scip, node);
+   if( cons == NULL )
+      return;
+
+   parentbound = SCIPgetParentboundSemiassign(cons);
+   if( parentbound == SCIP_INVALID ) /*lint !e777*/
+      return;
+
+   updatePseudocost(branchruledata, SCIPgetLocationSemiassign(cons), SCIPgetLPObjval(scip) - parentbound,
+      SCIPgetFracmassSemiassign(cons));
+}
+
+/** returns the pseudocost (bound gain per removed assignment) of a location; locations without observations get the
+ *  average over all locations
+ */
+static
+SCIP_Real getPseudocost(
+   SCIP_BRANCHRULEDATA*  branchruledata,     /* branching rule data                                  */
+   int                   location            /* location                                             */
+   )
+{
+   if( branchruledata->pscostcounts[location] > 0 )
+      return branchruledata->pscostsums[location] / branchruledata->pscostcounts[location];
+   if( branchruledata->pscostntotal > 0 )
+      return branchruledata->pscosttotal / branchruledata->pscostntotal;
+
+   return 1.0;
+}
+
+/** branch on a location: create two child nodes and forbid assigning them to the medians alternately in the two nodes;
+ *  the expected bound gain of each child is the removed assignment value times the pseudocost of the location, which
+ *  is used for the estimates of the children and to prefer the child with the smaller gain when diving
+ */
+static
+SCIP_RETCODE performBranching(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_BRANCHRULEDATA*  branchruledata,     /* branching rule data                                  */
+   int*                  medians,            /* assigned medians, sorted by fractional assignment    */
+   SCIP_Real*            values,             /* assignment values                                    */
+   int                   nassigned,          /* number of assigned medians                           */
+   int                   location,           /* the location to branch on                            */
+   SCIP_Real             lpobj               /* LP value of the current node                         */
+   )
+{
+   SCIP_NODE* childnode;
+   SCIP_CONS* childcons;
+   char name[SCIP_MAXSTRLEN];
+
+   SCIP_Bool* assigned;
+   SCIP_Bool* leftforbidden;
+   SCIP_Bool* rightforbidden;
+   SCIP_Real leftmass;
+   SCIP_Real rightmass;
+   SCIP_Real leftgain;
+   SCIP_Real rightgain;
+   SCIP_Real estimate;
+   int nlocations;
+
+   nlocations = SCIPprobdataGetNLocations(scip);
+
+   SCIP_CALL( SCIPallocClearBufferArray(scip, &assigned, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &leftforbidden, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &rightforbidden, nlocations) );
+
+   computeChildForbidden(scip, medians, values, nassigned, location, assigned, leftforbidden, rightforbidden);
+   computeChildMasses(scip, medians, values, nassigned, location, &leftmass, &rightmass);
+
+   /* as for variable branching, the estimate of the parent accounts for the cheaper child; the other child
+    * is charged with the difference of the expected gains
     */
+   leftgain = getPseudocost(branchruledata, location) * leftmass;
+   rightgain = getPseudocost(branchruledata, location) * rightmass;
+   estimate = MAX(SCIPgetLocalTransEstimate(scip), lpobj) - MIN(leftgain, rightgain);
+
+   SCIPdebugMessage("   -> expected gains %g / %g\n", leftgain, rightgain);
 
-   SCIP_CALL(SCIPcreateChild(scip, &childnode, 0, SCIPgetLocalTransEstimate(scip)));
+   /* the LP value and the removed assignment value are stored with the children to learn pseudocosts */
+   SCIP_CALL(SCIPcreateChild(scip, &childnode, -leftgain, estimate + leftgain));
 
    SCIPsnprintf(name, 24, "SemiassignConstrainsLeft");
    SCIP_CALL(SCIPcreateConsSemiassign(scip, &childcons, name, location, leftforbidden, childnode));
+   SCIPsetBranchingDataSemiassign(childcons, lpobj, leftmass);
    SCIP_CALL(SCIPaddConsNode(scip, childnode, childcons, NULL));
    SCIP_CALL(SCIPreleaseCons(scip, &childcons));
 
-   SCIP_CALL(SCIPcreateChild(scip, &childnode, 0, SCIPgetLocalTransEstimate(scip)));
+   SCIP_CALL(SCIPcreateChild(scip, &childnode, -rightgain, estimate + rightgain));
 
    SCIPsnprintf(name, 25, "SemiassignConstrainsright");
    SCIP_CALL(SCIPcreateConsSemiassign(scip, &childcons, name, location, rightforbidden, childnode));
+   SCIPsetBranchingDataSemiassign(childcons, lpobj, rightmass);
    SCIP_CALL(SCIPaddConsNode(scip, childnode, childcons, NULL));
    SCIP_CALL(SCIPreleaseCons(scip, &childcons));
 
-   SCIPfreeBufferArray(scip, &leftforbidden);
    SCIPfreeBufferArray(scip, &rightforbidden);
+   SCIPfreeBufferArray(scip, &leftforbidden);
+   SCIPfreeBufferArray(scip, &assigned);
+
+   return SCIP_OKAY;
+}
+
+/** product score of the bound gains of the two children */
+static
+SCIP_Real computeScore(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_Real             leftgain,           /* bound gain of the left child                         */
+   SCIP_Real             rightgain           /* bound gain of the right child                        */
+   )
+{
+   return MAX(leftgain, SCIPsumepsilon(scip)) * MAX(rightgain, SCIPsumepsilon(scip));
+}
+
+/** evaluates a child of a location by solving its LP with a limited number of pricing rounds in probing mode */
+static
+SCIP_RETCODE evaluateChild(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_BRANCHRULEDATA*  branchruledata,     /* branching rule data                                  */
+   int                   location,           /* the location to branch on                            */
+   SCIP_Bool*            forbidden,          /* medians forbidden for the location in the child      */
+   SCIP_Real*            childobj,           /* pointer to store the LP value of the child, or SCIP_INVALID */
+   SCIP_Bool*            infeasible          /* pointer to store whether the child LP is infeasible  */
+   )
+{
+   SCIP_VAR** vars;
+   int nvars;
+   SCIP_Bool lperror;
+   SCIP_Bool cutoff;
+
+   int i;
+
+   *childobj = SCIP_INVALID;
+   *infeasible = FALSE;
+
+   SCIP_CALL( SCIPstartProbing(scip) );
+   SCIP_CALL( SCIPnewProbingNode(scip) );
+
+   /* apply the child restriction to the pricer and to the existing columns */
+   SCIPpricerCpmpForbidAssignments(scip, location, forbidden);
+
+   SCIP_CALL( SCIPgetVarsData(scip, &vars, &nvars, NULL, NULL, NULL, NULL) );
+   for( i = 0; i < nvars; ++i )
+   {
+      if( SCIPvarGetUbLocal(vars[i]) > 0.5 && forbidden[SCIPvarGetMedian(vars[i])]
+         && SCIPisLocationInCluster(vars[i], location) )
+      {
+         SCIP_CALL( SCIPchgVarUbProbing(scip, vars[i], 0.0) );
+      }
+   }
+
+   SCIP_CALL( SCIPsolveProbingLPWithPricing(scip, FALSE, FALSE, branchruledata->sbmaxpricerounds, &lperror, &cutoff) );
+
+   if( cutoff )
+      *infeasible = TRUE;
+   else if( !lperror && SCIPgetLPSolstat(scip) == SCIP_LPSOLSTAT_OPTIMAL )
+      *childobj = SCIPgetLPObjval(scip);
+
+   SCIPpricerCpmpAllowAssignments(scip, location, forbidden);
+
+   SCIP_CALL( SCIPendProbing(scip) );
+
+   return SCIP_OKAY;
+}
+
+/** chooses a location by pseudocost, strong branching or reliability scores among the fractional locations;
+ *  the candidates are ranked by the fractionality criterion of chooseLocation(), which decides which of them are
+ *  evaluated by strong branching; the lists of all candidates are sorted, and the forbidden sets of the children are
+ *  only built for the candidates evaluated by strong branching
+ */
+static
+SCIP_RETCODE chooseLocationByScore(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_BRANCHRULEDATA*  branchruledata,     /* branching rule data                                  */
+   int*                  beg,                /* start of the list of each location                   */
+   int*                  medians,            /* assigned medians                                     */
+   SCIP_Real*            values,             /* assignment values                                    */
+   int*                  location            /* pointer to the chosen location, is updated           */
+   )
+{
+   SCIP_Bool* assigned;
+   SCIP_Bool* leftforbidden;
+   SCIP_Bool* rightforbidden;
+   SCIP_Real* candkeys;
+   int* cands;
+   int ncands;
+   int nlocations;
+   int nstrong;
+   SCIP_Real lpobj;
+   SCIP_Real bestscore;
+
+   int i;
+   int c;
+   int k;
+
+   nlocations = SCIPprobdataGetNLocations(scip);
+   lpobj = SCIPgetLPObjval(scip);
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &cands, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &candkeys, nlocations) );
+
+   /* scratch arrays for the children of the strong branching candidates, allocated on first use */
+   assigned = NULL;
+   leftforbidden = NULL;
+   rightforbidden = NULL;
+
+   /* rank the fractional locations: more fractional medians first, then the more balanced split */
+   ncands = 0;
+   for( i = 0; i < nlocations; ++i )
+   {
+      SCIP_Real totfrac;
+      SCIP_Real halffrac;
+      int nfracmedians;
+
+      nfracmedians = 0;
+      totfrac = 0.0;
+      halffrac = 0.0;
+      sortMedians(&medians[beg[i]], &values[beg[i]], beg[i + 1] - beg[i]);
+      for( k = beg[i]; k < beg[i + 1]; ++k )
+      {
+         if( !SCIPisFeasIntegral(scip, values[k]) )
+         {
+            nfracmedians += 1;
+            totfrac += values[k];
+            if( ((k - beg[i]) % 2) == 0 )
+               halffrac += values[k];
+         }
+      }
+
+      if( nfracmedians > 0 )
+      {
+         cands[ncands] = i;
+         candkeys[ncands] = nfracmedians + 1.0 / (1.0 + ABS(halffrac - 0.5 * totfrac));
+         ++ncands;
+      }
+   }
+   SCIPsortDownRealInt(candkeys, cands, ncands);
+
+   bestscore = -1.0;
+   nstrong = 0;
+   for( c = 0; c < ncands; ++c )
+   {
+      SCIP_Real leftmass;
+      SCIP_Real rightmass;
+      SCIP_Real leftgain;
+      SCIP_Real rightgain;
+      SCIP_Real score;
+      SCIP_Bool strong;
+
+      i = cands[c];
+
+      if( branchruledata->scoring == 's' )
+         strong = TRUE;
+      else if( branchruledata->scoring == 'r' )
+         strong = branchruledata->pscostcounts[i] < branchruledata->reliability;
+      else
+         strong = FALSE;
+
+      /* strong branching is limited to the best ranked candidates */
+      if( strong && nstrong >= branchruledata->sbcands )
+      {
+         if( branchruledata->scoring == 's' )
+            break;
+         strong = FALSE;
+      }
+
+      computeChildMasses(scip, &medians[beg[i]], &values[beg[i]], beg[i + 1] - beg[i], i, &leftmass, &rightmass);
+
+      if( strong )
+      {
+         SCIP_Real leftobj;
+         SCIP_Real rightobj;
+         SCIP_Bool leftinfeasible;
+         SCIP_Bool rightinfeasible;
+
+         ++nstrong;
+
+         if( assigned == NULL )
+         {
+            SCIP_CALL( SCIPallocClearBufferArray(scip, &assigned, nlocations) );
+            SCIP_CALL( SCIPallocBufferArray(scip, &leftforbidden, nlocations) );
+            SCIP_CALL( SCIPallocBufferArray(scip, &rightforbidden, nlocations) );
+         }
+         computeChildForbidden(scip, &medians[beg[i]], &values[beg[i]], beg[i + 1] - beg[i], i, assigned,
+            leftforbidden, rightforbidden);
+
+         SCIP_CALL( evaluateChild(scip, branchruledata, i, leftforbidden, &leftobj, &leftinfeasible) );
+         SCIP_CALL( evaluateChild(scip, branchruledata, i, rightforbidden, &rightobj, &rightinfeasible) );
+
+         /* an infeasible child makes the location very attractive; a failed LP falls back to the pseudocost */
+         if( leftinfeasible )
+            leftgain = SCIPinfinity(scip);
+         else if( leftobj != SCIP_INVALID ) /*lint !e777*/
+         {
+            leftgain = MAX(leftobj - lpobj, 0.0);
+            updatePseudocost(branchruledata, i, leftgain, leftmass);
+         }
+         else
+            leftgain = getPseudocost(branchruledata, i) * leftmass;
+
+         if( rightinfeasible )
+            rightgain = SCIPinfinity(scip);
+         else if( rightobj != SCIP_INVALID ) /*lint !e777*/
+         {
+            rightgain = MAX(rightobj - lpobj, 0.0);
+            updatePseudocost(branchruledata, i, rightgain, rightmass);
+         }
+         else
+            rightgain = getPseudocost(branchruledata, i) * rightmass;
+
+         SCIPdebugMessage("   -> strong branching on location %d: gains %g / %g\n", i+1, leftgain, rightgain);
+      }
+      else
+      {
+         leftgain = getPseudocost(branchruledata, i) * leftmass;
+         rightgain = getPseudocost(branchruledata, i) * rightmass;
+      }
+
+      score = computeScore(scip, leftgain, rightgain);
+      if( score > bestscore )
+      {
+         bestscore = score;
+         *location = i;
+      }
+   }
+
+   SCIPfreeBufferArrayNull(scip, &rightforbidden);
+   SCIPfreeBufferArrayNull(scip, &leftforbidden);
+   SCIPfreeBufferArrayNull(scip, &assigned);
+   SCIPfreeBufferArray(scip, &candkeys);
+   SCIPfreeBufferArray(scip, &cands);
 
    return SCIP_OKAY;
 }
@@ -272,72 +760,130 @@ SCIP_RETCODE performBranching(
  * @{
  */
 
+/** destructor of branching rule to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_BRANCHFREE(branchFreeSemiassign)
+{  /*lint --e{715}*/
+   SCIP_BRANCHRULEDATA* branchruledata;
+
+   branchruledata = SCIPbranchruleGetData(branchrule);
+   assert(branchruledata != NULL);
+
+   SCIPfreeMemory(scip, &branchruledata);
+   SCIPbranchruleSetData(branchrule, NULL);
+
+   return SCIP_OKAY;
+}
+
+/** solving process initialization method of branching rule (called when branch and bound process is about to begin) */
+static
+SCIP_DECL_BRANCHINITSOL(branchInitsolSemiassign)
+{  /*lint --e{715}*/
+   SCIP_BRANCHRULEDATA* branchruledata;
+
+   branchruledata = SCIPbranchruleGetData(branchrule);
+   assert(branchruledata != NULL);
+
+   branchruledata->nlocations = SCIPprobdataGetNLocations(scip);
+   SCIP_CALL( SCIPallocClearMemoryArray(scip, &branchruledata->pscostsums, branchruledata->nlocations) );
+   SCIP_CALL( SCIPallocClearMemoryArray(scip, &branchruledata->pscostcounts, branchruledata->nlocations) );
+   branchruledata->pscosttotal = 0.0;
+   branchruledata->pscostntotal = 0;
+   branchruledata->lastlearnednode = -1;
+
+   return SCIP_OKAY;
+}
+
+/** solving process deinitialization method of branching rule (called before branch and bound process data is freed) */
+static
+SCIP_DECL_BRANCHEXITSOL(branchExitsolSemiassign)
+{  /*lint --e{715}*/
+   SCIP_BRANCHRULEDATA* branchruledata;
+
+   branchruledata = SCIPbranchruleGetData(branchrule);
+   assert(branchruledata != NULL);
+
+   SCIPfreeMemoryArrayNull(scip, &branchruledata->pscostcounts);
+   SCIPfreeMemoryArrayNull(scip, &branchruledata->pscostsums);
+
+   return SCIP_OKAY;
+}
+
 /** branching execution method for fractional LP solutions */
 static
 SCIP_DECL_BRANCHEXECLP(branchExeclpSemiassign)
 {  /*lint --e{715}*/
+   SCIP_BRANCHRULEDATA* branchruledata;
 
-   int** sortedids;
-   SCIP_Real** assignments;
+   int* beg;
+   int* medians;
+   SCIP_Real* values;
+   int nentries;
    int location;
    int nlocations;
-
-   int i;
-   int j;
+   SCIP_Real lpobj;
 
    SCIPdebugMessage("Solved LP in node %"SCIP_LONGINT_FORMAT":\n", SCIPnodeGetNumber(SCIPgetCurrentNode(scip)));
    SCIPdebug( SCIPprintSolClusters(scip, NULL) );
 
+   branchruledata = SCIPbranchruleGetData(branchrule);
+   assert(branchruledata != NULL);
+
    nlocations = SCIPprobdataGetNLocations(scip);
+   lpobj = SCIPgetLPObjval(scip);
 
-   /* allocate memory */
-   SCIP_CALL( SCIPallocBufferArray(scip, &sortedids, nlocations) );
-   SCIP_CALL( SCIPallocBufferArray(scip, &assignments, nlocations) );
-   for( i = 0; i < nlocations; ++i )
-   {
-      SCIP_CALL( SCIPallocBufferArray(scip, &sortedids[i], nlocations) );
-      SCIP_CALL( SCIPallocBufferArray(scip, &assignments[i], nlocations) );
-      /* initialize the array of assigned medians; this will be sorted by fractional assignment to the location */
-      for( j = 0; j < nlocations; ++j )
-         sortedids[i][j] = j;
-   }
+   /* the LP value of this node tells how much the branching decision leading here increased the bound */
+   learnPseudocosts(scip, branchruledata);
 
-   SCIP_CALL( computeAssignments(scip, NULL, assignments) );
-   sortMedians(scip, sortedids, assignments);
+   /* compute the sparse assignments of the LP solution */
+   CPMP_PROF_START(CPMP_PROF_BRANCH_COMPUTE);
+   SCIP_CALL( SCIPallocBufferArray(scip, &beg, nlocations + 1) );
+   SCIP_CALL( computeAssignments(scip, NULL, beg, &medians, &values, &nentries) );
+   CPMP_PROF_STOP(CPMP_PROF_BRANCH_COMPUTE);
+   CPMP_PROF_COUNT(CPMP_PROF_BRANCH_ENTRIES, nentries);
 
-   SCIP_CALL( chooseLocation(scip, assignments, &location) );
+   /* the choice sorts the lists of the locations that can win it, including the chosen one */
+   CPMP_PROF_START(CPMP_PROF_BRANCH_CHOOSE);
+   SCIP_CALL( chooseLocation(scip, beg, medians, values, &location) );
 
    if( location == -1 )
+   {
+      CPMP_PROF_STOP(CPMP_PROF_BRANCH_CHOOSE);
       *result = SCIP_DIDNOTFIND;
+   }
    else
    {
-#ifdef SCIP_DEBUG
-      SCIPdebugMessage("Chosen location %d:\n", location+1);
-      SCIPdebugMessage("   median ids:");
-      for( j = 0; j < nlocations; ++j )
+      if( branchruledata->scoring != 'f' && !SCIPinProbing(scip) )
       {
-         SCIPdebugPrintf(" %d", sortedids[location][j]+1);
+         SCIP_CALL( chooseLocationByScore(scip, branchruledata, beg, medians, values, &location) );
       }
-      SCIPdebugPrintf("\n");
-      SCIPdebugMessage("   assignments:");
-      for( j = 0; j < nlocations; ++j )
+      CPMP_PROF_STOP(CPMP_PROF_BRANCH_CHOOSE);
+
+      CPMP_PROF_START(CPMP_PROF_BRANCH_SORT);
+      sortMedians(&medians[beg[location]], &values[beg[location]], beg[location + 1] - beg[location]);
+      CPMP_PROF_STOP(CPMP_PROF_BRANCH_SORT);
+
+#ifdef SCIP_DEBUG
+      int k;
+
+      SCIPdebugMessage("Chosen location %d:\n", location+1);
+      SCIPdebugMessage("   assigned medians:");
+      for( k = beg[location]; k < beg[location + 1]; ++k )
       {
-         SCIPdebugPrintf(" %g", assignments[location][j]);
+         SCIPdebugPrintf(" %d (%g)", medians[k]+1, values[k]);
       }
       SCIPdebugPrintf("\n");
 #endif
-      //printf("asdfasdfasdf\n");
-      SCIP_CALL( performBranching(scip, sortedids[location], assignments[location], location) );
+      CPMP_PROF_START(CPMP_PROF_BRANCH_CREATE);
+      SCIP_CALL( performBranching(scip, branchruledata, &medians[beg[location]], &values[beg[location]], beg[location + 1] - beg[location], location, lpobj) );
+      CPMP_PROF_STOP(CPMP_PROF_BRANCH_CREATE);
+      CPMP_PROF_COUNT(CPMP_PROF_BRANCH_CHILDREN, SCIPgetNChildren(scip));
       *result = SCIP_BRANCHED;
    }
 
-   for( i = nlocations-1; i >= 0; --i )
-   {
-      SCIPfreeBufferArray(scip, &assignments[i]);
-      SCIPfreeBufferArray(scip, &sortedids[i]);
-   }
-   SCIPfreeBufferArray(scip, &assignments);
-   SCIPfreeBufferArray(scip, &sortedids);
+   SCIPfreeBufferArray(scip, &values);
+   SCIPfreeBufferArray(scip, &medians);
+   SCIPfreeBufferArray(scip, &beg);
 
    return SCIP_OKAY;
 }
@@ -359,14 +905,53 @@ SCIP_RETCODE SCIPincludeBranchruleSemiassign(
 
    /* create Semi assignment branching rule data */
    branchruledata = NULL;
+   SCIP_CALL( SCIPallocMemory(scip, &branchruledata) );
+   branchruledata->pscostsums = NULL;
+   branchruledata->pscostcounts = NULL;
+   branchruledata->nlocations = 0;
+
    branchrule = NULL;
    /* include branching rule */
    SCIP_CALL( SCIPincludeBranchruleBasic(scip, &branchrule, BRANCHRULE_NAME, BRANCHRULE_DESC, BRANCHRULE_PRIORITY, BRANCHRULE_MAXDEPTH,
          BRANCHRULE_MAXBOUNDDIST, branchruledata) );
    assert(branchrule != NULL);
 
+   SCIP_CALL( SCIPsetBranchruleFree(scip, branchrule, branchFreeSemiassign) );
+   SCIP_CALL( SCIPsetBranchruleInitsol(scip, branchrule, branchInitsolSemiassign) );
+   SCIP_CALL( SCIPsetBranchruleExitsol(scip, branchrule, branchExitsolSemiassign) );
    SCIP_CALL( SCIPsetBranchruleExecLp(scip, branchrule, branchExeclpSemiassign) );
 
+   /* add semiassign branching rule parameters */
+   SCIP_CALL( SCIPaddCharParam(scip, "branching/" BRANCHRULE_NAME "/scoring",
+         "scoring of the candidate locations: 'f'ractionality, 'p'seudocosts, 's'trong branching, 'r'eliability",
+         &branchruledata->scoring, FALSE, DEFAULT_SCORING, "fpsr", NULL, NULL) );
+   SCIP_CALL( SCIPaddIntParam(scip, "branching/" BRANCHRULE_NAME "/sbcands",
+         "maximal number of candidate locations evaluated by strong branching",
+         &branchruledata->sbcands, FALSE, DEFAULT_SBCANDS, 1, INT_MAX, NULL, NULL) );
+   SCIP_CALL( SCIPaddIntParam(scip, "branching/" BRANCHRULE_NAME "/sbmaxpricerounds",
+         "maximal number of pricing rounds when solving a strong branching child (-1: no limit)",
+         &branchruledata->sbmaxpricerounds, FALSE, DEFAULT_SBMAXPRICEROUNDS, -1, INT_MAX, NULL, NULL) );
+   SCIP_CALL( SCIPaddIntParam(scip, "branching/" BRANCHRULE_NAME "/reliability",
+         "number of pseudocost observations after which a location is not evaluated by strong branching any more",
+         &branchruledata->reliability, FALSE, DEFAULT_RELIABILITY, 0, INT_MAX, NULL, NULL) );
+
+   return SCIP_OKAY;
+}
+
+/** for each location, computes the assignment values of its medians in a solution as a sparse list, as done by the
+ *  branching rule; the arrays of medians and values are buffer arrays which the caller has to free
+ */
+SCIP_RETCODE SCIPbranchSemiassignComputeAssignments(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_SOL*             sol,                /**< solution, or NULL for the LP solution */
+   int*                  beg,                /**< array of size nlocations+1 to store the list starts */
+   int**                 medians,            /**< pointer to store the array of assigned medians */
+   SCIP_Real**           values,             /**< pointer to store the array of assignment values */
+   int*                  nentries            /**< pointer to store the number of entries */
+   )
+{
+   SCIP_CALL( computeAssignments(scip, sol, beg, medians, values, nentries) );
+
    return SCIP_OKAY;
 }
 
@@ -30,9 +30,22 @@
 #include "scip/scip.h"
 
 /** creates the semiassign branching rule and includes it in SCIP */
-extern
+EXTERN
 SCIP_RETCODE SCIPincludeBranchruleSemiassign(
    SCIP*                 scip                /**< SCIP data structure */
    );
 
+/** for each location, computes the assignment values of its medians in a solution as a sparse list, as done by the
+ *  branching rule; the arrays of medians and values are buffer arrays which the caller has to free
+ */
+EXTERN
+SCIP_RETCODE SCIPbranchSemiassignComputeAssignments(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_SOL*             sol,                /**< solution, or NULL for the LP solution */
+   int*                  beg,                /**< array of size nlocations+1 to store the list starts */
+   int**                 medians,            /**< pointer to store the array of assigned medians */
+   SCIP_Real**           values,             /**< pointer to store the array of assignment values */
+   int*                  nentries            /**< pointer to store the number of entries */
+   );
+
 #endif
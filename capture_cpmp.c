@@ -0,0 +1,617 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   capture_cpmp.c
+ * @brief  capturing of the pricing problems of a run and reading them back for replay
+ * @author Christian Puchert
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "capture_cpmp.h"
+#include "pub_probdata.h"
+#include "pub_vardata.h"
+
+
+#define CAPTURE_VERSION        1        /**< version of the capture file format                                         */
+#define CAPTURE_BUFFERSIZE     262144   /**< size of the output buffer of the capture file                              */
+
+
+/*
+ * Data structures
+ */
+
+/** writer of captured pricing rounds */
+struct CPMP_CaptureWriter
+{
+   FILE*                 file;               /* capture file                                                                */
+   char*                 buffer;             /* output buffer of the capture file                                           */
+   int                   nlocations;         /* number of locations                                                         */
+   int                   maxrounds;          /* maximal number of rounds to capture (-1: no limit)                          */
+   int                   nrounds;            /* number of rounds captured so far                                            */
+   SCIP_Bool             inround;            /* is a round being captured?                                                  */
+};
+
+
+/*
+ * Local methods
+ */
+
+/** ensures that an integer array has at least the given size */
+static
+SCIP_RETCODE ensureIntArraySize(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   int**                 array,              /* pointer to the array                                 */
+   int*                  size,               /* pointer to the size of the array                     */
+   int                   minsize             /* minimal size                                         */
+   )
+{
+   if( minsize > *size )
+   {
+      int newsize;
+
+      newsize = SCIPcalcMemGrowSize(scip, minsize);
+      SCIP_CALL( SCIPreallocMemoryArray(scip, array, newsize) );
+      *size = newsize;
+   }
+
+   return SCIP_OKAY;
+}
+
+/** ensures that a real array has at least the given size */
+static
+SCIP_RETCODE ensureRealArraySize(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_Real**           array,              /* pointer to the array                                 */
+   int*                  size,               /* pointer to the size of the array                     */
+   int                   minsize             /* minimal size                                         */
+   )
+{
+   if( minsize > *size )
+   {
+      int newsize;
+
+      newsize = SCIPcalcMemGrowSize(scip, minsize);
+      SCIP_CALL( SCIPreallocMemoryArray(scip, array, newsize) );
+      *size = newsize;
+   }
+
+   return SCIP_OKAY;
+}
+
+/** reads the next keyword and checks it */
+static
+SCIP_RETCODE readKeyword(
+   FILE*                 file,               /* capture file                                         */
+   const char*           expected            /* expected keyword                                     */
+   )
+{
+   char keyword[32];
+
+   if( fscanf(file, "%31s", keyword) != 1 || strcmp(keyword, expected) != 0 )
+   {
+      SCIPerrorMessage("invalid capture file: expected <%s>\n", expected);
+      return SCIP_READERROR;
+   }
+
+   return SCIP_OKAY;
+}
+
+/** reads an array of integers */
+static
+SCIP_RETCODE readLongints(
+   FILE*                 file,               /* capture file                                         */
+   SCIP_Longint*         values,             /* array to store the values                            */
+   int                   nvalues             /* number of values to read                             */
+   )
+{
+   int i;
+
+   for( i = 0; i < nvalues; ++i )
+   {
+      if( fscanf(file, "%" SCIP_LONGINT_FORMAT, &values[i]) != 1 )
+      {
+         SCIPerrorMessage("invalid capture file: too few integers\n");
+         return SCIP_READERROR;
+      }
+   }
+
+   return SCIP_OKAY;
+}
+
+/** reads the body of a round after its ROUND line, up to and including the END line; a round without END line was
+ *  interrupted while it was written
+ */
+static
+SCIP_RETCODE readRound(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   FILE*                 file,               /* capture file                                         */
+   int                   nlocations,         /* number of locations                                  */
+   CPMP_CAPTUREROUND*    round,              /* round to fill                                        */
+   SCIP_Bool*            complete            /* pointer to store whether the END line was read       */
+   )
+{
+   char keyword[32];
+   int medianssize;
+   int cutoffssize;
+   int forbiddenssize;
+   int forbiddenbegsize;
+   int colvalssize;
+   int colmedianssize;
+   int colbegsize;
+   int collocationssize;
+   int nforbidden;
+   int i;
+
+   medianssize = 0;
+   cutoffssize = 0;
+   forbiddenssize = 0;
+   forbiddenbegsize = 0;
+   colvalssize = 0;
+   colmedianssize = 0;
+   colbegsize = 0;
+   collocationssize = 0;
+   *complete = FALSE;
+
+   SCIP_CALL( readKeyword(file, "DUALS") );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &round->duals, nlocations) );
+   for( i = 0; i < nlocations; ++i )
+   {
+      if( fscanf(file, "%lf", &round->duals[i]) != 1 )
+      {
+         SCIPerrorMessage("invalid capture file: too few duals\n");
+         return SCIP_READERROR;
+      }
+   }
+
+   SCIP_CALL( ensureIntArraySize(scip, &round->forbiddenbeg, &forbiddenbegsize, 1) );
+   SCIP_CALL( ensureIntArraySize(scip, &round->colbeg, &colbegsize, 1) );
+   round->forbiddenbeg[0] = 0;
+   round->colbeg[0] = 0;
+   nforbidden = 0;
+
+   while( fscanf(file, "%31s", keyword) == 1 )
+   {
+      int nentries;
+
+      if( strcmp(keyword, "END") == 0 )
+      {
+         *complete = TRUE;
+         break;
+      }
+      else if( strcmp(keyword, "PROBLEM") == 0 )
+      {
+         SCIP_CALL( ensureIntArraySize(scip, &round->medians, &medianssize, round->nproblems + 1) );
+         SCIP_CALL( ensureRealArraySize(scip, &round->cutoffs, &cutoffssize, round->nproblems + 1) );
+         SCIP_CALL( ensureIntArraySize(scip, &round->forbiddenbeg, &forbiddenbegsize, round->nproblems + 2) );
+
+         if( fscanf(file, "%d %lf %d", &round->medians[round->nproblems], &round->cutoffs[round->nproblems], &nentries) != 3
+            || nentries < 0 || nentries > nlocations )
+         {
+            SCIPerrorMessage("invalid capture file: invalid pricing problem\n");
+            return SCIP_READERROR;
+         }
+
+         SCIP_CALL( ensureIntArraySize(scip, &round->forbidden, &forbiddenssize, nforbidden + nentries) );
+         for( i = 0; i < nentries; ++i )
+         {
+            if( fscanf(file, "%d", &round->forbidden[nforbidden++]) != 1 )
+            {
+               SCIPerrorMessage("invalid capture file: too few forbidden locations\n");
+               return SCIP_READERROR;
+            }
+         }
+
+         ++round->nproblems;
+         round->forbiddenbeg[round->nproblems] = nforbidden;
+      }
+      else if( strcmp(keyword, "COLUMN") == 0 )
+      {
+         int ncollocations;
+
+         SCIP_CALL( ensureRealArraySize(scip, &round->colvals, &colvalssize, round->ncolumns + 1) );
+         SCIP_CALL( ensureIntArraySize(scip, &round->colmedians, &colmedianssize, round->ncolumns + 1) );
+         SCIP_CALL( ensureIntArraySize(scip, &round->colbeg, &colbegsize, round->ncolumns + 2) );
+
+         if( fscanf(file, "%lf %d %d", &round->colvals[round->ncolumns], &round->colmedians[round->ncolumns], &nentries) != 3
+            || nentries < 0 || nentries > nlocations )
+         {
+            SCIPerrorMessage("invalid capture file: invalid column\n");
+            return SCIP_READERROR;
+         }
+
+         ncollocations = round->colbeg[round->ncolumns];
+         SCIP_CALL( ensureIntArraySize(scip, &round->collocations, &collocationssize, ncollocations + nentries) );
+         for( i = 0; i < nentries; ++i )
+         {
+            if( fscanf(file, "%d", &round->collocations[ncollocations + i]) != 1 )
+            {
+               SCIPerrorMessage("invalid capture file: too few column locations\n");
+               return SCIP_READERROR;
+            }
+         }
+
+         ++round->ncolumns;
+         round->colbeg[round->ncolumns] = ncollocations + nentries;
+      }
+      else
+      {
+         SCIPerrorMessage("invalid capture file: unexpected keyword <%s>\n", keyword);
+         return SCIP_READERROR;
+      }
+   }
+
+   return SCIP_OKAY;
+}
+
+/** frees the arrays of a round */
+static
+void freeRound(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   CPMP_CAPTUREROUND*    round               /* round to free                                        */
+   )
+{
+   SCIPfreeMemoryArrayNull(scip, &round->collocations);
+   SCIPfreeMemoryArrayNull(scip, &round->colbeg);
+   SCIPfreeMemoryArrayNull(scip, &round->colmedians);
+   SCIPfreeMemoryArrayNull(scip, &round->colvals);
+   SCIPfreeMemoryArrayNull(scip, &round->forbidden);
+   SCIPfreeMemoryArrayNull(scip, &round->forbiddenbeg);
+   SCIPfreeMemoryArrayNull(scip, &round->cutoffs);
+   SCIPfreeMemoryArrayNull(scip, &round->medians);
+   SCIPfreeMemoryArrayNull(scip, &round->duals);
+}
+
+/** reads a capture file after it has been opened */
+static
+SCIP_RETCODE readCapture(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   FILE*                 file,               /* capture file                                         */
+   CPMP_CAPTURE*         capture             /* captured run to fill                                 */
+   )
+{
+   char keyword[32];
+   int roundssize;
+   int version;
+   int i;
+
+   SCIP_CALL( readKeyword(file, "CPMPCAPTURE") );
+   if( fscanf(file, "%d", &version) != 1 || version != CAPTURE_VERSION )
+   {
+      SCIPerrorMessage("capture file has an unsupported version\n");
+      return SCIP_READERROR;
+   }
+
+   SCIP_CALL( readKeyword(file, "INSTANCE") );
+   if( fscanf(file, "%d %d", &capture->nlocations, &capture->nclusters) != 2 || capture->nlocations <= 0 )
+   {
+      SCIPerrorMessage("invalid capture file: invalid instance size\n");
+      capture->nlocations = 0;
+      return SCIP_READERROR;
+   }
+
+   SCIP_CALL( SCIPallocClearMemoryArray(scip, &capture->distances, capture->nlocations) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &capture->demands, capture->nlocations) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &capture->capacities, capture->nlocations) );
+   for( i = 0; i < capture->nlocations; ++i )
+   {
+      SCIP_CALL( SCIPallocMemoryArray(scip, &capture->distances[i], capture->nlocations) );
+   }
+
+   SCIP_CALL( readKeyword(file, "DISTANCES") );
+   for( i = 0; i < capture->nlocations; ++i )
+   {
+      SCIP_CALL( readLongints(file, capture->distances[i], capture->nlocations) );
+   }
+   SCIP_CALL( readKeyword(file, "DEMANDS") );
+   SCIP_CALL( readLongints(file, capture->demands, capture->nlocations) );
+   SCIP_CALL( readKeyword(file, "CAPACITIES") );
+   SCIP_CALL( readLongints(file, capture->capacities, capture->nlocations) );
+
+   roundssize = 0;
+   while( fscanf(file, "%31s", keyword) == 1 )
+   {
+      CPMP_CAPTUREROUND* round;
+      SCIP_Bool complete;
+      int redcost;
+
+      if( strcmp(keyword, "ROUND") != 0 )
+      {
+         SCIPerrorMessage("invalid capture file: unexpected keyword <%s>\n", keyword);
+         return SCIP_READERROR;
+      }
+
+      if( capture->nrounds >= roundssize )
+      {
+         int newsize;
+
+         newsize = SCIPcalcMemGrowSize(scip, capture->nrounds + 1);
+         SCIP_CALL( SCIPreallocMemoryArray(scip, &capture->rounds, newsize) );
+         roundssize = newsize;
+      }
+
+      round = &capture->rounds[capture->nrounds];
+      BMSclearMemory(round);
+      ++capture->nrounds;
+
+      if( fscanf(file, "%" SCIP_LONGINT_FORMAT " %d", &round->node, &redcost) != 2 )
+      {
+         SCIPerrorMessage("invalid capture file: invalid round\n");
+         return SCIP_READERROR;
+      }
+      round->redcost = (redcost != 0);
+
+      SCIP_CALL( readRound(scip, file, capture->nlocations, round, &complete) );
+
+      /* the last round may have been interrupted */
+      if( !complete )
+      {
+         freeRound(scip, round);
+         --capture->nrounds;
+         break;
+      }
+   }
+
+   return SCIP_OKAY;
+}
+
+
+/*
+ * Interface methods
+ */
+
+/** opens a capture file and writes the instance data; if the file cannot be opened, a warning is printed and the
+ *  writer is set to NULL
+ */
+SCIP_RETCODE SCIPcreateCaptureWriterCpmp(
+   SCIP*                 scip,               /**< SCIP data structure */
+   CPMP_CAPTUREWRITER**  writer,             /**< pointer to store the writer */
+   const char*           filename,           /**< name of the capture file */
+   int                   maxrounds           /**< maximal number of rounds to capture (-1: no limit) */
+   )
+{
+   SCIP_Longint** distances;
+   SCIP_Longint* demands;
+   SCIP_Longint* capacities;
+   FILE* file;
+   int nlocations;
+   int i;
+   int j;
+
+   assert(writer != NULL);
+   assert(filename != NULL);
+
+   *writer = NULL;
+
+   file = fopen(filename, "w");
+   if( file == NULL )
+   {
+      SCIPwarningMessage(scip, "cannot open capture file <%s>, pricing problems are not captured\n", filename);
+      return SCIP_OKAY;
+   }
+
+   SCIP_CALL( SCIPallocMemory(scip, writer) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &(*writer)->buffer, CAPTURE_BUFFERSIZE) );
+   (void) setvbuf(file, (*writer)->buffer, _IOFBF, CAPTURE_BUFFERSIZE);
+
+   nlocations = SCIPprobdataGetNLocations(scip);
+   distances = SCIPprobdataGetDistances(scip);
+   demands = SCIPprobdataGetDemands(scip);
+   capacities = SCIPprobdataGetCapacities(scip);
+
+   (*writer)->file = file;
+   (*writer)->nlocations = nlocations;
+   (*writer)->maxrounds = maxrounds;
+   (*writer)->nrounds = 0;
+   (*writer)->inround = FALSE;
+
+   fprintf(file, "CPMPCAPTURE %d\nINSTANCE %d %d\nDISTANCES\n", CAPTURE_VERSION, nlocations, SCIPprobdataGetNClusters(scip));
+   for( i = 0; i < nlocations; ++i )
+   {
+      for( j = 0; j < nlocations; ++j )
+         fprintf(file, j == 0 ? "%" SCIP_LONGINT_FORMAT : " %" SCIP_LONGINT_FORMAT, distances[i][j]);
+      fputc('\n', file);
+   }
+   fprintf(file, "DEMANDS");
+   for( i = 0; i < nlocations; ++i )
+      fprintf(file, " %" SCIP_LONGINT_FORMAT, demands[i]);
+   fprintf(file, "\nCAPACITIES");
+   for( i = 0; i < nlocations; ++i )
+      fprintf(file, " %" SCIP_LONGINT_FORMAT, capacities[i]);
+   fputc('\n', file);
+
+   return SCIP_OKAY;
+}
+
+/** closes the capture file and frees the writer */
+void SCIPfreeCaptureWriterCpmp(
+   SCIP*                 scip,               /**< SCIP data structure */
+   CPMP_CAPTUREWRITER**  writer              /**< pointer to the writer */
+   )
+{
+   assert(writer != NULL);
+
+   if( *writer == NULL )
+      return;
+
+   /* a round interrupted by an error is dropped by the reader, since it lacks its END line */
+   (void) fclose((*writer)->file);
+   SCIPfreeMemoryArray(scip, &(*writer)->buffer);
+   SCIPfreeMemory(scip, writer);
+}
+
+/** starts capturing a pricing round, including the LP solution in reduced cost pricing; returns whether the round is
+ *  captured, i.e. whether the limit on the number of rounds has not been reached yet
+ */
+SCIP_Bool SCIPcaptureStartRoundCpmp(
+   SCIP*                 scip,               /**< SCIP data structure */
+   CPMP_CAPTUREWRITER*   writer,             /**< writer */
+   SCIP_Bool             redcost,            /**< is it a reduced cost pricing round? */
+   const SCIP_Real*      duals               /**< service duals the pricing problems are solved for */
+   )
+{
+   int i;
+
+   assert(writer != NULL);
+   assert(!writer->inround);
+
+   if( writer->maxrounds >= 0 && writer->nrounds >= writer->maxrounds )
+      return FALSE;
+
+   fprintf(writer->file, "ROUND %" SCIP_LONGINT_FORMAT " %d\nDUALS", SCIPnodeGetNumber(SCIPgetCurrentNode(scip)),
+      redcost ? 1 : 0);
+   for( i = 0; i < writer->nlocations; ++i )
+      fprintf(writer->file, " %.17g", duals[i]);
+   fputc('\n', writer->file);
+
+   /* the columns in the support of the LP solution are the input of the branching kernels */
+   if( redcost )
+   {
+      SCIP_VAR** vars;
+      int nvars;
+
+      vars = SCIPgetVars(scip);
+      nvars = SCIPgetNVars(scip);
+
+      for( i = 0; i < nvars; ++i )
+      {
+         SCIP_Real solval;
+         int* locations;
+         int nlocations;
+         int j;
+
+         solval = SCIPgetSolVal(scip, NULL, vars[i]);
+         if( SCIPisZero(scip, solval) )
+            continue;
+
+         locations = SCIPvarGetLocations(vars[i]);
+         nlocations = SCIPvarGetNLocations(vars[i]);
+
+         fprintf(writer->file, "COLUMN %.17g %d %d", solval, SCIPvarGetMedian(vars[i]), nlocations);
+         for( j = 0; j < nlocations; ++j )
+            fprintf(writer->file, " %d", locations[j]);
+         fputc('\n', writer->file);
+      }
+   }
+
+   writer->inround = TRUE;
+
+   return TRUE;
+}
+
+/** captures the pricing problem of a median in the current round */
+void SCIPcaptureProblemCpmp(
+   CPMP_CAPTUREWRITER*   writer,             /**< writer */
+   int                   median,             /**< median of the pricing problem */
+   SCIP_Real             cutoff,             /**< profit a knapsack solution has to exceed */
+   const SCIP_Bool*      forbidden           /**< for each location, is the assignment to the median forbidden? */
+   )
+{
+   int nforbidden;
+   int i;
+
+   assert(writer != NULL);
+   assert(writer->inround);
+
+   nforbidden = 0;
+   for( i = 0; i < writer->nlocations; ++i )
+      if( forbidden[i] )
+         ++nforbidden;
+
+   fprintf(writer->file, "PROBLEM %d %.17g %d", median, cutoff, nforbidden);
+   for( i = 0; i < writer->nlocations; ++i )
+      if( forbidden[i] )
+         fprintf(writer->file, " %d", i);
+   fputc('\n', writer->file);
+}
+
+/** finishes capturing the current round */
+void SCIPcaptureEndRoundCpmp(
+   CPMP_CAPTUREWRITER*   writer              /**< writer */
+   )
+{
+   assert(writer != NULL);
+   assert(writer->inround);
+
+   fprintf(writer->file, "END\n");
+   writer->inround = FALSE;
+   ++writer->nrounds;
+}
+
+/** reads a capture file */
+SCIP_RETCODE SCIPreadCaptureCpmp(
+   SCIP*                 scip,               /**< SCIP data structure */
+   const char*           filename,           /**< name of the capture file */
+   CPMP_CAPTURE**        capture             /**< pointer to store the captured run */
+   )
+{
+   FILE* file;
+   SCIP_RETCODE retcode;
+
+   assert(capture != NULL);
+
+   file = fopen(filename, "r");
+   if( file == NULL )
+   {
+      SCIPerrorMessage("cannot open capture file <%s> for reading\n", filename);
+      return SCIP_NOFILE;
+   }
+
+   SCIP_CALL( SCIPallocClearMemory(scip, capture) );
+
+   retcode = readCapture(scip, file, *capture);
+
+   (void) fclose(file);
+
+   if( retcode != SCIP_OKAY )
+      SCIPfreeCaptureCpmp(scip, capture);
+
+   return retcode;
+}
+
+/** frees a captured run */
+void SCIPfreeCaptureCpmp(
+   SCIP*                 scip,               /**< SCIP data structure */
+   CPMP_CAPTURE**        capture             /**< pointer to the captured run */
+   )
+{
+   int i;
+
+   assert(capture != NULL);
+
+   if( *capture == NULL )
+      return;
+
+   for( i = 0; i < (*capture)->nrounds; ++i )
+      freeRound(scip, &(*capture)->rounds[i]);
+   SCIPfreeMemoryArrayNull(scip, &(*capture)->rounds);
+
+   if( (*capture)->distances != NULL )
+   {
+      for( i = (*capture)->nlocations - 1; i >= 0; --i )
+      {
+         SCIPfreeMemoryArrayNull(scip, &(*capture)->distances[i]);
+      }
+   }
+   SCIPfreeMemoryArrayNull(scip, &(*capture)->capacities);
+   SCIPfreeMemoryArrayNull(scip, &(*capture)->demands);
+   SCIPfreeMemoryArrayNull(scip, &(*capture)->distances);
+
+   SCIPfreeMemory(scip, capture);
+}
@@ -0,0 +1,149 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   capture_cpmp.h
+ * @brief  capturing of the pricing problems of a run and reading them back for replay
+ * @author Christian Puchert
+ *
+ * In capture mode, the pricer writes the instance data and, for each pricing round, the service duals, the cutoff and
+ * the forbidden locations of each pricing problem as well as the columns in the support of the LP solution to a text
+ * file. The microbenchmark in check/microbench.c reads such files and replays the pricing problems against the
+ * different variants of the pricing kernels. Rounds under pair restrictions of Ryan-Foster branching are not captured.
+ *
+ * File format (white space separated, reals with full precision):
+ *
+ *     CPMPCAPTURE 1
+ *     INSTANCE <nlocations> <nclusters>
+ *     DISTANCES <nlocations x nlocations integers, row by row>
+ *     DEMANDS <nlocations integers>
+ *     CAPACITIES <nlocations integers>
+ *     ROUND <node> <1: reduced cost / 0: Farkas pricing>
+ *     DUALS <nlocations reals>
+ *     PROBLEM <median> <cutoff> <nforbidden> <forbidden locations>     (once per open median)
+ *     COLUMN <LP value> <median> <nlocations> <locations>              (once per column in the LP support)
+ *     END
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __CPMP_CAPTURE_CPMP_H__
+#define __CPMP_CAPTURE_CPMP_H__
+
+
+#include "scip/scip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** writer of captured pricing rounds */
+typedef struct CPMP_CaptureWriter CPMP_CAPTUREWRITER;
+
+/** captured pricing round */
+struct CPMP_CaptureRound
+{
+   SCIP_Longint          node;               /**< number of the node of the round                                    */
+   SCIP_Bool             redcost;            /**< is it a reduced cost pricing round (or a Farkas pricing round)?    */
+   SCIP_Real*            duals;              /**< service duals the pricing problems were solved for                 */
+   int                   nproblems;          /**< number of pricing problems, i.e. of open medians                   */
+   int*                  medians;            /**< medians of the pricing problems                                    */
+   SCIP_Real*            cutoffs;            /**< profits which the knapsack solutions had to exceed                 */
+   int*                  forbiddenbeg;       /**< start of the forbidden locations of each problem (size nproblems+1) */
+   int*                  forbidden;          /**< forbidden locations of all pricing problems                        */
+   int                   ncolumns;           /**< number of columns in the support of the LP solution                */
+   SCIP_Real*            colvals;            /**< LP values of the columns                                           */
+   int*                  colmedians;         /**< medians of the columns                                             */
+   int*                  colbeg;             /**< start of the locations of each column (size ncolumns+1)            */
+   int*                  collocations;       /**< locations of all columns                                           */
+};
+typedef struct CPMP_CaptureRound CPMP_CAPTUREROUND;
+
+/** captured run */
+struct CPMP_Capture
+{
+   int                   nlocations;         /**< number of locations                                                */
+   int                   nclusters;          /**< number of clusters                                                 */
+   SCIP_Longint**        distances;          /**< distance matrix                                                    */
+   SCIP_Longint*         demands;            /**< demands of the locations                                           */
+   SCIP_Longint*         capacities;         /**< capacities of the locations                                        */
+   CPMP_CAPTUREROUND*    rounds;             /**< captured pricing rounds                                            */
+   int                   nrounds;            /**< number of captured pricing rounds                                  */
+};
+typedef struct CPMP_Capture CPMP_CAPTURE;
+
+/** opens a capture file and writes the instance data; if the file cannot be opened, a warning is printed and the
+ *  writer is set to NULL
+ */
+EXTERN
+SCIP_RETCODE SCIPcreateCaptureWriterCpmp(
+   SCIP*                 scip,               /**< SCIP data structure */
+   CPMP_CAPTUREWRITER**  writer,             /**< pointer to store the writer */
+   const char*           filename,           /**< name of the capture file */
+   int                   maxrounds           /**< maximal number of rounds to capture (-1: no limit) */
+   );
+
+/** closes the capture file and frees the writer */
+EXTERN
+void SCIPfreeCaptureWriterCpmp(
+   SCIP*                 scip,               /**< SCIP data structure */
+   CPMP_CAPTUREWRITER**  writer              /**< pointer to the writer */
+   );
+
+/** starts capturing a pricing round, including the LP solution in reduced cost pricing; returns whether the round is
+ *  captured, i.e. whether the limit on the number of rounds has not been reached yet
+ */
+EXTERN
+SCIP_Bool SCIPcaptureStartRoundCpmp(
+   SCIP*                 scip,               /**< SCIP data structure */
+   CPMP_CAPTUREWRITER*   writer,             /**< writer */
+   SCIP_Bool             redcost,            /**< is it a reduced cost pricing round? */
+   const SCIP_Real*      duals               /**< service duals the pricing problems are solved for */
+   );
+
+/** captures the pricing problem of a median in the current round */
+EXTERN
+void SCIPcaptureProblemCpmp(
+   CPMP_CAPTUREWRITER*   writer,             /**< writer */
+   int                   median,             /**< median of the pricing problem */
+   SCIP_Real             cutoff,             /**< profit a knapsack solution has to exceed */
+   const SCIP_Bool*      forbidden           /**< for each location, is the assignment to the median forbidden? */
+   );
+
+/** finishes capturing the current round */
+EXTERN
+void SCIPcaptureEndRoundCpmp(
+   CPMP_CAPTUREWRITER*   writer              /**< writer */
+   );
+
+/** reads a capture file */
+EXTERN
+SCIP_RETCODE SCIPreadCaptureCpmp(
+   SCIP*                 scip,               /**< SCIP data structure */
+   const char*           filename,           /**< name of the capture file */
+   CPMP_CAPTURE**        capture             /**< pointer to store the captured run */
+   );
+
+/** frees a captured run */
+EXTERN
+void SCIPfreeCaptureCpmp(
+   SCIP*                 scip,               /**< SCIP data structure */
+   CPMP_CAPTURE**        capture             /**< pointer to the captured run */
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,182 @@
+#!/usr/bin/env bash
+#* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+#*                                                                           *
+#*                  This file is part of the program and library             *
+#*         SCIP --- Solving Constraint Integer Programs                      *
+#*                                                                           *
+#*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            *
+#*                            fuer Informationstechnik Berlin                *
+#*                                                                           *
+#*  SCIP is distributed under the terms of the ZIB Academic License.         *
+#*                                                                           *
+#*  You should have received a copy of the ZIB Academic License              *
+#*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      *
+#*                                                                           *
+#* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+#
+# Benchmark driver for the cpmp binary.
+#
+# Generates the instances of a suite with check/gencpmp.c (once; they are deterministic), solves each of them with the
+# cpmp binary under a time limit, and collects status, solving time, root time, nodes, pricing rounds, primal bound
+# and gap into check/results/<suite>.<timestamp>.res. If a baseline for the suite exists, a comparison table against
+# it is printed, including the shifted geometric means of the solving times; with -u, the results become the new
+# baseline check/baseline/<suite>.res.
+#
+# usage: check/bench.sh [-b <binary>] [-s <suite>] [-t <timelimit>] [-p <settings>] [-c <baseline>] [-u]
+
+set -u
+
+CHECKDIR=$(cd "$(dirname "$0")" && pwd)
+
+BINARY=${CHECKDIR}/../bin/cpmp
+SUITE=short
+TIMELIMIT=600
+SETTINGS=
+BASELINE=
+UPDATE=0
+
+while getopts "b:s:t:p:c:uh" opt
+do
+   case ${opt} in
+      b) BINARY=${OPTARG} ;;
+      s) SUITE=${OPTARG} ;;
+      t) TIMELIMIT=${OPTARG} ;;
+      p) SETTINGS=${OPTARG} ;;
+      c) BASELINE=${OPTARG} ;;
+      u) UPDATE=1 ;;
+      *) sed -n 's/^# usage: /usage: /p' "$0"; exit 1 ;;
+   esac
+done
+
+SUITEFILE=${CHECKDIR}/testset/${SUITE}.suite
+BASELINE=${BASELINE:-${CHECKDIR}/baseline/${SUITE}.res}
+
+if [ ! -f "${SUITEFILE}" ]
+then
+   echo "suite file ${SUITEFILE} not found" >&2
+   exit 1
+fi
+if [ ! -x "${BINARY}" ]
+then
+   echo "binary ${BINARY} not found; build it with CMake and pass it with -b" >&2
+   exit 1
+fi
+
+mkdir -p "${CHECKDIR}/bin" "${CHECKDIR}/instances" "${CHECKDIR}/results" "${CHECKDIR}/baseline"
+
+# build the generator
+GENERATOR=${CHECKDIR}/bin/gencpmp
+if [ ! -x "${GENERATOR}" ] || [ "${CHECKDIR}/gencpmp.c" -nt "${GENERATOR}" ]
+then
+   ${CC:-cc} -O2 -o "${GENERATOR}" "${CHECKDIR}/gencpmp.c" -lm || exit 1
+fi
+
+STAMP=$(date +%Y%m%d-%H%M%S)
+RESFILE=${CHECKDIR}/results/${SUITE}.${STAMP}.res
+OUTDIR=${CHECKDIR}/results/${SUITE}.${STAMP}
+mkdir -p "${OUTDIR}"
+
+printf "%-24s %-9s %10s %10s %10s %10s %16s %10s\n" "# instance" status time roottime nodes rounds primal gap > "${RESFILE}"
+
+# give the solver some time to stop and write its statistics before it is killed
+HARDLIMIT=$((TIMELIMIT + TIMELIMIT / 10 + 30))
+if command -v timeout > /dev/null
+then
+   TIMEOUT="timeout ${HARDLIMIT}"
+else
+   TIMEOUT=
+fi
+
+grep -v '^#' "${SUITEFILE}" | while read -r NAME NLOCATIONS NMEDIANS TYPE TIGHTNESS SEED
+do
+   [ -z "${NAME}" ] && continue
+
+   INSTANCE=${CHECKDIR}/instances/${NAME}.cpmp
+   if [ ! -f "${INSTANCE}" ]
+   then
+      "${GENERATOR}" -n "${NLOCATIONS}" -p "${NMEDIANS}" -t "${TYPE}" -r "${TIGHTNESS}" -s "${SEED}" -o "${INSTANCE}" || continue
+   fi
+
+   OUTFILE=${OUTDIR}/${NAME}.out
+   echo "solving ${NAME} ..." >&2
+
+   if [ -n "${SETTINGS}" ]
+   then
+      SETCMD="set load ${SETTINGS}"
+   else
+      SETCMD="set default"
+   fi
+
+   ${TIMEOUT} "${BINARY}" -c "${SETCMD}" -c "set limits time ${TIMELIMIT}" -c "read ${INSTANCE}" -c "optimize" \
+      -c "display statistics" -c "quit" > "${OUTFILE}" 2>&1
+
+   awk -v name="${NAME}" '
+      BEGIN { status = "abort"; time = "-"; roottime = "-"; nodes = "-"; rounds = "-"; primal = "-"; gap = "-" }
+      /^SCIP Status/ {
+         if( $0 ~ /optimal solution found/ ) status = "ok"
+         else if( $0 ~ /time limit reached/ ) status = "timelimit"
+         else if( $0 ~ /infeasible/ ) status = "infeasible"
+         else status = "fail"
+      }
+      /^Solving Time \(sec\)/ { time = $NF }
+      /^Solving Nodes/ { split($0, a, ":"); split(a[2], b, " "); nodes = b[1] }
+      /^Primal Bound/ { split($0, a, ":"); split(a[2], b, " "); primal = b[1] }
+      /^Gap/ { split($0, a, ":"); split(a[2], b, " "); gap = b[1] }
+      /^CPMP Pricing Rounds/ { getline; split($0, a, ":"); split(a[2], b, " "); rounds = b[1] }
+      /^CPMP Pricing Time/ { getline; split($0, a, ":"); split(a[2], b, " "); roottime = b[5] }
+      END { printf("%-24s %-9s %10s %10s %10s %10s %16s %10s\n", name, status, time, roottime, nodes, rounds, primal, gap) }
+   ' "${OUTFILE}" >> "${RESFILE}"
+done
+
+echo "results written to ${RESFILE}" >&2
+
+if [ -f "${BASELINE}" ]
+then
+   # compare with the baseline; the shifted geometric mean (shift 1 second) is not dominated by the easy instances
+   awk '
+      function sgm(sum, n) { return n > 0 ? exp(sum / n) - 1.0 : 0.0 }
+      FNR == NR {
+         if( $1 !~ /^#/ ) { bstatus[$1] = $2; btime[$1] = $3; broot[$1] = $4; bnodes[$1] = $5; brounds[$1] = $6; bprimal[$1] = $7 }
+         next
+      }
+      FNR == 1 {
+         printf("%-24s %-9s %9s %9s %7s %9s %9s %9s %9s %8s %8s %8s\n", "instance", "status", "time", "base", "ratio",
+            "root", "base", "nodes", "base", "rounds", "base", "gap")
+      }
+      $1 !~ /^#/ {
+         flag = ""
+         if( !($1 in bstatus) )
+            flag = "  (new)"
+         else if( bstatus[$1] == "ok" && $2 == "ok" && bprimal[$1] != $7 )
+            flag = "  (primal bound differs: " bprimal[$1] ")"
+         else if( bstatus[$1] != $2 )
+            flag = "  (was " bstatus[$1] ")"
+
+         ratio = "-"
+         if( ($1 in btime) && btime[$1] != "-" && $3 != "-" )
+         {
+            ratio = sprintf("%.2f", ($3 + 1.0) / (btime[$1] + 1.0))
+            sumlog += log($3 + 1.0)
+            sumbaselog += log(btime[$1] + 1.0)
+            ++ncommon
+         }
+         printf("%-24s %-9s %9s %9s %7s %9s %9s %9s %9s %8s %8s %8s%s\n", $1, $2, $3, ($1 in btime) ? btime[$1] : "-",
+            ratio, $4, ($1 in broot) ? broot[$1] : "-", $5, ($1 in bnodes) ? bnodes[$1] : "-", $6,
+            ($1 in brounds) ? brounds[$1] : "-", $8, flag)
+      }
+      END {
+         if( ncommon > 0 )
+            printf("\nshifted geometric mean of the solving time over %d instances: %.2f (baseline %.2f, ratio %.3f)\n",
+               ncommon, sgm(sumlog, ncommon), sgm(sumbaselog, ncommon), exp((sumlog - sumbaselog) / ncommon))
+      }
+   ' "${BASELINE}" "${RESFILE}"
+else
+   cat "${RESFILE}"
+   echo "no baseline ${BASELINE}; store one with -u" >&2
+fi
+
+if [ ${UPDATE} -eq 1 ]
+then
+   cp "${RESFILE}" "${BASELINE}"
+   echo "baseline ${BASELINE} updated" >&2
+fi
@@ -0,0 +1,322 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   gencpmp.c
+ * @brief  generator for random capacitated p-median instances in the format of the cpmp reader
+ * @author Christian Puchert
+ *
+ * The locations are points in the square [0,100]^2, either drawn uniformly at random as in the instances of Osman and
+ * Christofides and of Beasley, or drawn around p random centers. The distances are the Euclidean distances rounded to
+ * the nearest integer, the demands are drawn uniformly from [1,20], and all locations have the same capacity Q, which
+ * is chosen such that the total demand is the given fraction (the tightness) of the total capacity p * Q of p medians.
+ *
+ * Usage: gencpmp -n <locations> -p <medians> [-t r|c] [-r <tightness>] [-s <seed>] [-o <file>]
+ *
+ * The generator only depends on the C standard library, and the same arguments always yield the same instance.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI                   3.14159265358979323846
+#endif
+
+#define SQUARESIZE             100.0    /**< side length of the square containing the locations                        */
+#define MAXDEMAND              20       /**< maximal demand of a location                                              */
+#define MAXLINELENGTH          1023     /**< maximal length of a line the cpmp reader can read (SCIP_MAXSTRLEN - 1)    */
+
+/** state of the pseudo random number generator (xorshift64*) */
+static unsigned long long randstate;
+
+/** initializes the random number generator */
+static
+void initRandom(
+   unsigned long long    seed                /* seed of the random number generator */
+   )
+{
+   /* the state must not be zero; mix the seed with a splitmix64 step so that small seeds give unrelated streams */
+   seed += 0x9E3779B97F4A7C15ULL;
+   seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+   seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EBULL;
+   randstate = (seed ^ (seed >> 31)) | 1ULL;
+}
+
+/** returns a random number in [0,1) */
+static
+double getRandomReal(
+   void
+   )
+{
+   randstate ^= randstate >> 12;
+   randstate ^= randstate << 25;
+   randstate ^= randstate >> 27;
+
+   return (double)((randstate * 0x2545F4914F6CDD1DULL) >> 11) / 9007199254740992.0;
+}
+
+/** returns a random integer in [lb,ub] */
+static
+int getRandomInt(
+   int                   lb,                 /* lower bound */
+   int                   ub                  /* upper bound */
+   )
+{
+   return lb + (int)(getRandomReal() * (ub - lb + 1));
+}
+
+/** returns a normally distributed random number with mean 0 and standard deviation 1 (Box-Muller) */
+static
+double getRandomNormal(
+   void
+   )
+{
+   double u;
+
+   u = 1.0 - getRandomReal();
+
+   return sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * getRandomReal());
+}
+
+/** returns the number of characters of the decimal representation of a nonnegative number plus a separator */
+static
+int getFieldLength(
+   long long             value               /* nonnegative value */
+   )
+{
+   int length;
+
+   for( length = 2; value >= 10; value /= 10 )
+      ++length;
+
+   return length;
+}
+
+/** draws the coordinates of the locations */
+static
+void drawPoints(
+   double*               x,                  /* x coordinates of the locations */
+   double*               y,                  /* y coordinates of the locations */
+   int                   nlocations,         /* number of locations */
+   int                   nmedians,           /* number of medians */
+   char                  type                /* type of the instance: 'r'andom or 'c'lustered points */
+   )
+{
+   int i;
+
+   if( type == 'r' )
+   {
+      for( i = 0; i < nlocations; ++i )
+      {
+         x[i] = SQUARESIZE * getRandomReal();
+         y[i] = SQUARESIZE * getRandomReal();
+      }
+   }
+   else
+   {
+      double* centerx;
+      double* centery;
+      double sigma;
+
+      centerx = (double*) malloc(nmedians * sizeof(double));
+      centery = (double*) malloc(nmedians * sizeof(double));
+
+      for( i = 0; i < nmedians; ++i )
+      {
+         centerx[i] = SQUARESIZE * getRandomReal();
+         centery[i] = SQUARESIZE * getRandomReal();
+      }
+
+      /* the clusters get sparser the fewer there are, so that they cover comparable parts of the square */
+      sigma = SQUARESIZE / (4.0 * sqrt((double) nmedians));
+
+      for( i = 0; i < nlocations; ++i )
+      {
+         int center;
+
+         center = getRandomInt(0, nmedians - 1);
+         x[i] = centerx[center] + sigma * getRandomNormal();
+         y[i] = centery[center] + sigma * getRandomNormal();
+         x[i] = x[i] < 0.0 ? 0.0 : (x[i] > SQUARESIZE ? SQUARESIZE : x[i]);
+         y[i] = y[i] < 0.0 ? 0.0 : (y[i] > SQUARESIZE ? SQUARESIZE : y[i]);
+      }
+
+      free(centery);
+      free(centerx);
+   }
+}
+
+/** prints the usage of the generator */
+static
+void printUsage(
+   const char*           name                /* name of the program */
+   )
+{
+   fprintf(stderr, "usage: %s -n <locations> -p <medians> [-t r|c] [-r <tightness>] [-s <seed>] [-o <file>]\n", name);
+   fprintf(stderr, "  -n  number of locations\n");
+   fprintf(stderr, "  -p  number of medians\n");
+   fprintf(stderr, "  -t  'r'andom (default) or 'c'lustered points\n");
+   fprintf(stderr, "  -r  total demand divided by the capacity of p medians, in (0,1] (default 0.8)\n");
+   fprintf(stderr, "  -s  seed of the random number generator (default 0)\n");
+   fprintf(stderr, "  -o  output file (default: standard output)\n");
+}
+
+int
+main(
+   int                   argc,
+   char**                argv
+   )
+{
+   FILE* file;
+   const char* filename;
+   double* x;
+   double* y;
+   long long* demands;
+   long long totaldemand;
+   long long maxdemand;
+   long long capacity;
+   long long maxdistance;
+   double tightness;
+   unsigned long long seed;
+   char type;
+   int nlocations;
+   int nmedians;
+   int i;
+   int j;
+
+   nlocations = -1;
+   nmedians = -1;
+   type = 'r';
+   tightness = 0.8;
+   seed = 0;
+   filename = NULL;
+
+   for( i = 1; i < argc; ++i )
+   {
+      if( argv[i][0] != '-' || argv[i][1] == '\0' || argv[i][2] != '\0' || i + 1 >= argc )
+      {
+         printUsage(argv[0]);
+         return 1;
+      }
+
+      switch( argv[i][1] )
+      {
+      case 'n':
+         nlocations = atoi(argv[++i]);
+         break;
+      case 'p':
+         nmedians = atoi(argv[++i]);
+         break;
+      case 't':
+         type = argv[++i][0];
+         break;
+      case 'r':
+         tightness = atof(argv[++i]);
+         break;
+      case 's':
+         seed = strtoull(argv[++i], NULL, 10);
+         break;
+      case 'o':
+         filename = argv[++i];
+         break;
+      default:
+         printUsage(argv[0]);
+         return 1;
+      }
+   }
+
+   if( nlocations <= 0 || nmedians <= 0 || nmedians > nlocations || (type != 'r' && type != 'c')
+      || !(tightness > 0.0 && tightness <= 1.0) )
+   {
+      printUsage(argv[0]);
+      return 1;
+   }
+
+   /* the reader reads each line into a buffer of fixed size, so the rows of the distance matrix must fit into it */
+   maxdistance = (long long) floor(SQUARESIZE * sqrt(2.0) + 0.5);
+   if( (long long) nlocations * getFieldLength(maxdistance) > MAXLINELENGTH )
+   {
+      fprintf(stderr, "error: %d locations may exceed the maximal line length %d of the cpmp reader\n", nlocations,
+         MAXLINELENGTH);
+      return 1;
+   }
+
+   initRandom(seed);
+
+   x = (double*) malloc(nlocations * sizeof(double));
+   y = (double*) malloc(nlocations * sizeof(double));
+   demands = (long long*) malloc(nlocations * sizeof(long long));
+
+   drawPoints(x, y, nlocations, nmedians, type);
+
+   totaldemand = 0;
+   maxdemand = 0;
+   for( i = 0; i < nlocations; ++i )
+   {
+      demands[i] = getRandomInt(1, MAXDEMAND);
+      totaldemand += demands[i];
+      if( demands[i] > maxdemand )
+         maxdemand = demands[i];
+   }
+
+   /* each location must fit into a cluster of its own */
+   capacity = (long long) ceil(totaldemand / (nmedians * tightness));
+   if( capacity < maxdemand )
+      capacity = maxdemand;
+
+   file = filename == NULL ? stdout : fopen(filename, "w");
+   if( file == NULL )
+   {
+      fprintf(stderr, "error: cannot open file <%s> for writing\n", filename);
+      free(demands);
+      free(y);
+      free(x);
+      return 1;
+   }
+
+   fprintf(file, "%d %d\n", nlocations, nmedians);
+   for( i = 0; i < nlocations; ++i )
+   {
+      for( j = 0; j < nlocations; ++j )
+      {
+         double dx;
+         double dy;
+
+         dx = x[i] - x[j];
+         dy = y[i] - y[j];
+         fprintf(file, j == 0 ? "%lld" : " %lld", (long long) floor(sqrt(dx * dx + dy * dy) + 0.5));
+      }
+      fprintf(file, "\n");
+   }
+   for( i = 0; i < nlocations; ++i )
+      fprintf(file, i == 0 ? "%lld" : " %lld", demands[i]);
+   fprintf(file, "\n");
+   for( i = 0; i < nlocations; ++i )
+      fprintf(file, i == 0 ? "%lld" : " %lld", capacity);
+   fprintf(file, "\n");
+
+   if( file != stdout )
+      fclose(file);
+
+   free(demands);
+   free(y);
+   free(x);
+
+   return 0;
+}
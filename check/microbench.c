@@ -0,0 +1,656 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   microbench.c
+ * @brief  microbenchmarks of the pricing and branching kernels on captured pricing problems
+ * @author Christian Puchert
+ *
+ * Replays the pricing rounds of a capture file (written with the parameter pricers/cpmp/capturefile) against the
+ * kernels of the cpmp plugins, each in all of its variants:
+ *
+ *  - profits:     construction of the profit vectors, per instruction set, with the captured forbidden sets and
+ *                 without any, so that the difference is the cost of the forbidden-set filtering
+ *  - knapsack:    solving the pricing knapsacks with reduction and the cpmp solver, with the cpmp solver only, and
+ *                 with scip's exact knapsack solver
+ *  - assignments: the sparse assignments of the captured LP solutions as computed by semiassign branching
+ *  - incluster:   SCIPisLocationInCluster() for all columns and locations
+ *  - parse:       the integer parsing of the reader on the rows of the distance matrix
+ *
+ * For each variant, the number of calls, the total and the average wall clock time and a checksum are printed; the
+ * variants of a kernel must agree on the checksum.
+ *
+ * usage: microbench <capturefile> [-r <repetitions>] [-k <kernel>]
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "scip/scip.h"
+#include "scip/cons_knapsack.h"
+
+#include "branch_semiassign.h"
+#include "capture_cpmp.h"
+#include "knapsack_cpmp.h"
+#include "pricer_cpmp.h"
+#include "probdata.h"
+#include "profits_cpmp.h"
+#include "pub_probdata.h"
+#include "pub_vardata.h"
+#include "reader_cpmp.h"
+#include "vardata.h"
+
+
+#define DEFAULT_REPETITIONS    10       /**< number of times each kernel replays the captured rounds                    */
+#define KNAPSACK_MAXDPCELLS    10000000LL /**< maximal number of dynamic programming cells of the cpmp knapsack solver  */
+#define KNAPSACK_MAXBBNODES    1000000LL  /**< maximal number of branch-and-bound nodes of the cpmp knapsack solver     */
+
+
+/** prints the result line of a kernel variant */
+static
+void printResult(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   const char*           kernel,             /* name of the kernel                                   */
+   const char*           variant,            /* name of the variant                                  */
+   SCIP_Longint          ncalls,             /* number of calls                                      */
+   SCIP_Real             time,               /* total time in seconds                                */
+   SCIP_Real             checksum            /* checksum of the results                              */
+   )
+{
+   SCIPinfoMessage(scip, NULL, "%-12s %-24s %12" SCIP_LONGINT_FORMAT " %12.3f %12.1f %20.6f\n", kernel, variant, ncalls,
+      1e3 * time, ncalls > 0 ? 1e9 * time / ncalls : 0.0, checksum);
+}
+
+/** fills the dense forbidden row of a captured pricing problem */
+static
+void getForbiddenRow(
+   CPMP_CAPTUREROUND*    round,              /* captured round                                       */
+   int                   problem,            /* index of the pricing problem in the round            */
+   int                   nlocations,         /* number of locations                                  */
+   SCIP_Bool*            forbidden           /* array to store the forbidden row                     */
+   )
+{
+   int i;
+
+   BMSclearMemoryArray(forbidden, nlocations);
+   for( i = round->forbiddenbeg[problem]; i < round->forbiddenbeg[problem + 1]; ++i )
+      forbidden[round->forbidden[i]] = TRUE;
+}
+
+/** replays the profit construction of all captured pricing problems */
+static
+SCIP_RETCODE benchProfits(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   CPMP_CAPTURE*         capture,            /* captured run                                         */
+   int                   nrepetitions        /* number of repetitions                                */
+   )
+{
+   SCIP_Real** mediandistances;
+   SCIP_Bool* forbiddenrows;                 /* dense forbidden rows of all captured pricing problems */
+   SCIP_Bool* allowed;                       /* forbidden row without forbidden locations             */
+   SCIP_Real* profits;
+   SCIP_Longint* demands;
+   int* items;
+   SCIP_CLOCK* clock;
+   int nlocations;
+   int nproblems;
+   int level;
+   int r;
+   int p;
+   int k;
+
+   nlocations = capture->nlocations;
+   mediandistances = SCIPprobdataGetMedianDistances(scip);
+
+   nproblems = 0;
+   for( r = 0; r < capture->nrounds; ++r )
+      nproblems += capture->rounds[r].nproblems;
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &forbiddenrows, (size_t)MAX(nproblems, 1) * nlocations) );
+   SCIP_CALL( SCIPallocClearBufferArray(scip, &allowed, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &profits, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &demands, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &items, nlocations) );
+   SCIP_CALL( SCIPcreateWallClock(scip, &clock) );
+
+   /* the dense forbidden rows are set up in advance, so that only the kernel is timed */
+   k = 0;
+   for( r = 0; r < capture->nrounds; ++r )
+      for( p = 0; p < capture->rounds[r].nproblems; ++p, ++k )
+         getForbiddenRow(&capture->rounds[r], p, nlocations, &forbiddenrows[(size_t)k * nlocations]);
+
+   for( level = CPMP_SIMD_NONE; level <= CPMP_SIMD_AVX512; ++level )
+   {
+      static const char* levelnames[] = { "scalar", "avx2", "avx512" };
+      int filter;
+
+      if( level > (int)SCIPgetSimdLevelCpmp() )
+      {
+         SCIPinfoMessage(scip, NULL, "%-12s %-24s not supported by this processor or build\n", "profits", levelnames[level]);
+         continue;
+      }
+
+      for( filter = 1; filter >= 0; --filter )
+      {
+         char variant[SCIP_MAXSTRLEN];
+         SCIP_Real checksum;
+         SCIP_Longint ncalls;
+         int rep;
+
+         checksum = 0.0;
+         ncalls = 0;
+
+         SCIP_CALL( SCIPresetClock(scip, clock) );
+         SCIP_CALL( SCIPstartClock(scip, clock) );
+         for( rep = 0; rep < nrepetitions; ++rep )
+         {
+            k = 0;
+            for( r = 0; r < capture->nrounds; ++r )
+            {
+               CPMP_CAPTUREROUND* round;
+
+               round = &capture->rounds[r];
+               for( p = 0; p < round->nproblems; ++p, ++k )
+               {
+                  int nitems;
+
+                  nitems = SCIPcomputeProfitsCpmp((CPMP_SIMDLEVEL)level, nlocations, round->duals,
+                     round->redcost ? mediandistances[round->medians[p]] : NULL,
+                     filter ? &forbiddenrows[(size_t)k * nlocations] : allowed, capture->demands, items, profits, demands);
+                  checksum += nitems;
+                  ++ncalls;
+               }
+            }
+         }
+         SCIP_CALL( SCIPstopClock(scip, clock) );
+
+         (void) SCIPsnprintf(variant, SCIP_MAXSTRLEN, "%s%s", levelnames[level], filter ? "" : "-nofilter");
+         printResult(scip, "profits", variant, ncalls, SCIPgetClockTime(scip, clock), checksum / nrepetitions);
+      }
+   }
+
+   SCIP_CALL( SCIPfreeClock(scip, &clock) );
+   SCIPfreeBufferArray(scip, &items);
+   SCIPfreeBufferArray(scip, &demands);
+   SCIPfreeBufferArray(scip, &profits);
+   SCIPfreeBufferArray(scip, &allowed);
+   SCIPfreeBufferArray(scip, &forbiddenrows);
+
+   return SCIP_OKAY;
+}
+
+/** replays the knapsack solves of all captured pricing problems; the checksum is the sum of the profits of the
+ *  solutions, where a solution which does not exceed the cutoff counts with the cutoff (the solvers need not
+ *  optimize beyond it)
+ */
+static
+SCIP_RETCODE benchKnapsack(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   CPMP_CAPTURE*         capture,            /* captured run                                         */
+   int                   nrepetitions        /* number of repetitions                                */
+   )
+{
+   static const char* variantnames[] = { "reduce+cpmp", "cpmp", "scip" };
+   CPMP_KNAPSACK* knapsack;
+   SCIP_Real** mediandistances;
+   SCIP_Bool* forbidden;
+   SCIP_Real* allprofits;
+   SCIP_Longint* alldemands;
+   int* allitems;
+   SCIP_Real* profits;
+   SCIP_Longint* demands;
+   int* items;
+   int* solitems;
+   int* nonsolitems;
+   SCIP_CLOCK* clock;
+   int nlocations;
+   int variant;
+
+   nlocations = capture->nlocations;
+   mediandistances = SCIPprobdataGetMedianDistances(scip);
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &forbidden, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &allprofits, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &alldemands, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &allitems, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &profits, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &demands, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &items, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &solitems, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &nonsolitems, nlocations) );
+   SCIP_CALL( SCIPcreateKnapsackCpmp(scip, &knapsack, KNAPSACK_MAXDPCELLS, KNAPSACK_MAXBBNODES) );
+   SCIP_CALL( SCIPcreateWallClock(scip, &clock) );
+
+   for( variant = 0; variant < 3; ++variant )
+   {
+      SCIP_Real checksum;
+      SCIP_Longint ncalls;
+      SCIP_Longint nfailed;
+      int rep;
+      int r;
+      int p;
+
+      checksum = 0.0;
+      ncalls = 0;
+      nfailed = 0;
+
+      SCIP_CALL( SCIPresetClock(scip, clock) );
+      for( rep = 0; rep < nrepetitions; ++rep )
+      {
+         for( r = 0; r < capture->nrounds; ++r )
+         {
+            CPMP_CAPTUREROUND* round;
+
+            round = &capture->rounds[r];
+            for( p = 0; p < round->nproblems; ++p )
+            {
+               SCIP_Longint capacity;
+               SCIP_Real solval;
+               SCIP_Real upperbound;
+               SCIP_Bool success;
+               int nallitems;
+               int nitems;
+               int nsolitems;
+               int nnonsolitems;
+               int median;
+
+               median = round->medians[p];
+               capacity = capture->capacities[median];
+
+               /* the profit construction is not timed; the items are copied since the kernels modify them */
+               getForbiddenRow(round, p, nlocations, forbidden);
+               nallitems = SCIPcomputeProfitsCpmp(CPMP_SIMD_NONE, nlocations, round->duals,
+                  round->redcost ? mediandistances[median] : NULL, forbidden, capture->demands, allitems, allprofits,
+                  alldemands);
+               nitems = nallitems;
+               BMScopyMemoryArray(items, allitems, nallitems);
+               BMScopyMemoryArray(profits, allprofits, nallitems);
+               BMScopyMemoryArray(demands, alldemands, nallitems);
+
+               SCIP_CALL( SCIPstartClock(scip, clock) );
+               if( variant == 2 )
+               {
+                  SCIP_CALL( SCIPsolveKnapsackExactly(scip, nitems, demands, profits, capacity, items, solitems,
+                        nonsolitems, &nsolitems, &nnonsolitems, &solval, &success) );
+               }
+               else
+               {
+                  if( variant == 0 )
+                  {
+                     int noversized;
+                     int ndominated;
+                     int nbounded;
+
+                     SCIP_CALL( SCIPreduceKnapsackCpmp(scip, knapsack, &nitems, demands, profits, capacity, items,
+                           round->cutoffs[p], &noversized, &ndominated, &nbounded) );
+                  }
+                  SCIP_CALL( SCIPsolveKnapsackCpmp(scip, knapsack, nitems, demands, profits, capacity, items,
+                        round->cutoffs[p], solitems, &nsolitems, &solval, &upperbound, &success) );
+               }
+               SCIP_CALL( SCIPstopClock(scip, clock) );
+
+               if( success )
+                  checksum += MAX(solval, round->cutoffs[p]);
+               else
+                  ++nfailed;
+               ++ncalls;
+            }
+         }
+      }
+
+      printResult(scip, "knapsack", variantnames[variant], ncalls, SCIPgetClockTime(scip, clock), checksum / nrepetitions);
+      if( nfailed > 0 )
+         SCIPinfoMessage(scip, NULL, "%-12s %-24s %" SCIP_LONGINT_FORMAT " problems not solved (node limit)\n", "",
+            variantnames[variant], nfailed);
+   }
+
+   SCIP_CALL( SCIPfreeClock(scip, &clock) );
+   SCIPfreeKnapsackCpmp(scip, &knapsack);
+   SCIPfreeBufferArray(scip, &nonsolitems);
+   SCIPfreeBufferArray(scip, &solitems);
+   SCIPfreeBufferArray(scip, &items);
+   SCIPfreeBufferArray(scip, &demands);
+   SCIPfreeBufferArray(scip, &profits);
+   SCIPfreeBufferArray(scip, &allitems);
+   SCIPfreeBufferArray(scip, &alldemands);
+   SCIPfreeBufferArray(scip, &allprofits);
+   SCIPfreeBufferArray(scip, &forbidden);
+
+   return SCIP_OKAY;
+}
+
+/** creates a variable for each captured LP column and a solution with the LP values of each reduced cost round */
+static
+SCIP_RETCODE createColumns(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   CPMP_CAPTURE*         capture,            /* captured run                                         */
+   SCIP_SOL**            sols                /* array to store the solutions of the rounds (NULL for Farkas rounds) */
+   )
+{
+   int r;
+   int c;
+
+   for( r = 0; r < capture->nrounds; ++r )
+   {
+      CPMP_CAPTUREROUND* round;
+
+      round = &capture->rounds[r];
+      sols[r] = NULL;
+
+      if( !round->redcost )
+         continue;
+
+      SCIP_CALL( SCIPcreateOrigSol(scip, &sols[r], NULL) );
+
+      for( c = 0; c < round->ncolumns; ++c )
+      {
+         SCIP_VAR* var;
+         char name[SCIP_MAXSTRLEN];
+
+         (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "column_%d", SCIPgetNVars(scip));
+         SCIP_CALL( SCIPcreateVarBasic(scip, &var, name, 0.0, 1.0, 0.0, SCIP_VARTYPE_INTEGER) );
+         SCIP_CALL( SCIPcreateVarData(scip, var, round->colmedians[c], &round->collocations[round->colbeg[c]],
+               round->colbeg[c + 1] - round->colbeg[c]) );
+         SCIP_CALL( SCIPaddVar(scip, var) );
+         SCIP_CALL( SCIPsetSolVal(scip, sols[r], var, round->colvals[c]) );
+         SCIP_CALL( SCIPreleaseVar(scip, &var) );
+      }
+   }
+
+   return SCIP_OKAY;
+}
+
+/** replays the computation of the sparse assignments of semiassign branching on the captured LP solutions; all
+ *  columns of all rounds are in the problem, as in the master problem, where most of them are zero in an LP solution
+ */
+static
+SCIP_RETCODE benchAssignments(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   CPMP_CAPTURE*         capture,            /* captured run                                         */
+   SCIP_SOL**            sols,               /* solutions of the rounds (NULL for Farkas rounds)     */
+   int                   nrepetitions        /* number of repetitions                                */
+   )
+{
+   SCIP_CLOCK* clock;
+   SCIP_Real checksum;
+   SCIP_Longint ncalls;
+   int* beg;
+   int rep;
+   int r;
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &beg, capture->nlocations + 1) );
+   SCIP_CALL( SCIPcreateWallClock(scip, &clock) );
+
+   checksum = 0.0;
+   ncalls = 0;
+
+   for( rep = 0; rep < nrepetitions; ++rep )
+   {
+      for( r = 0; r < capture->nrounds; ++r )
+      {
+         SCIP_Real* values;
+         int* medians;
+         int nentries;
+
+         if( sols[r] == NULL )
+            continue;
+
+         SCIP_CALL( SCIPstartClock(scip, clock) );
+         SCIP_CALL( SCIPbranchSemiassignComputeAssignments(scip, sols[r], beg, &medians, &values, &nentries) );
+         SCIPfreeBufferArray(scip, &values);
+         SCIPfreeBufferArray(scip, &medians);
+         SCIP_CALL( SCIPstopClock(scip, clock) );
+
+         checksum += nentries;
+         ++ncalls;
+      }
+   }
+
+   printResult(scip, "assignments", "sparse", ncalls, SCIPgetClockTime(scip, clock), checksum / nrepetitions);
+
+   SCIP_CALL( SCIPfreeClock(scip, &clock) );
+   SCIPfreeBufferArray(scip, &beg);
+
+   return SCIP_OKAY;
+}
+
+/** replays the membership tests of propagation on all captured columns */
+static
+SCIP_RETCODE benchInCluster(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   CPMP_CAPTURE*         capture,            /* captured run                                         */
+   int                   nrepetitions        /* number of repetitions                                */
+   )
+{
+   SCIP_VAR** vars;
+   SCIP_CLOCK* clock;
+   SCIP_Real checksum;
+   SCIP_Longint ncalls;
+   int nvars;
+   int rep;
+   int v;
+
+   vars = SCIPgetVars(scip);
+   nvars = SCIPgetNVars(scip);
+
+   SCIP_CALL( SCIPcreateWallClock(scip, &clock) );
+
+   checksum = 0.0;
+   ncalls = 0;
+
+   SCIP_CALL( SCIPstartClock(scip, clock) );
+   for( rep = 0; rep < nrepetitions; ++rep )
+   {
+      for( v = 0; v < nvars; ++v )
+      {
+         int location;
+
+         for( location = 0; location < capture->nlocations; ++location )
+         {
+            if( SCIPisLocationInCluster(vars[v], location) )
+               checksum += 1.0;
+            ++ncalls;
+         }
+      }
+   }
+   SCIP_CALL( SCIPstopClock(scip, clock) );
+
+   printResult(scip, "incluster", "linear", ncalls, SCIPgetClockTime(scip, clock), checksum / nrepetitions);
+
+   SCIP_CALL( SCIPfreeClock(scip, &clock) );
+
+   return SCIP_OKAY;
+}
+
+/** replays the integer parsing of the reader on the rows of the captured distance matrix */
+static
+SCIP_RETCODE benchParse(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   CPMP_CAPTURE*         capture,            /* captured run                                         */
+   int                   nrepetitions        /* number of repetitions                                */
+   )
+{
+   char** lines;
+   SCIP_Longint* values;
+   SCIP_CLOCK* clock;
+   SCIP_Real checksum;
+   SCIP_Longint ncalls;
+   int linesize;
+   int nlocations;
+   int rep;
+   int i;
+   int j;
+
+   nlocations = capture->nlocations;
+   linesize = 21 * nlocations + 1;
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &lines, nlocations) );
+   for( i = 0; i < nlocations; ++i )
+   {
+      int pos;
+
+      SCIP_CALL( SCIPallocBufferArray(scip, &lines[i], linesize) );
+      pos = 0;
+      for( j = 0; j < nlocations; ++j )
+         pos += SCIPsnprintf(&lines[i][pos], linesize - pos, j == 0 ? "%" SCIP_LONGINT_FORMAT : " %" SCIP_LONGINT_FORMAT,
+            capture->distances[i][j]);
+   }
+   SCIP_CALL( SCIPallocBufferArray(scip, &values, nlocations) );
+   SCIP_CALL( SCIPcreateWallClock(scip, &clock) );
+
+   checksum = 0.0;
+   ncalls = 0;
+
+   SCIP_CALL( SCIPstartClock(scip, clock) );
+   for( rep = 0; rep < nrepetitions; ++rep )
+   {
+      for( i = 0; i < nlocations; ++i )
+      {
+         int nvalues;
+
+         nvalues = SCIPparseLongintsCpmp(lines[i], values, nlocations);
+         checksum += nvalues > 0 ? (SCIP_Real)values[nvalues - 1] : 0.0;
+         ++ncalls;
+      }
+   }
+   SCIP_CALL( SCIPstopClock(scip, clock) );
+
+   printResult(scip, "parse", "strtoll", ncalls, SCIPgetClockTime(scip, clock), checksum / nrepetitions);
+
+   SCIP_CALL( SCIPfreeClock(scip, &clock) );
+   SCIPfreeBufferArray(scip, &values);
+   for( i = nlocations - 1; i >= 0; --i )
+   {
+      SCIPfreeBufferArray(scip, &lines[i]);
+   }
+   SCIPfreeBufferArray(scip, &lines);
+
+   return SCIP_OKAY;
+}
+
+/** runs the microbenchmarks */
+static
+SCIP_RETCODE runMicrobench(
+   const char*           filename,           /* name of the capture file                             */
+   int                   nrepetitions,       /* number of repetitions                                */
+   const char*           kernel              /* kernel to run, or NULL for all                       */
+   )
+{
+   SCIP* scip;
+   CPMP_CAPTURE* capture;
+   SCIP_SOL** sols;
+   int r;
+
+   SCIP_CALL( SCIPcreate(&scip) );
+
+   /* the problem data is set up as in a run; the pricer has to be present for the problem creation */
+   SCIP_CALL( SCIPincludeReaderCpmp(scip) );
+   SCIP_CALL( SCIPincludePricerCpmp(scip) );
+
+   SCIP_CALL( SCIPreadCaptureCpmp(scip, filename, &capture) );
+   SCIP_CALL( SCIPcreateProbBasic(scip, filename) );
+   SCIP_CALL( SCIPcreateProbCpmp(scip, capture->nlocations, capture->nclusters, capture->distances, capture->demands,
+         capture->capacities) );
+
+   SCIPinfoMessage(scip, NULL, "capture <%s>: %d locations, %d clusters, %d rounds, %d repetitions\n\n", filename,
+      capture->nlocations, capture->nclusters, capture->nrounds, nrepetitions);
+   SCIPinfoMessage(scip, NULL, "%-12s %-24s %12s %12s %12s %20s\n", "kernel", "variant", "calls", "total (ms)",
+      "ns/call", "checksum");
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &sols, MAX(capture->nrounds, 1)) );
+   SCIP_CALL( createColumns(scip, capture, sols) );
+
+   if( kernel == NULL || strcmp(kernel, "profits") == 0 )
+   {
+      SCIP_CALL( benchProfits(scip, capture, nrepetitions) );
+   }
+   if( kernel == NULL || strcmp(kernel, "knapsack") == 0 )
+   {
+      SCIP_CALL( benchKnapsack(scip, capture, nrepetitions) );
+   }
+   if( kernel == NULL || strcmp(kernel, "assignments") == 0 )
+   {
+      SCIP_CALL( benchAssignments(scip, capture, sols, nrepetitions) );
+   }
+   if( kernel == NULL || strcmp(kernel, "incluster") == 0 )
+   {
+      SCIP_CALL( benchInCluster(scip, capture, nrepetitions) );
+   }
+   if( kernel == NULL || strcmp(kernel, "parse") == 0 )
+   {
+      SCIP_CALL( benchParse(scip, capture, nrepetitions) );
+   }
+
+   for( r = capture->nrounds - 1; r >= 0; --r )
+   {
+      if( sols[r] != NULL )
+      {
+         SCIP_CALL( SCIPfreeSol(scip, &sols[r]) );
+      }
+   }
+   SCIPfreeBufferArray(scip, &sols);
+
+   SCIPfreeCaptureCpmp(scip, &capture);
+
+   SCIP_CALL( SCIPfree(&scip) );
+
+   BMScheckEmptyMemory();
+
+   return SCIP_OKAY;
+}
+
+int
+main(
+   int                        argc,
+   char**                     argv
+   )
+{
+   SCIP_RETCODE retcode;
+   const char* kernel;
+   int nrepetitions;
+   int i;
+
+   kernel = NULL;
+   nrepetitions = DEFAULT_REPETITIONS;
+
+   for( i = 2; i + 1 < argc; i += 2 )
+   {
+      if( strcmp(argv[i], "-r") == 0 )
+         nrepetitions = atoi(argv[i + 1]);
+      else if( strcmp(argv[i], "-k") == 0 )
+         kernel = argv[i + 1];
+      else
+         break;
+   }
+
+   if( argc < 2 || i < argc || nrepetitions <= 0 )
+   {
+      fprintf(stderr, "usage: %s <capturefile> [-r <repetitions>] [-k profits|knapsack|assignments|incluster|parse]\n",
+         argv[0]);
+      return 1;
+   }
+
+   retcode = runMicrobench(argv[1], nrepetitions, kernel);
+   if( retcode != SCIP_OKAY )
+   {
+      SCIPprintError(retcode);
+      return -1;
+   }
+
+   return 0;
+}
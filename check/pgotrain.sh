@@ -0,0 +1,70 @@
+#!/usr/bin/env bash
+#* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+#*                                                                           *
+#*                  This file is part of the program and library             *
+#*         SCIP --- Solving Constraint Integer Programs                      *
+#*                                                                           *
+#*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            *
+#*                            fuer Informationstechnik Berlin                *
+#*                                                                           *
+#*  SCIP is distributed under the terms of the ZIB Academic License.         *
+#*                                                                           *
+#*  You should have received a copy of the ZIB Academic License              *
+#*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      *
+#*                                                                           *
+#* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+#
+# Training run of the profile-guided build, called by the pgo target of CMakeLists.txt.
+#
+# Generates the instances of a benchmark suite with the generator and solves each of them with the instrumented cpmp
+# binary under a time limit, which writes the profile data to the profile directory. Profiles written by clang
+# (*.profraw) are merged into <profiledir>/default.profdata afterwards; gcc needs no merge step.
+#
+# usage: check/pgotrain.sh <binary> <generator> <suitefile> <instancedir> <timelimit> <profiledir>
+
+set -u
+
+if [ $# -ne 6 ]
+then
+   sed -n 's/^# usage: /usage: /p' "$0"
+   exit 1
+fi
+
+BINARY=$1
+GENERATOR=$2
+SUITEFILE=$3
+INSTANCEDIR=$4
+TIMELIMIT=$5
+PROFILEDIR=$6
+
+mkdir -p "${INSTANCEDIR}" "${PROFILEDIR}"
+
+grep -v '^#' "${SUITEFILE}" | while read -r NAME NLOCATIONS NMEDIANS TYPE TIGHTNESS SEED
+do
+   [ -z "${NAME}" ] && continue
+
+   INSTANCE=${INSTANCEDIR}/${NAME}.cpmp
+   if [ ! -f "${INSTANCE}" ]
+   then
+      "${GENERATOR}" -n "${NLOCATIONS}" -p "${NMEDIANS}" -t "${TYPE}" -r "${TIGHTNESS}" -s "${SEED}" -o "${INSTANCE}" || exit 1
+   fi
+
+   echo "training on ${NAME} ..." >&2
+
+   # the statistics are displayed so that the table and profiling code is trained as well
+   "${BINARY}" -c "set limits time ${TIMELIMIT}" -c "read ${INSTANCE}" -c "optimize" -c "display statistics" \
+      -c "display cpmpprofile" -c "quit" > /dev/null 2>&1 || echo "cpmp failed on ${NAME}" >&2
+done || exit 1
+
+if ls "${PROFILEDIR}"/*.profraw > /dev/null 2>&1
+then
+   PROFDATA=${LLVM_PROFDATA:-$(command -v llvm-profdata)}
+   if [ -z "${PROFDATA}" ]
+   then
+      echo "llvm-profdata not found; set LLVM_PROFDATA" >&2
+      exit 1
+   fi
+   "${PROFDATA}" merge -output="${PROFILEDIR}/default.profdata" "${PROFILEDIR}"/*.profraw || exit 1
+fi
+
+exit 0
@@ -0,0 +1,1248 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   checkpoint_cpmp.c
+ * @brief  periodic checkpoints of a branch-and-price run and resuming a run from them
+ * @author Christian Puchert
+ *
+ * On resume, the root of the new run is solved with all columns of the checkpoint, and the branching rule of this file
+ * then creates one child of the root per open node of the checkpoint instead of branching; it has the highest priority
+ * and only runs once at the root.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "checkpoint_cpmp.h"
+#include "cons_median.h"
+#include "cons_samediff.h"
+#include "pricer_cpmp.h"
+#include "pub_probdata.h"
+#include "pub_vardata.h"
+#include "subtree_cpmp.h"
+
+
+#define EVENTHDLR_NAME         "cpmpcheckpoint"
+#define EVENTHDLR_DESC         "periodic checkpoints of cpmp branch-and-price runs"
+
+#define BRANCHRULE_NAME            "cpmpresume"
+#define BRANCHRULE_DESC            "recreation of the open nodes of a checkpoint at the root"
+#define BRANCHRULE_PRIORITY        10000000
+#define BRANCHRULE_MAXDEPTH        0
+#define BRANCHRULE_MAXBOUNDDIST    1.0
+
+#define DEFAULT_FILE           ""       /**< checkpoint file ("": no checkpoints)                                        */
+#define DEFAULT_INTERVAL       600.0    /**< minimal time in seconds between two checkpoints                             */
+
+#define CHECKPOINT_MAGIC       "CPMPCKP1" /**< first bytes of a checkpoint file                                        */
+#define CHECKPOINT_MAGICLEN    8        /**< length of the magic string                                                 */
+#define CHECKPOINT_COLUMNS     1        /**< tag of a record of columns                                                 */
+#define CHECKPOINT_SNAPSHOT    2        /**< tag of a record of a snapshot of the search                                */
+#define CHECKPOINT_SLACK       1048576  /**< bytes of superseded snapshots tolerated beyond the size of the columns     */
+
+
+/*
+ * Data structures
+ */
+
+/** growing byte buffer for the payload of a record */
+struct CkpBuffer
+{
+   char*                 data;               /* bytes of the buffer                                                         */
+   size_t                len;                /* number of bytes used                                                        */
+   size_t                size;               /* size of the buffer                                                          */
+};
+typedef struct CkpBuffer CKPBUFFER;
+
+/** columns of a checkpoint file, with the locations of column c in locations[beg[c]], ..., locations[beg[c + 1] - 1] */
+struct CkpColumns
+{
+   int*                  medians;            /* medians of the columns                                                      */
+   int*                  beg;                /* start of the locations of each column in locations                          */
+   int*                  locations;          /* locations of all columns                                                    */
+   int                   ncols;              /* number of columns                                                           */
+   int                   colssize;           /* size of medians and beg - 1                                                 */
+   int                   locationssize;      /* size of locations                                                           */
+};
+typedef struct CkpColumns CKPCOLUMNS;
+
+/** parsed snapshot of a checkpoint file */
+struct CkpSnapshot
+{
+   SCIP_Longint          nnodes;             /* number of nodes solved before the checkpoint                                */
+   SCIP_Real             time;               /* solving time before the checkpoint                                          */
+   int*                  solcols;            /* columns of the incumbent                                                    */
+   int                   nsolcols;           /* number of columns of the incumbent (0: no incumbent)                        */
+   SCIP_Real             solobj;             /* objective value of the incumbent                                            */
+   SCIP_Bool             hascenter;          /* does the snapshot contain a stability center?                               */
+   SCIP_Real             centerbound;        /* Lagrangian bound at the stability center                                    */
+   SCIP_Real             centerthreshold;    /* nclusters-th smallest median bound at the stability center                  */
+   SCIP_Real*            center;             /* service duals of the stability center                                       */
+   SCIP_Real*            medianbounds;       /* median bounds at the stability center                                       */
+   int*                  nodedata;           /* serialized restrictions of all open nodes                                   */
+   int*                  nodebeg;            /* start of the restrictions of each open node in nodedata                     */
+   SCIP_Real*            nodebounds;         /* lower bounds of the open nodes                                              */
+   int                   nopennodes;         /* number of open nodes                                                        */
+};
+typedef struct CkpSnapshot CKPSNAPSHOT;
+
+/** event handler data */
+struct SCIP_EventhdlrData
+{
+   char*                 filename;           /* checkpoint file ("": no checkpoints)                                        */
+   SCIP_Real             interval;           /* minimal time in seconds between two checkpoints                             */
+   int                   filterpos;          /* position of the node event in the event filter, or -1                       */
+   FILE*                 file;               /* checkpoint file opened for appending, or NULL before the first checkpoint   */
+   SCIP_Bool             failed;             /* has writing a checkpoint failed in this run?                                */
+   SCIP_Real             lastcheckpoint;     /* solving time of the last checkpoint                                         */
+   SCIP_HASHMAP*         colindices;         /* indices of the columns in the file                                          */
+   int                   ncols;              /* number of columns in the file                                               */
+   SCIP_Longint          colbytes;           /* bytes of the column records in the file                                     */
+   SCIP_Longint          snapshotbytes;      /* bytes of the snapshot records in the file, including superseded ones        */
+   SCIP_Longint          lastsnapshotbytes;  /* bytes of the last snapshot record                                           */
+   CKPBUFFER             buffer;             /* payload of the record being written                                         */
+   SCIP_Longint          prevnodes;          /* nodes solved in the runs this run was resumed from                          */
+   SCIP_Real             prevtime;           /* solving time of the runs this run was resumed from                          */
+};
+
+/** branching rule data */
+struct SCIP_BranchruleData
+{
+   CKPSNAPSHOT*          pending;            /* snapshot whose open nodes are recreated at the root, or NULL                */
+};
+
+
+/*
+ * Local methods
+ */
+
+/** appends bytes to a buffer */
+static
+SCIP_RETCODE bufferAppend(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   CKPBUFFER*            buffer,             /* buffer                                               */
+   const void*           bytes,              /* bytes to append                                      */
+   size_t                nbytes              /* number of bytes                                      */
+   )
+{
+   if( buffer->len + nbytes > buffer->size )
+   {
+      size_t newsize;
+
+      newsize = MAX(2 * buffer->size, buffer->len + nbytes);
+      SCIP_CALL( SCIPreallocMemoryArray(scip, &buffer->data, newsize) );
+      buffer->size = newsize;
+   }
+
+   memcpy(buffer->data + buffer->len, bytes, nbytes);
+   buffer->len += nbytes;
+
+   return SCIP_OKAY;
+}
+
+/** appends an integer to a buffer */
+static
+SCIP_RETCODE bufferAppendInt(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   CKPBUFFER*            buffer,             /* buffer                                               */
+   int                   value               /* value to append                                      */
+   )
+{
+   SCIP_CALL( bufferAppend(scip, buffer, &value, sizeof(value)) );
+
+   return SCIP_OKAY;
+}
+
+/** appends a real to a buffer */
+static
+SCIP_RETCODE bufferAppendReal(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   CKPBUFFER*            buffer,             /* buffer                                               */
+   SCIP_Real             value               /* value to append                                      */
+   )
+{
+   SCIP_CALL( bufferAppend(scip, buffer, &value, sizeof(value)) );
+
+   return SCIP_OKAY;
+}
+
+/** writes a record with the content of a buffer as payload to a file; returns FALSE on failure */
+static
+SCIP_Bool writeRecord(
+   FILE*                 file,               /* checkpoint file                                      */
+   int                   tag,                /* tag of the record                                    */
+   CKPBUFFER*            buffer,             /* payload                                              */
+   SCIP_Longint*         nbytes              /* pointer to increase by the size of the record        */
+   )
+{
+   SCIP_Longint length;
+
+   length = (SCIP_Longint)buffer->len;
+
+   if( fwrite(&tag, sizeof(tag), 1, file) != 1 || fwrite(&length, sizeof(length), 1, file) != 1
+      || fwrite(buffer->data, 1, buffer->len, file) != buffer->len )
+      return FALSE;
+
+   *nbytes += (SCIP_Longint)(sizeof(tag) + sizeof(length) + buffer->len);
+
+   return TRUE;
+}
+
+/** collects the columns which are not yet in the file as payload of a columns record */
+static
+SCIP_RETCODE collectColumns(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_EVENTHDLRDATA*   eventhdlrdata,      /* event handler data                                   */
+   int*                  nnewcols            /* pointer to store the number of new columns           */
+   )
+{
+   CKPBUFFER* buffer;
+   SCIP_VAR** vars;
+   int nvars;
+   int v;
+
+   buffer = &eventhdlrdata->buffer;
+   buffer->len = 0;
+   *nnewcols = 0;
+
+   /* the number of columns is filled in at the end */
+   SCIP_CALL( bufferAppendInt(scip, buffer, 0) );
+
+   vars = SCIPgetVars(scip);
+   nvars = SCIPgetNVars(scip);
+
+   for( v = 0; v < nvars; ++v )
+   {
+      if( SCIPhashmapExists(eventhdlrdata->colindices, vars[v]) )
+         continue;
+
+      SCIP_CALL( SCIPhashmapInsert(eventhdlrdata->colindices, vars[v], (void*)(size_t)eventhdlrdata->ncols) );
+      ++eventhdlrdata->ncols;
+      ++(*nnewcols);
+
+      SCIP_CALL( bufferAppendInt(scip, buffer, SCIPvarGetMedian(vars[v])) );
+      SCIP_CALL( bufferAppendInt(scip, buffer, SCIPvarGetNLocations(vars[v])) );
+      SCIP_CALL( bufferAppend(scip, buffer, SCIPvarGetLocations(vars[v]),
+            (size_t)SCIPvarGetNLocations(vars[v]) * sizeof(int)) );
+   }
+
+   memcpy(buffer->data, nnewcols, sizeof(int));
+
+   return SCIP_OKAY;
+}
+
+/** collects the state of the search as payload of a snapshot record; all columns must be in the file */
+static
+SCIP_RETCODE collectSnapshot(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_EVENTHDLRDATA*   eventhdlrdata,      /* event handler data                                   */
+   int*                  nopennodes          /* pointer to store the number of open nodes            */
+   )
+{
+   CKPBUFFER* buffer;
+   SCIP_SOL* sol;
+   SCIP_NODE** leaves;
+   SCIP_NODE** children;
+   SCIP_NODE** siblings;
+   SCIP_Real* center;
+   SCIP_Real* medianbounds;
+   SCIP_Real centerbound;
+   SCIP_Real centerthreshold;
+   SCIP_Longint nnodes;
+   int* data;
+   int nleaves;
+   int nchildren;
+   int nsiblings;
+   int nlocations;
+   int size;
+   int i;
+
+   buffer = &eventhdlrdata->buffer;
+   buffer->len = 0;
+   nlocations = SCIPprobdataGetNLocations(scip);
+
+   nnodes = eventhdlrdata->prevnodes + SCIPgetNNodes(scip);
+   SCIP_CALL( bufferAppend(scip, buffer, &nnodes, sizeof(nnodes)) );
+   SCIP_CALL( bufferAppendReal(scip, buffer, eventhdlrdata->prevtime + SCIPgetSolvingTime(scip)) );
+
+   /* incumbent as the indices of its columns; their number is filled in afterwards */
+   sol = SCIPgetBestSol(scip);
+   if( sol == NULL )
+   {
+      SCIP_CALL( bufferAppendInt(scip, buffer, 0) );
+      SCIP_CALL( bufferAppendReal(scip, buffer, SCIPinfinity(scip)) );
+   }
+   else
+   {
+      SCIP_VAR** vars;
+      size_t start;
+      int nsolcols;
+      int nvars;
+      int v;
+
+      vars = SCIPgetVars(scip);
+      nvars = SCIPgetNVars(scip);
+
+      start = buffer->len;
+      SCIP_CALL( bufferAppendInt(scip, buffer, 0) );
+      SCIP_CALL( bufferAppendReal(scip, buffer, SCIPgetSolOrigObj(scip, sol)) );
+
+      nsolcols = 0;
+      for( v = 0; v < nvars; ++v )
+      {
+         if( SCIPgetSolVal(scip, sol, vars[v]) < 0.5 )
+            continue;
+
+         assert(SCIPhashmapExists(eventhdlrdata->colindices, vars[v]));
+         SCIP_CALL( bufferAppendInt(scip, buffer, (int)(size_t)SCIPhashmapGetImage(eventhdlrdata->colindices, vars[v])) );
+         ++nsolcols;
+      }
+
+      memcpy(buffer->data + start, &nsolcols, sizeof(int));
+   }
+
+   /* stability center of the pricer */
+   if( SCIPpricerCpmpGetStabilityCenter(scip, &center, &medianbounds, &centerbound, &centerthreshold) )
+   {
+      SCIP_CALL( bufferAppendInt(scip, buffer, 1) );
+      SCIP_CALL( bufferAppendReal(scip, buffer, centerbound) );
+      SCIP_CALL( bufferAppendReal(scip, buffer, centerthreshold) );
+      SCIP_CALL( bufferAppend(scip, buffer, center, (size_t)nlocations * sizeof(SCIP_Real)) );
+      SCIP_CALL( bufferAppend(scip, buffer, medianbounds, (size_t)nlocations * sizeof(SCIP_Real)) );
+   }
+   else
+   {
+      SCIP_CALL( bufferAppendInt(scip, buffer, 0) );
+   }
+
+   /* open nodes with their lower bounds and branching restrictions */
+   SCIP_CALL( SCIPgetOpenNodesData(scip, &leaves, &children, &siblings, &nleaves, &nchildren, &nsiblings) );
+   *nopennodes = nleaves + nchildren + nsiblings;
+   SCIP_CALL( bufferAppendInt(scip, buffer, *nopennodes) );
+
+   size = 1 + 4 * nlocations;
+   SCIP_ALLOC( BMSallocMemoryArray(&data, size) );
+
+   for( i = 0; i < *nopennodes; ++i )
+   {
+      SCIP_NODE* node;
+      int ndata;
+
+      if( i < nleaves )
+         node = leaves[i];
+      else if( i < nleaves + nchildren )
+         node = children[i - nleaves];
+      else
+         node = siblings[i - nleaves - nchildren];
+
+      data[0] = 0;
+      ndata = 1;
+      SCIP_CALL( SCIPserializePathCpmp(scip, node, &data, &ndata, &size) );
+
+      SCIP_CALL( bufferAppendReal(scip, buffer, SCIPnodeGetLowerbound(node)) );
+      SCIP_CALL( bufferAppendInt(scip, buffer, ndata) );
+      SCIP_CALL( bufferAppend(scip, buffer, data, (size_t)ndata * sizeof(int)) );
+   }
+
+   BMSfreeMemoryArray(&data);
+
+   return SCIP_OKAY;
+}
+
+/** writes the header, all columns and a snapshot to a new file which then replaces the checkpoint file */
+static
+SCIP_RETCODE rewriteCheckpoint(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_EVENTHDLRDATA*   eventhdlrdata,      /* event handler data                                   */
+   int*                  nopennodes,         /* pointer to store the number of open nodes            */
+   SCIP_Bool*            success             /* pointer to store whether the checkpoint was written  */
+   )
+{
+   char tmpname[SCIP_MAXSTRLEN];
+   FILE* file;
+   int nlocations;
+   int nclusters;
+   int nnewcols;
+
+   *success = FALSE;
+
+   if( eventhdlrdata->file != NULL )
+   {
+      (void) fclose(eventhdlrdata->file);
+      eventhdlrdata->file = NULL;
+   }
+
+   SCIP_CALL( SCIPhashmapRemoveAll(eventhdlrdata->colindices) );
+   eventhdlrdata->ncols = 0;
+   eventhdlrdata->colbytes = 0;
+   eventhdlrdata->snapshotbytes = 0;
+
+   (void) SCIPsnprintf(tmpname, SCIP_MAXSTRLEN, "%s.tmp", eventhdlrdata->filename);
+   file = fopen(tmpname, "wb");
+   if( file == NULL )
+      return SCIP_OKAY;
+
+   nlocations = SCIPprobdataGetNLocations(scip);
+   nclusters = SCIPprobdataGetNClusters(scip);
+
+   SCIP_CALL( collectColumns(scip, eventhdlrdata, &nnewcols) );
+   if( fwrite(CHECKPOINT_MAGIC, 1, CHECKPOINT_MAGICLEN, file) != CHECKPOINT_MAGICLEN
+      || fwrite(&nlocations, sizeof(int), 1, file) != 1 || fwrite(&nclusters, sizeof(int), 1, file) != 1
+      || !writeRecord(file, CHECKPOINT_COLUMNS, &eventhdlrdata->buffer, &eventhdlrdata->colbytes) )
+   {
+      (void) fclose(file);
+      return SCIP_OKAY;
+   }
+
+   SCIP_CALL( collectSnapshot(scip, eventhdlrdata, nopennodes) );
+   eventhdlrdata->lastsnapshotbytes = 0;
+   if( !writeRecord(file, CHECKPOINT_SNAPSHOT, &eventhdlrdata->buffer, &eventhdlrdata->lastsnapshotbytes) )
+   {
+      (void) fclose(file);
+      return SCIP_OKAY;
+   }
+   eventhdlrdata->snapshotbytes = eventhdlrdata->lastsnapshotbytes;
+
+   /* the new file replaces the old one only when it is complete on disk */
+   if( fflush(file) != 0 || fsync(fileno(file)) != 0 )
+   {
+      (void) fclose(file);
+      return SCIP_OKAY;
+   }
+   if( fclose(file) != 0 || rename(tmpname, eventhdlrdata->filename) != 0 )
+      return SCIP_OKAY;
+
+   eventhdlrdata->file = fopen(eventhdlrdata->filename, "ab");
+   *success = eventhdlrdata->file != NULL;
+
+   return SCIP_OKAY;
+}
+
+/** writes a checkpoint, by appending to the checkpoint file or, at the first checkpoint of a run or if the superseded
+ *  snapshots take too much space, by rewriting it
+ */
+static
+SCIP_RETCODE writeCheckpoint(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_EVENTHDLRDATA*   eventhdlrdata       /* event handler data                                   */
+   )
+{
+   SCIP_Bool success;
+   int nopennodes;
+
+   if( eventhdlrdata->file == NULL
+      || eventhdlrdata->snapshotbytes - eventhdlrdata->lastsnapshotbytes > eventhdlrdata->colbytes + CHECKPOINT_SLACK )
+   {
+      SCIP_CALL( rewriteCheckpoint(scip, eventhdlrdata, &nopennodes, &success) );
+   }
+   else
+   {
+      FILE* file;
+      int nnewcols;
+
+      file = eventhdlrdata->file;
+
+      SCIP_CALL( collectColumns(scip, eventhdlrdata, &nnewcols) );
+      success = nnewcols == 0 || writeRecord(file, CHECKPOINT_COLUMNS, &eventhdlrdata->buffer, &eventhdlrdata->colbytes);
+
+      if( success )
+      {
+         SCIP_CALL( collectSnapshot(scip, eventhdlrdata, &nopennodes) );
+         eventhdlrdata->lastsnapshotbytes = 0;
+         success = writeRecord(file, CHECKPOINT_SNAPSHOT, &eventhdlrdata->buffer, &eventhdlrdata->lastsnapshotbytes)
+            && fflush(file) == 0 && fsync(fileno(file)) == 0;
+         eventhdlrdata->snapshotbytes += eventhdlrdata->lastsnapshotbytes;
+      }
+   }
+
+   if( !success )
+   {
+      SCIPwarningMessage(scip, "cannot write checkpoint file <%s>, no further checkpoints are written\n",
+         eventhdlrdata->filename);
+      eventhdlrdata->failed = TRUE;
+      if( eventhdlrdata->file != NULL )
+      {
+         (void) fclose(eventhdlrdata->file);
+         eventhdlrdata->file = NULL;
+      }
+      return SCIP_OKAY;
+   }
+
+   SCIPverbMessage(scip, SCIP_VERBLEVEL_HIGH, NULL, "checkpoint written to <%s>: %d columns, %d open nodes\n",
+      eventhdlrdata->filename, eventhdlrdata->ncols, nopennodes);
+
+   return SCIP_OKAY;
+}
+
+/** reads bytes from the payload of a record; returns FALSE if the payload is too short */
+static
+SCIP_Bool readBytes(
+   const char*           payload,            /* payload                                              */
+   size_t                len,                /* length of the payload                                */
+   size_t*               pos,                /* pointer to the current position in the payload       */
+   void*                 dest,               /* destination                                          */
+   size_t                nbytes              /* number of bytes to read                              */
+   )
+{
+   if( nbytes > len - *pos )
+      return FALSE;
+
+   memcpy(dest, payload + *pos, nbytes);
+   *pos += nbytes;
+
+   return TRUE;
+}
+
+/** checks whether serialized restrictions are well-formed */
+static
+SCIP_Bool checkRestrictions(
+   int*                  data,               /* serialized restrictions                              */
+   int                   ndata,              /* number of entries of data                            */
+   int                   nlocations          /* number of locations                                  */
+   )
+{
+   int pos;
+   int r;
+
+   if( ndata < 1 || data[0] < 0 )
+      return FALSE;
+
+   pos = 1;
+   for( r = 0; r < data[0]; ++r )
+   {
+      int i;
+
+      if( pos >= ndata )
+         return FALSE;
+
+      switch( data[pos] )
+      {
+      case CPMP_RESTRICTION_SEMIASSIGN:
+         if( pos + 3 > ndata || data[pos + 2] < 0 || data[pos + 2] > ndata - pos - 3 )
+            return FALSE;
+         for( i = 1; i < 3 + data[pos + 2]; ++i )
+         {
+            if( i != 2 && (data[pos + i] < 0 || data[pos + i] >= nlocations) )
+               return FALSE;
+         }
+         break;
+      case CPMP_RESTRICTION_MEDIAN:
+         if( pos + 3 > ndata || data[pos + 1] < 0 || data[pos + 1] >= nlocations
+            || (data[pos + 2] != (int)CPMP_MEDIAN_CLOSED && data[pos + 2] != (int)CPMP_MEDIAN_OPEN) )
+            return FALSE;
+         break;
+      case CPMP_RESTRICTION_SAMEDIFF:
+         if( pos + 4 > ndata || data[pos + 1] < 0 || data[pos + 1] >= nlocations || data[pos + 2] < 0
+            || data[pos + 2] >= nlocations
+            || (data[pos + 3] != (int)CPMP_SAMEDIFF_SAME && data[pos + 3] != (int)CPMP_SAMEDIFF_DIFFER) )
+            return FALSE;
+         break;
+      default:
+         return FALSE;
+      }
+
+      pos = SCIPnextRestrictionCpmp(data, pos);
+   }
+
+   return pos == ndata;
+}
+
+/** appends the columns of a columns record to the columns read so far */
+static
+SCIP_RETCODE parseColumns(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   const char*           payload,            /* payload of the record                                */
+   size_t                len,                /* length of the payload                                */
+   CKPCOLUMNS*           columns,            /* columns to append to                                 */
+   SCIP_Bool*            valid               /* pointer to store whether the payload is valid        */
+   )
+{
+   size_t pos;
+   int nlocations;
+   int ncols;
+   int c;
+
+   nlocations = SCIPprobdataGetNLocations(scip);
+   pos = 0;
+
+   *valid = readBytes(payload, len, &pos, &ncols, sizeof(int)) && ncols >= 0;
+
+   for( c = 0; c < ncols && *valid; ++c )
+   {
+      int median;
+      int n;
+      int i;
+
+      if( !readBytes(payload, len, &pos, &median, sizeof(int)) || !readBytes(payload, len, &pos, &n, sizeof(int))
+         || median < 0 || median >= nlocations || n < 1 || n > nlocations )
+      {
+         *valid = FALSE;
+         break;
+      }
+
+      if( columns->ncols >= columns->colssize )
+      {
+         columns->colssize = MAX(2 * columns->colssize, 1024);
+         SCIP_CALL( SCIPreallocMemoryArray(scip, &columns->medians, columns->colssize) );
+         SCIP_CALL( SCIPreallocMemoryArray(scip, &columns->beg, columns->colssize + 1) );
+      }
+      if( columns->ncols == 0 )
+         columns->beg[0] = 0;
+      if( columns->beg[columns->ncols] + n > columns->locationssize )
+      {
+         columns->locationssize = MAX(2 * columns->locationssize, columns->beg[columns->ncols] + n);
+         SCIP_CALL( SCIPreallocMemoryArray(scip, &columns->locations, columns->locationssize) );
+      }
+
+      if( !readBytes(payload, len, &pos, &columns->locations[columns->beg[columns->ncols]], (size_t)n * sizeof(int)) )
+      {
+         *valid = FALSE;
+         break;
+      }
+      for( i = columns->beg[columns->ncols]; i < columns->beg[columns->ncols] + n; ++i )
+      {
+         if( columns->locations[i] < 0 || columns->locations[i] >= nlocations )
+            *valid = FALSE;
+      }
+
+      columns->medians[columns->ncols] = median;
+      columns->beg[columns->ncols + 1] = columns->beg[columns->ncols] + n;
+      ++columns->ncols;
+   }
+
+   *valid = *valid && pos == len;
+
+   return SCIP_OKAY;
+}
+
+/** frees a parsed snapshot */
+static
+void freeSnapshot(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   CKPSNAPSHOT**         snapshot            /* pointer to the snapshot                              */
+   )
+{
+   if( *snapshot == NULL )
+      return;
+
+   SCIPfreeMemoryArrayNull(scip, &(*snapshot)->nodebounds);
+   SCIPfreeMemoryArrayNull(scip, &(*snapshot)->nodebeg);
+   SCIPfreeMemoryArrayNull(scip, &(*snapshot)->nodedata);
+   SCIPfreeMemoryArrayNull(scip, &(*snapshot)->medianbounds);
+   SCIPfreeMemoryArrayNull(scip, &(*snapshot)->center);
+   SCIPfreeMemoryArrayNull(scip, &(*snapshot)->solcols);
+   SCIPfreeMemory(scip, snapshot);
+}
+
+/** parses the payload of a snapshot record; the snapshot is NULL if the payload is invalid */
+static
+SCIP_RETCODE parseSnapshot(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   const char*           payload,            /* payload of the record                                */
+   size_t                len,                /* length of the payload                                */
+   int                   ncols,              /* number of columns written before the snapshot        */
+   CKPSNAPSHOT**         snapshot            /* pointer to store the snapshot                        */
+   )
+{
+   SCIP_Bool valid;
+   size_t pos;
+   int hascenter;
+   int nlocations;
+   int ndata;
+   int i;
+
+   nlocations = SCIPprobdataGetNLocations(scip);
+   pos = 0;
+
+   SCIP_CALL( SCIPallocClearMemory(scip, snapshot) );
+
+   valid = readBytes(payload, len, &pos, &(*snapshot)->nnodes, sizeof(SCIP_Longint))
+      && readBytes(payload, len, &pos, &(*snapshot)->time, sizeof(SCIP_Real))
+      && readBytes(payload, len, &pos, &(*snapshot)->nsolcols, sizeof(int))
+      && readBytes(payload, len, &pos, &(*snapshot)->solobj, sizeof(SCIP_Real))
+      && (*snapshot)->nsolcols >= 0 && (*snapshot)->nsolcols <= nlocations;
+
+   /* incumbent */
+   if( valid && (*snapshot)->nsolcols > 0 )
+   {
+      SCIP_CALL( SCIPallocMemoryArray(scip, &(*snapshot)->solcols, (*snapshot)->nsolcols) );
+      valid = readBytes(payload, len, &pos, (*snapshot)->solcols, (size_t)(*snapshot)->nsolcols * sizeof(int));
+      for( i = 0; i < (*snapshot)->nsolcols && valid; ++i )
+         valid = (*snapshot)->solcols[i] >= 0 && (*snapshot)->solcols[i] < ncols;
+   }
+
+   /* stability center */
+   valid = valid && readBytes(payload, len, &pos, &hascenter, sizeof(int));
+   if( valid && hascenter != 0 )
+   {
+      (*snapshot)->hascenter = TRUE;
+      SCIP_CALL( SCIPallocMemoryArray(scip, &(*snapshot)->center, nlocations) );
+      SCIP_CALL( SCIPallocMemoryArray(scip, &(*snapshot)->medianbounds, nlocations) );
+      valid = readBytes(payload, len, &pos, &(*snapshot)->centerbound, sizeof(SCIP_Real))
+         && readBytes(payload, len, &pos, &(*snapshot)->centerthreshold, sizeof(SCIP_Real))
+         && readBytes(payload, len, &pos, (*snapshot)->center, (size_t)nlocations * sizeof(SCIP_Real))
+         && readBytes(payload, len, &pos, (*snapshot)->medianbounds, (size_t)nlocations * sizeof(SCIP_Real));
+   }
+
+   /* open nodes; their restrictions take at most the rest of the payload */
+   valid = valid && readBytes(payload, len, &pos, &(*snapshot)->nopennodes, sizeof(int)) && (*snapshot)->nopennodes >= 0
+      && (size_t)(*snapshot)->nopennodes <= (len - pos) / (sizeof(SCIP_Real) + 2 * sizeof(int));
+   if( valid )
+   {
+      SCIP_CALL( SCIPallocMemoryArray(scip, &(*snapshot)->nodebounds, MAX((*snapshot)->nopennodes, 1)) );
+      SCIP_CALL( SCIPallocMemoryArray(scip, &(*snapshot)->nodebeg, (*snapshot)->nopennodes + 1) );
+      SCIP_CALL( SCIPallocMemoryArray(scip, &(*snapshot)->nodedata, MAX((len - pos) / sizeof(int), 1)) );
+   }
+
+   ndata = 0;
+   for( i = 0; i < (*snapshot)->nopennodes && valid; ++i )
+   {
+      int n;
+
+      (*snapshot)->nodebeg[i] = ndata;
+      valid = readBytes(payload, len, &pos, &(*snapshot)->nodebounds[i], sizeof(SCIP_Real))
+         && readBytes(payload, len, &pos, &n, sizeof(int)) && n >= 1
+         && readBytes(payload, len, &pos, &(*snapshot)->nodedata[ndata], (size_t)n * sizeof(int))
+         && checkRestrictions(&(*snapshot)->nodedata[ndata], n, nlocations);
+      ndata += valid ? n : 0;
+   }
+
+   if( !valid || pos != len )
+   {
+      freeSnapshot(scip, snapshot);
+      return SCIP_OKAY;
+   }
+
+   (*snapshot)->nodebeg[(*snapshot)->nopennodes] = ndata;
+
+   return SCIP_OKAY;
+}
+
+/** reads a checkpoint file: all columns and the last complete snapshot, which is NULL if there is none; a truncated
+ *  last record is ignored, and so are records of unknown type
+ */
+static
+SCIP_RETCODE readCheckpoint(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   const char*           filename,           /* name of the checkpoint file                          */
+   CKPCOLUMNS*           columns,            /* columns to fill                                      */
+   CKPSNAPSHOT**         snapshot            /* pointer to store the last snapshot                   */
+   )
+{
+   char magic[CHECKPOINT_MAGICLEN];
+   char* payload;
+   size_t payloadsize;
+   FILE* file;
+   SCIP_RETCODE retcode;
+   int nlocations;
+   int nclusters;
+
+   *snapshot = NULL;
+
+   file = fopen(filename, "rb");
+   if( file == NULL )
+   {
+      SCIPerrorMessage("cannot open checkpoint file <%s> for reading\n", filename);
+      return SCIP_NOFILE;
+   }
+
+   if( fread(magic, 1, CHECKPOINT_MAGICLEN, file) != CHECKPOINT_MAGICLEN
+      || memcmp(magic, CHECKPOINT_MAGIC, CHECKPOINT_MAGICLEN) != 0
+      || fread(&nlocations, sizeof(int), 1, file) != 1 || fread(&nclusters, sizeof(int), 1, file) != 1 )
+   {
+      SCIPerrorMessage("<%s> is not a cpmp checkpoint file\n", filename);
+      (void) fclose(file);
+      return SCIP_READERROR;
+   }
+
+   if( nlocations != SCIPprobdataGetNLocations(scip) || nclusters != SCIPprobdataGetNClusters(scip) )
+   {
+      SCIPerrorMessage("checkpoint file <%s> belongs to an instance with %d locations and %d clusters\n", filename,
+         nlocations, nclusters);
+      (void) fclose(file);
+      return SCIP_READERROR;
+   }
+
+   payload = NULL;
+   payloadsize = 0;
+   retcode = SCIP_OKAY;
+
+   for( ;; )
+   {
+      SCIP_Longint length;
+      SCIP_Bool valid;
+      int tag;
+
+      if( fread(&tag, sizeof(tag), 1, file) != 1 )
+         break;
+
+      if( fread(&length, sizeof(length), 1, file) != 1 || length < 0 )
+      {
+         SCIPwarningMessage(scip, "checkpoint file <%s> ends with a truncated record, which is ignored\n", filename);
+         break;
+      }
+
+      if( (size_t)length > payloadsize )
+      {
+         payloadsize = (size_t)length;
+         retcode = SCIPreallocMemoryArray(scip, &payload, payloadsize);
+         if( retcode != SCIP_OKAY )
+            break;
+      }
+
+      if( fread(payload, 1, (size_t)length, file) != (size_t)length )
+      {
+         SCIPwarningMessage(scip, "checkpoint file <%s> ends with a truncated record, which is ignored\n", filename);
+         break;
+      }
+
+      if( tag == CHECKPOINT_COLUMNS )
+      {
+         retcode = parseColumns(scip, payload, (size_t)length, columns, &valid);
+      }
+      else if( tag == CHECKPOINT_SNAPSHOT )
+      {
+         CKPSNAPSHOT* newsnapshot;
+
+         retcode = parseSnapshot(scip, payload, (size_t)length, columns->ncols, &newsnapshot);
+         valid = newsnapshot != NULL;
+         if( valid )
+         {
+            freeSnapshot(scip, snapshot);
+            *snapshot = newsnapshot;
+         }
+      }
+      else
+         valid = TRUE;
+
+      if( retcode != SCIP_OKAY )
+         break;
+
+      if( !valid )
+      {
+         SCIPerrorMessage("checkpoint file <%s> contains an invalid record\n", filename);
+         retcode = SCIP_READERROR;
+         break;
+      }
+   }
+
+   SCIPfreeMemoryArrayNull(scip, &payload);
+   (void) fclose(file);
+
+   if( retcode != SCIP_OKAY )
+      freeSnapshot(scip, snapshot);
+
+   return retcode;
+}
+
+/** frees the columns of a checkpoint file */
+static
+void freeColumns(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   CKPCOLUMNS*           columns             /* columns                                              */
+   )
+{
+   SCIPfreeMemoryArrayNull(scip, &columns->locations);
+   SCIPfreeMemoryArrayNull(scip, &columns->beg);
+   SCIPfreeMemoryArrayNull(scip, &columns->medians);
+}
+
+/** creates one child of the root per open node of the pending snapshot, skipping the nodes which are pruned by the
+ *  incumbent anyway
+ */
+static
+SCIP_RETCODE createResumedNodes(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_BRANCHRULEDATA*  branchruledata,     /* branching rule data                                  */
+   SCIP_RESULT*          result              /* pointer to store the result of the branching call    */
+   )
+{
+   CKPSNAPSHOT* snapshot;
+   int nchildren;
+   int i;
+
+   snapshot = branchruledata->pending;
+   assert(snapshot != NULL);
+   assert(SCIPgetDepth(scip) == 0);
+
+   nchildren = 0;
+   for( i = 0; i < snapshot->nopennodes; ++i )
+   {
+      SCIP_NODE* child;
+
+      if( SCIPisGE(scip, snapshot->nodebounds[i], SCIPgetCutoffbound(scip)) )
+         continue;
+
+      SCIP_CALL( SCIPcreateChild(scip, &child, 0.0, snapshot->nodebounds[i]) );
+      SCIP_CALL( SCIPapplyRestrictionsCpmp(scip, child, &snapshot->nodedata[snapshot->nodebeg[i]], "resume") );
+      SCIP_CALL( SCIPupdateNodeLowerbound(scip, child, snapshot->nodebounds[i]) );
+      ++nchildren;
+   }
+
+   SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL, "recreated %d of %d open nodes of the checkpoint\n", nchildren,
+      snapshot->nopennodes);
+
+   freeSnapshot(scip, &branchruledata->pending);
+
+   /* all open nodes of the checkpoint are pruned, so the search was complete */
+   *result = nchildren > 0 ? SCIP_BRANCHED : SCIP_CUTOFF;
+
+   return SCIP_OKAY;
+}
+
+
+/*
+ * Callback methods of event handler
+ */
+
+/** destructor of event handler to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_EVENTFREE(eventFreeCpmpcheckpoint)
+{  /*lint --e{715}*/
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   SCIPfreeMemory(scip, &eventhdlrdata);
+   SCIPeventhdlrSetData(eventhdlr, NULL);
+
+   return SCIP_OKAY;
+}
+
+/** solving process initialization method of event handler (called when branch and bound process is about to begin) */
+static
+SCIP_DECL_EVENTINITSOL(eventInitsolCpmpcheckpoint)
+{  /*lint --e{715}*/
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   eventhdlrdata->filterpos = -1;
+   if( eventhdlrdata->filename[0] == '\0' )
+      return SCIP_OKAY;
+
+   eventhdlrdata->file = NULL;
+   eventhdlrdata->failed = FALSE;
+   eventhdlrdata->lastcheckpoint = 0.0;
+   eventhdlrdata->ncols = 0;
+   eventhdlrdata->colbytes = 0;
+   eventhdlrdata->snapshotbytes = 0;
+   eventhdlrdata->lastsnapshotbytes = 0;
+   eventhdlrdata->buffer.data = NULL;
+   eventhdlrdata->buffer.len = 0;
+   eventhdlrdata->buffer.size = 0;
+   SCIP_CALL( SCIPhashmapCreate(&eventhdlrdata->colindices, SCIPblkmem(scip), SCIPgetNVars(scip) + 1024) );
+
+   SCIP_CALL( SCIPcatchEvent(scip, SCIP_EVENTTYPE_NODESOLVED, eventhdlr, NULL, &eventhdlrdata->filterpos) );
+
+   return SCIP_OKAY;
+}
+
+/** solving process deinitialization method of event handler (called before branch and bound process data is freed) */
+static
+SCIP_DECL_EVENTEXITSOL(eventExitsolCpmpcheckpoint)
+{  /*lint --e{715}*/
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   eventhdlrdata->prevnodes = 0;
+   eventhdlrdata->prevtime = 0.0;
+
+   if( eventhdlrdata->filterpos == -1 )
+      return SCIP_OKAY;
+
+   SCIP_CALL( SCIPdropEvent(scip, SCIP_EVENTTYPE_NODESOLVED, eventhdlr, NULL, eventhdlrdata->filterpos) );
+   eventhdlrdata->filterpos = -1;
+
+   if( eventhdlrdata->file != NULL )
+   {
+      (void) fclose(eventhdlrdata->file);
+      eventhdlrdata->file = NULL;
+   }
+
+   SCIPfreeMemoryArrayNull(scip, &eventhdlrdata->buffer.data);
+   SCIPhashmapFree(&eventhdlrdata->colindices);
+
+   return SCIP_OKAY;
+}
+
+/** execution method of event handler */
+static
+SCIP_DECL_EVENTEXEC(eventExecCpmpcheckpoint)
+{  /*lint --e{715}*/
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   assert(eventhdlrdata != NULL);
+
+   if( eventhdlrdata->failed || SCIPinProbing(scip)
+      || SCIPgetSolvingTime(scip) - eventhdlrdata->lastcheckpoint < eventhdlrdata->interval )
+      return SCIP_OKAY;
+
+   SCIP_CALL( writeCheckpoint(scip, eventhdlrdata) );
+   eventhdlrdata->lastcheckpoint = SCIPgetSolvingTime(scip);
+
+   return SCIP_OKAY;
+}
+
+
+/*
+ * Callback methods of branching rule
+ */
+
+/** destructor of branching rule to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_BRANCHFREE(branchFreeCpmpresume)
+{  /*lint --e{715}*/
+   SCIP_BRANCHRULEDATA* branchruledata;
+
+   branchruledata = SCIPbranchruleGetData(branchrule);
+   assert(branchruledata != NULL);
+
+   freeSnapshot(scip, &branchruledata->pending);
+   SCIPfreeMemory(scip, &branchruledata);
+   SCIPbranchruleSetData(branchrule, NULL);
+
+   return SCIP_OKAY;
+}
+
+/** solving process deinitialization method of branching rule (called before branch and bound process data is freed) */
+static
+SCIP_DECL_BRANCHEXITSOL(branchExitsolCpmpresume)
+{  /*lint --e{715}*/
+   SCIP_BRANCHRULEDATA* branchruledata;
+
+   branchruledata = SCIPbranchruleGetData(branchrule);
+   assert(branchruledata != NULL);
+
+   /* the open nodes are only recreated in the first run after the resume */
+   freeSnapshot(scip, &branchruledata->pending);
+
+   return SCIP_OKAY;
+}
+
+/** branching execution method for fractional LP solutions */
+static
+SCIP_DECL_BRANCHEXECLP(branchExeclpCpmpresume)
+{  /*lint --e{715}*/
+   SCIP_BRANCHRULEDATA* branchruledata;
+
+   branchruledata = SCIPbranchruleGetData(branchrule);
+   assert(branchruledata != NULL);
+
+   *result = SCIP_DIDNOTRUN;
+
+   if( branchruledata->pending != NULL )
+   {
+      SCIP_CALL( createResumedNodes(scip, branchruledata, result) );
+   }
+
+   return SCIP_OKAY;
+}
+
+/** branching execution method for not completely fixed pseudo solutions */
+static
+SCIP_DECL_BRANCHEXECPS(branchExecpsCpmpresume)
+{  /*lint --e{715}*/
+   SCIP_BRANCHRULEDATA* branchruledata;
+
+   branchruledata = SCIPbranchruleGetData(branchrule);
+   assert(branchruledata != NULL);
+
+   *result = SCIP_DIDNOTRUN;
+
+   if( branchruledata->pending != NULL )
+   {
+      SCIP_CALL( createResumedNodes(scip, branchruledata, result) );
+   }
+
+   return SCIP_OKAY;
+}
+
+
+/*
+ * Interface methods
+ */
+
+/** creates the checkpoint event handler and the branching rule recreating the tree on resume and includes them in
+ *  SCIP
+ */
+SCIP_RETCODE SCIPincludeCheckpointCpmp(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   SCIP_BRANCHRULEDATA* branchruledata;
+   SCIP_EVENTHDLR* eventhdlr;
+   SCIP_BRANCHRULE* branchrule;
+
+   /* create checkpoint event handler data */
+   eventhdlrdata = NULL;
+   SCIP_CALL( SCIPallocClearMemory(scip, &eventhdlrdata) );
+   assert(eventhdlrdata != NULL);
+   eventhdlrdata->filterpos = -1;
+
+   /* include event handler */
+   eventhdlr = NULL;
+   SCIP_CALL( SCIPincludeEventhdlrBasic(scip, &eventhdlr, EVENTHDLR_NAME, EVENTHDLR_DESC, eventExecCpmpcheckpoint,
+         eventhdlrdata) );
+   assert(eventhdlr != NULL);
+
+   SCIP_CALL( SCIPsetEventhdlrFree(scip, eventhdlr, eventFreeCpmpcheckpoint) );
+   SCIP_CALL( SCIPsetEventhdlrInitsol(scip, eventhdlr, eventInitsolCpmpcheckpoint) );
+   SCIP_CALL( SCIPsetEventhdlrExitsol(scip, eventhdlr, eventExitsolCpmpcheckpoint) );
+
+   /* create resume branching rule data */
+   branchruledata = NULL;
+   SCIP_CALL( SCIPallocClearMemory(scip, &branchruledata) );
+   assert(branchruledata != NULL);
+
+   /* include branching rule */
+   branchrule = NULL;
+   SCIP_CALL( SCIPincludeBranchruleBasic(scip, &branchrule, BRANCHRULE_NAME, BRANCHRULE_DESC, BRANCHRULE_PRIORITY,
+         BRANCHRULE_MAXDEPTH, BRANCHRULE_MAXBOUNDDIST, branchruledata) );
+   assert(branchrule != NULL);
+
+   SCIP_CALL( SCIPsetBranchruleFree(scip, branchrule, branchFreeCpmpresume) );
+   SCIP_CALL( SCIPsetBranchruleExitsol(scip, branchrule, branchExitsolCpmpresume) );
+   SCIP_CALL( SCIPsetBranchruleExecLp(scip, branchrule, branchExeclpCpmpresume) );
+   SCIP_CALL( SCIPsetBranchruleExecPs(scip, branchrule, branchExecpsCpmpresume) );
+
+   /* add checkpoint parameters */
+   SCIP_CALL( SCIPaddStringParam(scip, "cpmp/checkpoint/file",
+         "file to write checkpoints of the branch-and-price run to (\"\": no checkpoints)",
+         &eventhdlrdata->filename, FALSE, DEFAULT_FILE, NULL, NULL) );
+   SCIP_CALL( SCIPaddRealParam(scip, "cpmp/checkpoint/interval",
+         "minimal time in seconds between two checkpoints (0.0: after every node)",
+         &eventhdlrdata->interval, FALSE, DEFAULT_INTERVAL, 0.0, SCIP_REAL_MAX, NULL, NULL) );
+
+   return SCIP_OKAY;
+}
+
+/** loads a checkpoint into the original problem of the given SCIP, which must be the problem of the checkpointed run:
+ *  adds the columns and the incumbent and sets the stability center of the pricer; the next solve recreates the open
+ *  nodes of the checkpoint as children of the root; a transformed problem is freed before
+ */
+SCIP_RETCODE SCIPresumeCpmp(
+   SCIP*                 scip,               /**< SCIP data structure with the cpmp plugins and a cpmp problem */
+   const char*           filename            /**< name of the checkpoint file */
+   )
+{
+   SCIP_EVENTHDLR* eventhdlr;
+   SCIP_EVENTHDLRDATA* eventhdlrdata;
+   SCIP_BRANCHRULE* branchrule;
+   SCIP_BRANCHRULEDATA* branchruledata;
+   CKPCOLUMNS columns;
+   CKPSNAPSHOT* snapshot;
+   SCIP_VAR** vars;
+   SCIP_RETCODE retcode;
+   int c;
+
+   assert(scip != NULL);
+   assert(filename != NULL);
+
+   if( SCIPgetStage(scip) < SCIP_STAGE_PROBLEM || SCIPgetProbData(scip) == NULL )
+   {
+      SCIPerrorMessage("no cpmp problem to resume\n");
+      return SCIP_INVALIDCALL;
+   }
+
+   eventhdlr = SCIPfindEventhdlr(scip, EVENTHDLR_NAME);
+   branchrule = SCIPfindBranchrule(scip, BRANCHRULE_NAME);
+   if( eventhdlr == NULL || branchrule == NULL )
+   {
+      SCIPerrorMessage("checkpoint plugins not found\n");
+      return SCIP_PLUGINNOTFOUND;
+   }
+   eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+   branchruledata = SCIPbranchruleGetData(branchrule);
+
+   /* the columns are added to the original problem */
+   if( SCIPgetStage(scip) > SCIP_STAGE_PROBLEM )
+   {
+      SCIP_CALL( SCIPfreeTransform(scip) );
+   }
+
+   BMSclearMemory(&columns);
+   retcode = readCheckpoint(scip, filename, &columns, &snapshot);
+   if( retcode != SCIP_OKAY )
+   {
+      freeColumns(scip, &columns);
+      return retcode;
+   }
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &vars, MAX(columns.ncols, 1)) );
+   for( c = 0; c < columns.ncols; ++c )
+   {
+      SCIP_CALL( SCIPpricerCpmpAddColumn(scip, columns.medians[c], &columns.locations[columns.beg[c]],
+            columns.beg[c + 1] - columns.beg[c], &vars[c]) );
+   }
+
+   if( snapshot == NULL )
+   {
+      SCIPwarningMessage(scip, "checkpoint file <%s> contains no complete snapshot, only its %d columns are used\n",
+         filename, columns.ncols);
+   }
+   else
+   {
+      if( snapshot->nsolcols > 0 )
+      {
+         SCIP_SOL* sol;
+         SCIP_Bool stored;
+         int i;
+
+         SCIP_CALL( SCIPcreateOrigSol(scip, &sol, NULL) );
+         for( i = 0; i < snapshot->nsolcols; ++i )
+         {
+            SCIP_CALL( SCIPsetSolVal(scip, sol, vars[snapshot->solcols[i]], 1.0) );
+         }
+         SCIP_CALL( SCIPaddSolFree(scip, &sol, &stored) );
+      }
+
+      if( snapshot->hascenter )
+      {
+         SCIP_CALL( SCIPpricerCpmpSetStabilityCenter(scip, snapshot->center, snapshot->medianbounds,
+               snapshot->centerbound, snapshot->centerthreshold) );
+      }
+
+      SCIPinfoMessage(scip, NULL, "resuming from checkpoint <%s>: %d columns, %d open nodes, incumbent %g, "
+         "%" SCIP_LONGINT_FORMAT " nodes and %.1f seconds before\n", filename, columns.ncols, snapshot->nopennodes,
+         snapshot->nsolcols > 0 ? snapshot->solobj : SCIPinfinity(scip), snapshot->nnodes, snapshot->time);
+
+      eventhdlrdata->prevnodes = snapshot->nnodes;
+      eventhdlrdata->prevtime = snapshot->time;
+
+      /* the branching rule takes over the open nodes */
+      freeSnapshot(scip, &branchruledata->pending);
+      branchruledata->pending = snapshot;
+   }
+
+   for( c = 0; c < columns.ncols; ++c )
+   {
+      SCIP_CALL( SCIPreleaseVar(scip, &vars[c]) );
+   }
+   SCIPfreeBufferArray(scip, &vars);
+   freeColumns(scip, &columns);
+
+   return SCIP_OKAY;
+}
@@ -0,0 +1,79 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   checkpoint_cpmp.h
+ * @brief  periodic checkpoints of a branch-and-price run and resuming a run from them
+ * @author Christian Puchert
+ *
+ * If a checkpoint file is set (cpmp/checkpoint/file), an event handler writes a checkpoint after a node has been
+ * solved whenever cpmp/checkpoint/interval seconds have passed since the last one. A checkpoint consists of the
+ * columns of the master problem, the open nodes given by their lower bounds and branching restrictions (see
+ * subtree_cpmp.h), the incumbent as a set of columns and the stability center of the pricer. The pricing cache is not
+ * saved, since it is rebuilt in the first pricing rounds, and neither are the eliminated medians, which are recomputed
+ * from the stability center.
+ *
+ * The file is binary in native byte order and consists of a header followed by records:
+ *
+ *     header:   "CPMPCKP1" <int nlocations> <int nclusters>
+ *     record:   <int tag> <SCIP_Longint length of the payload in bytes> <payload>
+ *     COLUMNS:  <int ncolumns> (<int median> <int nlocations> <int locations ...>)*
+ *     SNAPSHOT: <SCIP_Longint nodes> <SCIP_Real time>
+ *               <int nclusters of the incumbent (0: none)> <SCIP_Real objective> <int column indices ...>
+ *               <int has center> [<SCIP_Real bound> <SCIP_Real threshold> <SCIP_Real center[nlocations]>
+ *               <SCIP_Real medianbounds[nlocations]>]
+ *               <int nopennodes> (<SCIP_Real lowerbound> <int nentries> <int restrictions[nentries]>)*
+ *
+ * The columns are numbered in the order of the COLUMNS records, and each SNAPSHOT refers to the columns written
+ * before it. A checkpoint only appends the columns generated since the last one and a new snapshot, so its cost grows
+ * with the tree, not with the number of columns. When the superseded snapshots take more space than the columns,
+ * the file is rewritten to a temporary file which then replaces it. On resume, a truncated last record, e.g. after a
+ * crash during a checkpoint, is ignored, and the last complete snapshot is used.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __CPMP_CHECKPOINT_CPMP_H__
+#define __CPMP_CHECKPOINT_CPMP_H__
+
+
+#include "scip/scip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** creates the checkpoint event handler and the branching rule recreating the tree on resume and includes them in
+ *  SCIP
+ */
+EXTERN
+SCIP_RETCODE SCIPincludeCheckpointCpmp(
+   SCIP*                 scip                /**< SCIP data structure */
+   );
+
+/** loads a checkpoint into the original problem of the given SCIP, which must be the problem of the checkpointed run:
+ *  adds the columns and the incumbent and sets the stability center of the pricer; the next solve recreates the open
+ *  nodes of the checkpoint as children of the root; a transformed problem is freed before
+ */
+EXTERN
+SCIP_RETCODE SCIPresumeCpmp(
+   SCIP*                 scip,               /**< SCIP data structure with the cpmp plugins and a cpmp problem */
+   const char*           filename            /**< name of the checkpoint file */
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
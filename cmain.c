@@ -24,11 +24,7 @@
 #include "scip/scipshell.h"
 #include "scip/scipdefplugins.h"
 
-#include "branch_semiassign.h"
-#include "cons_semiassign.h"
-#include "dialog_cpmp.h"
-#include "pricer_cpmp.h"
-#include "reader_cpmp.h"
+#include "cpmpplugins.h"
 
 /** creates a SCIP instance with default plugins, evaluates command line parameters, runs SCIP appropriately,
  *  and frees the SCIP instance
@@ -49,31 +45,8 @@ SCIP_RETCODE runShell(
    /* initialize SCIP */
    SCIP_CALL( SCIPcreate(&scip) );
 
-   /* include file reader, pricer, branching rule and constraint handler for branching */
-   SCIP_CALL( SCIPincludeReaderCpmp(scip) );
-   SCIP_CALL( SCIPincludePricerCpmp(scip) );
-
-   /* ********************************************************************************
-    * TODO: uncomment the following lines to enable branching
-    * ********************************************************************************
-    */
-   SCIP_CALL( SCIPincludeBranchruleSemiassign(scip) );
-   SCIP_CALL( SCIPincludeConshdlrSemiassign(scip) );
-
-   /* include custom dialog handler */
-   SCIP_CALL( SCIPincludeDialogCpmp(scip) );
-
-   /* include default plugins */
-   SCIP_CALL( SCIPincludeDefaultPlugins(scip) );
-
-   /* include default SCIP display output */
-   SCIP_CALL( SCIPincludeDispDefault(scip) );
-
-   /* for column generation instances, disable restarts */
-   SCIP_CALL( SCIPsetIntParam(scip, "presolving/maxrestarts", 0) );
-
-   /* turn off all separation algorithms */
-   SCIP_CALL( SCIPsetSeparating(scip, SCIP_PARAMSETTING_OFF, TRUE) );
+   /* include the cpmp plugins and the default plugins */
+   SCIP_CALL( SCIPincludeCpmpPlugins(scip) );
 
    /**********************************
     * Process command line arguments *
@@ -0,0 +1,384 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   cons_median.c
+ * @brief  constraint handler for median branching decisions
+ * @author Christian Puchert
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+
+#include "cons_median.h"
+#include "pricer_cpmp.h"
+#include "pub_probdata.h"
+#include "pub_vardata.h"
+
+#include "scip/cons_linear.h"
+
+
+/* fundamental constraint handler properties */
+#define CONSHDLR_NAME          "median"
+#define CONSHDLR_DESC          "constraint handler for median branching decisions in capacitated p-median problems"
+#define CONSHDLR_ENFOPRIORITY         0 /**< priority of the constraint handler for constraint enforcing */
+#define CONSHDLR_CHECKPRIORITY        0 /**< priority of the constraint handler for checking feasibility */
+#define CONSHDLR_EAGERFREQ          100 /**< frequency for using all instead of only the useful constraints in separation,
+                                              *   propagation and enforcement, -1 for no eager evaluations, 0 for first only */
+#define CONSHDLR_NEEDSCONS         TRUE /**< should the constraint handler be skipped if no constraints are available? */
+
+/* optional constraint handler properties */
+#define CONSHDLR_PROPFREQ             1 /**< frequency for propagating domains; zero means only preprocessing propagation */
+#define CONSHDLR_DELAYPROP        FALSE /**< should propagation method be delayed if other propagators found reductions? */
+#define CONSHDLR_PROP_TIMING       SCIP_PROPTIMING_BEFORELP/**< propagation timing mask of the constraint handler*/
+
+
+/*
+ * Data structures
+ */
+
+/** constraint data for median constraints */
+struct SCIP_ConsData
+{
+   int                   median;             /* median which is closed or open                                                          */
+   CPMP_MEDIANTYPE       type;               /* is the median closed or open?                                                           */
+   SCIP_CONS*            opencons;           /* local row requiring one of the columns of an open median, or NULL                       */
+
+   SCIP_NODE*            node;               /* node for which the constraint is valid                                                   */
+   SCIP_Bool             propagate;          /* Has the constrained to be propagated? TRUE if the subtree
+                                                below the node is entered and new variables have been created since the last propagation */
+   int                   npropvars;          /* number of variables present in the problem the last time the constrained was propagated  */
+};
+
+
+/*
+ * Callback methods of constraint handler
+ */
+
+/** frees specific constraint data */
+static
+SCIP_DECL_CONSDELETE(consDeleteMedian)
+{  /*lint --e{715}*/
+   assert(scip != NULL);
+   assert(consdata != NULL);
+   assert(*consdata != NULL);
+
+   if( (*consdata)->opencons != NULL )
+   {
+      SCIP_CALL( SCIPreleaseCons(scip, &(*consdata)->opencons) );
+   }
+   SCIPfreeMemory(scip, consdata);
+
+   return SCIP_OKAY;
+}
+
+
+/** constraint enforcing method of constraint handler for LP solutions */
+#define consEnfolpMedian NULL
+
+/** constraint enforcing method of constraint handler for pseudo solutions */
+#define consEnfopsMedian NULL
+
+/** feasibility check method of constraint handler for integral solutions */
+#define consCheckMedian NULL
+
+/** domain propagation method of constraint handler;
+ *  for a closed median, fix its columns to zero; for an open median, add the columns which have been created
+ *  in other parts of the tree to the row forcing it to be open
+ */
+static
+SCIP_DECL_CONSPROP(consPropMedian)
+{  /*lint --e{715}*/
+   SCIP_CONSDATA* consdata;
+   SCIP_VAR** vars;
+   int nvars;
+   int nchgvars;
+   SCIP_Bool fixed;
+   SCIP_Bool infeasible;
+
+   int c;
+   int i;
+
+   SCIP_CALL( SCIPgetVarsData(scip, &vars, &nvars, NULL, NULL, NULL, NULL) );
+
+   *result = SCIP_DIDNOTFIND;
+
+   SCIPdebugMessage("consPropMedian, nconss = %d\n", nconss);
+
+   for( c = 0; c < nconss && *result != SCIP_CUTOFF; ++c )
+   {
+      assert(SCIPconsIsActive(conss[c]));
+
+      consdata = SCIPconsGetData(conss[c]);
+      assert(consdata != NULL);
+
+      if( !consdata->propagate )
+         continue;
+
+      SCIPdebugMessage("   -> propagate constraint %s (median = %d)\n", SCIPconsGetName(conss[c]), consdata->median+1);
+
+      nchgvars = 0;
+      for( i = consdata->npropvars; i < nvars; ++i )
+      {
+         if( SCIPvarGetMedian(vars[i]) != consdata->median )
+            continue;
+
+         if( consdata->type == CPMP_MEDIAN_OPEN )
+         {
+            SCIP_CALL( SCIPaddCoefLinear(scip, consdata->opencons, vars[i], 1.0) );
+            ++nchgvars;
+         }
+         else if( !SCIPisFeasZero(scip, SCIPvarGetUbLocal(vars[i])) )
+         {
+            infeasible = FALSE;
+            fixed = FALSE;
+
+            SCIP_CALL( SCIPfixVar(scip, vars[i], 0.0, &infeasible, &fixed) );
+            ++nchgvars;
+
+            if( infeasible )
+            {
+               *result = SCIP_CUTOFF;
+               break;
+            }
+            else
+            {
+               *result = SCIP_REDUCEDDOM;
+               assert(fixed);
+            }
+         }
+      }
+
+      SCIPdebugMessage("   -> %d variables fixed to zero or added to the row.\n", nchgvars);
+
+      consdata->propagate = FALSE;
+      consdata->npropvars = i;
+   }
+
+   return SCIP_OKAY;
+}
+
+
+/** variable rounding lock method of constraint handler */
+static
+SCIP_DECL_CONSLOCK(consLockMedian)
+{  /*lint --e{715}*/
+   return SCIP_OKAY;
+}
+
+
+/** constraint activation notification method of constraint handler */
+static
+SCIP_DECL_CONSACTIVE(consActiveMedian)
+{  /*lint --e{715}*/
+   SCIP_CONSDATA* consdata;
+   int nvars;
+
+   consdata = SCIPconsGetData(cons);
+   assert(consdata != NULL);
+
+   nvars = SCIPgetNVars(scip);
+   assert(consdata->npropvars <= nvars);
+
+   SCIPdebugMessage("Activate constraint %s\n", SCIPconsGetName(cons));
+
+   /* notify SCIP that the branching decision has to be propagated to the newly created master variables */
+   if( consdata->npropvars < nvars )
+   {
+      SCIPdebugMessage("constraint %s needs to be propagated\n", SCIPconsGetName(cons));
+      consdata->propagate = TRUE;
+      SCIP_CALL( SCIPrepropagateNode(scip, consdata->node) );
+   }
+
+   /* notify the pricer about the closed or open median */
+   if( consdata->type == CPMP_MEDIAN_CLOSED )
+      SCIPpricerCpmpCloseMedian(scip, consdata->median);
+   else
+      SCIPpricerCpmpSetOpenCons(scip, consdata->median, consdata->opencons);
+
+   return SCIP_OKAY;
+}
+
+
+/** constraint deactivation notification method of constraint handler */
+static
+SCIP_DECL_CONSDEACTIVE(consDeactiveMedian)
+{  /*lint --e{715}*/
+   SCIP_CONSDATA* consdata;
+
+   consdata = SCIPconsGetData(cons);
+   assert(consdata != NULL);
+
+   SCIPdebugMessage("Deactivate constraint %s\n", SCIPconsGetName(cons));
+
+   if( consdata->type == CPMP_MEDIAN_CLOSED )
+      SCIPpricerCpmpReopenMedian(scip, consdata->median);
+   else
+   {
+      SCIPpricerCpmpSetOpenCons(scip, consdata->median, NULL);
+
+      /* the pricer added the columns created in the subtree to the row, so only later ones are missing */
+      if( !consdata->propagate )
+         consdata->npropvars = SCIPgetNVars(scip);
+   }
+
+   consdata->propagate = FALSE;
+
+   return SCIP_OKAY;
+}
+
+
+/** constraint display method of constraint handler */
+static
+SCIP_DECL_CONSPRINT(consPrintMedian)
+{  /*lint --e{715}*/
+   SCIP_CONSDATA* consdata;
+
+   consdata = SCIPconsGetData(cons);
+   assert(consdata != NULL);
+
+   SCIPinfoMessage(scip, file, "\n");
+   SCIPinfoMessage(scip, file, "   Median: %d (%s)\n", consdata->median+1,
+      consdata->type == CPMP_MEDIAN_CLOSED ? "closed" : "open");
+
+   return SCIP_OKAY;
+}
+
+
+/*
+ * constraint specific interface methods
+ */
+
+/** creates the handler for median constraints and includes it in SCIP */
+SCIP_RETCODE SCIPincludeConshdlrMedian(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_CONSHDLR* conshdlr;
+
+   conshdlr = NULL;
+
+   /* include constraint handler */
+   SCIP_CALL( SCIPincludeConshdlrBasic(scip, &conshdlr, CONSHDLR_NAME, CONSHDLR_DESC,
+         CONSHDLR_ENFOPRIORITY, CONSHDLR_CHECKPRIORITY, CONSHDLR_EAGERFREQ, CONSHDLR_NEEDSCONS,
+         consEnfolpMedian, consEnfopsMedian, consCheckMedian, consLockMedian,
+         NULL) );
+   assert(conshdlr != NULL);
+
+   /* set non-fundamental callbacks via specific setter functions */
+   SCIP_CALL( SCIPsetConshdlrActive(scip, conshdlr, consActiveMedian) );
+   SCIP_CALL( SCIPsetConshdlrDeactive(scip, conshdlr, consDeactiveMedian) );
+   SCIP_CALL( SCIPsetConshdlrDelete(scip, conshdlr, consDeleteMedian) );
+   SCIP_CALL( SCIPsetConshdlrPrint(scip, conshdlr, consPrintMedian) );
+   SCIP_CALL( SCIPsetConshdlrProp(scip, conshdlr, consPropMedian, CONSHDLR_PROPFREQ, CONSHDLR_DELAYPROP,
+         CONSHDLR_PROP_TIMING) );
+
+   return SCIP_OKAY;
+}
+
+/** creates and captures a median constraint
+ *
+ *  For an open median, the local row forcing the median to be open is created as well and added to the node.
+ *
+ *  @note the constraint gets captured, hence at one point you have to release it using the method SCIPreleaseCons()
+ */
+SCIP_RETCODE SCIPcreateConsMedian(
+   SCIP*                 scip,               /**< SCIP data structure                                                             */
+   SCIP_CONS**           cons,               /**< pointer to hold the created constraint                                          */
+   const char*           name,               /**< name of constraint                                                              */
+   int                   median,             /**< median which is closed or open                                                  */
+   CPMP_MEDIANTYPE       type,               /**< is the median closed or open?                                                   */
+   SCIP_NODE*            node                /**< node for which the constraint is valid                                          */
+   )
+{
+   SCIP_CONSHDLR* conshdlr;
+   SCIP_CONSDATA* consdata;
+   SCIP_VAR** vars;
+   int nvars;
+
+   /* find the median constraint handler */
+   conshdlr = SCIPfindConshdlr(scip, CONSHDLR_NAME);
+   if( conshdlr == NULL )
+   {
+      SCIPerrorMessage("median constraint handler not found\n");
+      return SCIP_PLUGINNOTFOUND;
+   }
+
+   SCIP_CALL( SCIPgetVarsData(scip, &vars, &nvars, NULL, NULL, NULL, NULL) );
+
+   /* create constraint data */
+   consdata = NULL;
+   SCIP_CALL( SCIPallocMemory(scip, &consdata) );
+   assert(consdata != NULL);
+
+   consdata->median = median;
+   consdata->type = type;
+   consdata->opencons = NULL;
+   consdata->node = node;
+   consdata->propagate = TRUE;
+   consdata->npropvars = 0;
+
+   /* an open median needs one of its columns; the existing columns are added right away */
+   if( type == CPMP_MEDIAN_OPEN )
+   {
+      char consname[SCIP_MAXSTRLEN];
+      int i;
+
+      (void) SCIPsnprintf(consname, SCIP_MAXSTRLEN, "open_%d", median+1);
+      SCIP_CALL( SCIPcreateConsLinear(scip, &consdata->opencons, consname, 0, NULL, NULL, 1.0, SCIPinfinity(scip),
+            TRUE, FALSE, TRUE, TRUE, TRUE, TRUE, TRUE, FALSE, FALSE, TRUE) );
+      for( i = 0; i < nvars; ++i )
+      {
+         if( SCIPvarGetMedian(vars[i]) == median )
+         {
+            SCIP_CALL( SCIPaddCoefLinear(scip, consdata->opencons, vars[i], 1.0) );
+         }
+      }
+      SCIP_CALL( SCIPaddConsNode(scip, node, consdata->opencons, NULL) );
+      consdata->npropvars = nvars;
+   }
+
+   /* create constraint */
+   SCIP_CALL( SCIPcreateCons(scip, cons, name, conshdlr, consdata, FALSE, FALSE, TRUE, TRUE, TRUE,
+         TRUE, FALSE, FALSE, FALSE, TRUE) );
+
+   return SCIP_OKAY;
+}
+
+/** returns the median of a median constraint */
+int SCIPgetMedianMedian(
+   SCIP_CONS*            cons                /**< median constraint                                                               */
+   )
+{
+   SCIP_CONSDATA* consdata;
+
+   consdata = SCIPconsGetData(cons);
+   assert(consdata != NULL);
+
+   return consdata->median;
+}
+
+/** returns whether the median of a median constraint is closed or open */
+CPMP_MEDIANTYPE SCIPgetTypeMedian(
+   SCIP_CONS*            cons                /**< median constraint                                                               */
+   )
+{
+   SCIP_CONSDATA* consdata;
+
+   consdata = SCIPconsGetData(cons);
+   assert(consdata != NULL);
+
+   return consdata->type;
+}
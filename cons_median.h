@@ -0,0 +1,84 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   cons_median.h
+ * @ingroup CONSHDLRS
+ * @brief  constraint handler for median branching decisions
+ * @author Christian Puchert
+ *
+ * A median constraint stores the decision that a median is closed or open in the subtree of a node. For a closed
+ * median, all its columns are fixed to zero and the pricer does not generate new ones. For an open median, a local
+ * row requires that at least one of its columns is chosen; new columns of the median are added to this row.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __CPMP_CONS_MEDIAN_H__
+#define __CPMP_CONS_MEDIAN_H__
+
+
+#include "scip/scip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** type of a median branching decision */
+enum CPMP_MedianType
+{
+   CPMP_MEDIAN_CLOSED = 0,                   /**< the median is closed, i.e. none of its columns is chosen */
+   CPMP_MEDIAN_OPEN   = 1                    /**< the median is open, i.e. one of its columns is chosen    */
+};
+typedef enum CPMP_MedianType CPMP_MEDIANTYPE;
+
+/** creates the handler for median constraints and includes it in SCIP */
+EXTERN
+SCIP_RETCODE SCIPincludeConshdlrMedian(
+   SCIP*                 scip                /**< SCIP data structure */
+   );
+
+/** creates and captures a median constraint
+ *
+ *  For an open median, the local row forcing the median to be open is created as well and added to the node.
+ *
+ *  @note the constraint gets captured, hence at one point you have to release it using the method SCIPreleaseCons()
+ */
+EXTERN
+SCIP_RETCODE SCIPcreateConsMedian(
+   SCIP*                 scip,               /**< SCIP data structure                                                             */
+   SCIP_CONS**           cons,               /**< pointer to hold the created constraint                                          */
+   const char*           name,               /**< name of constraint                                                              */
+   int                   median,             /**< median which is closed or open                                                  */
+   CPMP_MEDIANTYPE       type,               /**< is the median closed or open?                                                   */
+   SCIP_NODE*            node                /**< node for which the constraint is valid                                          */
+   );
+
+/** returns the median of a median constraint */
+EXTERN
+int SCIPgetMedianMedian(
+   SCIP_CONS*            cons                /**< median constraint                                                               */
+   );
+
+/** returns whether the median of a median constraint is closed or open */
+EXTERN
+CPMP_MEDIANTYPE SCIPgetTypeMedian(
+   SCIP_CONS*            cons                /**< median constraint                                                               */
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
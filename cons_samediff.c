@@ -0,0 +1,365 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   cons_samediff.c
+ * @brief  constraint handler for Ryan-Foster branching decisions
+ * @author Christian Puchert
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+
+#include "cons_samediff.h"
+#include "pricer_cpmp.h"
+#include "pub_probdata.h"
+#include "pub_vardata.h"
+
+
+/* fundamental constraint handler properties */
+#define CONSHDLR_NAME          "samediff"
+#define CONSHDLR_DESC          "constraint handler for Ryan-Foster branching decisions in capacitated p-median problems"
+#define CONSHDLR_ENFOPRIORITY         0 /**< priority of the constraint handler for constraint enforcing */
+#define CONSHDLR_CHECKPRIORITY        0 /**< priority of the constraint handler for checking feasibility */
+#define CONSHDLR_EAGERFREQ          100 /**< frequency for using all instead of only the useful constraints in separation,
+                                              *   propagation and enforcement, -1 for no eager evaluations, 0 for first only */
+#define CONSHDLR_NEEDSCONS         TRUE /**< should the constraint handler be skipped if no constraints are available? */
+
+/* optional constraint handler properties */
+#define CONSHDLR_PROPFREQ             1 /**< frequency for propagating domains; zero means only preprocessing propagation */
+#define CONSHDLR_DELAYPROP        FALSE /**< should propagation method be delayed if other propagators found reductions? */
+#define CONSHDLR_PROP_TIMING       SCIP_PROPTIMING_BEFORELP/**< propagation timing mask of the constraint handler*/
+
+
+/*
+ * Data structures
+ */
+
+/** constraint data for samediff constraints */
+struct SCIP_ConsData
+{
+   int                   location1;          /* first location of the pair                                                              */
+   int                   location2;          /* second location of the pair                                                             */
+   CPMP_SAMEDIFFTYPE     type;               /* must the locations be in the same cluster or in different ones?                         */
+
+   SCIP_NODE*            node;               /* node for which the constraint is valid                                                   */
+   SCIP_Bool             propagate;          /* Has the constrained to be propagated? TRUE if the subtree
+                                                below the node is entered and new variables have been created since the last propagation */
+   int                   npropvars;          /* number of variables present in the problem the last time the constrained was propagated  */
+};
+
+
+/*
+ * Local methods
+ */
+
+/** checks whether the cluster represented by a variable violates a samediff constraint */
+static
+SCIP_Bool isVarViolating(
+   SCIP_CONSDATA*        consdata,           /* constraint data                                      */
+   SCIP_VAR*             var                 /* variable to check                                    */
+   )
+{
+   SCIP_Bool contains1;
+   SCIP_Bool contains2;
+
+   contains1 = SCIPisLocationInCluster(var, consdata->location1);
+   contains2 = SCIPisLocationInCluster(var, consdata->location2);
+
+   if( consdata->type == CPMP_SAMEDIFF_SAME )
+      return contains1 != contains2;
+   else
+      return contains1 && contains2;
+}
+
+
+/*
+ * Callback methods of constraint handler
+ */
+
+/** frees specific constraint data */
+static
+SCIP_DECL_CONSDELETE(consDeleteSamediff)
+{  /*lint --e{715}*/
+   assert(scip != NULL);
+   assert(consdata != NULL);
+   assert(*consdata != NULL);
+
+   SCIPfreeMemory(scip, consdata);
+
+   return SCIP_OKAY;
+}
+
+
+/** constraint enforcing method of constraint handler for LP solutions */
+#define consEnfolpSamediff NULL
+
+/** constraint enforcing method of constraint handler for pseudo solutions */
+#define consEnfopsSamediff NULL
+
+/** feasibility check method of constraint handler for integral solutions */
+#define consCheckSamediff NULL
+
+/** domain propagation method of constraint handler;
+ *  fix those variables to zero whose represented clusters contain only one of the locations of a "same" pair
+ *  or both locations of a "differ" pair
+ */
+static
+SCIP_DECL_CONSPROP(consPropSamediff)
+{  /*lint --e{715}*/
+   SCIP_CONSDATA* consdata;
+   SCIP_VAR** vars;
+   int nvars;
+   int nfixedvars;
+   SCIP_Bool fixed;
+   SCIP_Bool infeasible;
+
+   int c;
+   int i;
+
+   SCIP_CALL( SCIPgetVarsData(scip, &vars, &nvars, NULL, NULL, NULL, NULL) );
+
+   *result = SCIP_DIDNOTFIND;
+
+   SCIPdebugMessage("consPropSamediff, nconss = %d\n", nconss);
+
+   for( c = 0; c < nconss && *result != SCIP_CUTOFF; ++c )
+   {
+      assert(SCIPconsIsActive(conss[c]));
+
+      consdata = SCIPconsGetData(conss[c]);
+      assert(consdata != NULL);
+
+      if( !consdata->propagate )
+         continue;
+
+      SCIPdebugMessage("   -> propagate constraint %s (locations = %d, %d)\n", SCIPconsGetName(conss[c]),
+         consdata->location1+1, consdata->location2+1);
+
+      nfixedvars = 0;
+      for( i = consdata->npropvars; i < nvars; ++i )
+      {
+         if( !SCIPisFeasZero(scip, SCIPvarGetUbLocal(vars[i])) && isVarViolating(consdata, vars[i]) )
+         {
+            infeasible = FALSE;
+            fixed = FALSE;
+
+            SCIP_CALL( SCIPfixVar(scip, vars[i], 0.0, &infeasible, &fixed) );
+            ++nfixedvars;
+            SCIPdebug( SCIPprintVarData(scip, vars[i]) );
+
+            if( infeasible )
+            {
+               *result = SCIP_CUTOFF;
+               break;
+            }
+            else
+            {
+               *result = SCIP_REDUCEDDOM;
+               assert(fixed);
+            }
+         }
+      }
+
+      SCIPdebugMessage("   -> %d variables fixed to zero.\n", nfixedvars);
+
+      consdata->propagate = FALSE;
+      consdata->npropvars = i;
+   }
+
+   return SCIP_OKAY;
+}
+
+
+/** variable rounding lock method of constraint handler */
+static
+SCIP_DECL_CONSLOCK(consLockSamediff)
+{  /*lint --e{715}*/
+   return SCIP_OKAY;
+}
+
+
+/** constraint activation notification method of constraint handler */
+static
+SCIP_DECL_CONSACTIVE(consActiveSamediff)
+{  /*lint --e{715}*/
+   SCIP_CONSDATA* consdata;
+   int nvars;
+
+   consdata = SCIPconsGetData(cons);
+   assert(consdata != NULL);
+
+   nvars = SCIPgetNVars(scip);
+   assert(consdata->npropvars <= nvars);
+
+   SCIPdebugMessage("Activate constraint %s\n", SCIPconsGetName(cons));
+
+   /* notify SCIP that the branching decision has to be propagated to the newly created master variables */
+   if( consdata->npropvars < nvars )
+   {
+      SCIPdebugMessage("constraint %s needs to be propagated\n", SCIPconsGetName(cons));
+      consdata->propagate = TRUE;
+      SCIP_CALL( SCIPrepropagateNode(scip, consdata->node) );
+   }
+
+   /* notify the pricer about the pair restriction */
+   SCIP_CALL( SCIPpricerCpmpAddPair(scip, consdata->location1, consdata->location2,
+         consdata->type == CPMP_SAMEDIFF_SAME) );
+
+   return SCIP_OKAY;
+}
+
+
+/** constraint deactivation notification method of constraint handler */
+static
+SCIP_DECL_CONSDEACTIVE(consDeactiveSamediff)
+{  /*lint --e{715}*/
+   SCIP_CONSDATA* consdata;
+
+   consdata = SCIPconsGetData(cons);
+   assert(consdata != NULL);
+
+   SCIPdebugMessage("Deactivate constraint %s\n", SCIPconsGetName(cons));
+
+   SCIPpricerCpmpRemovePair(scip, consdata->location1, consdata->location2, consdata->type == CPMP_SAMEDIFF_SAME);
+
+   consdata->propagate = FALSE;
+
+   return SCIP_OKAY;
+}
+
+
+/** constraint display method of constraint handler */
+static
+SCIP_DECL_CONSPRINT(consPrintSamediff)
+{  /*lint --e{715}*/
+   SCIP_CONSDATA* consdata;
+
+   consdata = SCIPconsGetData(cons);
+   assert(consdata != NULL);
+
+   SCIPinfoMessage(scip, file, "\n");
+   SCIPinfoMessage(scip, file, "   Locations: %d, %d (%s)\n", consdata->location1+1, consdata->location2+1,
+      consdata->type == CPMP_SAMEDIFF_SAME ? "same" : "differ");
+
+   return SCIP_OKAY;
+}
+
+
+/*
+ * constraint specific interface methods
+ */
+
+/** creates the handler for samediff constraints and includes it in SCIP */
+SCIP_RETCODE SCIPincludeConshdlrSamediff(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_CONSHDLR* conshdlr;
+
+   conshdlr = NULL;
+
+   /* include constraint handler */
+   SCIP_CALL( SCIPincludeConshdlrBasic(scip, &conshdlr, CONSHDLR_NAME, CONSHDLR_DESC,
+         CONSHDLR_ENFOPRIORITY, CONSHDLR_CHECKPRIORITY, CONSHDLR_EAGERFREQ, CONSHDLR_NEEDSCONS,
+         consEnfolpSamediff, consEnfopsSamediff, consCheckSamediff, consLockSamediff,
+         NULL) );
+   assert(conshdlr != NULL);
+
+   /* set non-fundamental callbacks via specific setter functions */
+   SCIP_CALL( SCIPsetConshdlrActive(scip, conshdlr, consActiveSamediff) );
+   SCIP_CALL( SCIPsetConshdlrDeactive(scip, conshdlr, consDeactiveSamediff) );
+   SCIP_CALL( SCIPsetConshdlrDelete(scip, conshdlr, consDeleteSamediff) );
+   SCIP_CALL( SCIPsetConshdlrPrint(scip, conshdlr, consPrintSamediff) );
+   SCIP_CALL( SCIPsetConshdlrProp(scip, conshdlr, consPropSamediff, CONSHDLR_PROPFREQ, CONSHDLR_DELAYPROP,
+         CONSHDLR_PROP_TIMING) );
+
+   return SCIP_OKAY;
+}
+
+/** creates and captures a samediff constraint
+ *
+ *  @note the constraint gets captured, hence at one point you have to release it using the method SCIPreleaseCons()
+ */
+SCIP_RETCODE SCIPcreateConsSamediff(
+   SCIP*                 scip,               /**< SCIP data structure                                                             */
+   SCIP_CONS**           cons,               /**< pointer to hold the created constraint                                          */
+   const char*           name,               /**< name of constraint                                                              */
+   int                   location1,          /**< first location of the pair                                                      */
+   int                   location2,          /**< second location of the pair                                                     */
+   CPMP_SAMEDIFFTYPE     type,               /**< must the locations be in the same cluster or in different ones?                 */
+   SCIP_NODE*            node                /**< node for which the constraint is valid                                          */
+   )
+{
+   SCIP_CONSHDLR* conshdlr;
+   SCIP_CONSDATA* consdata;
+
+   assert(location1 != location2);
+
+   /* find the samediff constraint handler */
+   conshdlr = SCIPfindConshdlr(scip, CONSHDLR_NAME);
+   if( conshdlr == NULL )
+   {
+      SCIPerrorMessage("samediff constraint handler not found\n");
+      return SCIP_PLUGINNOTFOUND;
+   }
+
+   /* create constraint data */
+   consdata = NULL;
+   SCIP_CALL( SCIPallocMemory(scip, &consdata) );
+   assert(consdata != NULL);
+
+   consdata->location1 = location1;
+   consdata->location2 = location2;
+   consdata->type = type;
+   consdata->node = node;
+   consdata->propagate = TRUE;
+   consdata->npropvars = 0;
+
+   /* create constraint */
+   SCIP_CALL( SCIPcreateCons(scip, cons, name, conshdlr, consdata, FALSE, FALSE, TRUE, TRUE, TRUE,
+         TRUE, FALSE, FALSE, FALSE, TRUE) );
+
+   return SCIP_OKAY;
+}
+
+/** returns the locations of the pair of a samediff constraint */
+void SCIPgetLocationsSamediff(
+   SCIP_CONS*            cons,               /**< samediff constraint                                                             */
+   int*                  location1,          /**< pointer to store the first location of the pair                                 */
+   int*                  location2           /**< pointer to store the second location of the pair                                */
+   )
+{
+   SCIP_CONSDATA* consdata;
+
+   consdata = SCIPconsGetData(cons);
+   assert(consdata != NULL);
+
+   *location1 = consdata->location1;
+   *location2 = consdata->location2;
+}
+
+/** returns whether the locations of a samediff constraint must be in the same cluster or in different ones */
+CPMP_SAMEDIFFTYPE SCIPgetTypeSamediff(
+   SCIP_CONS*            cons                /**< samediff constraint                                                             */
+   )
+{
+   SCIP_CONSDATA* consdata;
+
+   consdata = SCIPconsGetData(cons);
+   assert(consdata != NULL);
+
+   return consdata->type;
+}
@@ -0,0 +1,85 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   cons_samediff.h
+ * @ingroup CONSHDLRS
+ * @brief  constraint handler for Ryan-Foster branching decisions
+ * @author Christian Puchert
+ *
+ * A samediff constraint stores the decision that two locations are served by the same median (i.e. contained in
+ * the same cluster) or by different medians in the subtree of a node. Columns violating the decision are fixed to
+ * zero, and the pricer only generates columns which respect it.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __CPMP_CONS_SAMEDIFF_H__
+#define __CPMP_CONS_SAMEDIFF_H__
+
+
+#include "scip/scip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** type of a Ryan-Foster branching decision */
+enum CPMP_SamediffType
+{
+   CPMP_SAMEDIFF_DIFFER = 0,                 /**< the locations are in different clusters */
+   CPMP_SAMEDIFF_SAME   = 1                  /**< the locations are in the same cluster   */
+};
+typedef enum CPMP_SamediffType CPMP_SAMEDIFFTYPE;
+
+/** creates the handler for samediff constraints and includes it in SCIP */
+EXTERN
+SCIP_RETCODE SCIPincludeConshdlrSamediff(
+   SCIP*                 scip                /**< SCIP data structure */
+   );
+
+/** creates and captures a samediff constraint
+ *
+ *  @note the constraint gets captured, hence at one point you have to release it using the method SCIPreleaseCons()
+ */
+EXTERN
+SCIP_RETCODE SCIPcreateConsSamediff(
+   SCIP*                 scip,               /**< SCIP data structure                                                             */
+   SCIP_CONS**           cons,               /**< pointer to hold the created constraint                                          */
+   const char*           name,               /**< name of constraint                                                              */
+   int                   location1,          /**< first location of the pair                                                      */
+   int                   location2,          /**< second location of the pair                                                     */
+   CPMP_SAMEDIFFTYPE     type,               /**< must the locations be in the same cluster or in different ones?                 */
+   SCIP_NODE*            node                /**< node for which the constraint is valid                                          */
+   );
+
+/** returns the locations of the pair of a samediff constraint */
+EXTERN
+void SCIPgetLocationsSamediff(
+   SCIP_CONS*            cons,               /**< samediff constraint                                                             */
+   int*                  location1,          /**< pointer to store the first location of the pair                                 */
+   int*                  location2           /**< pointer to store the second location of the pair                                */
+   );
+
+/** returns whether the locations of a samediff constraint must be in the same cluster or in different ones */
+EXTERN
+CPMP_SAMEDIFFTYPE SCIPgetTypeSamediff(
+   SCIP_CONS*            cons                /**< samediff constraint                                                             */
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
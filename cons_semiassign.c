@@ -25,6 +25,7 @@
 
 #include "cons_semiassign.h"
 #include "pricer_cpmp.h"
+#include "prof_cpmp.h"
 #include "pub_probdata.h"
 #include "pub_vardata.h"
 
@@ -58,6 +59,9 @@ struct SCIP_ConsData
    SCIP_Bool             propagate;          /* Has the constrained to be propagated? TRUE if the subtree
                                                 below the node is entered and new variables have been created since the last propagation */
    int                   npropvars;          /* number of variables present in the problem the last time the constrained was propagated  */
+
+   SCIP_Real             parentbound;        /* LP value of the parent node when the constraint was created, or SCIP_INVALID            */
+   SCIP_Real             fracmass;           /* total assignment value of the location to the medians forbidden by the constraint       */
 };
 
 
@@ -108,6 +112,8 @@ SCIP_DECL_CONSPROP(consPropSemiassign)
    int c;
    int i;
 
+   CPMP_PROF_START(CPMP_PROF_CONSPROP_SEMIASSIGN);
+
    SCIP_CALL( SCIPgetVarsData(scip, &vars, &nvars, NULL, NULL, NULL, NULL) );
 
    *result = SCIP_DIDNOTFIND;
@@ -152,12 +158,16 @@ SCIP_DECL_CONSPROP(consPropSemiassign)
          }
 
          SCIPdebugMessage("   -> %d variables fixed to zero.\n", nfixedvars);
+         CPMP_PROF_COUNT(CPMP_PROF_SEMIASSIGN_SCANNED, i - consdata->npropvars);
+         CPMP_PROF_COUNT(CPMP_PROF_SEMIASSIGN_FIXED, nfixedvars);
 
          consdata->propagate = FALSE;
          consdata->npropvars = i;
       }
    }
 
+   CPMP_PROF_STOP(CPMP_PROF_CONSPROP_SEMIASSIGN);
+
    return SCIP_OKAY;
 }
 
@@ -177,6 +187,8 @@ SCIP_DECL_CONSACTIVE(consActiveSemiassign)
    SCIP_CONSDATA* consdata;
    int nvars;
 
+   CPMP_PROF_START(CPMP_PROF_CONSACTIVE_SEMIASSIGN);
+
    consdata = SCIPconsGetData(cons);
    assert(consdata != NULL);
 
@@ -191,11 +203,14 @@ SCIP_DECL_CONSACTIVE(consActiveSemiassign)
       SCIPdebugMessage("constraint %s needs to be propagated\n", SCIPconsGetName(cons));
       consdata->propagate = TRUE;
       SCIP_CALL( SCIPrepropagateNode(scip, consdata->node) );
+      CPMP_PROF_COUNT(CPMP_PROF_SEMIASSIGN_REPROPS, 1);
    }
 
    /* notify the pricer about the forbidden assignments */
    SCIPpricerCpmpForbidAssignments(scip, consdata->location, consdata->forbidden);
 
+   CPMP_PROF_STOP(CPMP_PROF_CONSACTIVE_SEMIASSIGN);
+
    return SCIP_OKAY;
 }
 
@@ -206,6 +221,8 @@ SCIP_DECL_CONSDEACTIVE(consDeactiveSemiassign)
 {  /*lint --e{715}*/
    SCIP_CONSDATA* consdata;
 
+   CPMP_PROF_START(CPMP_PROF_CONSDEACTIVE_SEMIASSIGN);
+
    consdata = SCIPconsGetData(cons);
    assert(consdata != NULL);
 
@@ -215,6 +232,8 @@ SCIP_DECL_CONSDEACTIVE(consDeactiveSemiassign)
 
    consdata->propagate = FALSE;
 
+   CPMP_PROF_STOP(CPMP_PROF_CONSDEACTIVE_SEMIASSIGN);
+
    return SCIP_OKAY;
 }
 
@@ -315,6 +334,8 @@ SCIP_RETCODE SCIPcreateConsSemiassign(
    consdata->node = node;
    consdata->propagate = TRUE;
    consdata->npropvars = 0;
+   consdata->parentbound = SCIP_INVALID;
+   consdata->fracmass = 0.0;
 
    /* create constraint */
    SCIP_CALL( SCIPcreateCons(scip, cons, name, conshdlr, consdata, FALSE, FALSE, TRUE, TRUE, TRUE,
@@ -322,3 +343,108 @@ SCIP_RETCODE SCIPcreateConsSemiassign(
 
    return SCIP_OKAY;
 }
+
+/** finds an active semiassign branching constraint which belongs to the given node, or returns NULL if there is none */
+SCIP_CONS* SCIPfindConsSemiassign(
+   SCIP*                 scip,               /**< SCIP data structure                                                             */
+   SCIP_NODE*            node                /**< node whose constraint should be found                                           */
+   )
+{
+   SCIP_CONSHDLR* conshdlr;
+   SCIP_CONS** conss;
+   int nconss;
+
+   int c;
+
+   conshdlr = SCIPfindConshdlr(scip, CONSHDLR_NAME);
+   if( conshdlr == NULL )
+      return NULL;
+
+   /* the active constraints come first */
+   conss = SCIPconshdlrGetConss(conshdlr);
+   nconss = SCIPconshdlrGetNActiveConss(conshdlr);
+
+   for( c = nconss - 1; c >= 0; --c )
+   {
+      SCIP_CONSDATA* consdata;
+
+      consdata = SCIPconsGetData(conss[c]);
+      assert(consdata != NULL);
+
+      /* constraints added by reduced cost fixing carry no branching data */
+      if( consdata->node == node && consdata->parentbound != SCIP_INVALID ) /*lint !e777*/
+         return conss[c];
+   }
+
+   return NULL;
+}
+
+/** returns the location of a semiassign constraint */
+int SCIPgetLocationSemiassign(
+   SCIP_CONS*            cons                /**< semiassign constraint                                                           */
+   )
+{
+   SCIP_CONSDATA* consdata;
+
+   consdata = SCIPconsGetData(cons);
+   assert(consdata != NULL);
+
+   return consdata->location;
+}
+
+/** returns for each median whether the location of a semiassign constraint may not be assigned to it */
+SCIP_Bool* SCIPgetForbiddenSemiassign(
+   SCIP_CONS*            cons                /**< semiassign constraint                                                           */
+   )
+{
+   SCIP_CONSDATA* consdata;
+
+   consdata = SCIPconsGetData(cons);
+   assert(consdata != NULL);
+
+   return consdata->forbidden;
+}
+
+/** stores the branching information of a semiassign constraint, which is used to learn pseudocosts
+ *  once its node has been solved
+ */
+void SCIPsetBranchingDataSemiassign(
+   SCIP_CONS*            cons,               /**< semiassign constraint                                                           */
+   SCIP_Real             parentbound,        /**< LP value of the parent node                                                     */
+   SCIP_Real             fracmass            /**< total assignment value of the location to the forbidden medians                 */
+   )
+{
+   SCIP_CONSDATA* consdata;
+
+   consdata = SCIPconsGetData(cons);
+   assert(consdata != NULL);
+
+   consdata->parentbound = parentbound;
+   consdata->fracmass = fracmass;
+}
+
+/** returns the LP value of the parent node of a semiassign constraint, or SCIP_INVALID if unknown */
+SCIP_Real SCIPgetParentboundSemiassign(
+   SCIP_CONS*            cons                /**< semiassign constraint                                                           */
+   )
+{
+   SCIP_CONSDATA* consdata;
+
+   consdata = SCIPconsGetData(cons);
+   assert(consdata != NULL);
+
+   return consdata->parentbound;
+}
+
+/** returns the total assignment value of the location to the medians forbidden by a semiassign constraint */
+SCIP_Real SCIPgetFracmassSemiassign(
+   SCIP_CONS*            cons                /**< semiassign constraint                                                           */
+   )
+{
+   SCIP_CONSDATA* consdata;
+
+   consdata = SCIPconsGetData(cons);
+   assert(consdata != NULL);
+
+   return consdata->fracmass;
+}
@@ -51,6 +51,47 @@ SCIP_RETCODE SCIPcreateConsSemiassign(
    SCIP_NODE*            node                /**< node for which the constraint is valid                                          */
    );
 
+/** finds an active semiassign branching constraint which belongs to the given node, or returns NULL if there is none */
+EXTERN
+SCIP_CONS* SCIPfindConsSemiassign(
+   SCIP*                 scip,               /**< SCIP data structure                                                             */
+   SCIP_NODE*            node                /**< node whose constraint should be found                                           */
+   );
+
+/** returns the location of a semiassign constraint */
+EXTERN
+int SCIPgetLocationSemiassign(
+   SCIP_CONS*            cons                /**< semiassign constraint                                                           */
+   );
+
+/** returns for each median whether the location of a semiassign constraint may not be assigned to it */
+EXTERN
+SCIP_Bool* SCIPgetForbiddenSemiassign(
+   SCIP_CONS*            cons                /**< semiassign constraint                                                           */
+   );
+
+/** stores the branching information of a semiassign constraint, which is used to learn pseudocosts
+ *  once its node has been solved
+ */
+EXTERN
+void SCIPsetBranchingDataSemiassign(
+   SCIP_CONS*            cons,               /**< semiassign constraint                                                           */
+   SCIP_Real             parentbound,        /**< LP value of the parent node                                                     */
+   SCIP_Real             fracmass            /**< total assignment value of the location to the forbidden medians                 */
+   );
+
+/** returns the LP value of the parent node of a semiassign constraint, or SCIP_INVALID if unknown */
+EXTERN
+SCIP_Real SCIPgetParentboundSemiassign(
+   SCIP_CONS*            cons                /**< semiassign constraint                                                           */
+   );
+
+/** returns the total assignment value of the location to the medians forbidden by a semiassign constraint */
+EXTERN
+SCIP_Real SCIPgetFracmassSemiassign(
+   SCIP_CONS*            cons                /**< semiassign constraint                                                           */
+   );
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,92 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   cpmpplugins.c
+ * @brief  inclusion of all plugins of the capacitated p-median problem example
+ * @author Christian Puchert
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include "scip/scipdefplugins.h"
+
+#include "branch_median.h"
+#include "branch_ryanfoster.h"
+#include "branch_semiassign.h"
+#include "checkpoint_cpmp.h"
+#include "cons_median.h"
+#include "cons_samediff.h"
+#include "cons_semiassign.h"
+#include "cpmpplugins.h"
+#include "dialog_cpmp.h"
+#include "heur_cpmpdiving.h"
+#include "heur_cpmplocal.h"
+#include "heur_restrictedmaster.h"
+#include "pricer_cpmp.h"
+#include "prop_cpmpredcost.h"
+#include "reader_cpmp.h"
+#include "table_cpmp.h"
+
+
+/** includes the cpmp plugins and the default SCIP plugins in SCIP and applies the cpmp default settings
+ *  (no restarts, no separation)
+ */
+SCIP_RETCODE SCIPincludeCpmpPlugins(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   /* include file reader, pricer, branching rule and constraint handler for branching */
+   SCIP_CALL( SCIPincludeReaderCpmp(scip) );
+   SCIP_CALL( SCIPincludePricerCpmp(scip) );
+   SCIP_CALL( SCIPincludeBranchruleSemiassign(scip) );
+   SCIP_CALL( SCIPincludeConshdlrSemiassign(scip) );
+
+   /* include the alternative branching rules on medians and location pairs; their priorities decide which rule is used */
+   SCIP_CALL( SCIPincludeBranchruleMedian(scip) );
+   SCIP_CALL( SCIPincludeConshdlrMedian(scip) );
+   SCIP_CALL( SCIPincludeBranchruleRyanfoster(scip) );
+   SCIP_CALL( SCIPincludeConshdlrSamediff(scip) );
+
+   /* include problem specific primal heuristics */
+   SCIP_CALL( SCIPincludeHeurCpmpdiving(scip) );
+   SCIP_CALL( SCIPincludeHeurRestrictedmaster(scip) );
+   SCIP_CALL( SCIPincludeHeurCpmplocal(scip) );
+
+   /* include reduced cost fixing of medians and assignments */
+   SCIP_CALL( SCIPincludePropCpmpredcost(scip) );
+
+   /* include periodic checkpoints and the recreation of the tree on resume */
+   SCIP_CALL( SCIPincludeCheckpointCpmp(scip) );
+
+   /* include custom dialog handler */
+   SCIP_CALL( SCIPincludeDialogCpmp(scip) );
+
+   /* include statistics table */
+   SCIP_CALL( SCIPincludeTableCpmp(scip) );
+
+   /* include default plugins */
+   SCIP_CALL( SCIPincludeDefaultPlugins(scip) );
+
+   /* include default SCIP display output */
+   SCIP_CALL( SCIPincludeDispDefault(scip) );
+
+   /* for column generation instances, disable restarts */
+   SCIP_CALL( SCIPsetIntParam(scip, "presolving/maxrestarts", 0) );
+
+   /* turn off all separation algorithms */
+   SCIP_CALL( SCIPsetSeparating(scip, SCIP_PARAMSETTING_OFF, TRUE) );
+
+   return SCIP_OKAY;
+}
@@ -21,11 +21,25 @@
 /*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
 
 #include <assert.h>
+#include <stdio.h>
 
 #include "scip/dialog_default.h"
+#include "batch_cpmp.h"
+#include "checkpoint_cpmp.h"
 #include "dialog_cpmp.h"
+#include "para_cpmp.h"
+#include "prof_cpmp.h"
 #include "pub_probdata.h"
 #include "pub_vardata.h"
+#include "race_cpmp.h"
+#include "table_cpmp.h"
+
+
+#define DEFAULT_BATCHWORKERS   1        /**< default number of parallel workers of the batch command                    */
+#define DEFAULT_RACEWORKERS    7        /**< default number of workers of the race command, one per configuration       */
+#define DEFAULT_RACESETTINGS   ""       /**< default settings files of the racing workers ("": built-in configurations) */
+#define DEFAULT_PARAWORKERS    4        /**< default number of workers of the parallel command                          */
+#define DEFAULT_PARACOLUMNS    2000     /**< default maximal number of columns sent along with a subtree                */
 
 
 /*
@@ -83,6 +97,226 @@ SCIP_DECL_DIALOGEXEC(dialogExecDisplaySolclusters)
 }
 
 
+/** display the timers and counters of the profiled cpmp plugins */
+static
+SCIP_DECL_DIALOGEXEC(dialogExecDisplayCpmpprofile)
+{  /*lint --e{715}*/
+   /* add your dialog to history of dialogs that have been executed */
+   SCIP_CALL( SCIPdialoghdlrAddHistory(dialoghdlr, dialog, NULL, FALSE) );
+
+   SCIPprintProfileCpmp(scip, NULL);
+
+   /* next dialog will be root dialog again */
+   *nextdialog = SCIPdialoghdlrGetRoot(dialoghdlr);
+
+   return SCIP_OKAY;
+}
+
+
+/** write the cpmp pricing statistics as JSON to a file */
+static
+SCIP_DECL_DIALOGEXEC(dialogExecWriteCpmpstatistics)
+{  /*lint --e{715}*/
+   char* filename;
+   SCIP_Bool endoffile;
+
+   SCIP_CALL( SCIPdialoghdlrGetWord(dialoghdlr, dialog, "enter filename: ", &filename, &endoffile) );
+   if( endoffile )
+   {
+      *nextdialog = NULL;
+      return SCIP_OKAY;
+   }
+
+   if( filename[0] != '\0' )
+   {
+      FILE* file;
+
+      SCIP_CALL( SCIPdialoghdlrAddHistory(dialoghdlr, dialog, filename, TRUE) );
+
+      if( SCIPgetStage(scip) < SCIP_STAGE_SOLVING )
+      {
+         SCIPdialogMessage(scip, NULL, "no statistics available\n");
+      }
+      else
+      {
+         file = fopen(filename, "w");
+         if( file == NULL )
+         {
+            SCIPdialogMessage(scip, NULL, "error creating file <%s>\n", filename);
+            SCIPdialoghdlrClearBuffer(dialoghdlr);
+         }
+         else
+         {
+            SCIP_CALL( SCIPwriteStatisticsJsonCpmp(scip, file) );
+            fclose(file);
+            SCIPdialogMessage(scip, NULL, "written cpmp statistics to file <%s>\n", filename);
+         }
+      }
+   }
+
+   /* next dialog will be root dialog again */
+   *nextdialog = SCIPdialoghdlrGetRoot(dialoghdlr);
+
+   return SCIP_OKAY;
+}
+
+
+/** solve the instances of a list file one after another and write one result line per instance */
+static
+SCIP_DECL_DIALOGEXEC(dialogExecBatch)
+{  /*lint --e{715}*/
+   char listfilename[SCIP_MAXSTRLEN];
+   char* filename;
+   SCIP_Bool endoffile;
+
+   SCIP_CALL( SCIPdialoghdlrGetWord(dialoghdlr, dialog, "enter instance list file: ", &filename, &endoffile) );
+   if( endoffile )
+   {
+      *nextdialog = NULL;
+      return SCIP_OKAY;
+   }
+
+   if( filename[0] != '\0' )
+   {
+      SCIP_RETCODE retcode;
+      int nworkers;
+
+      /* the word is overwritten when the next one is read */
+      (void) SCIPsnprintf(listfilename, SCIP_MAXSTRLEN, "%s", filename);
+
+      SCIP_CALL( SCIPdialoghdlrGetWord(dialoghdlr, dialog, "enter result file (empty for standard output): ", &filename,
+            &endoffile) );
+      if( endoffile )
+      {
+         *nextdialog = NULL;
+         return SCIP_OKAY;
+      }
+
+      SCIP_CALL( SCIPdialoghdlrAddHistory(dialoghdlr, dialog, listfilename, TRUE) );
+      SCIP_CALL( SCIPgetIntParam(scip, "cpmp/batch/workers", &nworkers) );
+
+      retcode = SCIPsolveBatchCpmp(scip, listfilename, filename[0] != '\0' ? filename : NULL, nworkers);
+      if( retcode == SCIP_NOFILE || retcode == SCIP_FILECREATEERROR )
+      {
+         SCIPdialogMessage(scip, NULL, "batch not solved\n");
+         SCIPdialoghdlrClearBuffer(dialoghdlr);
+      }
+      else
+      {
+         SCIP_CALL( retcode );
+      }
+   }
+
+   /* next dialog will be root dialog again */
+   *nextdialog = SCIPdialoghdlrGetRoot(dialoghdlr);
+
+   return SCIP_OKAY;
+}
+
+
+/** race differently configured SCIPs on the current problem */
+static
+SCIP_DECL_DIALOGEXEC(dialogExecRace)
+{  /*lint --e{715}*/
+   /* add your dialog to history of dialogs that have been executed */
+   SCIP_CALL( SCIPdialoghdlrAddHistory(dialoghdlr, dialog, NULL, FALSE) );
+
+   if( SCIPgetStage(scip) < SCIP_STAGE_PROBLEM || SCIPgetProbData(scip) == NULL )
+   {
+      SCIPdialogMessage(scip, NULL, "no problem exists\n");
+   }
+   else
+   {
+      char* settingsfiles;
+      int nworkers;
+
+      SCIP_CALL( SCIPgetIntParam(scip, "cpmp/race/workers", &nworkers) );
+      SCIP_CALL( SCIPgetStringParam(scip, "cpmp/race/settings", &settingsfiles) );
+      SCIP_CALL( SCIPraceCpmp(scip, nworkers, settingsfiles) );
+   }
+
+   /* next dialog will be root dialog again */
+   *nextdialog = SCIPdialoghdlrGetRoot(dialoghdlr);
+
+   return SCIP_OKAY;
+}
+
+
+/** search the branch-and-price tree of the current problem in parallel */
+static
+SCIP_DECL_DIALOGEXEC(dialogExecParallel)
+{  /*lint --e{715}*/
+   /* add your dialog to history of dialogs that have been executed */
+   SCIP_CALL( SCIPdialoghdlrAddHistory(dialoghdlr, dialog, NULL, FALSE) );
+
+   if( SCIPgetStage(scip) < SCIP_STAGE_PROBLEM || SCIPgetProbData(scip) == NULL )
+   {
+      SCIPdialogMessage(scip, NULL, "no problem exists\n");
+   }
+   else
+   {
+      int nworkers;
+      int maxsubtreecols;
+
+      SCIP_CALL( SCIPgetIntParam(scip, "cpmp/parallel/workers", &nworkers) );
+      SCIP_CALL( SCIPgetIntParam(scip, "cpmp/parallel/subtreecolumns", &maxsubtreecols) );
+      SCIP_CALL( SCIPsolveParallelCpmp(scip, nworkers, maxsubtreecols) );
+   }
+
+   /* next dialog will be root dialog again */
+   *nextdialog = SCIPdialoghdlrGetRoot(dialoghdlr);
+
+   return SCIP_OKAY;
+}
+
+
+/** load a checkpoint into the current problem and continue the checkpointed run */
+static
+SCIP_DECL_DIALOGEXEC(dialogExecResume)
+{  /*lint --e{715}*/
+   char* filename;
+   SCIP_Bool endoffile;
+
+   if( SCIPgetStage(scip) < SCIP_STAGE_PROBLEM || SCIPgetProbData(scip) == NULL )
+   {
+      SCIPdialogMessage(scip, NULL, "no problem exists\n");
+      SCIP_CALL( SCIPdialoghdlrAddHistory(dialoghdlr, dialog, NULL, FALSE) );
+      *nextdialog = SCIPdialoghdlrGetRoot(dialoghdlr);
+      return SCIP_OKAY;
+   }
+
+   SCIP_CALL( SCIPdialoghdlrGetWord(dialoghdlr, dialog, "enter checkpoint file: ", &filename, &endoffile) );
+   if( endoffile )
+   {
+      *nextdialog = NULL;
+      return SCIP_OKAY;
+   }
+
+   if( filename[0] != '\0' )
+   {
+      SCIP_RETCODE retcode;
+
+      SCIP_CALL( SCIPdialoghdlrAddHistory(dialoghdlr, dialog, filename, TRUE) );
+
+      retcode = SCIPresumeCpmp(scip, filename);
+      if( retcode == SCIP_NOFILE || retcode == SCIP_READERROR )
+      {
+         SCIPdialogMessage(scip, NULL, "checkpoint not loaded\n");
+         SCIPdialoghdlrClearBuffer(dialoghdlr);
+      }
+      else
+      {
+         SCIP_CALL( retcode );
+         SCIP_CALL( SCIPsolve(scip) );
+      }
+   }
+
+   /* next dialog will be root dialog again */
+   *nextdialog = SCIPdialoghdlrGetRoot(dialoghdlr);
+
+   return SCIP_OKAY;
+}
+
 
 /*
  * dialog specific interface methods
@@ -104,6 +338,54 @@ SCIP_RETCODE SCIPincludeDialogCpmp(
       SCIP_CALL( SCIPcreateRootDialog(scip, &root) );
    }
 
+   /* batch */
+   if( !SCIPdialogHasEntry(root, "batch") )
+   {
+      SCIP_CALL( SCIPincludeDialog(scip, &dialog,
+            NULL,
+            dialogExecBatch, NULL, NULL,
+            "batch", "solve the instances of a list file one after another and write one result line per instance",
+            FALSE, NULL) );
+      SCIP_CALL( SCIPaddDialogEntry(scip, root, dialog) );
+      SCIP_CALL( SCIPreleaseDialog(scip, &dialog) );
+   }
+
+   /* race */
+   if( !SCIPdialogHasEntry(root, "race") )
+   {
+      SCIP_CALL( SCIPincludeDialog(scip, &dialog,
+            NULL,
+            dialogExecRace, NULL, NULL,
+            "race", "race differently configured SCIPs in parallel on the problem and keep the best solution",
+            FALSE, NULL) );
+      SCIP_CALL( SCIPaddDialogEntry(scip, root, dialog) );
+      SCIP_CALL( SCIPreleaseDialog(scip, &dialog) );
+   }
+
+   /* parallel */
+   if( !SCIPdialogHasEntry(root, "parallel") )
+   {
+      SCIP_CALL( SCIPincludeDialog(scip, &dialog,
+            NULL,
+            dialogExecParallel, NULL, NULL,
+            "parallel", "search the branch-and-price tree of the problem with several workers in parallel",
+            FALSE, NULL) );
+      SCIP_CALL( SCIPaddDialogEntry(scip, root, dialog) );
+      SCIP_CALL( SCIPreleaseDialog(scip, &dialog) );
+   }
+
+   /* resume */
+   if( !SCIPdialogHasEntry(root, "resume") )
+   {
+      SCIP_CALL( SCIPincludeDialog(scip, &dialog,
+            NULL,
+            dialogExecResume, NULL, NULL,
+            "resume", "load a checkpoint written by cpmp/checkpoint/file into the problem and continue the run",
+            FALSE, NULL) );
+      SCIP_CALL( SCIPaddDialogEntry(scip, root, dialog) );
+      SCIP_CALL( SCIPreleaseDialog(scip, &dialog) );
+   }
+
    /* display */
    if( !SCIPdialogHasEntry(root, "display") )
    {
@@ -142,5 +424,59 @@ SCIP_RETCODE SCIPincludeDialogCpmp(
       SCIP_CALL( SCIPreleaseDialog(scip, &dialog) );
    }
 
+   /* display cpmpprofile */
+   if( !SCIPdialogHasEntry(submenu, "cpmpprofile") )
+   {
+      SCIP_CALL( SCIPincludeDialog(scip, &dialog,
+            NULL,
+            dialogExecDisplayCpmpprofile, NULL, NULL,
+            "cpmpprofile", "display the timers and counters of the profiled cpmp plugins", FALSE, NULL) );
+      SCIP_CALL( SCIPaddDialogEntry(scip, submenu, dialog) );
+      SCIP_CALL( SCIPreleaseDialog(scip, &dialog) );
+   }
+
+   /* write */
+   if( !SCIPdialogHasEntry(root, "write") )
+   {
+      SCIP_CALL( SCIPincludeDialog(scip, &submenu,
+         NULL,
+         SCIPdialogExecMenu, NULL, NULL,
+         "write", "write information to file", TRUE, NULL) );
+      SCIP_CALL( SCIPaddDialogEntry(scip, root, submenu) );
+      SCIP_CALL( SCIPreleaseDialog(scip, &submenu) );
+   }
+   if( SCIPdialogFindEntry(root, "write", &submenu) != 1 )
+   {
+      SCIPerrorMessage("write sub menu not found\n");
+      return SCIP_PLUGINNOTFOUND;
+   }
+
+   /* write cpmpstatistics */
+   if( !SCIPdialogHasEntry(submenu, "cpmpstatistics") )
+   {
+      SCIP_CALL( SCIPincludeDialog(scip, &dialog,
+            NULL,
+            dialogExecWriteCpmpstatistics, NULL, NULL,
+            "cpmpstatistics", "write the cpmp pricing statistics in JSON format to file", FALSE, NULL) );
+      SCIP_CALL( SCIPaddDialogEntry(scip, submenu, dialog) );
+      SCIP_CALL( SCIPreleaseDialog(scip, &dialog) );
+   }
+
+   SCIP_CALL( SCIPaddIntParam(scip, "cpmp/batch/workers",
+         "number of parallel workers of the batch command, each with its own SCIP (1: reuse the current SCIP)",
+         NULL, FALSE, DEFAULT_BATCHWORKERS, 1, 1024, NULL, NULL) );
+   SCIP_CALL( SCIPaddIntParam(scip, "cpmp/race/workers",
+         "number of workers of the race command, each with its own SCIP and configuration",
+         NULL, FALSE, DEFAULT_RACEWORKERS, 1, 256, NULL, NULL) );
+   SCIP_CALL( SCIPaddStringParam(scip, "cpmp/race/settings",
+         "settings files of the racing workers separated by ';' (\"\": built-in configurations)",
+         NULL, FALSE, DEFAULT_RACESETTINGS, NULL, NULL) );
+   SCIP_CALL( SCIPaddIntParam(scip, "cpmp/parallel/workers",
+         "number of workers of the parallel command, each with its own SCIP",
+         NULL, FALSE, DEFAULT_PARAWORKERS, 1, 256, NULL, NULL) );
+   SCIP_CALL( SCIPaddIntParam(scip, "cpmp/parallel/subtreecolumns",
+         "maximal number of columns sent along with a subtree to warm start the worker solving it",
+         NULL, FALSE, DEFAULT_PARACOLUMNS, 0, INT_MAX, NULL, NULL) );
+
    return SCIP_OKAY;
 }
@@ -0,0 +1,437 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   heur_cpmpdiving.c
+ * @ingroup PRIMALHEURISTICS
+ * @brief  column generation diving heuristic for capacitated p-median problems
+ * @author Christian Puchert
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+
+#include "heur_cpmpdiving.h"
+#include "pricer_cpmp.h"
+#include "pub_probdata.h"
+#include "pub_vardata.h"
+
+
+#define HEUR_NAME             "cpmpdiving"
+#define HEUR_DESC             "column generation diving heuristic for capacitated p-median problems"
+#define HEUR_DISPCHAR         'c'
+#define HEUR_PRIORITY         -1000000
+#define HEUR_FREQ             10
+#define HEUR_FREQOFS          0
+#define HEUR_MAXDEPTH         -1
+#define HEUR_TIMING           SCIP_HEURTIMING_AFTERLPPLUNGE
+#define HEUR_USESSUBSCIP      FALSE  /**< does the heuristic use a secondary SCIP instance? */
+
+#define DEFAULT_MAXBACKTRACKS     3    /**< maximal number of backtracks per dive                                   */
+#define DEFAULT_MAXPRICEROUNDS    10   /**< maximal number of pricing rounds per probing LP (-1: no limit)          */
+
+
+/*
+ * Data structures
+ */
+
+/** primal heuristic data */
+struct SCIP_HeurData
+{
+   int                   maxbacktracks;      /* maximal number of backtracks per dive                                   */
+   int                   maxpricerounds;     /* maximal number of pricing rounds per probing LP (-1: no limit)          */
+};
+
+/** pricer restrictions imposed by the fixings of a dive, one level per probing node */
+struct DiveRestrictions
+{
+   int*                  medians;            /* medians of the assignments forbidden by the fixings                     */
+   int*                  locations;          /* locations of the assignments forbidden by the fixings                   */
+   int                   nforbidden;         /* number of forbidden assignments                                         */
+   int                   forbiddensize;      /* size of the forbidden assignment arrays                                 */
+   int*                  levelstarts;        /* for each level, the first of its forbidden assignments                  */
+   int*                  closedmedians;      /* for each level, the median closed by it, or -1                          */
+   SCIP_VAR**            excludedcols;       /* for each level, the column excluded from pricing by it, or NULL         */
+   int                   nlevels;            /* number of levels                                                        */
+   int                   levelssize;         /* size of the level arrays                                                */
+};
+typedef struct DiveRestrictions DIVERESTRICTIONS;
+
+
+/*
+ * Local methods
+ */
+
+/** opens a new level of pricer restrictions */
+static
+SCIP_RETCODE pushLevel(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   DIVERESTRICTIONS*     restrictions,       /* pricer restrictions of the dive                      */
+   int                   closedmedian,       /* median closed on this level, or -1                   */
+   SCIP_VAR*             excludedcol         /* column excluded from pricing on this level, or NULL  */
+   )
+{
+   if( restrictions->nlevels == restrictions->levelssize )
+   {
+      restrictions->levelssize = SCIPcalcMemGrowSize(scip, restrictions->nlevels + 1);
+      SCIP_CALL( SCIPreallocMemoryArray(scip, &restrictions->levelstarts, restrictions->levelssize) );
+      SCIP_CALL( SCIPreallocMemoryArray(scip, &restrictions->closedmedians, restrictions->levelssize) );
+      SCIP_CALL( SCIPreallocMemoryArray(scip, &restrictions->excludedcols, restrictions->levelssize) );
+   }
+
+   restrictions->levelstarts[restrictions->nlevels] = restrictions->nforbidden;
+   restrictions->closedmedians[restrictions->nlevels] = closedmedian;
+   restrictions->excludedcols[restrictions->nlevels] = excludedcol;
+   ++restrictions->nlevels;
+
+   if( closedmedian >= 0 )
+      SCIPpricerCpmpCloseMedian(scip, closedmedian);
+   if( excludedcol != NULL )
+   {
+      SCIP_CALL( SCIPpricerCpmpExcludeColumn(scip, excludedcol) );
+   }
+
+   return SCIP_OKAY;
+}
+
+/** forbids an assignment in the pricer and records it on the current level */
+static
+SCIP_RETCODE pushForbidden(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   DIVERESTRICTIONS*     restrictions,       /* pricer restrictions of the dive                      */
+   int                   median,             /* median                                               */
+   int                   location            /* location which may not be assigned to the median     */
+   )
+{
+   assert(restrictions->nlevels > 0);
+
+   if( restrictions->nforbidden == restrictions->forbiddensize )
+   {
+      restrictions->forbiddensize = SCIPcalcMemGrowSize(scip, restrictions->nforbidden + 1);
+      SCIP_CALL( SCIPreallocMemoryArray(scip, &restrictions->medians, restrictions->forbiddensize) );
+      SCIP_CALL( SCIPreallocMemoryArray(scip, &restrictions->locations, restrictions->forbiddensize) );
+   }
+
+   restrictions->medians[restrictions->nforbidden] = median;
+   restrictions->locations[restrictions->nforbidden] = location;
+   ++restrictions->nforbidden;
+
+   SCIPpricerCpmpForbidAssignment(scip, median, location);
+
+   return SCIP_OKAY;
+}
+
+/** reverts the pricer restrictions of the last level */
+static
+void popLevel(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   DIVERESTRICTIONS*     restrictions        /* pricer restrictions of the dive                      */
+   )
+{
+   int level;
+
+   assert(restrictions->nlevels > 0);
+
+   level = --restrictions->nlevels;
+
+   while( restrictions->nforbidden > restrictions->levelstarts[level] )
+   {
+      --restrictions->nforbidden;
+      SCIPpricerCpmpAllowAssignment(scip, restrictions->medians[restrictions->nforbidden],
+         restrictions->locations[restrictions->nforbidden]);
+   }
+
+   if( restrictions->closedmedians[level] >= 0 )
+      SCIPpricerCpmpReopenMedian(scip, restrictions->closedmedians[level]);
+   if( restrictions->excludedcols[level] != NULL )
+      SCIPpricerCpmpIncludeColumn(scip, restrictions->excludedcols[level]);
+}
+
+/** chooses the column with the largest fractional LP value that is not fixed yet, or NULL if the LP is integral */
+static
+SCIP_VAR* chooseColumn(
+   SCIP*                 scip                /* SCIP data structure                                  */
+   )
+{
+   SCIP_VAR** vars;
+   int nvars;
+   SCIP_VAR* bestvar;
+   SCIP_Real bestval;
+
+   int i;
+
+   vars = SCIPgetVars(scip);
+   nvars = SCIPgetNVars(scip);
+
+   bestvar = NULL;
+   bestval = 0.0;
+   for( i = 0; i < nvars; ++i )
+   {
+      SCIP_Real solval;
+
+      if( SCIPvarGetLbLocal(vars[i]) > 0.5 || SCIPvarGetUbLocal(vars[i]) < 0.5 )
+         continue;
+
+      solval = SCIPvarGetLPSol(vars[i]);
+      if( !SCIPisFeasIntegral(scip, solval) && solval > bestval )
+      {
+         bestvar = vars[i];
+         bestval = solval;
+      }
+   }
+
+   return bestvar;
+}
+
+/** fixes a column to one at the current probing node: the other columns of its median and the columns of other
+ *  medians containing one of its locations are fixed to zero, and the pricer may neither generate columns for the
+ *  median nor assign its locations to other medians
+ */
+static
+SCIP_RETCODE fixColumn(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   DIVERESTRICTIONS*     restrictions,       /* pricer restrictions of the dive                      */
+   SCIP_VAR*             fixvar,             /* column to fix to one                                 */
+   SCIP_Bool*            incluster           /* working array of size nlocations, all FALSE          */
+   )
+{
+   SCIP_VAR** vars;
+   int nvars;
+   int nlocations;
+   int* members;
+   int nmembers;
+   int median;
+
+   int i;
+   int m;
+
+   nlocations = SCIPprobdataGetNLocations(scip);
+   median = SCIPvarGetMedian(fixvar);
+   members = SCIPvarGetLocations(fixvar);
+   nmembers = SCIPvarGetNLocations(fixvar);
+
+   SCIP_CALL( SCIPchgVarLbProbing(scip, fixvar, 1.0) );
+   SCIP_CALL( pushLevel(scip, restrictions, median, NULL) );
+
+   for( i = 0; i < nmembers; ++i )
+   {
+      incluster[members[i]] = TRUE;
+      for( m = 0; m < nlocations; ++m )
+      {
+         if( m != median && !SCIPpricerCpmpIsAssignmentForbidden(scip, m, members[i]) )
+         {
+            SCIP_CALL( pushForbidden(scip, restrictions, m, members[i]) );
+         }
+      }
+   }
+
+   SCIP_CALL( SCIPgetVarsData(scip, &vars, &nvars, NULL, NULL, NULL, NULL) );
+   for( i = 0; i < nvars; ++i )
+   {
+      int* varmembers;
+      int nvarmembers;
+      SCIP_Bool conflict;
+      int k;
+
+      if( vars[i] == fixvar || SCIPvarGetUbLocal(vars[i]) < 0.5 )
+         continue;
+
+      conflict = (SCIPvarGetMedian(vars[i]) == median);
+      varmembers = SCIPvarGetLocations(vars[i]);
+      nvarmembers = SCIPvarGetNLocations(vars[i]);
+      for( k = 0; k < nvarmembers && !conflict; ++k )
+         conflict = incluster[varmembers[k]];
+
+      if( conflict )
+      {
+         SCIP_CALL( SCIPchgVarUbProbing(scip, vars[i], 0.0) );
+      }
+   }
+
+   for( i = 0; i < nmembers; ++i )
+      incluster[members[i]] = FALSE;
+
+   return SCIP_OKAY;
+}
+
+/** resolves the probing LP with column generation and checks whether the dive may continue */
+static
+SCIP_RETCODE solveProbingLP(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_HEURDATA*        heurdata,           /* heuristic data                                       */
+   SCIP_Bool*            failed              /* pointer to store whether the LP is infeasible, unsolved, or cut off */
+   )
+{
+   SCIP_Bool lperror;
+   SCIP_Bool cutoff;
+
+   SCIP_CALL( SCIPsolveProbingLPWithPricing(scip, FALSE, FALSE, heurdata->maxpricerounds, &lperror, &cutoff) );
+
+   *failed = lperror || cutoff || SCIPgetLPSolstat(scip) != SCIP_LPSOLSTAT_OPTIMAL
+      || SCIPisGE(scip, SCIPgetLPObjval(scip), SCIPgetCutoffbound(scip));
+
+   return SCIP_OKAY;
+}
+
+
+/*
+ * Callback methods of primal heuristic
+ */
+
+/** destructor of primal heuristic to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_HEURFREE(heurFreeCpmpdiving)
+{  /*lint --e{715}*/
+   SCIP_HEURDATA* heurdata;
+
+   heurdata = SCIPheurGetData(heur);
+   assert(heurdata != NULL);
+
+   SCIPfreeMemory(scip, &heurdata);
+   SCIPheurSetData(heur, NULL);
+
+   return SCIP_OKAY;
+}
+
+/** execution method of primal heuristic */
+static
+SCIP_DECL_HEUREXEC(heurExecCpmpdiving)
+{  /*lint --e{715}*/
+   SCIP_HEURDATA* heurdata;
+   DIVERESTRICTIONS restrictions;
+   SCIP_Bool* incluster;
+   int nbacktracks;
+
+   heurdata = SCIPheurGetData(heur);
+   assert(heurdata != NULL);
+
+   *result = SCIP_DIDNOTRUN;
+
+   /* the dive starts from the optimal LP of the current node */
+   if( !SCIPhasCurrentNodeLP(scip) || SCIPgetLPSolstat(scip) != SCIP_LPSOLSTAT_OPTIMAL || SCIPinProbing(scip) )
+      return SCIP_OKAY;
+
+   *result = SCIP_DIDNOTFIND;
+
+   SCIPdebugMessage("start cpmp diving at node %"SCIP_LONGINT_FORMAT"\n", SCIPnodeGetNumber(SCIPgetCurrentNode(scip)));
+
+   BMSclearMemory(&restrictions);
+   SCIP_CALL( SCIPallocClearBufferArray(scip, &incluster, SCIPprobdataGetNLocations(scip)) );
+
+   SCIP_CALL( SCIPstartProbing(scip) );
+
+   nbacktracks = 0;
+   while( !SCIPisStopped(scip) )
+   {
+      SCIP_VAR* var;
+      SCIP_Bool failed;
+
+      var = chooseColumn(scip);
+
+      /* all columns are integral: the LP solution is a feasible solution of the problem */
+      if( var == NULL )
+      {
+         SCIP_SOL* sol;
+         SCIP_Bool stored;
+
+         SCIP_CALL( SCIPcreateSol(scip, &sol, heur) );
+         SCIP_CALL( SCIPlinkLPSol(scip, sol) );
+         SCIP_CALL( SCIPtrySolFree(scip, &sol, FALSE, FALSE, TRUE, TRUE, TRUE, &stored) );
+
+         if( stored )
+         {
+            SCIPdebugMessage("cpmp diving found a solution at probing depth %d\n", SCIPgetProbingDepth(scip));
+            *result = SCIP_FOUNDSOL;
+         }
+         break;
+      }
+
+      SCIPdebugMessage("   -> fix column <%s> with LP value %g\n", SCIPvarGetName(var), SCIPvarGetLPSol(var));
+
+      SCIP_CALL( SCIPnewProbingNode(scip) );
+      SCIP_CALL( fixColumn(scip, &restrictions, var, incluster) );
+      SCIP_CALL( solveProbingLP(scip, heurdata, &failed) );
+
+      /* revert the fixing and exclude the column instead */
+      if( failed && nbacktracks < heurdata->maxbacktracks )
+      {
+         ++nbacktracks;
+         SCIPdebugMessage("   -> backtrack, exclude column <%s>\n", SCIPvarGetName(var));
+
+         popLevel(scip, &restrictions);
+         SCIP_CALL( SCIPbacktrackProbing(scip, SCIPgetProbingDepth(scip) - 1) );
+
+         /* the pricer must not generate the cluster of the column again as a new column */
+         SCIP_CALL( SCIPnewProbingNode(scip) );
+         SCIP_CALL( pushLevel(scip, &restrictions, -1, var) );
+         SCIP_CALL( SCIPchgVarUbProbing(scip, var, 0.0) );
+         SCIP_CALL( solveProbingLP(scip, heurdata, &failed) );
+      }
+
+      if( failed )
+         break;
+   }
+
+   /* revert all pricer restrictions before the probing nodes are left */
+   while( restrictions.nlevels > 0 )
+      popLevel(scip, &restrictions);
+
+   SCIP_CALL( SCIPendProbing(scip) );
+
+   SCIPfreeBufferArray(scip, &incluster);
+   SCIPfreeMemoryArrayNull(scip, &restrictions.excludedcols);
+   SCIPfreeMemoryArrayNull(scip, &restrictions.closedmedians);
+   SCIPfreeMemoryArrayNull(scip, &restrictions.levelstarts);
+   SCIPfreeMemoryArrayNull(scip, &restrictions.locations);
+   SCIPfreeMemoryArrayNull(scip, &restrictions.medians);
+
+   return SCIP_OKAY;
+}
+
+
+/*
+ * primal heuristic specific interface methods
+ */
+
+/** creates the cpmp diving heuristic and includes it in SCIP */
+SCIP_RETCODE SCIPincludeHeurCpmpdiving(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_HEURDATA* heurdata;
+   SCIP_HEUR* heur;
+
+   /* create cpmp diving heuristic data */
+   heurdata = NULL;
+   SCIP_CALL( SCIPallocMemory(scip, &heurdata) );
+
+   heur = NULL;
+   /* include primal heuristic */
+   SCIP_CALL( SCIPincludeHeurBasic(scip, &heur, HEUR_NAME, HEUR_DESC, HEUR_DISPCHAR, HEUR_PRIORITY, HEUR_FREQ,
+         HEUR_FREQOFS, HEUR_MAXDEPTH, HEUR_TIMING, HEUR_USESSUBSCIP, heurExecCpmpdiving, heurdata) );
+   assert(heur != NULL);
+
+   SCIP_CALL( SCIPsetHeurFree(scip, heur, heurFreeCpmpdiving) );
+
+   /* add cpmp diving heuristic parameters */
+   SCIP_CALL( SCIPaddIntParam(scip, "heuristics/" HEUR_NAME "/maxbacktracks",
+         "maximal number of backtracks per dive, in which the last fixed column is excluded instead",
+         &heurdata->maxbacktracks, FALSE, DEFAULT_MAXBACKTRACKS, 0, INT_MAX, NULL, NULL) );
+   SCIP_CALL( SCIPaddIntParam(scip, "heuristics/" HEUR_NAME "/maxpricerounds",
+         "maximal number of pricing rounds when resolving a probing LP (-1: no limit)",
+         &heurdata->maxpricerounds, FALSE, DEFAULT_MAXPRICEROUNDS, -1, INT_MAX, NULL, NULL) );
+
+   return SCIP_OKAY;
+}
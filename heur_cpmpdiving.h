@@ -0,0 +1,51 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   heur_cpmpdiving.h
+ * @ingroup PRIMALHEURISTICS
+ * @brief  column generation diving heuristic for capacitated p-median problems
+ * @author Christian Puchert
+ *
+ * The heuristic repeatedly fixes the column with the largest fractional LP value to one in probing mode. The
+ * locations of the fixed cluster may then not be assigned to any other median, and the median of the cluster is
+ * closed; the pricer respects these restrictions when the probing LP is resolved with column generation. If a
+ * probing LP becomes infeasible, the last fixing is reverted and the column is fixed to zero instead, up to a
+ * limited number of backtracks; the pricer then does not generate its cluster again. Integral probing LP solutions
+ * are tried as primal solutions.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __CPMP_HEUR_CPMPDIVING_H__
+#define __CPMP_HEUR_CPMPDIVING_H__
+
+
+#include "scip/scip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** creates the cpmp diving heuristic and includes it in SCIP */
+EXTERN
+SCIP_RETCODE SCIPincludeHeurCpmpdiving(
+   SCIP*                 scip                /**< SCIP data structure */
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
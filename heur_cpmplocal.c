@@ -0,0 +1,666 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   heur_cpmplocal.c
+ * @ingroup PRIMALHEURISTICS
+ * @brief  assignment repair and median swap local search for capacitated p-median problems
+ * @author Christian Puchert
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+
+#include "heur_cpmplocal.h"
+#include "pricer_cpmp.h"
+#include "pub_probdata.h"
+#include "pub_vardata.h"
+
+
+#define HEUR_NAME             "cpmplocal"
+#define HEUR_DESC             "assignment repair and median swap local search for capacitated p-median problems"
+#define HEUR_DISPCHAR         'L'
+#define HEUR_PRIORITY         -20000
+#define HEUR_FREQ             1
+#define HEUR_FREQOFS          0
+#define HEUR_MAXDEPTH         -1
+#define HEUR_TIMING           SCIP_HEURTIMING_AFTERNODE
+#define HEUR_USESSUBSCIP      FALSE  /**< does the heuristic use a secondary SCIP instance? */
+
+#define DEFAULT_MAXROUNDS     50     /**< maximal number of local search rounds                                    */
+#define DEFAULT_LPROUNDFREQ   10     /**< frequency for starting from the LP medians if there is no new incumbent (0: never) */
+
+
+/*
+ * Data structures
+ */
+
+/** primal heuristic data */
+struct SCIP_HeurData
+{
+   int                   maxrounds;          /* maximal number of local search rounds                                    */
+   int                   lproundfreq;        /* frequency for starting from the LP medians if there is no new incumbent  */
+   int                   lastsolindex;       /* index of the last incumbent the local search started from, or -1        */
+   SCIP_Longint          ncalls;             /* number of calls                                                          */
+};
+
+/** current solution of the local search */
+struct LocalSolution
+{
+   int*                  medians;            /* open medians                                                             */
+   int                   nmedians;           /* number of open medians                                                   */
+   SCIP_Bool*            isopen;             /* for each location, is it an open median?                                 */
+   int*                  assignment;         /* for each location, the median it is assigned to, or -1                  */
+   SCIP_Longint*         loads;              /* for each median, total demand of the locations assigned to it            */
+};
+typedef struct LocalSolution LOCALSOLUTION;
+
+
+/*
+ * Local methods
+ */
+
+/** computes the best and second best median with sufficient residual capacity for a location */
+static
+void computeBestMedians(
+   LOCALSOLUTION*        lsol,               /* local search solution                                */
+   SCIP_Longint**        distances,          /* distances between the locations                      */
+   SCIP_Longint*         demands,            /* demands of the locations                             */
+   SCIP_Longint*         capacities,         /* capacities of the locations                          */
+   int                   location,           /* location                                             */
+   int*                  best,               /* pointer to store the best median, or -1              */
+   int*                  second              /* pointer to store the second best median, or -1       */
+   )
+{
+   int i;
+
+   *best = -1;
+   *second = -1;
+   for( i = 0; i < lsol->nmedians; ++i )
+   {
+      int median = lsol->medians[i];
+
+      if( lsol->loads[median] + demands[location] > capacities[median] )
+         continue;
+
+      if( *best == -1 || distances[location][median] < distances[location][*best] )
+      {
+         *second = *best;
+         *best = median;
+      }
+      else if( *second == -1 || distances[location][median] < distances[location][*second] )
+         *second = median;
+   }
+}
+
+/** assigns all locations to the open medians, taking the location with the largest regret, i.e. the cost difference
+ *  between its second best and best median, first
+ */
+static
+SCIP_RETCODE assignGreedy(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   LOCALSOLUTION*        lsol,               /* local search solution                                */
+   int                   nlocations,         /* number of locations                                  */
+   SCIP_Longint**        distances,          /* distances between the locations                      */
+   SCIP_Longint*         demands,            /* demands of the locations                             */
+   SCIP_Longint*         capacities,         /* capacities of the locations                          */
+   SCIP_Bool*            success             /* pointer to store whether all locations could be assigned */
+   )
+{
+   int* best;
+   int* second;
+   int iter;
+   int l;
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &best, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &second, nlocations) );
+
+   for( l = 0; l < nlocations; ++l )
+   {
+      lsol->assignment[l] = -1;
+      lsol->loads[l] = 0;
+   }
+   for( l = 0; l < nlocations; ++l )
+      computeBestMedians(lsol, distances, demands, capacities, l, &best[l], &second[l]);
+
+   *success = TRUE;
+   for( iter = 0; iter < nlocations && *success; ++iter )
+   {
+      SCIP_Longint maxregret;
+      int location;
+      int median;
+
+      /* find the unassigned location with maximal regret; ties are broken by larger demand */
+      location = -1;
+      maxregret = -1;
+      for( l = 0; l < nlocations; ++l )
+      {
+         SCIP_Longint regret;
+
+         if( lsol->assignment[l] >= 0 )
+            continue;
+
+         if( best[l] == -1 )
+         {
+            *success = FALSE;
+            break;
+         }
+
+         regret = second[l] == -1 ? SCIP_LONGINT_MAX : distances[l][second[l]] - distances[l][best[l]];
+         if( regret > maxregret || (regret == maxregret && demands[l] > demands[location]) )
+         {
+            location = l;
+            maxregret = regret;
+         }
+      }
+      if( !(*success) )
+         break;
+      assert(location >= 0);
+
+      median = best[location];
+      lsol->assignment[location] = median;
+      lsol->loads[median] += demands[location];
+
+      /* only the locations which relied on the median may have lost their best or second best choice */
+      for( l = 0; l < nlocations; ++l )
+      {
+         if( lsol->assignment[l] < 0 && (best[l] == median || second[l] == median)
+            && lsol->loads[median] + demands[l] > capacities[median] )
+            computeBestMedians(lsol, distances, demands, capacities, l, &best[l], &second[l]);
+      }
+   }
+
+   SCIPfreeBufferArray(scip, &second);
+   SCIPfreeBufferArray(scip, &best);
+
+   return SCIP_OKAY;
+}
+
+/** improves the assignment for fixed medians by shifting single locations to another median and by swapping
+ *  two locations of different medians; returns whether an improvement was found
+ */
+static
+SCIP_Bool improveAssignment(
+   LOCALSOLUTION*        lsol,               /* local search solution                                */
+   int                   nlocations,         /* number of locations                                  */
+   SCIP_Longint**        distances,          /* distances between the locations                      */
+   SCIP_Longint*         demands,            /* demands of the locations                             */
+   SCIP_Longint*         capacities          /* capacities of the locations                          */
+   )
+{
+   SCIP_Bool improved;
+   int l;
+   int k;
+   int i;
+
+   improved = FALSE;
+
+   /* shift moves: assign a location to the closest median with enough residual capacity */
+   for( l = 0; l < nlocations; ++l )
+   {
+      int current = lsol->assignment[l];
+      int bestmedian = -1;
+      SCIP_Longint bestdelta = 0;
+
+      for( i = 0; i < lsol->nmedians; ++i )
+      {
+         int median = lsol->medians[i];
+         SCIP_Longint delta;
+
+         if( median == current || lsol->loads[median] + demands[l] > capacities[median] )
+            continue;
+
+         delta = distances[l][median] - distances[l][current];
+         if( delta < bestdelta )
+         {
+            bestmedian = median;
+            bestdelta = delta;
+         }
+      }
+
+      if( bestmedian >= 0 )
+      {
+         lsol->loads[current] -= demands[l];
+         lsol->loads[bestmedian] += demands[l];
+         lsol->assignment[l] = bestmedian;
+         improved = TRUE;
+      }
+   }
+
+   /* swap moves: exchange the medians of two locations if both medians keep their capacity */
+   for( l = 0; l < nlocations; ++l )
+   {
+      for( k = l + 1; k < nlocations; ++k )
+      {
+         int median1 = lsol->assignment[l];
+         int median2 = lsol->assignment[k];
+         SCIP_Longint delta;
+
+         if( median1 == median2 )
+            continue;
+
+         delta = distances[l][median2] + distances[k][median1] - distances[l][median1] - distances[k][median2];
+         if( delta >= 0 )
+            continue;
+
+         if( lsol->loads[median1] - demands[l] + demands[k] > capacities[median1]
+            || lsol->loads[median2] - demands[k] + demands[l] > capacities[median2] )
+            continue;
+
+         lsol->loads[median1] += demands[k] - demands[l];
+         lsol->loads[median2] += demands[l] - demands[k];
+         lsol->assignment[l] = median2;
+         lsol->assignment[k] = median1;
+         improved = TRUE;
+      }
+   }
+
+   return improved;
+}
+
+/** swaps the median of a cluster with a closed location if the latter serves the cluster at lower cost and has
+ *  enough capacity; returns whether an improvement was found
+ */
+static
+SCIP_RETCODE swapMedians(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   LOCALSOLUTION*        lsol,               /* local search solution                                */
+   int                   nlocations,         /* number of locations                                  */
+   SCIP_Longint**        distances,          /* distances between the locations                      */
+   SCIP_Longint*         capacities,         /* capacities of the locations                          */
+   SCIP_Bool*            improved            /* pointer to store whether an improvement was found    */
+   )
+{
+   int* members;
+   int nmembers;
+   int i;
+   int k;
+   int l;
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &members, nlocations) );
+
+   *improved = FALSE;
+   for( i = 0; i < lsol->nmedians; ++i )
+   {
+      int median = lsol->medians[i];
+      int bestmedian = -1;
+      SCIP_Longint bestdelta = 0;
+
+      nmembers = 0;
+      for( l = 0; l < nlocations; ++l )
+         if( lsol->assignment[l] == median )
+            members[nmembers++] = l;
+
+      if( nmembers == 0 )
+         continue;
+
+      for( k = 0; k < nlocations; ++k )
+      {
+         SCIP_Longint delta;
+
+         if( lsol->isopen[k] || capacities[k] < lsol->loads[median] )
+            continue;
+
+         delta = 0;
+         for( l = 0; l < nmembers; ++l )
+            delta += distances[members[l]][k] - distances[members[l]][median];
+
+         if( delta < bestdelta )
+         {
+            bestmedian = k;
+            bestdelta = delta;
+         }
+      }
+
+      if( bestmedian >= 0 )
+      {
+         for( l = 0; l < nmembers; ++l )
+            lsol->assignment[members[l]] = bestmedian;
+         lsol->loads[bestmedian] = lsol->loads[median];
+         lsol->loads[median] = 0;
+         lsol->isopen[median] = FALSE;
+         lsol->isopen[bestmedian] = TRUE;
+         lsol->medians[i] = bestmedian;
+         *improved = TRUE;
+      }
+   }
+
+   SCIPfreeBufferArray(scip, &members);
+
+   return SCIP_OKAY;
+}
+
+/** translates the local search solution into master columns and submits it */
+static
+SCIP_RETCODE submitSolution(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_HEUR*            heur,               /* heuristic                                            */
+   LOCALSOLUTION*        lsol,               /* local search solution                                */
+   int                   nlocations,         /* number of locations                                  */
+   SCIP_Bool*            stored              /* pointer to store whether the solution was accepted   */
+   )
+{
+   SCIP_SOL* sol;
+   int* members;
+   int nmembers;
+   int i;
+   int l;
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &members, nlocations) );
+   SCIP_CALL( SCIPcreateSol(scip, &sol, heur) );
+
+   for( i = 0; i < lsol->nmedians; ++i )
+   {
+      SCIP_VAR* var;
+      int median = lsol->medians[i];
+
+      nmembers = 0;
+      for( l = 0; l < nlocations; ++l )
+         if( lsol->assignment[l] == median )
+            members[nmembers++] = l;
+
+      if( nmembers == 0 )
+         continue;
+
+      var = SCIPfindClusterVar(scip, median, members, nmembers);
+      if( var != NULL )
+      {
+         SCIP_CALL( SCIPsetSolVal(scip, sol, var, 1.0) );
+      }
+      else
+      {
+         SCIP_CALL( SCIPpricerCpmpAddColumn(scip, median, members, nmembers, &var) );
+         SCIP_CALL( SCIPsetSolVal(scip, sol, var, 1.0) );
+         SCIP_CALL( SCIPreleaseVar(scip, &var) );
+      }
+   }
+
+   SCIP_CALL( SCIPtrySolFree(scip, &sol, FALSE, FALSE, TRUE, TRUE, TRUE, stored) );
+
+   SCIPfreeBufferArray(scip, &members);
+
+   return SCIP_OKAY;
+}
+
+/** initializes the local search solution from the columns of a solution */
+static
+void initFromSolution(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_SOL*             sol,                /* solution                                             */
+   LOCALSOLUTION*        lsol,               /* local search solution                                */
+   int                   nlocations,         /* number of locations                                  */
+   SCIP_Longint*         demands             /* demands of the locations                             */
+   )
+{
+   SCIP_VAR** vars;
+   int nvars;
+   int i;
+   int l;
+
+   vars = SCIPgetVars(scip);
+   nvars = SCIPgetNVars(scip);
+
+   for( l = 0; l < nlocations; ++l )
+   {
+      lsol->assignment[l] = -1;
+      lsol->loads[l] = 0;
+   }
+
+   /* a location covered by several chosen clusters is assigned to the first one */
+   for( i = 0; i < nvars; ++i )
+   {
+      int* members;
+      int median;
+
+      if( SCIPgetSolVal(scip, sol, vars[i]) < 0.5 )
+         continue;
+
+      median = SCIPvarGetMedian(vars[i]);
+      if( !lsol->isopen[median] )
+      {
+         lsol->isopen[median] = TRUE;
+         lsol->medians[lsol->nmedians++] = median;
+      }
+
+      members = SCIPvarGetLocations(vars[i]);
+      for( l = 0; l < SCIPvarGetNLocations(vars[i]); ++l )
+      {
+         if( lsol->assignment[members[l]] == -1 )
+         {
+            lsol->assignment[members[l]] = median;
+            lsol->loads[median] += demands[members[l]];
+         }
+      }
+   }
+}
+
+/** opens the medians with the largest total value of their columns in the LP solution */
+static
+SCIP_RETCODE initFromLP(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   LOCALSOLUTION*        lsol,               /* local search solution                                */
+   int                   nlocations          /* number of locations                                  */
+   )
+{
+   SCIP_VAR** vars;
+   int nvars;
+   SCIP_Real* openings;
+   int* perm;
+   int nclusters;
+   int i;
+
+   vars = SCIPgetVars(scip);
+   nvars = SCIPgetNVars(scip);
+   nclusters = SCIPprobdataGetNClusters(scip);
+
+   SCIP_CALL( SCIPallocClearBufferArray(scip, &openings, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &perm, nlocations) );
+
+   for( i = 0; i < nvars; ++i )
+   {
+      if( SCIPvarIsInLP(vars[i]) )
+         openings[SCIPvarGetMedian(vars[i])] += SCIPvarGetLPSol(vars[i]);
+   }
+   for( i = 0; i < nlocations; ++i )
+      perm[i] = i;
+   SCIPsortDownRealInt(openings, perm, nlocations);
+
+   for( i = 0; i < nlocations && lsol->nmedians < nclusters; ++i )
+   {
+      if( !SCIPisPositive(scip, openings[i]) )
+         break;
+
+      lsol->isopen[perm[i]] = TRUE;
+      lsol->medians[lsol->nmedians++] = perm[i];
+   }
+
+   SCIPfreeBufferArray(scip, &perm);
+   SCIPfreeBufferArray(scip, &openings);
+
+   return SCIP_OKAY;
+}
+
+
+/*
+ * Callback methods of primal heuristic
+ */
+
+/** destructor of primal heuristic to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_HEURFREE(heurFreeCpmplocal)
+{  /*lint --e{715}*/
+   SCIP_HEURDATA* heurdata;
+
+   heurdata = SCIPheurGetData(heur);
+   assert(heurdata != NULL);
+
+   SCIPfreeMemory(scip, &heurdata);
+   SCIPheurSetData(heur, NULL);
+
+   return SCIP_OKAY;
+}
+
+/** solving process initialization method of primal heuristic (called when branch and bound process is about to begin) */
+static
+SCIP_DECL_HEURINITSOL(heurInitsolCpmplocal)
+{  /*lint --e{715}*/
+   SCIP_HEURDATA* heurdata;
+
+   heurdata = SCIPheurGetData(heur);
+   assert(heurdata != NULL);
+
+   heurdata->lastsolindex = -1;
+   heurdata->ncalls = 0;
+
+   return SCIP_OKAY;
+}
+
+/** execution method of primal heuristic */
+static
+SCIP_DECL_HEUREXEC(heurExecCpmplocal)
+{  /*lint --e{715}*/
+   SCIP_HEURDATA* heurdata;
+   SCIP_SOL* bestsol;
+   LOCALSOLUTION lsol;
+   int nlocations;
+   SCIP_Longint** distances;
+   SCIP_Longint* demands;
+   SCIP_Longint* capacities;
+   SCIP_Longint cost;
+   SCIP_Bool fromsol;
+   SCIP_Bool success;
+   int round;
+   int l;
+
+   heurdata = SCIPheurGetData(heur);
+   assert(heurdata != NULL);
+
+   *result = SCIP_DIDNOTRUN;
+   ++heurdata->ncalls;
+
+   /* start from a new incumbent which was not found by this heuristic, or from the LP solution now and then */
+   bestsol = SCIPgetBestSol(scip);
+   /* solutions may be freed and their memory reused, so they are recognized by their index, not by their address */
+   fromsol = bestsol != NULL && SCIPsolGetIndex(bestsol) != heurdata->lastsolindex && SCIPsolGetHeur(bestsol) != heur;
+   if( !fromsol && (heurdata->lproundfreq == 0 || heurdata->ncalls % heurdata->lproundfreq != 0
+         || !SCIPhasCurrentNodeLP(scip) || SCIPgetLPSolstat(scip) != SCIP_LPSOLSTAT_OPTIMAL) )
+      return SCIP_OKAY;
+
+   *result = SCIP_DIDNOTFIND;
+
+   nlocations = SCIPprobdataGetNLocations(scip);
+   distances = SCIPprobdataGetDistances(scip);
+   demands = SCIPprobdataGetDemands(scip);
+   capacities = SCIPprobdataGetCapacities(scip);
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &lsol.medians, nlocations) );
+   SCIP_CALL( SCIPallocClearBufferArray(scip, &lsol.isopen, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &lsol.assignment, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &lsol.loads, nlocations) );
+   lsol.nmedians = 0;
+
+   success = TRUE;
+   if( fromsol )
+   {
+      heurdata->lastsolindex = SCIPsolGetIndex(bestsol);
+      initFromSolution(scip, bestsol, &lsol, nlocations, demands);
+      for( l = 0; l < nlocations && success; ++l )
+         success = (lsol.assignment[l] >= 0);
+   }
+   else
+   {
+      SCIP_CALL( initFromLP(scip, &lsol, nlocations) );
+      SCIP_CALL( assignGreedy(scip, &lsol, nlocations, distances, demands, capacities, &success) );
+   }
+
+   if( success )
+   {
+      /* alternate between improving the assignment and swapping the medians */
+      for( round = 0; round < heurdata->maxrounds && !SCIPisStopped(scip); ++round )
+      {
+         SCIP_Bool improved;
+         SCIP_Bool swapped;
+
+         improved = improveAssignment(&lsol, nlocations, distances, demands, capacities);
+         SCIP_CALL( swapMedians(scip, &lsol, nlocations, distances, capacities, &swapped) );
+
+         if( !improved && !swapped )
+            break;
+      }
+
+      cost = 0;
+      for( l = 0; l < nlocations; ++l )
+         cost += distances[l][lsol.assignment[l]];
+
+      SCIPdebugMessage("cpmp local search: cost %"SCIP_LONGINT_FORMAT" after %d rounds, upper bound %g\n", cost, round,
+         SCIPgetUpperbound(scip));
+
+      /* the costs are integral, so only a solution with smaller cost improves the incumbent */
+      if( (SCIP_Real)cost < SCIPgetUpperbound(scip) - 0.5 )
+      {
+         SCIP_Bool stored;
+
+         SCIP_CALL( submitSolution(scip, heur, &lsol, nlocations, &stored) );
+         if( stored )
+            *result = SCIP_FOUNDSOL;
+      }
+   }
+
+   SCIPfreeBufferArray(scip, &lsol.loads);
+   SCIPfreeBufferArray(scip, &lsol.assignment);
+   SCIPfreeBufferArray(scip, &lsol.isopen);
+   SCIPfreeBufferArray(scip, &lsol.medians);
+
+   return SCIP_OKAY;
+}
+
+
+/*
+ * primal heuristic specific interface methods
+ */
+
+/** creates the cpmp local search heuristic and includes it in SCIP */
+SCIP_RETCODE SCIPincludeHeurCpmplocal(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_HEURDATA* heurdata;
+   SCIP_HEUR* heur;
+
+   /* create cpmp local search heuristic data */
+   heurdata = NULL;
+   SCIP_CALL( SCIPallocMemory(scip, &heurdata) );
+   heurdata->lastsolindex = -1;
+   heurdata->ncalls = 0;
+
+   heur = NULL;
+   /* include primal heuristic */
+   SCIP_CALL( SCIPincludeHeurBasic(scip, &heur, HEUR_NAME, HEUR_DESC, HEUR_DISPCHAR, HEUR_PRIORITY, HEUR_FREQ,
+         HEUR_FREQOFS, HEUR_MAXDEPTH, HEUR_TIMING, HEUR_USESSUBSCIP, heurExecCpmplocal, heurdata) );
+   assert(heur != NULL);
+
+   SCIP_CALL( SCIPsetHeurFree(scip, heur, heurFreeCpmplocal) );
+   SCIP_CALL( SCIPsetHeurInitsol(scip, heur, heurInitsolCpmplocal) );
+
+   /* add cpmp local search heuristic parameters */
+   SCIP_CALL( SCIPaddIntParam(scip, "heuristics/" HEUR_NAME "/maxrounds",
+         "maximal number of local search rounds of assignment improvement and median swaps",
+         &heurdata->maxrounds, FALSE, DEFAULT_MAXROUNDS, 0, INT_MAX, NULL, NULL) );
+   SCIP_CALL( SCIPaddIntParam(scip, "heuristics/" HEUR_NAME "/lproundfreq",
+         "frequency (in calls) for starting from the medians of the LP solution if there is no new incumbent (0: never)",
+         &heurdata->lproundfreq, FALSE, DEFAULT_LPROUNDFREQ, 0, INT_MAX, NULL, NULL) );
+
+   return SCIP_OKAY;
+}
@@ -0,0 +1,51 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   heur_cpmplocal.h
+ * @ingroup PRIMALHEURISTICS
+ * @brief  assignment repair and median swap local search for capacitated p-median problems
+ * @author Christian Puchert
+ *
+ * The heuristic works directly on the problem data. It starts from the medians of a new incumbent or from the medians
+ * with the largest opening in the LP solution. For fixed medians, the locations are assigned by a regret-based greedy
+ * procedure and improved by shifting single locations and swapping pairs of locations between medians. Moreover, the
+ * median of a cluster is swapped with a closed location if this reduces the service costs of the cluster. All moves
+ * are evaluated incrementally by their change of cost and load. An improved solution is translated into master
+ * columns and submitted to SCIP.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __CPMP_HEUR_CPMPLOCAL_H__
+#define __CPMP_HEUR_CPMPLOCAL_H__
+
+
+#include "scip/scip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** creates the cpmp local search heuristic and includes it in SCIP */
+EXTERN
+SCIP_RETCODE SCIPincludeHeurCpmplocal(
+   SCIP*                 scip                /**< SCIP data structure */
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,368 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   heur_restrictedmaster.c
+ * @ingroup PRIMALHEURISTICS
+ * @brief  restricted master heuristic for capacitated p-median problems
+ * @author Christian Puchert
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+
+#include "heur_restrictedmaster.h"
+#include "pub_probdata.h"
+#include "pub_vardata.h"
+
+#include "scip/scipdefplugins.h"
+#include "scip/cons_linear.h"
+#include "scip/cons_setppc.h"
+
+
+#define HEUR_NAME             "restrictedmaster"
+#define HEUR_DESC             "solves the master problem restricted to the generated columns as an integer program"
+#define HEUR_DISPCHAR         'M'
+#define HEUR_PRIORITY         -10000
+#define HEUR_FREQ             10
+#define HEUR_FREQOFS          0
+#define HEUR_MAXDEPTH         -1
+#define HEUR_TIMING           SCIP_HEURTIMING_AFTERNODE
+#define HEUR_USESSUBSCIP      TRUE   /**< does the heuristic use a secondary SCIP instance? */
+
+#define DEFAULT_NODELIMIT     500LL  /**< node limit of the sub-SCIP                                               */
+#define DEFAULT_TIMELIMIT     10.0   /**< time limit of the sub-SCIP in seconds                                     */
+#define DEFAULT_MINNEWCOLS    0.1    /**< minimal fraction of new columns since the last call to run again          */
+
+
+/*
+ * Data structures
+ */
+
+/** primal heuristic data */
+struct SCIP_HeurData
+{
+   SCIP_Longint          nodelimit;          /* node limit of the sub-SCIP                                               */
+   SCIP_Real             timelimit;          /* time limit of the sub-SCIP in seconds                                     */
+   SCIP_Real             minnewcols;         /* minimal fraction of new columns since the last call to run again          */
+   int                   lastnvars;          /* number of columns at the last call                                        */
+};
+
+
+/*
+ * Local methods
+ */
+
+/** creates the restricted master problem in the sub-SCIP; returns FALSE in success if some location is not
+ *  covered by any column, such that the restricted master problem is infeasible
+ */
+static
+SCIP_RETCODE createSubproblem(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP*                 subscip,            /* sub-SCIP to create the problem in                    */
+   SCIP_VAR**            vars,               /* columns of the master problem                        */
+   SCIP_VAR**            subvars,            /* array to store the corresponding sub-SCIP variables  */
+   int                   nvars,              /* number of columns                                    */
+   SCIP_Bool*            success             /* pointer to store whether the problem could be created */
+   )
+{
+   SCIP_VAR** consvars;
+   int* beg;
+   int* colidx;
+   int nlocations;
+   int nclusters;
+   SCIP_CONS* cons;
+   char name[SCIP_MAXSTRLEN];
+
+   int i;
+   int j;
+
+   nlocations = SCIPprobdataGetNLocations(scip);
+   nclusters = SCIPprobdataGetNClusters(scip);
+
+   SCIP_CALL( SCIPcreateProbBasic(subscip, "restrictedmaster") );
+   SCIP_CALL( SCIPsetObjIntegral(subscip) );
+
+   for( i = 0; i < nvars; ++i )
+   {
+      /* columns which are globally fixed to zero are kept, such that the indices of the arrays coincide */
+      SCIP_CALL( SCIPcreateVarBasic(subscip, &subvars[i], SCIPvarGetName(vars[i]), 0.0,
+            MIN(SCIPvarGetUbGlobal(vars[i]), 1.0), SCIPvarGetObj(vars[i]), SCIP_VARTYPE_BINARY) );
+      SCIP_CALL( SCIPaddVar(subscip, subvars[i]) );
+   }
+
+   /* the columns of each location and of each median, stored one after the other */
+   SCIP_CALL( SCIPallocClearBufferArray(scip, &beg, 2 * nlocations + 1) );
+   for( i = 0; i < nvars; ++i )
+   {
+      int* members = SCIPvarGetLocations(vars[i]);
+
+      for( j = 0; j < SCIPvarGetNLocations(vars[i]); ++j )
+         ++beg[members[j] + 1];
+      ++beg[nlocations + SCIPvarGetMedian(vars[i]) + 1];
+   }
+   for( i = 0; i < 2 * nlocations; ++i )
+      beg[i + 1] += beg[i];
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &colidx, MAX(beg[2 * nlocations], 1)) );
+   for( i = 0; i < nvars; ++i )
+   {
+      int* members = SCIPvarGetLocations(vars[i]);
+
+      for( j = 0; j < SCIPvarGetNLocations(vars[i]); ++j )
+         colidx[beg[members[j]]++] = i;
+      colidx[beg[nlocations + SCIPvarGetMedian(vars[i])]++] = i;
+   }
+   for( i = 2 * nlocations; i > 0; --i )
+      beg[i] = beg[i - 1];
+   beg[0] = 0;
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &consvars, MAX(nvars, 1)) );
+
+   *success = TRUE;
+   for( i = 0; i < 2 * nlocations && *success; ++i )
+   {
+      int nconsvars;
+
+      nconsvars = beg[i + 1] - beg[i];
+      for( j = 0; j < nconsvars; ++j )
+         consvars[j] = subvars[colidx[beg[i] + j]];
+
+      if( i < nlocations )
+      {
+         /* each location is served by a cluster */
+         if( nconsvars == 0 )
+            *success = FALSE;
+         else
+         {
+            (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "service_%d", i+1);
+            SCIP_CALL( SCIPcreateConsBasicSetcover(subscip, &cons, name, nconsvars, consvars) );
+            SCIP_CALL( SCIPaddCons(subscip, cons) );
+            SCIP_CALL( SCIPreleaseCons(subscip, &cons) );
+         }
+      }
+      else if( nconsvars > 1 )
+      {
+         /* each median serves at most one cluster */
+         (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "conv_%d", i - nlocations + 1);
+         SCIP_CALL( SCIPcreateConsBasicSetpack(subscip, &cons, name, nconsvars, consvars) );
+         SCIP_CALL( SCIPaddCons(subscip, cons) );
+         SCIP_CALL( SCIPreleaseCons(subscip, &cons) );
+      }
+   }
+
+   /* at most p clusters are chosen */
+   if( *success )
+   {
+      SCIP_CALL( SCIPcreateConsBasicLinear(subscip, &cons, "medians", 0, NULL, NULL, -SCIPinfinity(subscip),
+            (SCIP_Real)nclusters) );
+      for( i = 0; i < nvars; ++i )
+      {
+         SCIP_CALL( SCIPaddCoefLinear(subscip, cons, subvars[i], 1.0) );
+      }
+      SCIP_CALL( SCIPaddCons(subscip, cons) );
+      SCIP_CALL( SCIPreleaseCons(subscip, &cons) );
+   }
+
+   SCIPfreeBufferArray(scip, &consvars);
+   SCIPfreeBufferArray(scip, &colidx);
+   SCIPfreeBufferArray(scip, &beg);
+
+   return SCIP_OKAY;
+}
+
+
+/*
+ * Callback methods of primal heuristic
+ */
+
+/** destructor of primal heuristic to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_HEURFREE(heurFreeRestrictedmaster)
+{  /*lint --e{715}*/
+   SCIP_HEURDATA* heurdata;
+
+   heurdata = SCIPheurGetData(heur);
+   assert(heurdata != NULL);
+
+   SCIPfreeMemory(scip, &heurdata);
+   SCIPheurSetData(heur, NULL);
+
+   return SCIP_OKAY;
+}
+
+/** solving process initialization method of primal heuristic (called when branch and bound process is about to begin) */
+static
+SCIP_DECL_HEURINITSOL(heurInitsolRestrictedmaster)
+{  /*lint --e{715}*/
+   SCIP_HEURDATA* heurdata;
+
+   heurdata = SCIPheurGetData(heur);
+   assert(heurdata != NULL);
+
+   heurdata->lastnvars = 0;
+
+   return SCIP_OKAY;
+}
+
+/** execution method of primal heuristic */
+static
+SCIP_DECL_HEUREXEC(heurExecRestrictedmaster)
+{  /*lint --e{715}*/
+   SCIP_HEURDATA* heurdata;
+   SCIP* subscip;
+   SCIP_VAR** vars;
+   SCIP_VAR** subvars;
+   int nvars;
+   SCIP_Real timelimit;
+   SCIP_Real memorylimit;
+   SCIP_Bool success;
+
+   int i;
+
+   heurdata = SCIPheurGetData(heur);
+   assert(heurdata != NULL);
+
+   *result = SCIP_DIDNOTRUN;
+
+   /* only run if enough columns have been generated since the last call */
+   SCIP_CALL( SCIPgetVarsData(scip, &vars, &nvars, NULL, NULL, NULL, NULL) );
+   if( nvars == 0 || nvars - heurdata->lastnvars < heurdata->minnewcols * heurdata->lastnvars
+      || nvars == heurdata->lastnvars )
+      return SCIP_OKAY;
+
+   /* the sub-SCIP respects the remaining time and memory of the main SCIP */
+   SCIP_CALL( SCIPgetRealParam(scip, "limits/time", &timelimit) );
+   if( !SCIPisInfinity(scip, timelimit) )
+      timelimit -= SCIPgetSolvingTime(scip);
+   timelimit = MIN(timelimit, heurdata->timelimit);
+   SCIP_CALL( SCIPgetRealParam(scip, "limits/memory", &memorylimit) );
+   if( !SCIPisInfinity(scip, memorylimit) )
+      memorylimit -= SCIPgetMemUsed(scip) / 1048576.0;
+   if( timelimit <= 0.0 || memorylimit <= 0.0 )
+      return SCIP_OKAY;
+
+   heurdata->lastnvars = nvars;
+   *result = SCIP_DIDNOTFIND;
+
+   SCIPdebugMessage("restricted master heuristic with %d columns\n", nvars);
+
+   SCIP_CALL( SCIPcreate(&subscip) );
+   SCIP_CALL( SCIPincludeDefaultPlugins(subscip) );
+   SCIP_CALL( SCIPsetIntParam(subscip, "display/verblevel", 0) );
+   SCIP_CALL( SCIPsetBoolParam(subscip, "misc/catchctrlc", FALSE) );
+   SCIP_CALL( SCIPsetSubscipsOff(subscip, TRUE) );
+   SCIP_CALL( SCIPsetLongintParam(subscip, "limits/nodes", heurdata->nodelimit) );
+   SCIP_CALL( SCIPsetRealParam(subscip, "limits/time", timelimit) );
+   SCIP_CALL( SCIPsetRealParam(subscip, "limits/memory", memorylimit) );
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &subvars, nvars) );
+   SCIP_CALL( createSubproblem(scip, subscip, vars, subvars, nvars, &success) );
+
+   if( success )
+   {
+      /* only solutions better than the incumbent are of interest */
+      if( !SCIPisInfinity(scip, SCIPgetUpperbound(scip)) )
+      {
+         SCIP_CALL( SCIPsetObjlimit(subscip, SCIPgetUpperbound(scip) - 0.5) );
+      }
+
+      SCIP_CALL( SCIPsolve(subscip) );
+
+      /* pass the solutions of the sub-SCIP back, the best one first */
+      for( i = 0; i < SCIPgetNSols(subscip); ++i )
+      {
+         SCIP_SOL* subsol;
+         SCIP_SOL* sol;
+         SCIP_Bool stored;
+         int v;
+
+         subsol = SCIPgetSols(subscip)[i];
+
+         SCIP_CALL( SCIPcreateSol(scip, &sol, heur) );
+         for( v = 0; v < nvars; ++v )
+         {
+            if( SCIPgetSolVal(subscip, subsol, subvars[v]) > 0.5 )
+            {
+               SCIP_CALL( SCIPsetSolVal(scip, sol, vars[v], 1.0) );
+            }
+         }
+         SCIP_CALL( SCIPtrySolFree(scip, &sol, FALSE, FALSE, TRUE, TRUE, TRUE, &stored) );
+
+         if( stored )
+         {
+            *result = SCIP_FOUNDSOL;
+            SCIPdebugMessage("restricted master heuristic found a solution of value %g\n",
+               SCIPgetSolOrigObj(subscip, subsol));
+         }
+         else
+            break;
+      }
+   }
+   else
+   {
+      SCIPdebugMessage("restricted master heuristic: some location is not covered by any column\n");
+   }
+
+   for( i = 0; i < nvars; ++i )
+   {
+      SCIP_CALL( SCIPreleaseVar(subscip, &subvars[i]) );
+   }
+   SCIPfreeBufferArray(scip, &subvars);
+   SCIP_CALL( SCIPfree(&subscip) );
+
+   return SCIP_OKAY;
+}
+
+
+/*
+ * primal heuristic specific interface methods
+ */
+
+/** creates the restricted master heuristic and includes it in SCIP */
+SCIP_RETCODE SCIPincludeHeurRestrictedmaster(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_HEURDATA* heurdata;
+   SCIP_HEUR* heur;
+
+   /* create restricted master heuristic data */
+   heurdata = NULL;
+   SCIP_CALL( SCIPallocMemory(scip, &heurdata) );
+   heurdata->lastnvars = 0;
+
+   heur = NULL;
+   /* include primal heuristic */
+   SCIP_CALL( SCIPincludeHeurBasic(scip, &heur, HEUR_NAME, HEUR_DESC, HEUR_DISPCHAR, HEUR_PRIORITY, HEUR_FREQ,
+         HEUR_FREQOFS, HEUR_MAXDEPTH, HEUR_TIMING, HEUR_USESSUBSCIP, heurExecRestrictedmaster, heurdata) );
+   assert(heur != NULL);
+
+   SCIP_CALL( SCIPsetHeurFree(scip, heur, heurFreeRestrictedmaster) );
+   SCIP_CALL( SCIPsetHeurInitsol(scip, heur, heurInitsolRestrictedmaster) );
+
+   /* add restricted master heuristic parameters */
+   SCIP_CALL( SCIPaddLongintParam(scip, "heuristics/" HEUR_NAME "/nodelimit",
+         "node limit of the sub-SCIP solving the restricted master problem",
+         &heurdata->nodelimit, FALSE, DEFAULT_NODELIMIT, -1LL, SCIP_LONGINT_MAX, NULL, NULL) );
+   SCIP_CALL( SCIPaddRealParam(scip, "heuristics/" HEUR_NAME "/timelimit",
+         "time limit of the sub-SCIP solving the restricted master problem in seconds",
+         &heurdata->timelimit, FALSE, DEFAULT_TIMELIMIT, 0.0, SCIP_REAL_MAX, NULL, NULL) );
+   SCIP_CALL( SCIPaddRealParam(scip, "heuristics/" HEUR_NAME "/minnewcols",
+         "minimal number of new columns since the last call, relative to the previous number, to run again",
+         &heurdata->minnewcols, FALSE, DEFAULT_MINNEWCOLS, 0.0, SCIP_REAL_MAX, NULL, NULL) );
+
+   return SCIP_OKAY;
+}
@@ -0,0 +1,49 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   heur_restrictedmaster.h
+ * @ingroup PRIMALHEURISTICS
+ * @brief  restricted master heuristic for capacitated p-median problems
+ * @author Christian Puchert
+ *
+ * The heuristic solves the master problem restricted to the columns generated so far as an integer program in a
+ * sub-SCIP: each location has to be covered by a chosen cluster, each median serves at most one cluster, and at most
+ * p clusters are chosen. The sub-SCIP is solved with node and time limits, and its solutions are passed back to
+ * the master problem.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __CPMP_HEUR_RESTRICTEDMASTER_H__
+#define __CPMP_HEUR_RESTRICTEDMASTER_H__
+
+
+#include "scip/scip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** creates the restricted master heuristic and includes it in SCIP */
+EXTERN
+SCIP_RETCODE SCIPincludeHeurRestrictedmaster(
+   SCIP*                 scip                /**< SCIP data structure */
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,1136 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   knapsack_cpmp.c
+ * @brief  knapsack solver specialized for the pricing problems of capacitated p-median problems
+ * @author Christian Puchert
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+
+#include "knapsack_cpmp.h"
+
+#include "scip/scipdefplugins.h"
+#include "scip/cons_knapsack.h"
+#include "scip/cons_setppc.h"
+
+#define MAXCONFLICTNODES       1000     /**< maximal number of nodes of the branching on conflicts                      */
+
+
+/*
+ * Data structures
+ */
+
+/** working memory of the knapsack solver; all arrays are reused between calls and only grow */
+struct CPMP_Knapsack
+{
+   SCIP_Longint          maxdpcells;         /* maximal number of (item, capacity) cells for dynamic programming      */
+   SCIP_Longint          maxnodes;           /* maximal number of branch-and-bound nodes, or -1 for no limit          */
+
+   int                   itemssize;          /* size of the item arrays                                               */
+   int*                  perm;               /* positions of the candidate items, sorted by nonincreasing efficiency  */
+   SCIP_Real*            efficiencies;       /* efficiencies (profit per weight) of the candidate items               */
+   SCIP_Longint*         weights;            /* weights of the items in the current (sorted) order                    */
+   SCIP_Real*            profits;            /* profits of the items in the current (sorted) order                    */
+   SCIP_Longint*         prefixweights;      /* prefix sums of the weights, of size itemssize+1                       */
+   SCIP_Real*            prefixprofits;      /* prefix sums of the profits, of size itemssize+1                       */
+   int*                  fixings;            /* fixing status of each sorted item: -1 free, 0 or 1 fixed              */
+   int*                  freeitems;          /* sorted positions of the items that are still free after reduction     */
+   SCIP_Bool*            x;                  /* current branch-and-bound assignment of the free items                 */
+   SCIP_Bool*            freebestx;          /* best branch-and-bound assignment of the free items                    */
+   SCIP_Bool*            bestx;              /* best assignment found, over the sorted items                          */
+
+   SCIP_Real*            dpvals;             /* dynamic programming values, one per capacity                          */
+   SCIP_Longint          dpvalssize;         /* size of the dynamic programming value array                           */
+   unsigned int*         dpbits;             /* decision bits of the dynamic programming, one per (item, capacity)    */
+   SCIP_Longint          dpbitssize;         /* size of the decision bit array (in words)                             */
+};
+
+
+/*
+ * Local methods
+ */
+
+/** makes sure that the working memory can hold the given number of items */
+static
+SCIP_RETCODE ensureItemsSize(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   CPMP_KNAPSACK*        knapsack,           /* knapsack solver                                      */
+   int                   nitems              /* number of items                                      */
+   )
+{
+   if( nitems <= knapsack->itemssize )
+      return SCIP_OKAY;
+
+   SCIP_CALL( SCIPreallocMemoryArray(scip, &knapsack->perm, nitems) );
+   SCIP_CALL( SCIPreallocMemoryArray(scip, &knapsack->efficiencies, nitems) );
+   SCIP_CALL( SCIPreallocMemoryArray(scip, &knapsack->weights, nitems) );
+   SCIP_CALL( SCIPreallocMemoryArray(scip, &knapsack->profits, nitems) );
+   SCIP_CALL( SCIPreallocMemoryArray(scip, &knapsack->prefixweights, nitems + 1) );
+   SCIP_CALL( SCIPreallocMemoryArray(scip, &knapsack->prefixprofits, nitems + 1) );
+   SCIP_CALL( SCIPreallocMemoryArray(scip, &knapsack->fixings, nitems) );
+   SCIP_CALL( SCIPreallocMemoryArray(scip, &knapsack->freeitems, nitems) );
+   SCIP_CALL( SCIPreallocMemoryArray(scip, &knapsack->x, nitems) );
+   SCIP_CALL( SCIPreallocMemoryArray(scip, &knapsack->freebestx, nitems) );
+   SCIP_CALL( SCIPreallocMemoryArray(scip, &knapsack->bestx, nitems) );
+   knapsack->itemssize = nitems;
+
+   return SCIP_OKAY;
+}
+
+/** computes the prefix sums of weights and profits of the given (sorted) items */
+static
+void computePrefixSums(
+   SCIP_Longint*         weights,            /* item weights                                         */
+   SCIP_Real*            profits,            /* item profits                                         */
+   int                   nitems,             /* number of items                                      */
+   SCIP_Longint*         prefixweights,      /* array to store the prefix sums of the weights        */
+   SCIP_Real*            prefixprofits       /* array to store the prefix sums of the profits        */
+   )
+{
+   int i;
+
+   prefixweights[0] = 0;
+   prefixprofits[0] = 0.0;
+   for( i = 0; i < nitems; ++i )
+   {
+      prefixweights[i+1] = prefixweights[i] + weights[i];
+      prefixprofits[i+1] = prefixprofits[i] + profits[i];
+   }
+}
+
+/** starting from item start with the given residual capacity, finds the critical item, i.e. the first item which
+ *  does not fit any more if all items before it are packed; returns nitems if all remaining items fit
+ */
+static
+int findCriticalItem(
+   SCIP_Longint*         prefixweights,      /* prefix sums of the weights                           */
+   int                   nitems,             /* number of items                                      */
+   int                   start,              /* first item to be considered                          */
+   SCIP_Longint          capacity            /* residual capacity                                    */
+   )
+{
+   SCIP_Longint limit;
+   int lo;
+   int hi;
+
+   /* find the largest r in [start, nitems] with prefixweights[r] <= limit */
+   limit = prefixweights[start] + capacity;
+   lo = start;
+   hi = nitems;
+   while( lo < hi )
+   {
+      int mid = (lo + hi + 1) / 2;
+
+      if( prefixweights[mid] <= limit )
+         lo = mid;
+      else
+         hi = mid - 1;
+   }
+
+   return lo;
+}
+
+/** Dantzig bound (value of the LP relaxation) of the items from start onwards with the given residual capacity */
+static
+SCIP_Real computeDantzigBound(
+   SCIP_Longint*         weights,            /* item weights, sorted by nonincreasing efficiency     */
+   SCIP_Real*            profits,            /* item profits, sorted by nonincreasing efficiency     */
+   SCIP_Longint*         prefixweights,      /* prefix sums of the weights                           */
+   SCIP_Real*            prefixprofits,      /* prefix sums of the profits                           */
+   int                   nitems,             /* number of items                                      */
+   int                   start,              /* first item to be considered                          */
+   SCIP_Longint          capacity            /* residual capacity                                    */
+   )
+{
+   SCIP_Longint residual;
+   int r;
+
+   r = findCriticalItem(prefixweights, nitems, start, capacity);
+   if( r == nitems )
+      return prefixprofits[nitems] - prefixprofits[start];
+
+   residual = capacity - (prefixweights[r] - prefixweights[start]);
+
+   return prefixprofits[r] - prefixprofits[start] + residual * profits[r] / weights[r];
+}
+
+/** Martello-Toth upper bound U2 of the items from start onwards with the given residual capacity:
+ *  the maximum of the bounds obtained by excluding and by including the critical item
+ */
+static
+SCIP_Real computeMTBound(
+   SCIP_Longint*         weights,            /* item weights, sorted by nonincreasing efficiency     */
+   SCIP_Real*            profits,            /* item profits, sorted by nonincreasing efficiency     */
+   SCIP_Longint*         prefixweights,      /* prefix sums of the weights                           */
+   SCIP_Real*            prefixprofits,      /* prefix sums of the profits                           */
+   int                   nitems,             /* number of items                                      */
+   int                   start,              /* first item to be considered                          */
+   SCIP_Longint          capacity            /* residual capacity                                    */
+   )
+{
+   SCIP_Longint residual;
+   SCIP_Real fitprofit;
+   SCIP_Real bound0;
+   SCIP_Real bound1;
+   int r;
+
+   r = findCriticalItem(prefixweights, nitems, start, capacity);
+   if( r == nitems )
+      return prefixprofits[nitems] - prefixprofits[start];
+
+   fitprofit = prefixprofits[r] - prefixprofits[start];
+   residual = capacity - (prefixweights[r] - prefixweights[start]);
+   assert(residual >= 0 && residual < weights[r]);
+
+   /* critical item excluded: fill the residual capacity with the next item */
+   bound0 = fitprofit;
+   if( r + 1 < nitems )
+      bound0 += residual * profits[r+1] / weights[r+1];
+
+   /* critical item included: remove the missing weight at the efficiency of the previous item */
+   if( r > start )
+      bound1 = fitprofit + profits[r] - (weights[r] - residual) * profits[r-1] / weights[r-1];
+   else
+      bound1 = -SCIP_REAL_MAX;
+
+   return MAX(bound0, bound1);
+}
+
+/** solves the problem on the sorted items by dynamic programming over the capacity */
+static
+SCIP_RETCODE solveDP(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   CPMP_KNAPSACK*        knapsack,           /* knapsack solver                                      */
+   int                   nitems,             /* number of (sorted) items                             */
+   SCIP_Longint          capacity,           /* capacity of the knapsack                             */
+   SCIP_Real*            solval              /* pointer to store the optimal profit                  */
+   )
+{
+   SCIP_Longint nvals;
+   SCIP_Longint nwords;
+   SCIP_Longint c;
+   int t;
+
+   nvals = capacity + 1;
+   nwords = (nvals * nitems + 31) / 32;
+
+   if( nvals > knapsack->dpvalssize )
+   {
+      SCIP_CALL( SCIPreallocMemoryArray(scip, &knapsack->dpvals, nvals) );
+      knapsack->dpvalssize = nvals;
+   }
+   if( nwords > knapsack->dpbitssize )
+   {
+      SCIP_CALL( SCIPreallocMemoryArray(scip, &knapsack->dpbits, nwords) );
+      knapsack->dpbitssize = nwords;
+   }
+
+   BMSclearMemoryArray(knapsack->dpvals, nvals);
+   BMSclearMemoryArray(knapsack->dpbits, nwords);
+
+   /* dpvals[c] is the best profit with weight at most c using the items processed so far */
+   for( t = 0; t < nitems; ++t )
+   {
+      SCIP_Longint weight = knapsack->weights[t];
+      SCIP_Real profit = knapsack->profits[t];
+      SCIP_Longint offset = t * nvals;
+
+      for( c = capacity; c >= weight; --c )
+      {
+         if( knapsack->dpvals[c - weight] + profit > knapsack->dpvals[c] )
+         {
+            SCIP_Longint bit = offset + c;
+
+            knapsack->dpvals[c] = knapsack->dpvals[c - weight] + profit;
+            knapsack->dpbits[bit / 32] |= (1u << (bit % 32));
+         }
+      }
+   }
+
+   /* reconstruct the solution backwards */
+   c = capacity;
+   for( t = nitems - 1; t >= 0; --t )
+   {
+      SCIP_Longint bit = t * nvals + c;
+
+      if( knapsack->dpbits[bit / 32] & (1u << (bit % 32)) )
+      {
+         knapsack->bestx[t] = TRUE;
+         c -= knapsack->weights[t];
+      }
+      else
+         knapsack->bestx[t] = FALSE;
+   }
+   assert(c >= 0);
+
+   *solval = knapsack->dpvals[capacity];
+
+   return SCIP_OKAY;
+}
+
+/** depth-first branch-and-bound (Horowitz-Sahni scheme) with the Martello-Toth bound on the given items;
+ *  searches for solutions with a profit larger than the given threshold and stores the best one in x
+ */
+static
+void solveBranchAndBound(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_Longint*         weights,            /* item weights, sorted by nonincreasing efficiency     */
+   SCIP_Real*            profits,            /* item profits, sorted by nonincreasing efficiency     */
+   SCIP_Longint*         prefixweights,      /* prefix sums of the weights                           */
+   SCIP_Real*            prefixprofits,      /* prefix sums of the profits                           */
+   int                   nitems,             /* number of items                                      */
+   SCIP_Longint          capacity,           /* capacity of the knapsack                             */
+   SCIP_Longint          maxnodes,           /* maximal number of nodes, or -1 for no limit          */
+   SCIP_Bool*            x,                  /* working array for the current assignment             */
+   SCIP_Bool*            bestx,              /* array to store the best assignment found             */
+   SCIP_Real*            bestval,            /* on input the threshold, on output the best profit    */
+   SCIP_Bool*            found,              /* pointer to store whether a better solution was found */
+   SCIP_Bool*            aborted             /* pointer to store whether the node limit was hit      */
+   )
+{
+   SCIP_Longint residual;
+   SCIP_Longint nnodes;
+   SCIP_Real profit;
+   SCIP_Real eps;
+   int j;
+   int i;
+
+   eps = SCIPepsilon(scip);
+
+   *found = FALSE;
+   *aborted = FALSE;
+
+   residual = capacity;
+   profit = 0.0;
+   nnodes = 0;
+   j = 0;
+
+   for( ;; )
+   {
+      /* forward move: pack the items greedily, pruning whenever an item has to be left out */
+      if( profit + computeMTBound(weights, profits, prefixweights, prefixprofits, nitems, j, residual) > *bestval + eps )
+      {
+         while( j < nitems )
+         {
+            if( weights[j] <= residual )
+            {
+               x[j] = TRUE;
+               residual -= weights[j];
+               profit += profits[j];
+               ++j;
+            }
+            else
+            {
+               x[j] = FALSE;
+               ++j;
+               if( profit + computeMTBound(weights, profits, prefixweights, prefixprofits, nitems, j, residual) <= *bestval + eps )
+                  break;
+            }
+         }
+
+         /* a leaf has been reached: update the best solution */
+         if( j == nitems && profit > *bestval + eps )
+         {
+            *bestval = profit;
+            BMScopyMemoryArray(bestx, x, nitems);
+            *found = TRUE;
+         }
+      }
+
+      /* backtrack: remove the last packed item and continue with it being excluded */
+      for( i = j - 1; i >= 0 && !x[i]; --i )
+         ;
+      if( i < 0 )
+         break;
+
+      x[i] = FALSE;
+      residual += weights[i];
+      profit -= profits[i];
+      j = i + 1;
+
+      ++nnodes;
+      if( maxnodes >= 0 && nnodes > maxnodes )
+      {
+         *aborted = TRUE;
+         break;
+      }
+   }
+}
+
+
+/** data for sorting items by nondecreasing weight and, for equal weights, nonincreasing profit */
+struct CPMP_ItemOrder
+{
+   SCIP_Longint*         weights;            /* item weights                                         */
+   SCIP_Real*            profits;            /* item profits                                         */
+};
+
+/** comparator for sorting items by nondecreasing weight and, for equal weights, nonincreasing profit */
+static
+SCIP_DECL_SORTINDCOMP(compareItemsWeightProfit)
+{
+   struct CPMP_ItemOrder* order = (struct CPMP_ItemOrder*)dataptr;
+
+   if( order->weights[ind1] != order->weights[ind2] )
+      return order->weights[ind1] < order->weights[ind2] ? -1 : 1;
+   if( order->profits[ind1] != order->profits[ind2] )
+      return order->profits[ind1] > order->profits[ind2] ? -1 : 1;
+
+   return ind1 - ind2;
+}
+
+/** solves a node of the branching on conflicts, at which the excluded items are removed: the knapsack problem without
+ *  the conflicts is solved on the remaining items; if its solution packs both items of a conflict, the first item is
+ *  excluded in one child and the second item in the other one
+ */
+static
+SCIP_RETCODE solveConflictNode(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   CPMP_KNAPSACK*        knapsack,           /* knapsack solver                                      */
+   int                   nitems,             /* number of items                                      */
+   SCIP_Longint*         weights,            /* item weights                                         */
+   SCIP_Real*            profits,            /* item profits                                         */
+   SCIP_Longint          capacity,           /* capacity of the knapsack                             */
+   int                   nconflicts,         /* number of conflicting item pairs                     */
+   int*                  conflicts1,         /* first items of the conflicting pairs                 */
+   int*                  conflicts2,         /* second items of the conflicting pairs                */
+   SCIP_Bool*            excluded,           /* items excluded at the node; unchanged on return      */
+   SCIP_Bool*            packed,             /* working array, all FALSE on entry and on return      */
+   int*                  bestitems,          /* positions of the items of the best solution found    */
+   int*                  nbestitems,         /* pointer to the number of items of the best solution  */
+   SCIP_Real*            bestval,            /* pointer to the profit of the best solution found     */
+   int*                  nnodes,             /* pointer to the number of nodes so far                */
+   SCIP_Bool*            aborted             /* pointer to store whether the node limit was hit      */
+   )
+{
+   SCIP_Longint* nodeweights;
+   SCIP_Real* nodeprofits;
+   int* nodeitems;
+   int* solitems;
+   SCIP_Real solval;
+   SCIP_Real upperbound;
+   SCIP_Bool success;
+   int nnodeitems;
+   int nsolitems;
+   int c;
+   int i;
+
+   ++(*nnodes);
+   if( *nnodes > MAXCONFLICTNODES )
+   {
+      *aborted = TRUE;
+      return SCIP_OKAY;
+   }
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &nodeweights, nitems) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &nodeprofits, nitems) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &nodeitems, nitems) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &solitems, nitems) );
+
+   nnodeitems = 0;
+   for( i = 0; i < nitems; ++i )
+   {
+      if( excluded[i] )
+         continue;
+
+      nodeweights[nnodeitems] = weights[i];
+      nodeprofits[nnodeitems] = profits[i];
+      nodeitems[nnodeitems] = i;
+      ++nnodeitems;
+   }
+
+   /* only solutions better than the best one without conflicts are of interest */
+   SCIP_CALL( SCIPsolveKnapsackCpmp(scip, knapsack, nnodeitems, nodeweights, nodeprofits, capacity, nodeitems, *bestval,
+         solitems, &nsolitems, &solval, &upperbound, &success) );
+
+   if( !success )
+      *aborted = TRUE;
+   else if( solval > *bestval )
+   {
+      for( i = 0; i < nsolitems; ++i )
+         packed[solitems[i]] = TRUE;
+      for( c = 0; c < nconflicts; ++c )
+      {
+         if( packed[conflicts1[c]] && packed[conflicts2[c]] )
+            break;
+      }
+      for( i = 0; i < nsolitems; ++i )
+         packed[solitems[i]] = FALSE;
+
+      if( c == nconflicts )
+      {
+         BMScopyMemoryArray(bestitems, solitems, nsolitems);
+         *nbestitems = nsolitems;
+         *bestval = solval;
+      }
+      else
+      {
+         excluded[conflicts1[c]] = TRUE;
+         SCIP_CALL( solveConflictNode(scip, knapsack, nitems, weights, profits, capacity, nconflicts, conflicts1,
+               conflicts2, excluded, packed, bestitems, nbestitems, bestval, nnodes, aborted) );
+         excluded[conflicts1[c]] = FALSE;
+
+         if( !(*aborted) )
+         {
+            excluded[conflicts2[c]] = TRUE;
+            SCIP_CALL( solveConflictNode(scip, knapsack, nitems, weights, profits, capacity, nconflicts, conflicts1,
+                  conflicts2, excluded, packed, bestitems, nbestitems, bestval, nnodes, aborted) );
+            excluded[conflicts2[c]] = FALSE;
+         }
+      }
+   }
+
+   SCIPfreeBufferArray(scip, &solitems);
+   SCIPfreeBufferArray(scip, &nodeitems);
+   SCIPfreeBufferArray(scip, &nodeprofits);
+   SCIPfreeBufferArray(scip, &nodeweights);
+
+   return SCIP_OKAY;
+}
+
+/** solves a 0/1 knapsack problem with conflicts as an integer program in a sub-SCIP */
+static
+SCIP_RETCODE solveConflictKnapsackSubscip(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   int                   nitems,             /* number of items                                      */
+   SCIP_Longint*         weights,            /* item weights                                         */
+   SCIP_Real*            profits,            /* item profits                                         */
+   SCIP_Longint          capacity,           /* capacity of the knapsack                             */
+   int*                  items,              /* item identifiers                                     */
+   int                   nconflicts,         /* number of conflicting item pairs                     */
+   int*                  conflicts1,         /* first items of the conflicting pairs                 */
+   int*                  conflicts2,         /* second items of the conflicting pairs                */
+   int*                  solitems,           /* array to store the items of the solution             */
+   int*                  nsolitems,          /* pointer to store the number of solution items        */
+   SCIP_Real*            solval,             /* pointer to store the profit of the solution          */
+   SCIP_Real*            upperbound,         /* pointer to store an upper bound on the profit        */
+   SCIP_Bool*            success             /* pointer to store whether it was solved optimally     */
+   )
+{
+   SCIP* subscip;
+   SCIP_VAR** vars;
+   SCIP_CONS* cons;
+   SCIP_SOL* sol;
+   SCIP_Real timelimit;
+   SCIP_Real memorylimit;
+   char name[SCIP_MAXSTRLEN];
+   int i;
+
+   /* the sub-SCIP inherits the remaining time and memory */
+   SCIP_CALL( SCIPgetRealParam(scip, "limits/time", &timelimit) );
+   if( !SCIPisInfinity(scip, timelimit) )
+      timelimit -= SCIPgetSolvingTime(scip);
+   SCIP_CALL( SCIPgetRealParam(scip, "limits/memory", &memorylimit) );
+   if( !SCIPisInfinity(scip, memorylimit) )
+      memorylimit -= SCIPgetMemUsed(scip) / 1048576.0;
+   if( timelimit <= 0.0 || memorylimit <= 0.0 )
+      return SCIP_OKAY;
+
+   SCIP_CALL( SCIPcreate(&subscip) );
+   SCIP_CALL( SCIPincludeDefaultPlugins(subscip) );
+   SCIP_CALL( SCIPsetIntParam(subscip, "display/verblevel", 0) );
+   SCIP_CALL( SCIPsetBoolParam(subscip, "misc/catchctrlc", FALSE) );
+   SCIP_CALL( SCIPsetSubscipsOff(subscip, TRUE) );
+   SCIP_CALL( SCIPsetRealParam(subscip, "limits/time", timelimit) );
+   SCIP_CALL( SCIPsetRealParam(subscip, "limits/memory", memorylimit) );
+
+   /* the profits are fractional, so the objective is not declared integral */
+   SCIP_CALL( SCIPcreateProbBasic(subscip, "conflictknapsack") );
+   SCIP_CALL( SCIPsetObjsense(subscip, SCIP_OBJSENSE_MAXIMIZE) );
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &vars, nitems) );
+   for( i = 0; i < nitems; ++i )
+   {
+      (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "x_%d", items[i]);
+      SCIP_CALL( SCIPcreateVarBasic(subscip, &vars[i], name, 0.0, 1.0, profits[i], SCIP_VARTYPE_BINARY) );
+      SCIP_CALL( SCIPaddVar(subscip, vars[i]) );
+   }
+
+   SCIP_CALL( SCIPcreateConsBasicKnapsack(subscip, &cons, "capacity", nitems, vars, weights, capacity) );
+   SCIP_CALL( SCIPaddCons(subscip, cons) );
+   SCIP_CALL( SCIPreleaseCons(subscip, &cons) );
+
+   for( i = 0; i < nconflicts; ++i )
+   {
+      SCIP_VAR* pair[2];
+
+      pair[0] = vars[conflicts1[i]];
+      pair[1] = vars[conflicts2[i]];
+      (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "conflict_%d", i);
+      SCIP_CALL( SCIPcreateConsBasicSetpack(subscip, &cons, name, 2, pair) );
+      SCIP_CALL( SCIPaddCons(subscip, cons) );
+      SCIP_CALL( SCIPreleaseCons(subscip, &cons) );
+   }
+
+   SCIP_CALL( SCIPsolve(subscip) );
+
+   sol = SCIPgetBestSol(subscip);
+   if( sol != NULL )
+   {
+      for( i = 0; i < nitems; ++i )
+      {
+         if( SCIPgetSolVal(subscip, sol, vars[i]) > 0.5 )
+         {
+            solitems[(*nsolitems)++] = items[i];
+            *solval += profits[i];
+         }
+      }
+   }
+   *upperbound = MAX(SCIPgetDualbound(subscip), *solval);
+   *success = (SCIPgetStatus(subscip) == SCIP_STATUS_OPTIMAL);
+
+   for( i = 0; i < nitems; ++i )
+   {
+      SCIP_CALL( SCIPreleaseVar(subscip, &vars[i]) );
+   }
+   SCIPfreeBufferArray(scip, &vars);
+   SCIP_CALL( SCIPfree(&subscip) );
+
+   return SCIP_OKAY;
+}
+
+/*
+ * interface methods
+ */
+
+/** creates the working memory of the knapsack solver */
+SCIP_RETCODE SCIPcreateKnapsackCpmp(
+   SCIP*                 scip,               /**< SCIP data structure                                                 */
+   CPMP_KNAPSACK**       knapsack,           /**< pointer to store the knapsack solver                                */
+   SCIP_Longint          maxdpcells,         /**< maximal number of (item, capacity) cells for dynamic programming    */
+   SCIP_Longint          maxnodes            /**< maximal number of branch-and-bound nodes, or -1 for no limit        */
+   )
+{
+   assert(scip != NULL);
+   assert(knapsack != NULL);
+
+   SCIP_CALL( SCIPallocMemory(scip, knapsack) );
+   BMSclearMemory(*knapsack);
+
+   (*knapsack)->maxdpcells = maxdpcells;
+   (*knapsack)->maxnodes = maxnodes;
+
+   return SCIP_OKAY;
+}
+
+/** frees the working memory of the knapsack solver */
+void SCIPfreeKnapsackCpmp(
+   SCIP*                 scip,               /**< SCIP data structure                                                 */
+   CPMP_KNAPSACK**       knapsack            /**< pointer to the knapsack solver                                      */
+   )
+{
+   assert(scip != NULL);
+   assert(knapsack != NULL);
+   assert(*knapsack != NULL);
+
+   SCIPfreeMemoryArrayNull(scip, &(*knapsack)->dpbits);
+   SCIPfreeMemoryArrayNull(scip, &(*knapsack)->dpvals);
+   SCIPfreeMemoryArrayNull(scip, &(*knapsack)->bestx);
+   SCIPfreeMemoryArrayNull(scip, &(*knapsack)->freebestx);
+   SCIPfreeMemoryArrayNull(scip, &(*knapsack)->x);
+   SCIPfreeMemoryArrayNull(scip, &(*knapsack)->freeitems);
+   SCIPfreeMemoryArrayNull(scip, &(*knapsack)->fixings);
+   SCIPfreeMemoryArrayNull(scip, &(*knapsack)->prefixprofits);
+   SCIPfreeMemoryArrayNull(scip, &(*knapsack)->prefixweights);
+   SCIPfreeMemoryArrayNull(scip, &(*knapsack)->profits);
+   SCIPfreeMemoryArrayNull(scip, &(*knapsack)->weights);
+   SCIPfreeMemoryArrayNull(scip, &(*knapsack)->efficiencies);
+   SCIPfreeMemoryArrayNull(scip, &(*knapsack)->perm);
+   SCIPfreeMemory(scip, knapsack);
+}
+
+/** reduces a 0/1 knapsack problem in place by removing items which cannot be part of an interesting solution:
+ *  items with nonpositive profit or a weight above the capacity, items which are dominated by an item with smaller
+ *  weight and larger profit while only one of them fits, and items whose inclusion bounds the profit by the cutoff
+ *
+ *  The removals keep every solution with a profit of more than the cutoff; if a solution of the reduced problem does
+ *  not exceed the cutoff, the cutoff is an upper bound for the removed items.
+ */
+SCIP_RETCODE SCIPreduceKnapsackCpmp(
+   SCIP*                 scip,               /**< SCIP data structure                                                 */
+   CPMP_KNAPSACK*        knapsack,           /**< knapsack solver                                                     */
+   int*                  nitems,             /**< pointer to the number of items, is updated                          */
+   SCIP_Longint*         weights,            /**< item weights, are compacted                                         */
+   SCIP_Real*            profits,            /**< item profits, are compacted                                         */
+   SCIP_Longint          capacity,           /**< capacity of the knapsack                                            */
+   int*                  items,              /**< item identifiers, are compacted                                     */
+   SCIP_Real             cutoff,             /**< only solutions with a larger profit are of interest, or -infinity   */
+   int*                  noversized,         /**< pointer to store the number of items removed for their weight       */
+   int*                  ndominated,         /**< pointer to store the number of items removed by dominance           */
+   int*                  nbounded            /**< pointer to store the number of items removed by the bound           */
+   )
+{
+   struct CPMP_ItemOrder order;
+   SCIP_Longint totalweight;
+   SCIP_Real bestprofit;
+   int nlarge;
+   int n;
+   int i;
+   int t;
+
+   assert(scip != NULL);
+   assert(knapsack != NULL);
+   assert(nitems != NULL);
+   assert(*nitems >= 0);
+   assert(capacity >= 0);
+
+   *noversized = 0;
+   *ndominated = 0;
+   *nbounded = 0;
+
+   /* remove the items which can never be packed or never increase the profit */
+   n = 0;
+   totalweight = 0;
+   for( i = 0; i < *nitems; ++i )
+   {
+      if( !SCIPisPositive(scip, profits[i]) )
+         continue;
+
+      if( weights[i] > capacity )
+      {
+         ++(*noversized);
+         continue;
+      }
+
+      items[n] = items[i];
+      weights[n] = weights[i];
+      profits[n] = profits[i];
+      totalweight += weights[i];
+      ++n;
+   }
+   *nitems = n;
+
+   /* if all items fit, there is nothing to decide */
+   if( totalweight <= capacity )
+      return SCIP_OKAY;
+
+   SCIP_CALL( ensureItemsSize(scip, knapsack, n) );
+
+   /* dominance: at most one of the items with more than half of the capacity is packed, so among them, an item can
+    * be replaced by any other with at most its weight and at least its profit
+    */
+   nlarge = 0;
+   for( i = 0; i < n; ++i )
+   {
+      knapsack->fixings[i] = -1;
+      if( 2 * weights[i] > capacity )
+         knapsack->perm[nlarge++] = i;
+   }
+
+   if( nlarge > 1 )
+   {
+      order.weights = weights;
+      order.profits = profits;
+      SCIPsortInd(knapsack->perm, compareItemsWeightProfit, (void*)&order, nlarge);
+
+      bestprofit = -SCIPinfinity(scip);
+      for( t = 0; t < nlarge; ++t )
+      {
+         i = knapsack->perm[t];
+         if( profits[i] <= bestprofit )
+         {
+            knapsack->fixings[i] = 0;
+            ++(*ndominated);
+         }
+         else
+            bestprofit = profits[i];
+      }
+   }
+
+   /* bound-based reduction: an item can be removed if the Dantzig bound of the solutions containing it does not
+    * exceed the cutoff
+    */
+   if( !SCIPisInfinity(scip, -cutoff) )
+   {
+      int ncands;
+
+      ncands = 0;
+      for( i = 0; i < n; ++i )
+      {
+         if( knapsack->fixings[i] == 0 )
+            continue;
+         knapsack->perm[ncands] = i;
+         knapsack->efficiencies[ncands] = profits[i] / weights[i];
+         ++ncands;
+      }
+
+      SCIPsortDownRealInt(knapsack->efficiencies, knapsack->perm, ncands);
+      for( t = 0; t < ncands; ++t )
+      {
+         knapsack->weights[t] = weights[knapsack->perm[t]];
+         knapsack->profits[t] = profits[knapsack->perm[t]];
+      }
+      computePrefixSums(knapsack->weights, knapsack->profits, ncands, knapsack->prefixweights, knapsack->prefixprofits);
+
+      for( t = 0; t < ncands; ++t )
+      {
+         /* the bound may count the item a second time, which only weakens it */
+         if( knapsack->profits[t] + computeDantzigBound(knapsack->weights, knapsack->profits, knapsack->prefixweights,
+               knapsack->prefixprofits, ncands, 0, capacity - knapsack->weights[t]) <= cutoff )
+         {
+            knapsack->fixings[knapsack->perm[t]] = 0;
+            ++(*nbounded);
+         }
+      }
+   }
+
+   /* compact the remaining items, keeping their order */
+   if( *ndominated + *nbounded > 0 )
+   {
+      n = 0;
+      for( i = 0; i < *nitems; ++i )
+      {
+         if( knapsack->fixings[i] == 0 )
+            continue;
+
+         items[n] = items[i];
+         weights[n] = weights[i];
+         profits[n] = profits[i];
+         ++n;
+      }
+      *nitems = n;
+   }
+
+   return SCIP_OKAY;
+}
+
+/** solves a 0/1 knapsack problem
+ *
+ *  If a solution with a profit of more than the given cutoff exists, an optimal solution is returned and
+ *  upperbound equals solval. Otherwise, solitems contains the best solution found so far (which need not be optimal),
+ *  and upperbound is a proven upper bound on the optimal profit which does not exceed the cutoff.
+ *  If the node limit of the branch-and-bound is hit, success is set to FALSE.
+ */
+SCIP_RETCODE SCIPsolveKnapsackCpmp(
+   SCIP*                 scip,               /**< SCIP data structure                                                 */
+   CPMP_KNAPSACK*        knapsack,           /**< knapsack solver                                                     */
+   int                   nitems,             /**< number of items                                                     */
+   SCIP_Longint*         weights,            /**< item weights                                                        */
+   SCIP_Real*            profits,            /**< item profits                                                        */
+   SCIP_Longint          capacity,           /**< capacity of the knapsack                                            */
+   int*                  items,              /**< item identifiers                                                    */
+   SCIP_Real             cutoff,             /**< only solutions with a larger profit are of interest, or -infinity   */
+   int*                  solitems,           /**< array to store the identifiers of the items in the solution         */
+   int*                  nsolitems,          /**< pointer to store the number of items in the solution                */
+   SCIP_Real*            solval,             /**< pointer to store the profit of the solution                         */
+   SCIP_Real*            upperbound,         /**< pointer to store an upper bound on the optimal profit               */
+   SCIP_Bool*            success             /**< pointer to store whether the problem was solved                     */
+   )
+{
+   SCIP_Longint totalweight;
+   SCIP_Longint residual;
+   SCIP_Real fixedprofit;                    /* profit of the items that are packed in any case             */
+   SCIP_Real greedyval;                      /* profit of the greedy solution of the sorted items           */
+   SCIP_Real rootbound;                      /* Martello-Toth bound of the sorted items                     */
+   SCIP_Real threshold;                      /* only solutions of the sorted items above this are of interest */
+   SCIP_Real eps;
+   int ncands;
+   int nfree;
+   int r;
+   int i;
+   int t;
+
+   assert(scip != NULL);
+   assert(knapsack != NULL);
+   assert(nitems >= 0);
+   assert(capacity >= 0);
+
+   eps = SCIPepsilon(scip);
+
+   *nsolitems = 0;
+   *solval = 0.0;
+   *upperbound = 0.0;
+   *success = TRUE;
+
+   SCIP_CALL( ensureItemsSize(scip, knapsack, nitems) );
+
+   /* items with positive profit and zero weight are packed in any case, items with nonpositive profit or a weight
+    * above the capacity never; the remaining items are the candidates
+    */
+   fixedprofit = 0.0;
+   totalweight = 0;
+   ncands = 0;
+   for( i = 0; i < nitems; ++i )
+   {
+      if( !SCIPisPositive(scip, profits[i]) || weights[i] > capacity )
+         continue;
+
+      if( weights[i] == 0 )
+      {
+         solitems[(*nsolitems)++] = items[i];
+         fixedprofit += profits[i];
+      }
+      else
+      {
+         knapsack->perm[ncands] = i;
+         knapsack->efficiencies[ncands] = profits[i] / weights[i];
+         totalweight += weights[i];
+         ++ncands;
+      }
+   }
+
+   /* all candidates fit: the problem is trivial */
+   if( totalweight <= capacity )
+   {
+      for( t = 0; t < ncands; ++t )
+      {
+         solitems[(*nsolitems)++] = items[knapsack->perm[t]];
+         fixedprofit += profits[knapsack->perm[t]];
+      }
+      *solval = fixedprofit;
+      *upperbound = fixedprofit;
+
+      return SCIP_OKAY;
+   }
+
+   /* sort the candidates by nonincreasing efficiency */
+   SCIPsortDownRealInt(knapsack->efficiencies, knapsack->perm, ncands);
+   for( t = 0; t < ncands; ++t )
+   {
+      knapsack->weights[t] = weights[knapsack->perm[t]];
+      knapsack->profits[t] = profits[knapsack->perm[t]];
+   }
+   computePrefixSums(knapsack->weights, knapsack->profits, ncands, knapsack->prefixweights, knapsack->prefixprofits);
+
+   /* greedy solution as initial incumbent */
+   greedyval = 0.0;
+   residual = capacity;
+   for( t = 0; t < ncands; ++t )
+   {
+      knapsack->bestx[t] = (knapsack->weights[t] <= residual);
+      if( knapsack->bestx[t] )
+      {
+         residual -= knapsack->weights[t];
+         greedyval += knapsack->profits[t];
+      }
+   }
+
+   rootbound = computeMTBound(knapsack->weights, knapsack->profits, knapsack->prefixweights, knapsack->prefixprofits,
+      ncands, 0, capacity);
+   threshold = MAX(greedyval, cutoff - fixedprofit);
+
+   SCIPdebugMessage("knapsack: %d candidates, capacity %"SCIP_LONGINT_FORMAT", greedy %g, bound %g, threshold %g\n",
+      ncands, capacity, greedyval + fixedprofit, rootbound + fixedprofit, threshold + fixedprofit);
+
+   if( rootbound <= threshold + eps )
+   {
+      /* early exit: either the greedy solution is optimal, or no solution can beat the cutoff */
+      *upperbound = fixedprofit + MAX(rootbound, greedyval);
+   }
+   else if( capacity + 1 <= knapsack->maxdpcells / ncands )
+   {
+      SCIP_Real dpval;
+
+      SCIP_CALL( solveDP(scip, knapsack, ncands, capacity, &dpval) );
+      greedyval = dpval;
+      *upperbound = fixedprofit + dpval;
+   }
+   else
+   {
+      SCIP_Longint freecapacity;
+      SCIP_Real freeprofit;
+      SCIP_Bool found;
+      SCIP_Bool aborted;
+      SCIP_Real bestval;
+
+      /* bound-based reduction: an item can be fixed to the opposite of its value in the LP relaxation
+       * if the Dantzig bound with the item flipped does not exceed the threshold
+       */
+      r = findCriticalItem(knapsack->prefixweights, ncands, 0, capacity);
+      assert(r < ncands);
+
+      freecapacity = capacity;
+      freeprofit = 0.0;
+      nfree = 0;
+      for( t = 0; t < ncands; ++t )
+      {
+         knapsack->fixings[t] = -1;
+
+         /* bound with the item excluded (the items before it are still packed) */
+         if( t <= r && knapsack->prefixprofits[t] + computeDantzigBound(knapsack->weights, knapsack->profits,
+               knapsack->prefixweights, knapsack->prefixprofits, ncands, t + 1, capacity - knapsack->prefixweights[t])
+            <= threshold + eps )
+            knapsack->fixings[t] = 1;
+
+         /* bound with the item included */
+         if( t >= r && knapsack->profits[t] + computeDantzigBound(knapsack->weights, knapsack->profits,
+               knapsack->prefixweights, knapsack->prefixprofits, ncands, 0, capacity - knapsack->weights[t])
+            <= threshold + eps )
+         {
+            /* the critical item cannot be fixed both ways unless no better solution exists at all */
+            if( knapsack->fixings[t] == 1 )
+            {
+               nfree = -1;
+               break;
+            }
+            knapsack->fixings[t] = 0;
+         }
+
+         if( knapsack->fixings[t] == 1 )
+         {
+            freecapacity -= knapsack->weights[t];
+            freeprofit += knapsack->profits[t];
+         }
+         else if( knapsack->fixings[t] == -1 )
+            knapsack->freeitems[nfree++] = t;
+      }
+
+      /* solve the reduced problem on the free items, which are still sorted by efficiency */
+      found = FALSE;
+      aborted = FALSE;
+      bestval = threshold - freeprofit;
+      if( nfree >= 0 && freecapacity >= 0 )
+      {
+         SCIP_Longint* freeweights;
+         SCIP_Real* freeprofits;
+
+         SCIPdebugMessage("knapsack: reduction leaves %d of %d candidates free\n", nfree, ncands);
+
+         /* compact the free items in place; the sorted arrays are not needed any more */
+         freeweights = knapsack->weights;
+         freeprofits = knapsack->profits;
+         for( i = 0; i < nfree; ++i )
+         {
+            freeweights[i] = knapsack->weights[knapsack->freeitems[i]];
+            freeprofits[i] = knapsack->profits[knapsack->freeitems[i]];
+         }
+         computePrefixSums(freeweights, freeprofits, nfree, knapsack->prefixweights, knapsack->prefixprofits);
+
+         solveBranchAndBound(scip, freeweights, freeprofits, knapsack->prefixweights, knapsack->prefixprofits, nfree,
+            freecapacity, knapsack->maxnodes, knapsack->x, knapsack->freebestx, &bestval, &found, &aborted);
+      }
+
+      if( aborted )
+      {
+         *success = FALSE;
+         return SCIP_OKAY;
+      }
+
+      if( found )
+      {
+         /* the branch-and-bound solution is stored over the free items; expand it to the sorted candidates */
+         for( t = 0; t < ncands; ++t )
+            knapsack->bestx[t] = (knapsack->fixings[t] == 1);
+         for( i = 0; i < nfree; ++i )
+            knapsack->bestx[knapsack->freeitems[i]] = knapsack->freebestx[i];
+         greedyval = bestval + freeprofit;
+         *upperbound = fixedprofit + greedyval;
+      }
+      else
+      {
+         /* no solution beats the threshold: the greedy solution is kept */
+         *upperbound = fixedprofit + threshold;
+      }
+   }
+
+   /* collect the packed candidates */
+   for( t = 0; t < ncands; ++t )
+   {
+      if( knapsack->bestx[t] )
+         solitems[(*nsolitems)++] = items[knapsack->perm[t]];
+   }
+   *solval = fixedprofit + greedyval;
+   assert(*solval <= *upperbound + eps);
+
+   return SCIP_OKAY;
+}
+
+/** solves a 0/1 knapsack problem with conflicts, i.e. pairs of items which may not be packed together
+ *
+ *  The conflicts are resolved by branching on them, each node being a knapsack problem without conflicts; if the
+ *  branching exceeds its node limit, the problem is solved as an integer program in a sub-SCIP. If the problem is
+ *  solved to optimality, success is set to TRUE and solitems contains an optimal solution; upperbound is a proven upper
+ *  bound on the optimal profit in any case.
+ */
+SCIP_RETCODE SCIPsolveConflictKnapsackCpmp(
+   SCIP*                 scip,               /**< SCIP data structure                                                 */
+   CPMP_KNAPSACK*        knapsack,           /**< knapsack solver                                                     */
+   int                   nitems,             /**< number of items                                                     */
+   SCIP_Longint*         weights,            /**< item weights                                                        */
+   SCIP_Real*            profits,            /**< item profits                                                        */
+   SCIP_Longint          capacity,           /**< capacity of the knapsack                                            */
+   int*                  items,              /**< item identifiers                                                    */
+   int                   nconflicts,         /**< number of conflicting item pairs                                    */
+   int*                  conflicts1,         /**< positions of the first items of the conflicting pairs               */
+   int*                  conflicts2,         /**< positions of the second items of the conflicting pairs              */
+   int*                  solitems,           /**< array to store the identifiers of the items in the solution         */
+   int*                  nsolitems,          /**< pointer to store the number of items in the solution                */
+   SCIP_Real*            solval,             /**< pointer to store the profit of the solution                         */
+   SCIP_Real*            upperbound,         /**< pointer to store an upper bound on the optimal profit               */
+   SCIP_Bool*            success             /**< pointer to store whether the problem was solved to optimality       */
+   )
+{
+   SCIP_Bool* excluded;
+   SCIP_Bool* packed;
+   int* bestitems;
+   SCIP_Real bestval;
+   SCIP_Bool aborted;
+   int nbestitems;
+   int nnodes;
+   int i;
+
+   assert(scip != NULL);
+   assert(knapsack != NULL);
+   assert(nitems >= 0);
+   assert(nconflicts == 0 || (conflicts1 != NULL && conflicts2 != NULL));
+
+   *nsolitems = 0;
+   *solval = 0.0;
+   *upperbound = 0.0;
+   *success = FALSE;
+
+   if( nitems == 0 )
+   {
+      *success = TRUE;
+      return SCIP_OKAY;
+   }
+
+   SCIP_CALL( SCIPallocClearBufferArray(scip, &excluded, nitems) );
+   SCIP_CALL( SCIPallocClearBufferArray(scip, &packed, nitems) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &bestitems, nitems) );
+
+   /* the empty solution respects all conflicts */
+   nbestitems = 0;
+   bestval = 0.0;
+   nnodes = 0;
+   aborted = FALSE;
+   SCIP_CALL( solveConflictNode(scip, knapsack, nitems, weights, profits, capacity, nconflicts, conflicts1, conflicts2,
+         excluded, packed, bestitems, &nbestitems, &bestval, &nnodes, &aborted) );
+
+   if( !aborted )
+   {
+      for( i = 0; i < nbestitems; ++i )
+         solitems[i] = items[bestitems[i]];
+      *nsolitems = nbestitems;
+      *solval = bestval;
+      *upperbound = bestval;
+      *success = TRUE;
+   }
+
+   SCIPfreeBufferArray(scip, &bestitems);
+   SCIPfreeBufferArray(scip, &packed);
+   SCIPfreeBufferArray(scip, &excluded);
+
+   if( aborted )
+   {
+      SCIP_CALL( solveConflictKnapsackSubscip(scip, nitems, weights, profits, capacity, items, nconflicts, conflicts1,
+            conflicts2, solitems, nsolitems, solval, upperbound, success) );
+   }
+
+   return SCIP_OKAY;
+}
@@ -0,0 +1,137 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   knapsack_cpmp.h
+ * @brief  knapsack solver specialized for the pricing problems of capacitated p-median problems
+ * @author Christian Puchert
+ *
+ * The pricing problem of each median is a 0/1 knapsack problem with integer demands, the capacity of the median,
+ * and profits which change from round to round. This solver keeps its working memory between calls, uses dynamic
+ * programming over the capacity if the capacity is small, and a depth-first branch-and-bound with the Martello-Toth
+ * upper bound on the items that survive bound-based reduction otherwise. If a cutoff value is given, it stops as soon
+ * as it is proven that no solution with a larger profit exists. The same bounds are offered as a separate reduction
+ * step, so that the callers can shrink the problems before handing them to any solver. Knapsack problems with
+ * conflicting item pairs, which arise from Ryan-Foster branching decisions, are solved by branching on the conflicts
+ * and only as integer programs if there are too many of them.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __CPMP_KNAPSACK_CPMP_H__
+#define __CPMP_KNAPSACK_CPMP_H__
+
+
+#include "scip/scip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** working memory of the knapsack solver */
+typedef struct CPMP_Knapsack CPMP_KNAPSACK;
+
+/** creates the working memory of the knapsack solver */
+EXTERN
+SCIP_RETCODE SCIPcreateKnapsackCpmp(
+   SCIP*                 scip,               /**< SCIP data structure                                                 */
+   CPMP_KNAPSACK**       knapsack,           /**< pointer to store the knapsack solver                                */
+   SCIP_Longint          maxdpcells,         /**< maximal number of (item, capacity) cells for dynamic programming    */
+   SCIP_Longint          maxnodes            /**< maximal number of branch-and-bound nodes, or -1 for no limit        */
+   );
+
+/** frees the working memory of the knapsack solver */
+EXTERN
+void SCIPfreeKnapsackCpmp(
+   SCIP*                 scip,               /**< SCIP data structure                                                 */
+   CPMP_KNAPSACK**       knapsack            /**< pointer to the knapsack solver                                      */
+   );
+
+/** reduces a 0/1 knapsack problem in place by removing items which cannot be part of an interesting solution:
+ *  items with nonpositive profit or a weight above the capacity, items which are dominated by an item with smaller
+ *  weight and larger profit while only one of them fits, and items whose inclusion bounds the profit by the cutoff
+ *
+ *  The removals keep every solution with a profit of more than the cutoff; if a solution of the reduced problem does
+ *  not exceed the cutoff, the cutoff is an upper bound for the removed items.
+ */
+EXTERN
+SCIP_RETCODE SCIPreduceKnapsackCpmp(
+   SCIP*                 scip,               /**< SCIP data structure                                                 */
+   CPMP_KNAPSACK*        knapsack,           /**< knapsack solver                                                     */
+   int*                  nitems,             /**< pointer to the number of items, is updated                          */
+   SCIP_Longint*         weights,            /**< item weights, are compacted                                         */
+   SCIP_Real*            profits,            /**< item profits, are compacted                                         */
+   SCIP_Longint          capacity,           /**< capacity of the knapsack                                            */
+   int*                  items,              /**< item identifiers, are compacted                                     */
+   SCIP_Real             cutoff,             /**< only solutions with a larger profit are of interest, or -infinity   */
+   int*                  noversized,         /**< pointer to store the number of items removed for their weight       */
+   int*                  ndominated,         /**< pointer to store the number of items removed by dominance           */
+   int*                  nbounded            /**< pointer to store the number of items removed by the bound           */
+   );
+
+/** solves a 0/1 knapsack problem
+ *
+ *  If a solution with a profit of more than the given cutoff exists, an optimal solution is returned and
+ *  upperbound equals solval. Otherwise, solitems contains the best solution found so far (which need not be optimal),
+ *  and upperbound is a proven upper bound on the optimal profit which does not exceed the cutoff.
+ *  If the node limit of the branch-and-bound is hit, success is set to FALSE.
+ */
+EXTERN
+SCIP_RETCODE SCIPsolveKnapsackCpmp(
+   SCIP*                 scip,               /**< SCIP data structure                                                 */
+   CPMP_KNAPSACK*        knapsack,           /**< knapsack solver                                                     */
+   int                   nitems,             /**< number of items                                                     */
+   SCIP_Longint*         weights,            /**< item weights                                                        */
+   SCIP_Real*            profits,            /**< item profits                                                        */
+   SCIP_Longint          capacity,           /**< capacity of the knapsack                                            */
+   int*                  items,              /**< item identifiers                                                    */
+   SCIP_Real             cutoff,             /**< only solutions with a larger profit are of interest, or -infinity   */
+   int*                  solitems,           /**< array to store the identifiers of the items in the solution         */
+   int*                  nsolitems,          /**< pointer to store the number of items in the solution                */
+   SCIP_Real*            solval,             /**< pointer to store the profit of the solution                         */
+   SCIP_Real*            upperbound,         /**< pointer to store an upper bound on the optimal profit               */
+   SCIP_Bool*            success             /**< pointer to store whether the problem was solved                     */
+   );
+
+/** solves a 0/1 knapsack problem with conflicts, i.e. pairs of items which may not be packed together
+ *
+ *  The conflicts are resolved by branching on them, each node being a knapsack problem without conflicts; if the
+ *  branching exceeds its node limit, the problem is solved as an integer program in a sub-SCIP. If the problem is
+ *  solved to optimality, success is set to TRUE and solitems contains an optimal solution; upperbound is a proven upper
+ *  bound on the optimal profit in any case.
+ */
+EXTERN
+SCIP_RETCODE SCIPsolveConflictKnapsackCpmp(
+   SCIP*                 scip,               /**< SCIP data structure                                                 */
+   CPMP_KNAPSACK*        knapsack,           /**< knapsack solver                                                     */
+   int                   nitems,             /**< number of items                                                     */
+   SCIP_Longint*         weights,            /**< item weights                                                        */
+   SCIP_Real*            profits,            /**< item profits                                                        */
+   SCIP_Longint          capacity,           /**< capacity of the knapsack                                            */
+   int*                  items,              /**< item identifiers                                                    */
+   int                   nconflicts,         /**< number of conflicting item pairs                                    */
+   int*                  conflicts1,         /**< positions of the first items of the conflicting pairs               */
+   int*                  conflicts2,         /**< positions of the second items of the conflicting pairs              */
+   int*                  solitems,           /**< array to store the identifiers of the items in the solution         */
+   int*                  nsolitems,          /**< pointer to store the number of items in the solution                */
+   SCIP_Real*            solval,             /**< pointer to store the profit of the solution                         */
+   SCIP_Real*            upperbound,         /**< pointer to store an upper bound on the optimal profit               */
+   SCIP_Bool*            success             /**< pointer to store whether the problem was solved to optimality       */
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
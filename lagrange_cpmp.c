@@ -0,0 +1,367 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   lagrange_cpmp.c
+ * @brief  Lagrangian relaxation of the assignment constraints of capacitated p-median problems
+ * @author Christian Puchert
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+
+#include "lagrange_cpmp.h"
+#include "pub_probdata.h"
+
+
+#define STEP_INIT             2.0            /**< initial factor of the Polyak step length                           */
+#define STEP_MIN              1e-4           /**< minimal factor of the Polyak step length                           */
+#define STEP_MAXSTALL         20             /**< iterations without improvement after which the factor is halved   */
+#define TARGET_REL            0.05           /**< relative distance of the target value to the best bound if no primal bound is known */
+
+
+/*
+ * Local methods
+ */
+
+/** evaluates the Lagrangian subproblems of all medians for given multipliers
+ *
+ *  For each median, medianbounds contains a lower bound on the value of its clusters, and clustervals and the item
+ *  buffer the value and the locations of the best cluster found.
+ */
+static
+SCIP_RETCODE evaluateMedians(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   CPMP_KNAPSACK*        knapsack,           /* knapsack solver                                      */
+   CPMP_SIMDLEVEL        simdlevel,          /* instruction set for computing the profits            */
+   SCIP_Bool**           forbidden,          /* matrix of forbidden assignments                      */
+   const SCIP_Real*      multipliers,        /* multipliers of the assignment constraints            */
+   SCIP_Real*            medianbounds,       /* array to store the lower bounds on the cluster values */
+   SCIP_Real*            clustervals,        /* array to store the values of the best clusters       */
+   int**                 itembuffer,         /* pointer to buffer of the locations of the best clusters */
+   int*                  buffersize,         /* pointer to size of the item buffer                   */
+   int*                  itemstarts          /* array to store the start of each cluster in the buffer */
+   )
+{
+   int nlocations;
+   SCIP_Real** mediandistances;
+   SCIP_Longint* alldemands;
+   SCIP_Longint* capacities;
+   int* items;
+   SCIP_Real* profits;
+   SCIP_Longint* demands;
+   int median;
+
+   nlocations = SCIPprobdataGetNLocations(scip);
+   mediandistances = SCIPprobdataGetMedianDistances(scip);
+   alldemands = SCIPprobdataGetDemands(scip);
+   capacities = SCIPprobdataGetCapacities(scip);
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &items, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &profits, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &demands, nlocations) );
+
+   itemstarts[0] = 0;
+   for( median = 0; median < nlocations; ++median )
+   {
+      SCIP_Real solval;
+      SCIP_Real upperbound;
+      SCIP_Bool success;
+      int nitems;
+      int nsolitems;
+
+      nitems = SCIPcomputeProfitsCpmp(simdlevel, nlocations, multipliers, mediandistances[median], forbidden[median],
+         alldemands, items, profits, demands);
+
+      /* make sure that the buffer can take all items of this median */
+      if( itemstarts[median] + nitems > *buffersize )
+      {
+         *buffersize = MAX(2 * (*buffersize), itemstarts[median] + nitems);
+         SCIP_CALL( SCIPreallocMemoryArray(scip, itembuffer, *buffersize) );
+      }
+
+      SCIP_CALL( SCIPsolveKnapsackCpmp(scip, knapsack, nitems, demands, profits, capacities[median], items,
+            -SCIPinfinity(scip), &(*itembuffer)[itemstarts[median]], &nsolitems, &solval, &upperbound, &success) );
+
+      /* if the node limit was hit, the sum of all positive profits is still a valid bound */
+      if( !success )
+      {
+         int i;
+
+         upperbound = 0.0;
+         for( i = 0; i < nitems; ++i )
+            upperbound += profits[i];
+         nsolitems = 0;
+         solval = 0.0;
+      }
+
+      medianbounds[median] = -upperbound;
+      clustervals[median] = -solval;
+      itemstarts[median + 1] = itemstarts[median] + nsolitems;
+   }
+
+   SCIPfreeBufferArray(scip, &demands);
+   SCIPfreeBufferArray(scip, &profits);
+   SCIPfreeBufferArray(scip, &items);
+
+   return SCIP_OKAY;
+}
+
+/** computes a projected subgradient: each location has to be served once, minus the number of chosen clusters
+ *  containing it; returns its squared norm
+ */
+static
+SCIP_Real computeSubgradient(
+   int                   nlocations,         /* number of locations                                  */
+   const SCIP_Real*      multipliers,        /* multipliers of the assignment constraints            */
+   const int*            chosen,             /* medians of the chosen clusters                       */
+   int                   nchosen,            /* number of chosen clusters                            */
+   const int*            itembuffer,         /* locations of the best clusters                       */
+   const int*            itemstarts,         /* start of each cluster in the buffer                  */
+   SCIP_Real*            subgradient         /* array to store the subgradient                       */
+   )
+{
+   SCIP_Real norm;
+   int location;
+   int i;
+   int k;
+
+   for( location = 0; location < nlocations; ++location )
+      subgradient[location] = 1.0;
+
+   for( i = 0; i < nchosen; ++i )
+   {
+      for( k = itemstarts[chosen[i]]; k < itemstarts[chosen[i] + 1]; ++k )
+         subgradient[itembuffer[k]] -= 1.0;
+   }
+
+   /* multipliers at zero cannot decrease further */
+   norm = 0.0;
+   for( location = 0; location < nlocations; ++location )
+   {
+      if( multipliers[location] <= 0.0 && subgradient[location] < 0.0 )
+         subgradient[location] = 0.0;
+      norm += subgradient[location] * subgradient[location];
+   }
+
+   return norm;
+}
+
+
+/*
+ * Interface methods
+ */
+
+/** computes the Lagrangian function value for given multipliers and lower bounds on the cluster values of the
+ *  medians, i.e. the sum of the multipliers plus the nclusters smallest negative median bounds
+ */
+SCIP_RETCODE SCIPcomputeLagrangeBoundCpmp(
+   SCIP*                 scip,               /**< SCIP data structure                                                 */
+   int                   nlocations,         /**< number of locations                                                 */
+   int                   nclusters,          /**< maximal number of clusters                                          */
+   const SCIP_Real*      multipliers,        /**< multipliers of the assignment constraints                           */
+   const SCIP_Real*      medianbounds,       /**< lower bounds on the cluster values of the medians                   */
+   SCIP_Real*            lagrangebound,      /**< pointer to store the Lagrangian bound                               */
+   SCIP_Real*            threshold           /**< pointer to store the nclusters-th smallest median bound, or 0.0 if
+                                              *   it is not negative; may be NULL */
+   )
+{
+   SCIP_Real* sortedbounds;
+   int i;
+
+   assert(lagrangebound != NULL);
+
+   SCIP_CALL( SCIPduplicateBufferArray(scip, &sortedbounds, medianbounds, nlocations) );
+   SCIPsortReal(sortedbounds, nlocations);
+
+   *lagrangebound = 0.0;
+   for( i = 0; i < nlocations; ++i )
+      *lagrangebound += multipliers[i];
+   for( i = 0; i < nclusters && i < nlocations && sortedbounds[i] < 0.0; ++i )
+      *lagrangebound += sortedbounds[i];
+
+   if( threshold != NULL )
+      *threshold = (nclusters > 0 && i == nclusters) ? sortedbounds[nclusters - 1] : 0.0;
+
+   SCIPfreeBufferArray(scip, &sortedbounds);
+
+   return SCIP_OKAY;
+}
+
+/** returns a lower bound on the objective value of all solutions which contain a cluster of a given median, given the
+ *  Lagrangian bound and the nclusters-th smallest median bound
+ */
+SCIP_Real SCIPgetLagrangeMedianBoundCpmp(
+   SCIP_Real             lagrangebound,      /**< Lagrangian bound                                                    */
+   SCIP_Real             threshold,          /**< nclusters-th smallest median bound, or 0.0 if it is not negative    */
+   SCIP_Real             medianbound         /**< lower bound on the cluster values of the median                     */
+   )
+{
+   /* a cluster of the median replaces the worst chosen one; if the median is chosen anyway, this underestimates the
+    * Lagrangian bound, which is still valid
+    */
+   return lagrangebound - threshold + medianbound;
+}
+
+/** maximizes the Lagrangian function by a subgradient method */
+SCIP_RETCODE SCIPsolveLagrangeCpmp(
+   SCIP*                 scip,               /**< SCIP data structure                                                 */
+   CPMP_KNAPSACK*        knapsack,           /**< knapsack solver                                                     */
+   CPMP_SIMDLEVEL        simdlevel,          /**< instruction set for computing the profits                           */
+   SCIP_Bool**           forbidden,          /**< matrix of forbidden assignments, indexed by median and location     */
+   int                   maxiters,           /**< maximal number of subgradient iterations                            */
+   SCIP_Real             timelimit,          /**< time limit in seconds                                               */
+   SCIP_Real             primalbound,        /**< objective value of a known solution, or infinity                   */
+   SCIP_Bool             initialize,         /**< should the starting multipliers be computed instead of given?      */
+   SCIP_Real*            multipliers,        /**< starting multipliers; on return, the best multipliers              */
+   SCIP_Real*            medianbounds,       /**< array to store lower bounds on the cluster values of the medians    */
+   SCIP_Real*            lowerbound,         /**< pointer to store the best Lagrangian bound                          */
+   int*                  niters              /**< pointer to store the number of iterations                           */
+   )
+{
+   int nlocations;
+   int nclusters;
+   SCIP_Longint** distances;
+
+   SCIP_Real* current;                       /* current multipliers                                  */
+   SCIP_Real* currentbounds;                 /* median bounds for the current multipliers            */
+   SCIP_Real* clustervals;                   /* values of the best clusters for the current multipliers */
+   SCIP_Real* subgradient;
+   int* itembuffer;
+   int* itemstarts;
+   int* chosen;
+   int buffersize;
+   SCIP_Real starttime;
+   SCIP_Real stepfactor;
+   int nstalls;
+   int location;
+
+   assert(knapsack != NULL);
+   assert(forbidden != NULL);
+   assert(multipliers != NULL);
+   assert(medianbounds != NULL);
+   assert(lowerbound != NULL);
+   assert(niters != NULL);
+
+   nlocations = SCIPprobdataGetNLocations(scip);
+   nclusters = SCIPprobdataGetNClusters(scip);
+   distances = SCIPprobdataGetDistances(scip);
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &current, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &currentbounds, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &clustervals, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &subgradient, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &itemstarts, nlocations + 1) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &chosen, nlocations) );
+   /* the item buffer grows during the evaluation, so it is not taken from the buffer stack */
+   buffersize = 4 * nlocations;
+   SCIP_CALL( SCIPallocMemoryArray(scip, &itembuffer, buffersize) );
+
+   /* the cheapest way to serve a location other than by itself is a good first guess of its multiplier */
+   if( initialize )
+   {
+      for( location = 0; location < nlocations; ++location )
+      {
+         int median;
+
+         multipliers[location] = SCIPinfinity(scip);
+         for( median = 0; median < nlocations; ++median )
+         {
+            if( median != location && distances[location][median] < multipliers[location] )
+               multipliers[location] = (SCIP_Real)distances[location][median];
+         }
+         if( SCIPisInfinity(scip, multipliers[location]) )
+            multipliers[location] = 0.0;
+      }
+   }
+   BMScopyMemoryArray(current, multipliers, nlocations);
+
+   *lowerbound = -SCIPinfinity(scip);
+   starttime = SCIPgetSolvingTime(scip);
+   stepfactor = STEP_INIT;
+   nstalls = 0;
+
+   for( *niters = 0; *niters < maxiters && !SCIPisStopped(scip); ++(*niters) )
+   {
+      SCIP_Real value;
+      SCIP_Real target;
+      SCIP_Real norm;
+      SCIP_Real step;
+      int nchosen;
+      int i;
+
+      SCIP_CALL( evaluateMedians(scip, knapsack, simdlevel, forbidden, current, currentbounds, clustervals,
+            &itembuffer, &buffersize, itemstarts) );
+      SCIP_CALL( SCIPcomputeLagrangeBoundCpmp(scip, nlocations, nclusters, current, currentbounds, &value, NULL) );
+
+      if( value > *lowerbound )
+      {
+         *lowerbound = value;
+         BMScopyMemoryArray(multipliers, current, nlocations);
+         BMScopyMemoryArray(medianbounds, currentbounds, nlocations);
+         nstalls = 0;
+      }
+      else if( ++nstalls >= STEP_MAXSTALL )
+      {
+         stepfactor /= 2.0;
+         nstalls = 0;
+      }
+
+      SCIPdebugMessage("Lagrange iteration %d: value %g, best %g, step factor %g\n", *niters, value, *lowerbound,
+         stepfactor);
+
+      /* no solution is better than the known one, or no further progress is to be expected */
+      if( (!SCIPisInfinity(scip, primalbound) && SCIPisGE(scip, SCIPceil(scip, *lowerbound), primalbound))
+         || stepfactor < STEP_MIN || SCIPgetSolvingTime(scip) - starttime >= timelimit )
+      {
+         ++(*niters);
+         break;
+      }
+
+      /* choose the clusters of the relaxed solution: the nclusters best ones with negative value */
+      for( i = 0; i < nlocations; ++i )
+         chosen[i] = i;
+      SCIPsortRealInt(clustervals, chosen, nlocations);
+      for( nchosen = 0; nchosen < nclusters && nchosen < nlocations && clustervals[nchosen] < 0.0; ++nchosen );
+
+      norm = computeSubgradient(nlocations, current, chosen, nchosen, itembuffer, itemstarts, subgradient);
+
+      /* the relaxed solution is feasible and hence optimal */
+      if( norm == 0.0 )
+      {
+         ++(*niters);
+         break;
+      }
+
+      if( !SCIPisInfinity(scip, primalbound) )
+         target = primalbound;
+      else
+         target = *lowerbound + MAX(TARGET_REL * REALABS(*lowerbound), 1.0);
+
+      step = stepfactor * MAX(target - value, 0.0) / norm;
+      for( location = 0; location < nlocations; ++location )
+         current[location] = MAX(current[location] + step * subgradient[location], 0.0);
+   }
+
+   SCIPfreeMemoryArray(scip, &itembuffer);
+   SCIPfreeBufferArray(scip, &chosen);
+   SCIPfreeBufferArray(scip, &itemstarts);
+   SCIPfreeBufferArray(scip, &subgradient);
+   SCIPfreeBufferArray(scip, &clustervals);
+   SCIPfreeBufferArray(scip, &currentbounds);
+   SCIPfreeBufferArray(scip, &current);
+
+   return SCIP_OKAY;
+}
@@ -0,0 +1,97 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   lagrange_cpmp.h
+ * @brief  Lagrangian relaxation of the assignment constraints of capacitated p-median problems
+ * @author Christian Puchert
+ *
+ * Relaxing the constraints that each location must be served, with multipliers u >= 0, decomposes the problem into
+ * one knapsack problem per median: its best cluster minimizes the distances minus the multipliers of the locations.
+ * The Lagrangian function is the sum of the multipliers plus the p smallest negative cluster values. It is maximized
+ * by a subgradient method with Polyak step sizes, using the same profit computation and knapsack solver as the
+ * pricer. Since the relaxation is the Lagrangian dual of the master problem, its value is a lower bound on the root
+ * LP value, which is available before any column has been generated. The bounds on the cluster values of each median
+ * additionally allow to decide whether a median can be part of any solution better than a given one.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __CPMP_LAGRANGE_CPMP_H__
+#define __CPMP_LAGRANGE_CPMP_H__
+
+
+#include "scip/scip.h"
+
+#include "knapsack_cpmp.h"
+#include "profits_cpmp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** computes the Lagrangian function value for given multipliers and lower bounds on the cluster values of the
+ *  medians, i.e. the sum of the multipliers plus the nclusters smallest negative median bounds
+ */
+EXTERN
+SCIP_RETCODE SCIPcomputeLagrangeBoundCpmp(
+   SCIP*                 scip,               /**< SCIP data structure                                                 */
+   int                   nlocations,         /**< number of locations                                                 */
+   int                   nclusters,          /**< maximal number of clusters                                          */
+   const SCIP_Real*      multipliers,        /**< multipliers of the assignment constraints                           */
+   const SCIP_Real*      medianbounds,       /**< lower bounds on the cluster values of the medians                   */
+   SCIP_Real*            lagrangebound,      /**< pointer to store the Lagrangian bound                               */
+   SCIP_Real*            threshold           /**< pointer to store the nclusters-th smallest median bound, or 0.0 if
+                                              *   it is not negative; may be NULL */
+   );
+
+/** returns a lower bound on the objective value of all solutions which contain a cluster of a given median, given the
+ *  Lagrangian bound and the nclusters-th smallest median bound
+ */
+EXTERN
+SCIP_Real SCIPgetLagrangeMedianBoundCpmp(
+   SCIP_Real             lagrangebound,      /**< Lagrangian bound                                                    */
+   SCIP_Real             threshold,          /**< nclusters-th smallest median bound, or 0.0 if it is not negative    */
+   SCIP_Real             medianbound         /**< lower bound on the cluster values of the median                     */
+   );
+
+/** maximizes the Lagrangian function by a subgradient method
+ *
+ *  The method starts from the multipliers given, or, if initialize is TRUE, from the distance of each location to its
+ *  closest other location. It stops after maxiters iterations, if the time limit or the minimal step length is
+ *  reached, or if the bound proves that no solution is better than the primal bound. On return, multipliers contains
+ *  the best multipliers found, lowerbound their Lagrangian value, and medianbounds the corresponding lower bounds on
+ *  the cluster values of the medians.
+ */
+EXTERN
+SCIP_RETCODE SCIPsolveLagrangeCpmp(
+   SCIP*                 scip,               /**< SCIP data structure                                                 */
+   CPMP_KNAPSACK*        knapsack,           /**< knapsack solver                                                     */
+   CPMP_SIMDLEVEL        simdlevel,          /**< instruction set for computing the profits                           */
+   SCIP_Bool**           forbidden,          /**< matrix of forbidden assignments, indexed by median and location     */
+   int                   maxiters,           /**< maximal number of subgradient iterations                            */
+   SCIP_Real             timelimit,          /**< time limit in seconds                                               */
+   SCIP_Real             primalbound,        /**< objective value of a known solution, or infinity                   */
+   SCIP_Bool             initialize,         /**< should the starting multipliers be computed instead of given?      */
+   SCIP_Real*            multipliers,        /**< starting multipliers; on return, the best multipliers              */
+   SCIP_Real*            medianbounds,       /**< array to store lower bounds on the cluster values of the medians    */
+   SCIP_Real*            lowerbound,         /**< pointer to store the best Lagrangian bound                          */
+   int*                  niters              /**< pointer to store the number of iterations                           */
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
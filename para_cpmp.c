@@ -0,0 +1,1150 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   para_cpmp.c
+ * @brief  parallel branch-and-price tree search for the capacitated p-median problem
+ * @author Christian Puchert
+ *
+ * A subtree is serialized into one integer array: its restrictions as described in subtree_cpmp.h, followed by
+ * [ncolumns, column, ...] where a column is [median, nlocations, locations ...].
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <pthread.h>
+#include <string.h>
+
+#include "cons_median.h"
+#include "cons_samediff.h"
+#include "cpmpplugins.h"
+#include "para_cpmp.h"
+#include "pricer_cpmp.h"
+#include "probdata.h"
+#include "pub_probdata.h"
+#include "pub_vardata.h"
+#include "subtree_cpmp.h"
+
+
+#define HEUR_NAME             "cpmppara"
+#define HEUR_DESC             "subtree setup, load balancing and solution exchange of parallel cpmp workers"
+#define HEUR_DISPCHAR         'P'
+#define HEUR_PRIORITY         1000000
+#define HEUR_FREQ             1
+#define HEUR_FREQOFS          0
+#define HEUR_MAXDEPTH         -1
+#define HEUR_TIMING           (SCIP_HEURTIMING_BEFORENODE | SCIP_HEURTIMING_DURINGPRICINGLOOP | SCIP_HEURTIMING_AFTERNODE)
+#define HEUR_USESSUBSCIP      FALSE  /**< does the heuristic use a secondary SCIP instance? */
+
+#define PARA_MAXWORKERS        256      /**< maximal number of workers                                                  */
+
+
+/*
+ * Data structures
+ */
+
+/** open subtree */
+struct ParaSubtree
+{
+   int*                  data;               /* serialized restrictions and columns                                         */
+   int                   colstart;           /* position of the number of columns in data                                   */
+   SCIP_Real             lowerbound;         /* lower bound of the subtree                                                  */
+};
+typedef struct ParaSubtree PARASUBTREE;
+
+/** pool shared by the workers */
+struct ParaPool
+{
+   pthread_mutex_t       mutex;              /* mutex protecting all other members except the constant ones                 */
+   pthread_cond_t        cond;               /* condition signaled when subtrees are queued or the search ends              */
+   SCIP*                 scip;               /* SCIP data structure with the problem (constant)                             */
+   SCIP_CLOCK*           clock;              /* wall clock of the search, started before the workers (constant)             */
+   SCIP_Real             timelimit;          /* time limit of the search (constant)                                         */
+   SCIP_Bool             stop;               /* should the workers stop?                                                    */
+   SCIP_Bool             finished;           /* has the whole tree been searched?                                           */
+   SCIP_RETCODE          retcode;            /* first error of a worker                                                     */
+
+   PARASUBTREE**         queue;              /* open subtrees which are not taken by a worker                               */
+   int                   nqueued;            /* number of queued subtrees                                                   */
+   int                   queuesize;          /* size of the queue                                                           */
+   int                   maxqueued;          /* maximal number of queued subtrees                                           */
+   int                   nidle;              /* number of workers waiting for a subtree                                     */
+   int                   nbusy;              /* number of workers solving a subtree                                         */
+   SCIP_Real             openbound;          /* smallest lower bound of the subtrees which were interrupted                 */
+   int                   nsolved;            /* number of subtrees solved completely                                        */
+   int                   npruned;            /* number of queued subtrees pruned by the incumbent                           */
+
+   SCIP_Real             bestobj;            /* objective value of the best solution                                        */
+   int                   bestworker;         /* worker which found the best solution, or -1                                 */
+   int*                  bestmedians;        /* medians of the clusters of the best solution                                */
+   int*                  bestbeg;            /* start of the locations of each cluster, and their total number at the end   */
+   int*                  bestlocations;      /* locations of the clusters of the best solution                              */
+   int                   nbestclusters;      /* number of clusters of the best solution                                     */
+};
+typedef struct ParaPool PARAPOOL;
+
+/** worker of the parallel search */
+struct ParaWorker
+{
+   SCIP*                 scip;               /* SCIP of the worker                                                          */
+   PARAPOOL*             pool;               /* pool shared by the workers                                                  */
+   int                   index;              /* index of the worker                                                         */
+   pthread_t             thread;             /* thread of the worker                                                        */
+   int                   nsubtrees;          /* number of subtrees the worker took                                          */
+   SCIP_Longint          nnodes;             /* number of nodes the worker processed                                        */
+   SCIP_Real             time;               /* time the worker spent solving subtrees                                      */
+};
+typedef struct ParaWorker PARAWORKER;
+
+/** primal heuristic data of the parallel heuristic of a worker */
+struct SCIP_HeurData
+{
+   PARAPOOL*             pool;               /* pool shared by the workers                                                  */
+   int                   worker;             /* index of the worker                                                         */
+   int                   maxsubtreecols;     /* maximal number of columns sent along with a subtree                         */
+   PARASUBTREE*          subtree;            /* subtree which is solved, or NULL                                            */
+   SCIP_Bool             applied;            /* have the restrictions of the subtree been added to the root?                */
+   SCIP_Real             exportedobj;        /* objective value of the last published solution                              */
+   int                   ndonated;           /* number of subtrees handed over                                              */
+   int                   nsolsexported;      /* number of solutions published                                               */
+   int                   nsolsimported;      /* number of solutions taken over from the pool                                */
+};
+
+
+/*
+ * Local methods
+ */
+
+/** ensures that an integer array can hold the given number of entries */
+static
+SCIP_RETCODE ensureDataSize(
+   int**                 data,               /* pointer to the array                                 */
+   int*                  size,               /* pointer to the size of the array                     */
+   int                   needed              /* number of entries needed                             */
+   )
+{
+   if( needed > *size )
+   {
+      int newsize;
+
+      newsize = MAX(2 * *size, needed);
+      SCIP_ALLOC( BMSreallocMemoryArray(data, newsize) );
+      *size = newsize;
+   }
+
+   return SCIP_OKAY;
+}
+
+/** frees a subtree */
+static
+void freeSubtree(
+   PARASUBTREE**         subtree             /* pointer to the subtree                               */
+   )
+{
+   BMSfreeMemoryArray(&(*subtree)->data);
+   BMSfreeMemory(subtree);
+}
+
+/** queues a subtree and wakes up the idle workers; the pool mutex must be held */
+static
+SCIP_RETCODE pushSubtree(
+   PARAPOOL*             pool,               /* pool                                                 */
+   PARASUBTREE*          subtree             /* subtree                                              */
+   )
+{
+   if( pool->nqueued >= pool->queuesize )
+   {
+      int newsize;
+
+      newsize = MAX(2 * pool->queuesize, 64);
+      SCIP_ALLOC( BMSreallocMemoryArray(&pool->queue, newsize) );
+      pool->queuesize = newsize;
+   }
+
+   pool->queue[pool->nqueued++] = subtree;
+   pool->maxqueued = MAX(pool->maxqueued, pool->nqueued);
+   (void) pthread_cond_broadcast(&pool->cond);
+
+   return SCIP_OKAY;
+}
+
+/** removes the queued subtree with the smallest lower bound from the queue; the pool mutex must be held */
+static
+PARASUBTREE* popSubtree(
+   PARAPOOL*             pool                /* pool                                                 */
+   )
+{
+   PARASUBTREE* subtree;
+   int best;
+   int i;
+
+   assert(pool->nqueued > 0);
+
+   best = 0;
+   for( i = 1; i < pool->nqueued; ++i )
+   {
+      if( pool->queue[i]->lowerbound < pool->queue[best]->lowerbound )
+         best = i;
+   }
+
+   subtree = pool->queue[best];
+   pool->queue[best] = pool->queue[--pool->nqueued];
+
+   return subtree;
+}
+
+/** creates the pool with the whole problem as the only subtree */
+static
+SCIP_RETCODE createPool(
+   SCIP*                 scip,               /* SCIP data structure with the problem                 */
+   PARAPOOL**            pool                /* pointer to store the pool                            */
+   )
+{
+   PARASUBTREE* root;
+
+   SCIP_ALLOC( BMSallocMemory(pool) );
+   BMSclearMemory(*pool);
+
+   (*pool)->scip = scip;
+   (*pool)->retcode = SCIP_OKAY;
+   (*pool)->openbound = SCIPinfinity(scip);
+   (*pool)->bestobj = SCIP_REAL_MAX;
+   (*pool)->bestworker = -1;
+   SCIP_CALL( SCIPgetRealParam(scip, "limits/time", &(*pool)->timelimit) );
+   SCIP_CALL( SCIPcreateWallClock(scip, &(*pool)->clock) );
+
+   (void) pthread_mutex_init(&(*pool)->mutex, NULL);
+   (void) pthread_cond_init(&(*pool)->cond, NULL);
+
+   /* no restrictions and no columns */
+   SCIP_ALLOC( BMSallocMemory(&root) );
+   SCIP_ALLOC( BMSallocMemoryArray(&root->data, 2) );
+   root->data[0] = 0;
+   root->data[1] = 0;
+   root->colstart = 1;
+   root->lowerbound = -SCIPinfinity(scip);
+   SCIP_CALL( pushSubtree(*pool, root) );
+
+   return SCIP_OKAY;
+}
+
+/** frees the pool and the subtrees left in it */
+static
+SCIP_RETCODE freePool(
+   SCIP*                 scip,               /* SCIP data structure with the problem                 */
+   PARAPOOL**            pool                /* pointer to the pool                                  */
+   )
+{
+   while( (*pool)->nqueued > 0 )
+      freeSubtree(&(*pool)->queue[--(*pool)->nqueued]);
+
+   (void) pthread_cond_destroy(&(*pool)->cond);
+   (void) pthread_mutex_destroy(&(*pool)->mutex);
+
+   SCIP_CALL( SCIPfreeClock(scip, &(*pool)->clock) );
+
+   BMSfreeMemoryArrayNull(&(*pool)->queue);
+   BMSfreeMemoryArrayNull(&(*pool)->bestlocations);
+   BMSfreeMemoryArrayNull(&(*pool)->bestbeg);
+   BMSfreeMemoryArrayNull(&(*pool)->bestmedians);
+   BMSfreeMemory(pool);
+
+   return SCIP_OKAY;
+}
+
+/** appends the columns of the worker which comply with serialized restrictions, at most maxcols of them: first those
+ *  of the current LP, then the most recent ones
+ */
+static
+SCIP_RETCODE serializeColumns(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   int                   maxcols,            /* maximal number of columns                            */
+   int**                 data,               /* pointer to the serialized restrictions               */
+   int*                  ndata,              /* pointer to the number of entries of data             */
+   int*                  size                /* pointer to the size of data                          */
+   )
+{
+   SCIP_VAR** vars;
+   SCIP_Bool* closed;
+   SCIP_Bool* forbidden;
+   int* restrictions;
+   int nrestrictions;
+   int nlocations;
+   int colstart;
+   int ncols;
+   int nvars;
+   int pass;
+   int pos;
+   int r;
+
+   vars = SCIPgetVars(scip);
+   nvars = SCIPgetNVars(scip);
+   nlocations = SCIPprobdataGetNLocations(scip);
+   colstart = *ndata;
+
+   /* the restrictions as closed medians, the positions of the other restrictions and, for each of them that is a
+    * semiassign restriction, its forbidden medians
+    */
+   nrestrictions = MAX((*data)[0], 1);
+   SCIP_CALL( SCIPallocClearBufferArray(scip, &closed, nlocations) );
+   SCIP_CALL( SCIPallocClearBufferArray(scip, &forbidden, nrestrictions * nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &restrictions, nrestrictions) );
+
+   nrestrictions = 0;
+   pos = 1;
+   for( r = 0; r < (*data)[0]; ++r )
+   {
+      if( (*data)[pos] == (int)CPMP_RESTRICTION_SEMIASSIGN )
+      {
+         int i;
+
+         for( i = 0; i < (*data)[pos + 2]; ++i )
+            forbidden[nrestrictions * nlocations + (*data)[pos + 3 + i]] = TRUE;
+         restrictions[nrestrictions++] = pos;
+      }
+      else if( (*data)[pos] == (int)CPMP_RESTRICTION_SAMEDIFF )
+         restrictions[nrestrictions++] = pos;
+      else if( (*data)[pos + 2] == (int)CPMP_MEDIAN_CLOSED )
+         closed[(*data)[pos + 1]] = TRUE;
+      pos = SCIPnextRestrictionCpmp(*data, pos);
+   }
+
+   SCIP_CALL( ensureDataSize(data, size, *ndata + 1) );
+   ++(*ndata);
+
+   ncols = 0;
+   for( pass = 0; pass < 2 && ncols < maxcols; ++pass )
+   {
+      int v;
+
+      for( v = nvars - 1; v >= 0 && ncols < maxcols; --v )
+      {
+         int median;
+
+         if( SCIPvarIsInLP(vars[v]) != (pass == 0) || SCIPvarGetUbGlobal(vars[v]) < 0.5 )
+            continue;
+
+         median = SCIPvarGetMedian(vars[v]);
+         if( closed[median] )
+            continue;
+         for( r = 0; r < nrestrictions; ++r )
+         {
+            int* restriction;
+
+            restriction = &(*data)[restrictions[r]];
+            if( restriction[0] == (int)CPMP_RESTRICTION_SEMIASSIGN )
+            {
+               if( forbidden[r * nlocations + median] && SCIPisLocationInCluster(vars[v], restriction[1]) )
+                  break;
+            }
+            else
+            {
+               SCIP_Bool contains1;
+               SCIP_Bool contains2;
+
+               /* a same restriction is violated by a column with only one of the locations, a differ restriction by a
+                * column with both of them
+                */
+               contains1 = SCIPisLocationInCluster(vars[v], restriction[1]);
+               contains2 = SCIPisLocationInCluster(vars[v], restriction[2]);
+               if( restriction[3] == (int)CPMP_SAMEDIFF_SAME ? contains1 != contains2 : contains1 && contains2 )
+                  break;
+            }
+         }
+         if( r < nrestrictions )
+            continue;
+
+         SCIP_CALL( ensureDataSize(data, size, *ndata + 2 + SCIPvarGetNLocations(vars[v])) );
+         (*data)[*ndata] = median;
+         (*data)[*ndata + 1] = SCIPvarGetNLocations(vars[v]);
+         BMScopyMemoryArray(&(*data)[*ndata + 2], SCIPvarGetLocations(vars[v]), SCIPvarGetNLocations(vars[v]));
+         *ndata += 2 + SCIPvarGetNLocations(vars[v]);
+         ++ncols;
+      }
+   }
+   (*data)[colstart] = ncols;
+
+   SCIPfreeBufferArray(scip, &restrictions);
+   SCIPfreeBufferArray(scip, &forbidden);
+   SCIPfreeBufferArray(scip, &closed);
+
+   return SCIP_OKAY;
+}
+
+/** serializes the subtree of an open node of the worker */
+static
+SCIP_RETCODE serializeSubtree(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_HEURDATA*        heurdata,           /* data of the parallel heuristic                       */
+   SCIP_NODE*            node,               /* open node                                            */
+   PARASUBTREE**         subtree             /* pointer to store the subtree                         */
+   )
+{
+   int ndata;
+   int size;
+
+   SCIP_ALLOC( BMSallocMemory(subtree) );
+   (*subtree)->lowerbound = SCIPnodeGetLowerbound(node);
+
+   /* the restrictions of the subtree of the worker come first */
+   ndata = heurdata->subtree->colstart;
+   size = ndata + 64;
+   SCIP_ALLOC( BMSallocMemoryArray(&(*subtree)->data, size) );
+   BMScopyMemoryArray((*subtree)->data, heurdata->subtree->data, ndata);
+
+   SCIP_CALL( SCIPserializePathCpmp(scip, node, &(*subtree)->data, &ndata, &size) );
+   (*subtree)->colstart = ndata;
+
+   SCIP_CALL( serializeColumns(scip, heurdata->maxsubtreecols, &(*subtree)->data, &ndata, &size) );
+
+   return SCIP_OKAY;
+}
+
+/** hands open nodes with the best lower bounds over to the pool while fewer subtrees are queued than workers are idle;
+ *  the handed over nodes are cut off, and at least one open node is kept
+ */
+static
+SCIP_RETCODE donateSubtrees(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_HEURDATA*        heurdata            /* data of the parallel heuristic                       */
+   )
+{
+   PARAPOOL* pool;
+   SCIP_NODE** leaves;
+   SCIP_NODE** children;
+   SCIP_NODE** siblings;
+   SCIP_NODE** nodes;
+   SCIP_Real* bounds;
+   int nleaves;
+   int nchildren;
+   int nsiblings;
+   int nnodes;
+   int ndonate;
+   int i;
+
+   pool = heurdata->pool;
+
+   (void) pthread_mutex_lock(&pool->mutex);
+   ndonate = pool->nidle - pool->nqueued;
+   (void) pthread_mutex_unlock(&pool->mutex);
+   if( ndonate <= 0 || SCIPgetNNodesLeft(scip) < 2 )
+      return SCIP_OKAY;
+
+   SCIP_CALL( SCIPgetOpenNodesData(scip, &leaves, &children, &siblings, &nleaves, &nchildren, &nsiblings) );
+   nnodes = nleaves + nchildren + nsiblings;
+   if( nnodes < 2 )
+      return SCIP_OKAY;
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &nodes, nnodes) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &bounds, nnodes) );
+   BMScopyMemoryArray(nodes, leaves, nleaves);
+   BMScopyMemoryArray(&nodes[nleaves], children, nchildren);
+   BMScopyMemoryArray(&nodes[nleaves + nchildren], siblings, nsiblings);
+   for( i = 0; i < nnodes; ++i )
+      bounds[i] = SCIPnodeGetLowerbound(nodes[i]);
+   SCIPsortRealPtr(bounds, (void**)nodes, nnodes);
+
+   ndonate = MIN(ndonate, nnodes - 1);
+   for( i = 0; i < nnodes && ndonate > 0; ++i )
+   {
+      PARASUBTREE* subtree;
+      SCIP_RETCODE retcode;
+
+      /* the node is pruned anyway */
+      if( SCIPisGE(scip, bounds[i], SCIPgetCutoffbound(scip)) )
+         break;
+
+      SCIP_CALL( serializeSubtree(scip, heurdata, nodes[i], &subtree) );
+
+      (void) pthread_mutex_lock(&pool->mutex);
+      retcode = pushSubtree(pool, subtree);
+      (void) pthread_mutex_unlock(&pool->mutex);
+      if( retcode != SCIP_OKAY )
+      {
+         freeSubtree(&subtree);
+         SCIP_CALL( retcode );
+      }
+
+      SCIP_CALL( SCIPcutoffNode(scip, nodes[i]) );
+      ++heurdata->ndonated;
+      --ndonate;
+   }
+
+   SCIPfreeBufferArray(scip, &bounds);
+   SCIPfreeBufferArray(scip, &nodes);
+
+   return SCIP_OKAY;
+}
+
+/** publishes the best solution of the worker if it improved since the last call */
+static
+SCIP_RETCODE exportSolution(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_HEUR*            heur,               /* parallel heuristic                                   */
+   SCIP_HEURDATA*        heurdata            /* data of the parallel heuristic                       */
+   )
+{
+   PARAPOOL* pool;
+   SCIP_SOL* sol;
+   SCIP_VAR** vars;
+   SCIP_Real obj;
+   int* medians;
+   int* beg;
+   int* locations;
+   int nlocations;
+   int nclusters;
+   int nvars;
+   int v;
+
+   sol = SCIPgetBestSol(scip);
+
+   /* solutions taken from the pool are not published again */
+   if( sol == NULL || SCIPsolGetHeur(sol) == heur )
+      return SCIP_OKAY;
+
+   obj = SCIPgetSolOrigObj(scip, sol);
+   if( !SCIPisLT(scip, obj, heurdata->exportedobj) )
+      return SCIP_OKAY;
+   heurdata->exportedobj = obj;
+
+   vars = SCIPgetVars(scip);
+   nvars = SCIPgetNVars(scip);
+   nlocations = SCIPprobdataGetNLocations(scip);
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &medians, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &beg, nlocations + 1) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &locations, nlocations) );
+
+   /* a solution covering locations several times, which would not fit into the arrays, is not published */
+   nclusters = 0;
+   beg[0] = 0;
+   for( v = 0; v < nvars; ++v )
+   {
+      int nclusterlocations;
+
+      if( SCIPgetSolVal(scip, sol, vars[v]) < 0.5 )
+         continue;
+
+      nclusterlocations = SCIPvarGetNLocations(vars[v]);
+      if( nclusters >= nlocations || beg[nclusters] + nclusterlocations > nlocations )
+         break;
+
+      medians[nclusters] = SCIPvarGetMedian(vars[v]);
+      BMScopyMemoryArray(&locations[beg[nclusters]], SCIPvarGetLocations(vars[v]), nclusterlocations);
+      beg[nclusters + 1] = beg[nclusters] + nclusterlocations;
+      ++nclusters;
+   }
+
+   if( v == nvars )
+   {
+      pool = heurdata->pool;
+
+      (void) pthread_mutex_lock(&pool->mutex);
+      if( obj < pool->bestobj )
+      {
+         if( pool->bestmedians == NULL )
+         {
+            if( BMSallocMemoryArray(&pool->bestmedians, nlocations) == NULL
+               || BMSallocMemoryArray(&pool->bestbeg, nlocations + 1) == NULL
+               || BMSallocMemoryArray(&pool->bestlocations, nlocations) == NULL )
+            {
+               (void) pthread_mutex_unlock(&pool->mutex);
+               return SCIP_NOMEMORY;
+            }
+         }
+
+         BMScopyMemoryArray(pool->bestmedians, medians, nclusters);
+         BMScopyMemoryArray(pool->bestbeg, beg, nclusters + 1);
+         BMScopyMemoryArray(pool->bestlocations, locations, beg[nclusters]);
+         pool->nbestclusters = nclusters;
+         pool->bestobj = obj;
+         pool->bestworker = heurdata->worker;
+         ++heurdata->nsolsexported;
+      }
+      (void) pthread_mutex_unlock(&pool->mutex);
+   }
+
+   SCIPfreeBufferArray(scip, &locations);
+   SCIPfreeBufferArray(scip, &beg);
+   SCIPfreeBufferArray(scip, &medians);
+
+   return SCIP_OKAY;
+}
+
+/** takes over the best solution of the pool if it is better than the incumbent of the worker; the solution need not
+ *  comply with the restrictions of the subtree, but it is feasible for the original problem, which is all that counts
+ *  for pruning
+ */
+static
+SCIP_RETCODE importSolution(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_HEUR*            heur,               /* parallel heuristic                                   */
+   SCIP_HEURDATA*        heurdata,           /* data of the parallel heuristic                       */
+   SCIP_RESULT*          result              /* pointer to store the result                          */
+   )
+{
+   PARAPOOL* pool;
+   SCIP_SOL* sol;
+   SCIP_Bool stored;
+   SCIP_Real obj;
+   int* medians;
+   int* beg;
+   int* locations;
+   int nclusters;
+   int nlocations;
+   int c;
+
+   pool = heurdata->pool;
+   nlocations = SCIPprobdataGetNLocations(scip);
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &medians, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &beg, nlocations + 1) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &locations, nlocations) );
+
+   (void) pthread_mutex_lock(&pool->mutex);
+   nclusters = 0;
+   obj = pool->bestobj;
+   if( pool->bestmedians != NULL && SCIPisLT(scip, obj, SCIPgetPrimalbound(scip)) )
+   {
+      nclusters = pool->nbestclusters;
+      BMScopyMemoryArray(medians, pool->bestmedians, nclusters);
+      BMScopyMemoryArray(beg, pool->bestbeg, nclusters + 1);
+      BMScopyMemoryArray(locations, pool->bestlocations, pool->bestbeg[nclusters]);
+   }
+   (void) pthread_mutex_unlock(&pool->mutex);
+
+   if( nclusters > 0 )
+   {
+      SCIP_CALL( SCIPcreateSol(scip, &sol, heur) );
+
+      /* the worker may already have a column of a cluster, e.g. one sent along with the subtree */
+      for( c = 0; c < nclusters; ++c )
+      {
+         SCIP_VAR* var;
+
+         var = SCIPfindClusterVar(scip, medians[c], &locations[beg[c]], beg[c + 1] - beg[c]);
+         if( var != NULL )
+         {
+            SCIP_CALL( SCIPsetSolVal(scip, sol, var, 1.0) );
+         }
+         else
+         {
+            SCIP_CALL( SCIPpricerCpmpAddColumn(scip, medians[c], &locations[beg[c]], beg[c + 1] - beg[c], &var) );
+            SCIP_CALL( SCIPsetSolVal(scip, sol, var, 1.0) );
+            SCIP_CALL( SCIPreleaseVar(scip, &var) );
+         }
+      }
+
+      /* the bounds are not checked, since columns violating the restrictions are fixed to zero */
+      SCIP_CALL( SCIPtrySolFree(scip, &sol, FALSE, FALSE, FALSE, TRUE, TRUE, &stored) );
+      if( stored )
+      {
+         ++heurdata->nsolsimported;
+         *result = SCIP_FOUNDSOL;
+      }
+
+      /* do not publish the solution of another worker as own solution */
+      heurdata->exportedobj = MIN(heurdata->exportedobj, obj);
+   }
+
+   SCIPfreeBufferArray(scip, &locations);
+   SCIPfreeBufferArray(scip, &beg);
+   SCIPfreeBufferArray(scip, &medians);
+
+   return SCIP_OKAY;
+}
+
+
+/*
+ * Callback methods of primal heuristic
+ */
+
+/** destructor of primal heuristic to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_HEURFREE(heurFreeCpmppara)
+{  /*lint --e{715}*/
+   SCIP_HEURDATA* heurdata;
+
+   heurdata = SCIPheurGetData(heur);
+   assert(heurdata != NULL);
+
+   SCIPfreeBlockMemory(scip, &heurdata);
+   SCIPheurSetData(heur, NULL);
+
+   return SCIP_OKAY;
+}
+
+/** solving process initialization method of primal heuristic (called when branch and bound process is about to begin) */
+static
+SCIP_DECL_HEURINITSOL(heurInitsolCpmppara)
+{  /*lint --e{715}*/
+   SCIP_HEURDATA* heurdata;
+
+   heurdata = SCIPheurGetData(heur);
+   assert(heurdata != NULL);
+
+   heurdata->applied = FALSE;
+   heurdata->exportedobj = SCIPinfinity(scip);
+
+   return SCIP_OKAY;
+}
+
+/** execution method of primal heuristic */
+static
+SCIP_DECL_HEUREXEC(heurExecCpmppara)
+{  /*lint --e{715}*/
+   SCIP_HEURDATA* heurdata;
+   PARAPOOL* pool;
+   SCIP_Bool stop;
+
+   heurdata = SCIPheurGetData(heur);
+   assert(heurdata != NULL);
+   assert(heurdata->subtree != NULL);
+
+   pool = heurdata->pool;
+
+   *result = SCIP_DIDNOTRUN;
+
+   (void) pthread_mutex_lock(&pool->mutex);
+   if( !pool->stop && SCIPgetClockTime(pool->scip, pool->clock) >= pool->timelimit )
+   {
+      pool->stop = TRUE;
+      (void) pthread_cond_broadcast(&pool->cond);
+   }
+   stop = pool->stop;
+   (void) pthread_mutex_unlock(&pool->mutex);
+
+   /* the time limit is hit or another worker failed */
+   if( stop )
+   {
+      SCIP_CALL( SCIPinterruptSolve(scip) );
+      return SCIP_OKAY;
+   }
+
+   /* the first call is at the root, before its LP is solved */
+   if( !heurdata->applied )
+   {
+      assert(SCIPgetDepth(scip) == 0);
+      SCIP_CALL( SCIPapplyRestrictionsCpmp(scip, SCIPgetCurrentNode(scip), heurdata->subtree->data, "subtree") );
+      heurdata->applied = TRUE;
+   }
+
+   *result = SCIP_DIDNOTFIND;
+
+   SCIP_CALL( exportSolution(scip, heur, heurdata) );
+   SCIP_CALL( importSolution(scip, heur, heurdata, result) );
+
+   if( heurtiming & SCIP_HEURTIMING_AFTERNODE )
+   {
+      SCIP_CALL( donateSubtrees(scip, heurdata) );
+   }
+
+   return SCIP_OKAY;
+}
+
+/** includes the parallel heuristic of a worker in its SCIP */
+static
+SCIP_RETCODE includeHeurCpmppara(
+   SCIP*                 scip,               /* SCIP data structure of the worker                    */
+   PARAPOOL*             pool,               /* pool shared by the workers                           */
+   int                   worker,             /* index of the worker                                  */
+   int                   maxsubtreecols      /* maximal number of columns sent along with a subtree  */
+   )
+{
+   SCIP_HEURDATA* heurdata;
+   SCIP_HEUR* heur;
+
+   SCIP_CALL( SCIPallocBlockMemory(scip, &heurdata) );
+   BMSclearMemory(heurdata);
+   heurdata->pool = pool;
+   heurdata->worker = worker;
+   heurdata->maxsubtreecols = maxsubtreecols;
+
+   SCIP_CALL( SCIPincludeHeurBasic(scip, &heur, HEUR_NAME, HEUR_DESC, HEUR_DISPCHAR, HEUR_PRIORITY, HEUR_FREQ,
+         HEUR_FREQOFS, HEUR_MAXDEPTH, HEUR_TIMING, HEUR_USESSUBSCIP, heurExecCpmppara, heurdata) );
+   assert(heur != NULL);
+
+   SCIP_CALL( SCIPsetHeurFree(scip, heur, heurFreeCpmppara) );
+   SCIP_CALL( SCIPsetHeurInitsol(scip, heur, heurInitsolCpmppara) );
+
+   return SCIP_OKAY;
+}
+
+
+/*
+ * Parallel search
+ */
+
+/** creates the SCIP of a worker with the cpmp plugins, the parallel heuristic and the settings of the given SCIP */
+static
+SCIP_RETCODE createWorker(
+   SCIP*                 scip,               /* SCIP data structure with the problem                 */
+   PARAWORKER*           worker,             /* worker                                               */
+   int                   maxsubtreecols      /* maximal number of columns sent along with a subtree  */
+   )
+{
+   SCIP_CALL( SCIPcreate(&worker->scip) );
+   SCIP_CALL( SCIPincludeCpmpPlugins(worker->scip) );
+   SCIP_CALL( includeHeurCpmppara(worker->scip, worker->pool, worker->index, maxsubtreecols) );
+   SCIP_CALL( SCIPcopyParamSettings(scip, worker->scip) );
+
+   /* the time limit is checked by the parallel heuristic for the whole search */
+   SCIP_CALL( SCIPsetRealParam(worker->scip, "limits/time", SCIPinfinity(worker->scip)) );
+
+   /* the other limits would stop the subtrees early, and a stopped subtree leaves the search incomplete */
+   SCIP_CALL( SCIPresetParam(worker->scip, "limits/nodes") );
+   SCIP_CALL( SCIPresetParam(worker->scip, "limits/totalnodes") );
+   SCIP_CALL( SCIPresetParam(worker->scip, "limits/stallnodes") );
+   SCIP_CALL( SCIPresetParam(worker->scip, "limits/memory") );
+   SCIP_CALL( SCIPresetParam(worker->scip, "limits/gap") );
+   SCIP_CALL( SCIPresetParam(worker->scip, "limits/absgap") );
+   SCIP_CALL( SCIPresetParam(worker->scip, "limits/solutions") );
+   SCIP_CALL( SCIPresetParam(worker->scip, "limits/bestsol") );
+
+   /* the workers would all write to the same checkpoint, trace and capture files */
+   SCIP_CALL( SCIPsetStringParam(worker->scip, "cpmp/checkpoint/file", "") );
+   SCIP_CALL( SCIPsetStringParam(worker->scip, "pricers/cpmp/tracefile", "") );
+   SCIP_CALL( SCIPsetStringParam(worker->scip, "pricers/cpmp/capturefile", "") );
+
+   /* the workers would only interleave their logs; the result table is printed at the end */
+   SCIPsetMessagehdlrQuiet(worker->scip, TRUE);
+
+   return SCIP_OKAY;
+}
+
+/** solves a subtree as a problem of its own with the SCIP of a worker */
+static
+SCIP_RETCODE solveSubtree(
+   PARAWORKER*           worker,             /* worker                                               */
+   PARASUBTREE*          subtree             /* subtree                                              */
+   )
+{
+   SCIP_HEURDATA* heurdata;
+   PARAPOOL* pool;
+   SCIP* scip;
+   SCIP_Real bestobj;
+   int* data;
+   int pos;
+   int c;
+
+   scip = worker->scip;
+   pool = worker->pool;
+   data = subtree->data;
+
+   assert(SCIPgetStage(scip) == SCIP_STAGE_INIT);
+
+   SCIP_CALL( SCIPcreateProbBasic(scip, SCIPgetProbName(pool->scip)) );
+   SCIP_CALL( SCIPcreateProbCpmpShared(scip, pool->scip) );
+
+   /* the columns sent along with the subtree */
+   pos = subtree->colstart + 1;
+   for( c = 0; c < data[subtree->colstart]; ++c )
+   {
+      SCIP_VAR* var;
+
+      SCIP_CALL( SCIPpricerCpmpAddColumn(scip, data[pos], &data[pos + 2], data[pos + 1], &var) );
+      SCIP_CALL( SCIPreleaseVar(scip, &var) );
+      pos += 2 + data[pos + 1];
+   }
+
+   /* only solutions better than the incumbent are of interest */
+   (void) pthread_mutex_lock(&pool->mutex);
+   bestobj = pool->bestobj;
+   (void) pthread_mutex_unlock(&pool->mutex);
+   if( bestobj < SCIP_REAL_MAX )
+   {
+      SCIP_CALL( SCIPsetObjlimit(scip, bestobj) );
+   }
+
+   heurdata = SCIPheurGetData(SCIPfindHeur(scip, HEUR_NAME));
+   assert(heurdata != NULL);
+   heurdata->subtree = subtree;
+
+   SCIP_CALL( SCIPsolve(scip) );
+
+   ++worker->nsubtrees;
+   worker->nnodes += SCIPgetNTotalNodes(scip);
+   worker->time += SCIPgetSolvingTime(scip);
+
+   (void) pthread_mutex_lock(&pool->mutex);
+   if( SCIPgetStatus(scip) == SCIP_STATUS_OPTIMAL || SCIPgetStatus(scip) == SCIP_STATUS_INFEASIBLE )
+      ++pool->nsolved;
+   else
+      pool->openbound = MIN(pool->openbound, MAX(subtree->lowerbound, SCIPgetDualbound(scip)));
+   (void) pthread_mutex_unlock(&pool->mutex);
+
+   heurdata->subtree = NULL;
+   SCIP_CALL( SCIPfreeProb(scip) );
+
+   return SCIP_OKAY;
+}
+
+/** thread function of a worker: solves queued subtrees until the tree is searched or the search is stopped */
+static
+void* workerThread(
+   void*                 arg                 /* worker                                               */
+   )
+{
+   PARAWORKER* worker;
+   PARAPOOL* pool;
+
+   worker = (PARAWORKER*)arg;
+   pool = worker->pool;
+
+   (void) pthread_mutex_lock(&pool->mutex);
+   while( TRUE ) /*lint !e716*/
+   {
+      PARASUBTREE* subtree;
+      SCIP_RETCODE retcode;
+
+      while( !pool->stop && pool->nqueued == 0 && pool->nbusy > 0 )
+      {
+         ++pool->nidle;
+         (void) pthread_cond_wait(&pool->cond, &pool->mutex);
+         --pool->nidle;
+      }
+
+      if( pool->stop )
+         break;
+
+      /* no subtree is left and nobody could hand one over */
+      if( pool->nqueued == 0 )
+      {
+         pool->stop = TRUE;
+         pool->finished = TRUE;
+         (void) pthread_cond_broadcast(&pool->cond);
+         break;
+      }
+
+      subtree = popSubtree(pool);
+      if( SCIPisGE(worker->scip, subtree->lowerbound, pool->bestobj) )
+      {
+         ++pool->npruned;
+         freeSubtree(&subtree);
+         continue;
+      }
+      ++pool->nbusy;
+      (void) pthread_mutex_unlock(&pool->mutex);
+
+      retcode = solveSubtree(worker, subtree);
+      if( retcode != SCIP_OKAY )
+         SCIPerrorMessage("error <%d> in worker %d\n", retcode, worker->index);
+
+      (void) pthread_mutex_lock(&pool->mutex);
+      --pool->nbusy;
+      if( retcode != SCIP_OKAY )
+      {
+         /* the subtree is lost, so the search cannot be completed */
+         if( pool->retcode == SCIP_OKAY )
+            pool->retcode = retcode;
+         pool->openbound = MIN(pool->openbound, subtree->lowerbound);
+         pool->stop = TRUE;
+      }
+      freeSubtree(&subtree);
+      (void) pthread_cond_broadcast(&pool->cond);
+   }
+   (void) pthread_mutex_unlock(&pool->mutex);
+
+   return NULL;
+}
+
+/** prints the results of the workers and of the search */
+static
+void printResults(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   PARAPOOL*             pool,               /* pool                                                 */
+   PARAWORKER*           workers,            /* workers                                              */
+   int                   nworkers            /* number of workers                                    */
+   )
+{
+   SCIP_Real dualbound;
+   int ndonated;
+   int w;
+   int i;
+
+   SCIPinfoMessage(scip, NULL, "%-6s %9s %9s %9s %9s %7s %6s\n", "worker", "subtrees", "nodes", "time", "donated",
+      "solsout", "solsin");
+
+   ndonated = 0;
+   for( w = 0; w < nworkers; ++w )
+   {
+      SCIP_HEURDATA* heurdata;
+
+      heurdata = SCIPheurGetData(SCIPfindHeur(workers[w].scip, HEUR_NAME));
+      assert(heurdata != NULL);
+
+      SCIPinfoMessage(scip, NULL, "%-6d %9d %9" SCIP_LONGINT_FORMAT " %9.2f %9d %7d %6d\n", w, workers[w].nsubtrees,
+         workers[w].nnodes, workers[w].time, heurdata->ndonated, heurdata->nsolsexported, heurdata->nsolsimported);
+      ndonated += heurdata->ndonated;
+   }
+
+   SCIPinfoMessage(scip, NULL, "subtrees: %d handed over, %d solved, %d pruned, at most %d queued\n", ndonated,
+      pool->nsolved, pool->npruned, pool->maxqueued);
+
+   /* a subtree which was stopped, e.g. because of an error, leaves its lower bound open */
+   if( pool->finished && (SCIPisInfinity(scip, pool->openbound)
+         || (pool->bestmedians != NULL && SCIPisGE(scip, pool->openbound, pool->bestobj))) )
+   {
+      if( pool->bestmedians != NULL )
+         SCIPinfoMessage(scip, NULL, "tree searched: optimal solution %.9g, found by worker %d, %.2f seconds\n",
+            pool->bestobj, pool->bestworker, SCIPgetClockTime(scip, pool->clock));
+      else
+         SCIPinfoMessage(scip, NULL, "tree searched: problem is infeasible, %.2f seconds\n",
+            SCIPgetClockTime(scip, pool->clock));
+   }
+   else
+   {
+      dualbound = pool->openbound;
+      for( i = 0; i < pool->nqueued; ++i )
+         dualbound = MIN(dualbound, pool->queue[i]->lowerbound);
+      if( pool->bestmedians != NULL )
+         dualbound = MIN(dualbound, pool->bestobj);
+
+      SCIPinfoMessage(scip, NULL, "%s: primal bound %.9g, dual bound %.9g, %.2f seconds\n",
+         pool->finished ? "tree searched incompletely" : "search stopped",
+         pool->bestmedians != NULL ? pool->bestobj : SCIPinfinity(scip), dualbound, SCIPgetClockTime(scip, pool->clock));
+   }
+}
+
+/** adds the best solution of the pool to the original problem */
+static
+SCIP_RETCODE transferSolution(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   PARAPOOL*             pool                /* pool                                                 */
+   )
+{
+   SCIP_SOL* sol;
+   SCIP_Bool stored;
+   int c;
+
+   assert(SCIPgetStage(scip) == SCIP_STAGE_PROBLEM);
+
+   if( pool->bestmedians == NULL )
+      return SCIP_OKAY;
+
+   SCIP_CALL( SCIPcreateOrigSol(scip, &sol, NULL) );
+
+   for( c = 0; c < pool->nbestclusters; ++c )
+   {
+      SCIP_VAR* var;
+
+      SCIP_CALL( SCIPpricerCpmpAddColumn(scip, pool->bestmedians[c], &pool->bestlocations[pool->bestbeg[c]],
+            pool->bestbeg[c + 1] - pool->bestbeg[c], &var) );
+      SCIP_CALL( SCIPsetSolVal(scip, sol, var, 1.0) );
+      SCIP_CALL( SCIPreleaseVar(scip, &var) );
+   }
+
+   SCIP_CALL( SCIPaddSolFree(scip, &sol, &stored) );
+
+   return SCIP_OKAY;
+}
+
+
+/*
+ * Interface methods
+ */
+
+/** searches the branch-and-price tree of the problem of the given SCIP in parallel, prints the results of the workers
+ *  and adds the best solution found to the original problem; a transformed problem of the given SCIP is freed before
+ */
+SCIP_RETCODE SCIPsolveParallelCpmp(
+   SCIP*                 scip,               /**< SCIP data structure with the cpmp plugins and a cpmp problem */
+   int                   nworkers,           /**< number of workers */
+   int                   maxsubtreecols      /**< maximal number of columns sent along with a subtree */
+   )
+{
+   PARAWORKER* workers;
+   PARAPOOL* pool;
+   SCIP_RETCODE retcode;
+   int nstarted;
+   int w;
+
+   assert(scip != NULL);
+   assert(nworkers >= 1);
+   assert(maxsubtreecols >= 0);
+
+   if( SCIPgetStage(scip) < SCIP_STAGE_PROBLEM || SCIPgetProbData(scip) == NULL )
+   {
+      SCIPerrorMessage("no cpmp problem to solve in parallel\n");
+      return SCIP_INVALIDCALL;
+   }
+
+   /* the workers share the instance data of the original problem */
+   if( SCIPgetStage(scip) > SCIP_STAGE_PROBLEM )
+   {
+      SCIP_CALL( SCIPfreeTransform(scip) );
+   }
+
+   nworkers = MIN(nworkers, PARA_MAXWORKERS);
+
+   SCIP_CALL( createPool(scip, &pool) );
+   SCIP_CALL( SCIPallocClearBufferArray(scip, &workers, nworkers) );
+
+   /* set up all SCIPs before starting any thread, since the parameters of scip are read while copying */
+   retcode = SCIP_OKAY;
+   for( w = 0; w < nworkers && retcode == SCIP_OKAY; ++w )
+   {
+      workers[w].pool = pool;
+      workers[w].index = w;
+      retcode = createWorker(scip, &workers[w], maxsubtreecols);
+   }
+   nworkers = w;
+
+   nstarted = 0;
+   if( retcode == SCIP_OKAY )
+   {
+      SCIPinfoMessage(scip, NULL, "searching the tree of <%s> with %d workers\n", SCIPgetProbName(scip), nworkers);
+
+      SCIP_CALL( SCIPstartClock(scip, pool->clock) );
+      for( ; nstarted < nworkers; ++nstarted )
+      {
+         if( pthread_create(&workers[nstarted].thread, NULL, workerThread, &workers[nstarted]) != 0 )
+         {
+            SCIPerrorMessage("cannot start worker thread %d\n", nstarted);
+            break;
+         }
+      }
+      if( nstarted == 0 )
+         retcode = SCIP_ERROR;
+   }
+
+   for( w = 0; w < nstarted; ++w )
+      (void) pthread_join(workers[w].thread, NULL);
+
+   if( nstarted > 0 )
+   {
+      SCIP_CALL( SCIPstopClock(scip, pool->clock) );
+      printResults(scip, pool, workers, nstarted);
+   }
+
+   if( retcode == SCIP_OKAY )
+      retcode = pool->retcode;
+   if( retcode == SCIP_OKAY )
+      retcode = transferSolution(scip, pool);
+
+   /* the problems of the workers refer to the instance data of scip, so they are freed first */
+   for( w = nworkers - 1; w >= 0; --w )
+   {
+      if( workers[w].scip != NULL )
+      {
+         SCIP_CALL( SCIPfree(&workers[w].scip) );
+      }
+   }
+
+   SCIPfreeBufferArray(scip, &workers);
+   SCIP_CALL( freePool(scip, &pool) );
+
+   return retcode;
+}
@@ -0,0 +1,63 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   para_cpmp.h
+ * @brief  parallel branch-and-price tree search for the capacitated p-median problem
+ * @author Christian Puchert
+ *
+ * The branch-and-price tree is searched by several worker threads in the manner of UG: the open subtrees are kept in
+ * a queue, and each worker repeatedly takes the subtree with the smallest lower bound and solves it with its own SCIP
+ * as a problem of its own. A subtree is given by its branching restrictions relative to the original problem, i.e.,
+ * the semiassign, median and Ryan-Foster constraints on its path (see subtree_cpmp.h), which the worker adds to the
+ * root of its problem, together with the columns of the sending worker which comply with them as a warm start. Both are
+ * serialized into a flat integer array, so subtrees could as well be sent to other processes.
+ *
+ * The search starts with the whole problem as the only subtree (ramp-up): the first worker solves it while the others
+ * are idle, and as long as fewer subtrees are queued than workers are idle, a busy worker hands over its open nodes
+ * with the best lower bounds after each node (load balancing) and cuts them off locally. Improving solutions are
+ * shared by all workers through the pool; they are feasible for the original problem and thus valid incumbents in every
+ * subtree.
+ *
+ * The time limit of the given SCIP applies to the whole search. Parallel workers require a SCIP library with
+ * thread-safe memory management (e.g., built with PARASCIP=true or with a TPI).
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __CPMP_PARA_CPMP_H__
+#define __CPMP_PARA_CPMP_H__
+
+
+#include "scip/scip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** searches the branch-and-price tree of the problem of the given SCIP in parallel, prints the results of the workers
+ *  and adds the best solution found to the original problem; a transformed problem of the given SCIP is freed before
+ */
+EXTERN
+SCIP_RETCODE SCIPsolveParallelCpmp(
+   SCIP*                 scip,               /**< SCIP data structure with the cpmp plugins and a cpmp problem */
+   int                   nworkers,           /**< number of workers */
+   int                   maxsubtreecols      /**< maximal number of columns sent along with a subtree */
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -21,8 +21,14 @@
 /*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
 
 #include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
 
+#include "capture_cpmp.h"
+#include "knapsack_cpmp.h"
+#include "lagrange_cpmp.h"
 #include "pricer_cpmp.h"
+#include "profits_cpmp.h"
 #include "pub_probdata.h"
 #include "pub_vardata.h"
 #include "vardata.h"
@@ -36,6 +42,27 @@
 #define PRICER_PRIORITY        0
 #define PRICER_DELAY           TRUE     /* only call pricer if all problem variables have non-negative reduced costs */
 
+#define DEFAULT_USECACHE       TRUE     /**< should pricing results be cached per median and reused if nothing changed? */
+#define DEFAULT_KNAPSACKALGO   'c'      /**< knapsack algorithm: 'c'pmp specific solver or 's'cip's general solver      */
+#define DEFAULT_MAXDPCELLS     10000000LL /**< maximal number of (item, capacity) cells for dynamic programming         */
+#define DEFAULT_MAXBBNODES     1000000LL  /**< maximal number of branch-and-bound nodes of the knapsack solver (-1: none) */
+#define DEFAULT_REDUCEITEMS    TRUE     /**< should the knapsack items be reduced by dominance and bounds?              */
+#define DEFAULT_LAGRANGEBOUND  TRUE     /**< should the Lagrangian bound be computed in reduced cost pricing?           */
+#define DEFAULT_EARLYSTOPGAP   0.0      /**< relative gap between LP value and Lagrangian bound to stop pricing at      */
+#define DEFAULT_TAILINGOFFROUNDS 0      /**< rounds without LP progress to stop pricing at a node (0: never)           */
+#define DEFAULT_TAILINGOFFREL  1e-4     /**< minimal relative LP improvement per round for tailing-off control          */
+#define DEFAULT_SIMDLEVEL      2        /**< instruction set for the profits: 0 scalar, 1 AVX2, 2 AVX-512               */
+#define DEFAULT_LAGRANGEITERS  200      /**< subgradient iterations before root column generation (0: no Lagrangian relaxation) */
+#define DEFAULT_LAGRANGETIME   10.0     /**< time limit in seconds for the Lagrangian relaxation                         */
+#define DEFAULT_SMOOTHING      0.0      /**< smoothing factor for the service duals at the root (0.0: no smoothing)     */
+#define DEFAULT_ELIMINATEMEDIANS TRUE   /**< should medians be eliminated by their Lagrangian bounds at the root?       */
+#define DEFAULT_TRACEFILE      ""       /**< file to write a trace of the pricing rounds to ("": no trace)              */
+#define DEFAULT_TRACEFORMAT    'c'      /**< format of the trace: 'c'sv or 'j'son lines                                  */
+#define DEFAULT_CAPTUREFILE    ""       /**< file to capture the pricing problems in for the microbenchmarks ("": none) */
+#define DEFAULT_CAPTUREMAXROUNDS 200    /**< maximal number of pricing rounds to capture (-1: no limit)                 */
+
+#define TRACE_BUFFERSIZE       65536    /**< size of the output buffer of the trace file                                 */
+
 
 
 
@@ -47,6 +74,98 @@
 struct SCIP_PricerData
 {
    SCIP_Bool**           forbiddenassignments; /* matrix of assignments which are forbidden by the current branching decisions */
+   uint64_t*             forbiddenhashes;    /* for each median, hash of its forbidden set, which is restored with the set      */
+   uint64_t              pairhash;           /* hash of the active pair restrictions (0: none)                               */
+
+   /* pricing result cache */
+   SCIP_Bool             usecache;           /* should pricing results be cached per median and reused if nothing changed?  */
+   SCIP_Real*            lastduals;          /* service duals (or Farkas values) of the last pricing round                  */
+   SCIP_Bool             lastuseredcost;     /* was the last pricing round a reduced cost pricing round?                    */
+   SCIP_Longint          dualsnapshot;       /* id of the current dual snapshot; increased whenever the service duals change */
+   SCIP_Longint          typesnapshot;       /* first dual snapshot of the current pricing type (reduced cost or Farkas)     */
+   SCIP_Real             dualdrift;          /* total increase of the service duals since the first snapshot of the type    */
+   int**                 cachedsolitems;     /* for each median, the items of the last optimal knapsack solution            */
+   int*                  ncachedsolitems;    /* for each median, the number of items in the cached knapsack solution        */
+   SCIP_Real*            cachedsolvals;      /* for each median, the profit of the cached knapsack solution                 */
+   SCIP_Longint*         cachedsnapshots;    /* for each median, the dual snapshot the cached solution was computed for     */
+   uint64_t*             cachedhashes;       /* for each median, the restrictions hash the cached solution belongs to       */
+   SCIP_Real*            cacheddrifts;       /* for each median, the dual drift when the cached solution was computed       */
+   SCIP_Bool*            cachedadded;        /* for each median, was the cached solution already added as a column?         */
+
+   /* knapsack solver */
+   CPMP_KNAPSACK*        knapsack;           /* working memory of the cpmp specific knapsack solver                         */
+   char                  knapsackalgo;       /* knapsack algorithm: 'c'pmp specific solver or 's'cip's general solver       */
+   SCIP_Longint          maxdpcells;         /* maximal number of (item, capacity) cells for dynamic programming            */
+   SCIP_Longint          maxbbnodes;         /* maximal number of branch-and-bound nodes of the knapsack solver             */
+   int                   simdlevel;          /* instruction set for the profits: 0 scalar, 1 AVX2, 2 AVX-512                */
+   SCIP_Bool             reduceitems;        /* should the knapsack items be reduced by dominance and bounds?               */
+
+   /* Lagrangian bound and early termination */
+   SCIP_Bool             lagrangebound;      /* should the Lagrangian bound be computed in reduced cost pricing?            */
+   SCIP_Real             earlystopgap;       /* relative gap between LP value and Lagrangian bound to stop pricing at       */
+   int                   tailingoffrounds;   /* rounds without LP progress to stop pricing at a node (0: never)            */
+   SCIP_Real             tailingoffrel;      /* minimal relative LP improvement per round for tailing-off control           */
+   SCIP_Longint          boundnode;          /* number of the node the following data belongs to                            */
+   SCIP_Real             nodebound;          /* best Lagrangian bound at this node                                          */
+   SCIP_Real             lastlpobj;          /* LP value of the last reduced cost pricing round at this node                */
+   int                   ntailingrounds;     /* number of consecutive rounds without sufficient LP progress at this node    */
+
+   /* Lagrangian relaxation, dual smoothing and median elimination at the root */
+   int                   lagrangeiters;      /* subgradient iterations before root column generation (0: none)             */
+   SCIP_Real             lagrangetime;       /* time limit in seconds for the Lagrangian relaxation                         */
+   SCIP_Real             smoothing;          /* smoothing factor for the service duals at the root (0.0: no smoothing)      */
+   SCIP_Bool             eliminatemedians;   /* should medians be eliminated by their Lagrangian bounds at the root?        */
+   SCIP_Bool             lagrangedone;       /* has the Lagrangian relaxation been solved?                                  */
+   SCIP_Real*            stabcenter;         /* service duals with the best Lagrangian bound at the root (stability center) */
+   SCIP_Real*            rootmedianbounds;   /* lower bounds on the cluster values of the medians at the stability center   */
+   SCIP_Real             rootbound;          /* Lagrangian bound at the stability center, or -infinity                      */
+   SCIP_Real             rootthreshold;      /* nclusters-th smallest median bound at the stability center                  */
+   SCIP_Real             elimcutoff;         /* cutoff bound of the last median elimination                                 */
+   SCIP_Bool             elimoutdated;       /* has the stability center changed since the last median elimination?         */
+   SCIP_Bool*            eliminated;         /* for each median, has it been eliminated?                                    */
+   SCIP_Real*            initstabcenter;     /* stability center to start the next solve with (e.g., on resume), or NULL    */
+   SCIP_Real*            initmedianbounds;   /* median bounds at the stability center to start with, or NULL                */
+   SCIP_Real             initrootbound;      /* Lagrangian bound at the stability center to start with                      */
+   SCIP_Real             initthreshold;      /* nclusters-th smallest median bound at the stability center to start with    */
+
+   /* reduced cost information of the last complete reduced cost pricing round, for reduced cost fixing */
+   SCIP_Longint          redcostnode;        /* number of the node the information belongs to, or -1                        */
+   SCIP_Real             redcostlpobj;       /* LP value of the round                                                       */
+   SCIP_Real*            redcostbounds;      /* for each median, lower bound on the reduced costs of its columns            */
+   SCIP_Real*            redcostduals;       /* service duals of the round                                                  */
+
+   /* median and Ryan-Foster branching restrictions */
+   int*                  closedmedians;      /* for each median, number of active branching decisions closing it            */
+   SCIP_CONS**           openconss;          /* for each median, local row forcing it to be open, or NULL                   */
+   int*                  pairlocations1;     /* first locations of the active pair restrictions                             */
+   int*                  pairlocations2;     /* second locations of the active pair restrictions                            */
+   SCIP_Bool*            pairsame;           /* for each pair restriction, must the locations be in the same cluster?       */
+   int                   npairs;             /* number of active pair restrictions                                          */
+   int                   pairssize;          /* size of the pair restriction arrays                                         */
+   SCIP_VAR**            excludedcols;       /* columns whose clusters may not be generated again, e.g. while diving        */
+   int                   nexcludedcols;      /* number of excluded columns                                                  */
+   int                   excludedcolssize;   /* size of the excluded column array                                           */
+
+   /* convergence trace */
+   char*                 tracefile;          /* file to write a trace of the pricing rounds to ("": no trace)               */
+   char                  traceformat;        /* format of the trace: 'c'sv or 'j'son lines                                  */
+   FILE*                 trace;              /* open trace file, or NULL                                                    */
+   char*                 tracebuffer;        /* output buffer of the trace file                                             */
+   SCIP_CLOCK*           roundclock;         /* wall clock time of the current pricing round                                */
+   SCIP_Longint          tracenode;          /* number of the node of the last traced round                                 */
+   int                   traceround;         /* index of the last traced round at this node                                 */
+   SCIP_Real             roundminredcost;    /* most negative reduced cost of the columns added in the current round        */
+
+   /* capture mode */
+   char*                 capturefile;        /* file to capture the pricing problems in ("": no capture)                    */
+   int                   capturemaxrounds;   /* maximal number of pricing rounds to capture (-1: no limit)                  */
+   CPMP_CAPTUREWRITER*   capture;            /* writer of the captured pricing rounds, or NULL                              */
+
+   CPMP_PRICERSTATS      stats;              /* pricing statistics                                                          */
+   SCIP_CLOCK*           dualclock;          /* time for extracting the duals                                               */
+   SCIP_CLOCK*           setupclock;         /* time for setting up and reducing the knapsack problems                      */
+   SCIP_CLOCK*           solveclock;         /* time for solving the knapsack problems                                      */
+   SCIP_CLOCK*           addclock;           /* time for adding columns                                                     */
 };
 
 
@@ -66,7 +185,10 @@ SCIP_RETCODE addColumn(
    int                   median,             /* median for which the pricing problem has been solved */
    int*                  locations,          /* locations contained in the new cluster               */
    int                   nlocations,         /* number of locations                                  */
-   SCIP_Real             score               /* score for the column: either its reduced cost or Farkas value */
+   SCIP_Real             score,              /* score for the column: either its reduced cost or Farkas value */
+   SCIP_CONS*            opencons,           /* local row forcing the median to be open, or NULL     */
+   SCIP_Bool             priced,             /* is the column added during pricing?                  */
+   SCIP_VAR**            newvar              /* pointer to store the captured column, or NULL        */
    )
 {
    SCIP_Longint** distances;
@@ -80,6 +202,8 @@ SCIP_RETCODE addColumn(
 
    int i;
 
+   cost = 0.0;
+
    /* get necessary problem data */
    distances = SCIPprobdataGetDistances(scip);
    serviceconss = SCIPprobdataGetServiceconss(scip);
@@ -91,331 +215,2010 @@ SCIP_RETCODE addColumn(
    assert(convconss != NULL);
    assert(mediancons != NULL);
 
-   /* ****************************************************************************************************
-    * TODO: compute the total service costs of the new cluster, to be stored in 'cost'
-    * ****************************************************************************************************
-    */
+   /* the cost of the cluster is the total distance of its locations to the median */
    for (i = 0; i < nlocations; ++i) cost += distances[locations[i]][median];
 
    /* create a new variable representing the found cluster, add the corresponding data and add it to the master problem */
    (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "column_%d", SCIPgetNVars(scip));
    SCIP_CALL( SCIPcreateVarBasic(scip, &var, name, 0.0, 1.0, cost, SCIP_VARTYPE_INTEGER) );
    SCIP_CALL( SCIPcreateVarData(scip, var, median, locations, nlocations) );
-   SCIP_CALL( SCIPaddPricedVar(scip, var, score) );
+   if( priced )
+   {
+      SCIP_CALL( SCIPaddPricedVar(scip, var, score) );
+   }
+   else
+   {
+      SCIP_CALL( SCIPaddVar(scip, var) );
+   }
    SCIP_CALL( SCIPchgVarUbLazy(scip, var, 1.0) );
 
 
-   /* ****************************************************************************************************
-    * TODO: add the variable to the master constraints:
-    *   * to each service constraints whose location is contained in the cluster;
-    *   * to the convexity constraint of the median
-    *   * to the p-median constraint
-    * ****************************************************************************************************
-    */
+   /* the column covers the service constraints of its locations and counts for the median and p-median constraints */
    for (i = 0; i < nlocations; ++i) SCIP_CALL( SCIPaddCoefLinear(scip, serviceconss[locations[i]], var, 1.0) );
 
    SCIP_CALL( SCIPaddCoefLinear(scip, mediancons, var, 1.0) );
    SCIP_CALL( SCIPaddCoefLinear(scip, convconss[median], var, 1.0) );
 
+   /* if the median is forced to be open at the current node, the column also counts for that row */
+   if( opencons != NULL )
+   {
+      SCIP_CALL( SCIPaddCoefLinear(scip, opencons, var, 1.0) );
+   }
+
    SCIPdebugMessage("Found improving column, score=%g:\n", score);
    SCIPdebug( SCIPprintVarData(scip, var) );
 
-   SCIP_CALL( SCIPreleaseVar(scip, &var) );
+   if( newvar != NULL )
+      *newvar = var;
+   else
+   {
+      SCIP_CALL( SCIPreleaseVar(scip, &var) );
+   }
 
    return SCIP_OKAY;
 }
 
 
 /**
- * Call the pricing routine
+ * check whether a knapsack solution of a median is the cluster of an excluded column
  */
 static
-SCIP_RETCODE performPricing(
-   SCIP*                 scip,               /* SCIP data structure                                  */
+SCIP_Bool isClusterExcluded(
    SCIP_PRICERDATA*      pricerdata,         /* pricer data structure                                */
-   SCIP_Bool             useredcost,         /* Is reduced cost pricing or Farkas pricing performed? */
-   SCIP_RESULT*          result              /* SCIP result pointer                                  */
+   int                   median,             /* median of the cluster                                */
+   int*                  locations,          /* locations of the cluster                             */
+   int                   nlocations          /* number of locations of the cluster                   */
    )
 {
-   int nlocations;
-   SCIP_Longint** distances;
-   SCIP_Longint* alldemands;
-   SCIP_Longint* capacities;
-   SCIP_CONS** serviceconss;
-   SCIP_CONS** convconss;
-   SCIP_CONS* mediancons;
+   int c;
+   int i;
 
-   int* items;                               /* array of items in the knapsack problem                                            */
-   int nitems;                               /* number of items                                                                   */
-   SCIP_Real* profits;                       /* array of item profits                                                             */
-   SCIP_Longint* demands;                    /* array of item demands                                                             */
-   int* solitems;                            /* array of items contained in the knapsack; to be filled by the knapsack solver     */
-   int nsolitems;                            /* number of items contained in the knapsack; to be set by the knapsack solver       */
-   int* nonsolitems;                         /* array of items not contained in the knapsack; to be filled by the knapsack solver */
-   int nnonsolitems;                         /* number of items not contained in the knapsack; to be set by the knapsack solver   */
-   SCIP_Real solval;                         /* total profit returned by the knapsack solver                                      */
-   SCIP_Bool success;                        /* indicates whether the knapsack problem was solved successfully                    */
+   for( c = 0; c < pricerdata->nexcludedcols; ++c )
+   {
+      SCIP_VAR* var = pricerdata->excludedcols[c];
 
-   SCIP_Real* pi_service;
-   SCIP_Real* pi_conv;
-   SCIP_Real pi_median;
+      if( SCIPvarGetMedian(var) != median || SCIPvarGetNLocations(var) != nlocations )
+         continue;
+
+      for( i = 0; i < nlocations; ++i )
+         if( !SCIPisLocationInCluster(var, locations[i]) )
+            break;
+
+      if( i == nlocations )
+         return TRUE;
+   }
 
+   return FALSE;
+}
+
+/**
+ * check whether a column respects the restrictions of the current node: its median is not closed, none of its
+ * locations is forbidden for the median, and it respects the pair restrictions
+ */
+static
+SCIP_Bool isColumnAllowed(
+   SCIP_PRICERDATA*      pricerdata,         /* pricer data structure                                */
+   SCIP_VAR*             var                 /* column to check                                      */
+   )
+{
+   int* locations;
+   int nlocations;
    int median;
+   int i;
+
+   median = SCIPvarGetMedian(var);
+   locations = SCIPvarGetLocations(var);
+   nlocations = SCIPvarGetNLocations(var);
+
+   if( pricerdata->closedmedians[median] > 0 )
+      return FALSE;
+
+   for( i = 0; i < nlocations; ++i )
+      if( pricerdata->forbiddenassignments[median][locations[i]] )
+         return FALSE;
+
+   for( i = 0; i < pricerdata->npairs; ++i )
+   {
+      SCIP_Bool contains1 = SCIPisLocationInCluster(var, pricerdata->pairlocations1[i]);
+      SCIP_Bool contains2 = SCIPisLocationInCluster(var, pricerdata->pairlocations2[i]);
+
+      if( pricerdata->pairsame[i] ? contains1 != contains2 : contains1 && contains2 )
+         return FALSE;
+   }
+
+   return TRUE;
+}
+
+/**
+ * compute the key of a forbidden assignment or of a pair restriction for the restrictions hashes; the hashes combine
+ * the keys of the active restrictions, so they return to their old values when the restrictions are restored
+ */
+static
+uint64_t computeRestrictionKey(
+   int                   location1,          /* median or first location of the pair                 */
+   int                   location2,          /* location or second location of the pair              */
+   int                   type                /* 0: forbidden assignment, 1: different, 2: same       */
+   )
+{
+   uint64_t key;
+
+   /* splitmix64 finalizer */
+   key = ((uint64_t)(unsigned int)location1 << 32) | (uint64_t)(unsigned int)location2;
+   key += ((uint64_t)type + 1) * 0x9e3779b97f4a7c15ULL;
+   key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+   key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+
+   return key ^ (key >> 31);
+}
+
+/**
+ * return the hash of the restrictions of the pricing problem of a median
+ */
+static
+uint64_t getRestrictionsHash(
+   SCIP_PRICERDATA*      pricerdata,         /* pricer data structure                                */
+   int                   median              /* median                                               */
+   )
+{
+   return pricerdata->forbiddenhashes[median] ^ pricerdata->pairhash;
+}
+
+/**
+ * update the dual snapshot: if some service dual (or Farkas value) differs from the last round by more than epsilon,
+ * start a new snapshot; the increases of the duals are summed up, since they bound the increase of every knapsack
+ * optimum since the cached solutions were computed
+ */
+static
+void updateDualSnapshot(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_PRICERDATA*      pricerdata,         /* pricer data structure                                */
+   SCIP_Real*            pi_service,         /* current service duals or Farkas values               */
+   int                   nlocations,         /* number of locations                                  */
+   SCIP_Bool             useredcost          /* Is reduced cost pricing or Farkas pricing performed? */
+   )
+{
+   SCIP_Bool changed;
    int location;
 
-   /* get necessary problem data */
-   nlocations = SCIPprobdataGetNLocations(scip);
-   distances = SCIPprobdataGetDistances(scip);
-   alldemands = SCIPprobdataGetDemands(scip);
-   capacities = SCIPprobdataGetCapacities(scip);
-   serviceconss = SCIPprobdataGetServiceconss(scip);
-   convconss = SCIPprobdataGetConvconss(scip);
-   mediancons = SCIPprobdataGetMediancons(scip);
+   /* the knapsack problems of the other pricing type have different profits */
+   if( pricerdata->dualsnapshot == 0 || pricerdata->lastuseredcost != useredcost )
+   {
+      BMScopyMemoryArray(pricerdata->lastduals, pi_service, nlocations);
+      pricerdata->lastuseredcost = useredcost;
+      ++pricerdata->dualsnapshot;
+      pricerdata->typesnapshot = pricerdata->dualsnapshot;
+      pricerdata->dualdrift = 0.0;
+      return;
+   }
 
-   assert(nlocations >= 0);
-   assert(distances != NULL);
-   assert(alldemands != NULL);
-   assert(capacities != NULL);
-   assert(serviceconss != NULL);
-   assert(convconss != NULL);
-   assert(mediancons != NULL);
+   changed = FALSE;
+   for( location = 0; location < nlocations; ++location )
+   {
+      if( pi_service[location] > pricerdata->lastduals[location] )
+         pricerdata->dualdrift += pi_service[location] - pricerdata->lastduals[location];
+      if( !SCIPisEQ(scip, pi_service[location], pricerdata->lastduals[location]) )
+         changed = TRUE;
+   }
 
-   /* allocate memory */
+   BMScopyMemoryArray(pricerdata->lastduals, pi_service, nlocations);
+   if( changed )
+      ++pricerdata->dualsnapshot;
+}
+
+/**
+ * check whether the cached knapsack solution of a median is still optimal,
+ * i.e. neither the duals nor the restrictions of the median have changed since it was computed
+ */
+static
+SCIP_Bool isCacheValid(
+   SCIP_PRICERDATA*      pricerdata,         /* pricer data structure                                */
+   int                   median              /* median whose pricing problem is to be solved         */
+   )
+{
+   return pricerdata->usecache
+      && pricerdata->cachedsnapshots[median] == pricerdata->dualsnapshot
+      && pricerdata->cachedhashes[median] == getRestrictionsHash(pricerdata, median);
+}
+
+/**
+ * check whether the cached knapsack solution of a median is still feasible, i.e. the restrictions of the median are
+ * the same as when it was computed; then it can serve as a starting solution
+ */
+static
+SCIP_Bool isCacheFeasible(
+   SCIP_PRICERDATA*      pricerdata,         /* pricer data structure                                */
+   int                   median              /* median whose pricing problem is to be solved         */
+   )
+{
+   return pricerdata->usecache
+      && pricerdata->cachedsnapshots[median] > 0
+      && pricerdata->cachedhashes[median] == getRestrictionsHash(pricerdata, median);
+}
+
+/**
+ * compute an upper bound on the optimum of the knapsack problem of a median from its cached solution: the profit of
+ * any solution increased by at most the increase of the duals since the cached one was computed; returns infinity if
+ * there is no such bound
+ */
+static
+SCIP_Real computeCacheBound(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_PRICERDATA*      pricerdata,         /* pricer data structure                                */
+   int                   median              /* median whose pricing problem is to be solved         */
+   )
+{
+   if( !isCacheFeasible(pricerdata, median) || pricerdata->cachedsnapshots[median] < pricerdata->typesnapshot )
+      return SCIPinfinity(scip);
+
+   return pricerdata->cachedsolvals[median] + pricerdata->dualdrift - pricerdata->cacheddrifts[median];
+}
+
+/**
+ * compute the profit of the cached knapsack solution of a median w.r.t. the current duals
+ */
+static
+SCIP_Real rescoreCache(
+   SCIP_PRICERDATA*      pricerdata,         /* pricer data structure                                */
+   int                   median,             /* median whose pricing problem is to be solved         */
+   SCIP_Real*            pi_service,         /* current service duals or Farkas values               */
+   SCIP_Longint**        distances,          /* distances between the locations                      */
+   SCIP_Bool             useredcost          /* Is reduced cost pricing or Farkas pricing performed? */
+   )
+{
+   SCIP_Real solval;
+   int i;
+
+   solval = 0.0;
+   for( i = 0; i < pricerdata->ncachedsolitems[median]; ++i )
+   {
+      int location = pricerdata->cachedsolitems[median][i];
+
+      solval += pi_service[location];
+      if( useredcost )
+         solval -= distances[location][median];
+   }
+
+   return solval;
+}
+
+/**
+ * store an optimal knapsack solution of a median in the cache
+ */
+static
+SCIP_RETCODE storeCache(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_PRICERDATA*      pricerdata,         /* pricer data structure                                */
+   int                   median,             /* median for which the pricing problem has been solved */
+   int*                  solitems,           /* items contained in the knapsack solution             */
+   int                   nsolitems,          /* number of items contained in the knapsack solution   */
+   SCIP_Real             solval              /* profit of the knapsack solution                      */
+   )
+{
+   SCIPfreeMemoryArrayNull(scip, &pricerdata->cachedsolitems[median]);
+   if( nsolitems > 0 )
+   {
+      SCIP_CALL( SCIPduplicateMemoryArray(scip, &pricerdata->cachedsolitems[median], solitems, nsolitems) );
+   }
+
+   pricerdata->ncachedsolitems[median] = nsolitems;
+   pricerdata->cachedsolvals[median] = solval;
+   pricerdata->cachedsnapshots[median] = pricerdata->dualsnapshot;
+   pricerdata->cacheddrifts[median] = pricerdata->dualdrift;
+   pricerdata->cachedhashes[median] = getRestrictionsHash(pricerdata, median);
+   pricerdata->cachedadded[median] = FALSE;
+
+   return SCIP_OKAY;
+}
+
+
+/**
+ * find the representative of a location in the union-find structure of the "same" pair restrictions
+ */
+static
+int findComponent(
+   int*                  components,         /* for each location, its parent in the union-find structure */
+   int                   location            /* location whose component is to be found              */
+   )
+{
+   while( components[location] != location )
+   {
+      components[location] = components[components[location]];
+      location = components[location];
+   }
+
+   return location;
+}
+
+/**
+ * solve the pricing problem of a median under Ryan-Foster pair restrictions: locations which must be in the same
+ * cluster are merged into one item, and locations which must be in different clusters give conflicting items;
+ * the knapsack solution is returned in terms of locations
+ */
+static
+SCIP_RETCODE solvePairedPricingProblem(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_PRICERDATA*      pricerdata,         /* pricer data structure                                */
+   int                   median,             /* median whose pricing problem is to be solved         */
+   SCIP_Real*            pi_service,         /* service duals or Farkas values                       */
+   SCIP_Real*            distrow,            /* distances to the median, or NULL in Farkas pricing   */
+   SCIP_Longint*         alldemands,         /* demands of the locations                             */
+   SCIP_Longint          capacity,           /* capacity of the median                               */
+   SCIP_Real             cutoff,             /* only solutions with a larger profit are of interest  */
+   int*                  solitems,           /* array to store the locations of the solution         */
+   int*                  nsolitems,          /* pointer to store the number of locations in the solution */
+   SCIP_Real*            solval,             /* pointer to store the profit of the solution          */
+   SCIP_Real*            upperbound,         /* pointer to store an upper bound on the optimal profit */
+   SCIP_Bool*            success             /* pointer to store whether the problem was solved      */
+   )
+{
+   int nlocations;
+   int* components;                          /* union-find structure over the locations              */
+   SCIP_Real* compprofits;                   /* for each component root, the total profit            */
+   SCIP_Longint* compweights;                /* for each component root, the total demand            */
+   SCIP_Bool* compexcluded;                  /* for each component root, can it not be packed at all? */
+   int* compitems;                           /* for each component root, its item position, or -1    */
+   int* items;
+   SCIP_Real* profits;
+   SCIP_Longint* weights;
+   int* compsol;
+   int ncompsol;
+   int* nonsolitems;
+   int nnonsolitems;
+   int* conflicts1;
+   int* conflicts2;
+   int nconflicts;
+   int nitems;
+   int location;
+   int i;
+
+   nlocations = SCIPprobdataGetNLocations(scip);
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &components, nlocations) );
+   SCIP_CALL( SCIPallocClearBufferArray(scip, &compprofits, nlocations) );
+   SCIP_CALL( SCIPallocClearBufferArray(scip, &compweights, nlocations) );
+   SCIP_CALL( SCIPallocClearBufferArray(scip, &compexcluded, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &compitems, nlocations) );
    SCIP_CALL( SCIPallocBufferArray(scip, &items, nlocations) );
    SCIP_CALL( SCIPallocBufferArray(scip, &profits, nlocations) );
-   SCIP_CALL( SCIPallocBufferArray(scip, &demands, nlocations) );
-   SCIP_CALL( SCIPallocBufferArray(scip, &solitems, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &weights, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &compsol, nlocations) );
    SCIP_CALL( SCIPallocBufferArray(scip, &nonsolitems, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &conflicts1, MAX(pricerdata->npairs, 1)) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &conflicts2, MAX(pricerdata->npairs, 1)) );
 
-   SCIP_CALL( SCIPallocBufferArray(scip, &pi_service, nlocations) );
-   SCIP_CALL( SCIPallocBufferArray(scip, &pi_conv, nlocations) );
+   /* merge the locations which must be in the same cluster */
+   for( location = 0; location < nlocations; ++location )
+      components[location] = location;
+   for( i = 0; i < pricerdata->npairs; ++i )
+   {
+      if( pricerdata->pairsame[i] )
+      {
+         int root1 = findComponent(components, pricerdata->pairlocations1[i]);
+         int root2 = findComponent(components, pricerdata->pairlocations2[i]);
 
-   *result = SCIP_DIDNOTRUN;
+         if( root1 != root2 )
+            components[root2] = root1;
+      }
+   }
 
-   for( median = 0; median < nlocations && !SCIPisStopped(scip); ++median )
+   /* a component can only be packed if none of its locations is forbidden for the median */
+   for( location = 0; location < nlocations; ++location )
    {
-      nitems = 0;
+      int root = findComponent(components, location);
 
-      /* ****************************************************************************************************
-       * TODO: prepare the knapsack problem for the current pricing problem:
-       * store the possible locations as items, get their demands and calculate their profits;
-       *
-       * NOTE: Due to branching restrictions, not all locations are added as items, so you
-       * need to check the pricerdata->forbiddenassignments array
-       *
-       * NOTE: The profits depend on whether you do reduced cost pricing or Farkas pricing!
-       * ****************************************************************************************************
-       */
-      for ( location = 0; location < nlocations; ++location) {
+      compprofits[root] += distrow != NULL ? pi_service[location] - distrow[location] : pi_service[location];
+      compweights[root] += alldemands[location];
+      if( pricerdata->forbiddenassignments[median][location] )
+         compexcluded[root] = TRUE;
+   }
 
-         if (useredcost) {
+   /* a component containing two locations which must be in different clusters cannot be packed either */
+   for( i = 0; i < pricerdata->npairs; ++i )
+   {
+      if( !pricerdata->pairsame[i] )
+      {
+         int root1 = findComponent(components, pricerdata->pairlocations1[i]);
 
-            pi_service[location] = SCIPgetDualsolLinear(scip, serviceconss[location]);
-            pi_conv[location] = SCIPgetDualsolLinear(scip, convconss[location]);
-         }
-         else {
+         if( root1 == findComponent(components, pricerdata->pairlocations2[i]) )
+            compexcluded[root1] = TRUE;
+      }
+   }
+
+   /* each remaining component with positive profit becomes an item, identified by its root */
+   nitems = 0;
+   for( location = 0; location < nlocations; ++location )
+   {
+      compitems[location] = -1;
+      if( components[location] == location && !compexcluded[location] && compprofits[location] > 0.0
+         && compweights[location] <= capacity )
+      {
+         compitems[location] = nitems;
+         items[nitems] = location;
+         profits[nitems] = compprofits[location];
+         weights[nitems] = compweights[location];
+         ++nitems;
+      }
+   }
 
-            pi_service[location] = SCIPgetDualfarkasLinear(scip, serviceconss[location]);
-            pi_conv[location] = SCIPgetDualfarkasLinear(scip, convconss[location]);
+   /* the "different" restrictions between items become conflicts */
+   nconflicts = 0;
+   for( i = 0; i < pricerdata->npairs; ++i )
+   {
+      if( !pricerdata->pairsame[i] )
+      {
+         int item1 = compitems[findComponent(components, pricerdata->pairlocations1[i])];
+         int item2 = compitems[findComponent(components, pricerdata->pairlocations2[i])];
+
+         if( item1 >= 0 && item2 >= 0 )
+         {
+            conflicts1[nconflicts] = item1;
+            conflicts2[nconflicts] = item2;
+            ++nconflicts;
          }
       }
-      if (useredcost) pi_median = SCIPgetDualsolLinear(scip, mediancons); else SCIPgetDualfarkasLinear(scip, mediancons);
+   }
+
+   ++pricerdata->stats.nknapsacks;
+   pricerdata->stats.nlocations += nlocations;
+   pricerdata->stats.npositive += nitems;
+   pricerdata->stats.nitems += nitems;
+
+   SCIPdebugMessage("  -> median %d: %d merged items, %d conflicts\n", median + 1, nitems, nconflicts);
+
+   *success = FALSE;
+   if( nconflicts > 0 )
+   {
+      SCIP_CALL( SCIPsolveConflictKnapsackCpmp(scip, pricerdata->knapsack, nitems, weights, profits, capacity, items,
+            nconflicts, conflicts1, conflicts2, compsol, &ncompsol, solval, upperbound, success) );
+   }
+   else
+   {
+      if( pricerdata->knapsackalgo == 'c' )
+      {
+         SCIP_CALL( SCIPsolveKnapsackCpmp(scip, pricerdata->knapsack, nitems, weights, profits, capacity, items,
+               cutoff, compsol, &ncompsol, solval, upperbound, success) );
+      }
+      if( !(*success) )
+      {
+         SCIP_CALL( SCIPsolveKnapsackExactly(scip, nitems, weights, profits, capacity, items, compsol, nonsolitems,
+               &ncompsol, &nnonsolitems, solval, success) );
+         *upperbound = *solval;
+      }
+   }
 
-      for ( location = 0; location < nlocations; ++location) {
+   /* expand the packed components to their locations */
+   *nsolitems = 0;
+   if( *success )
+   {
+      BMSclearMemoryArray(compexcluded, nlocations);
+      for( i = 0; i < ncompsol; ++i )
+         compexcluded[compsol[i]] = TRUE;
+      for( location = 0; location < nlocations; ++location )
+         if( compexcluded[findComponent(components, location)] )
+            solitems[(*nsolitems)++] = location;
+   }
 
-         if (!SCIPpricerCpmpIsAssignmentForbidden(scip, median, location)) {
+   SCIPfreeBufferArray(scip, &conflicts2);
+   SCIPfreeBufferArray(scip, &conflicts1);
+   SCIPfreeBufferArray(scip, &nonsolitems);
+   SCIPfreeBufferArray(scip, &compsol);
+   SCIPfreeBufferArray(scip, &weights);
+   SCIPfreeBufferArray(scip, &profits);
+   SCIPfreeBufferArray(scip, &items);
+   SCIPfreeBufferArray(scip, &compitems);
+   SCIPfreeBufferArray(scip, &compexcluded);
+   SCIPfreeBufferArray(scip, &compweights);
+   SCIPfreeBufferArray(scip, &compprofits);
+   SCIPfreeBufferArray(scip, &components);
 
-            items[nitems] = location;
-            demands[nitems] = alldemands[location];
+   return SCIP_OKAY;
+}
 
-            if (useredcost) profits[nitems] = pi_service[location] - distances[location][median]; else profits[nitems] = pi_service[location];
 
-            nitems++;
-         }
-      }
+/**
+ * eliminate all medians which cannot be part of a solution better than the incumbent, according to their Lagrangian
+ * bounds at the stability center; their pricing problems are not solved any more and their columns are fixed to zero
+ */
+static
+SCIP_RETCODE eliminateMedians(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_PRICERDATA*      pricerdata          /* pricer data structure                                */
+   )
+{
+   SCIP_VAR** vars;
+   int nvars;
+   int nlocations;
+   SCIP_Real cutoffbound;
+   int median;
+   int i;
+
+   if( !pricerdata->eliminatemedians || SCIPisInfinity(scip, -pricerdata->rootbound) )
+      return SCIP_OKAY;
+
+   /* the bounds only get stronger if the incumbent or the stability center improved */
+   cutoffbound = SCIPgetCutoffbound(scip);
+   if( SCIPisInfinity(scip, cutoffbound) || (cutoffbound >= pricerdata->elimcutoff && !pricerdata->elimoutdated) )
+      return SCIP_OKAY;
+
+   pricerdata->elimcutoff = cutoffbound;
+   pricerdata->elimoutdated = FALSE;
+
+   nlocations = SCIPprobdataGetNLocations(scip);
+   vars = SCIPgetVars(scip);
+   nvars = SCIPgetNVars(scip);
+
+   for( median = 0; median < nlocations; ++median )
+   {
+      SCIP_Real bound;
+
+      if( pricerdata->eliminated[median] )
+         continue;
+
+      /* all column costs are integral, so is the objective value of every solution */
+      bound = SCIPgetLagrangeMedianBoundCpmp(pricerdata->rootbound, pricerdata->rootthreshold,
+         pricerdata->rootmedianbounds[median]);
+      if( SCIPisFeasLT(scip, SCIPfeasCeil(scip, bound), cutoffbound) )
+         continue;
 
-      SCIP_CALL( SCIPsolveKnapsackExactly(scip, nitems, demands, profits, capacities[median], items, solitems, nonsolitems, &nsolitems, &nnonsolitems, &solval, &success) );
+      SCIPdebugMessage("eliminate median %d: Lagrangian bound %g, cutoff bound %g\n", median + 1, bound, cutoffbound);
+
+      pricerdata->eliminated[median] = TRUE;
+      ++pricerdata->closedmedians[median];
+      ++pricerdata->stats.neliminated;
+
+      for( i = 0; i < nvars; ++i )
+      {
+         if( SCIPvarGetMedian(vars[i]) == median && SCIPvarGetLbGlobal(vars[i]) < 0.5 )
+         {
+            SCIP_CALL( SCIPchgVarUbGlobal(scip, vars[i], 0.0) );
+         }
+      }
+   }
+
+   return SCIP_OKAY;
+}
+
+/**
+ * move the stability center to the given service duals if their Lagrangian bound is better than the one of the
+ * current center; the median bounds are kept for median elimination
+ */
+static
+SCIP_RETCODE updateStabilityCenter(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_PRICERDATA*      pricerdata,         /* pricer data structure                                */
+   SCIP_Real*            duals,              /* service duals                                        */
+   SCIP_Real*            medianbounds,       /* lower bounds on the cluster values of the medians    */
+   SCIP_Real*            lagrangebound       /* pointer to store the Lagrangian bound of the duals   */
+   )
+{
+   SCIP_Real threshold;
+   int nlocations;
+
+   nlocations = SCIPprobdataGetNLocations(scip);
+
+   SCIP_CALL( SCIPcomputeLagrangeBoundCpmp(scip, nlocations, SCIPprobdataGetNClusters(scip), duals, medianbounds,
+         lagrangebound, &threshold) );
+
+   if( *lagrangebound > pricerdata->rootbound )
+   {
+      BMScopyMemoryArray(pricerdata->stabcenter, duals, nlocations);
+      BMScopyMemoryArray(pricerdata->rootmedianbounds, medianbounds, nlocations);
+      pricerdata->rootbound = *lagrangebound;
+      pricerdata->rootthreshold = threshold;
+      pricerdata->elimoutdated = TRUE;
+   }
+
+   return SCIP_OKAY;
+}
+
+/**
+ * solve the Lagrangian relaxation before column generation at the root starts; its multipliers become the first
+ * stability center
+ */
+static
+SCIP_RETCODE solveLagrangianRelaxation(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_PRICERDATA*      pricerdata          /* pricer data structure                                */
+   )
+{
+   SCIP_Real* multipliers;
+   SCIP_Real* medianbounds;
+   SCIP_Real lagrangebound;
+   int nlocations;
+   int niters;
+
+   nlocations = SCIPprobdataGetNLocations(scip);
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &multipliers, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &medianbounds, nlocations) );
+
+   SCIP_CALL( SCIPsolveLagrangeCpmp(scip, pricerdata->knapsack, (CPMP_SIMDLEVEL)pricerdata->simdlevel,
+         pricerdata->forbiddenassignments, pricerdata->lagrangeiters, pricerdata->lagrangetime, SCIPgetUpperbound(scip),
+         TRUE, multipliers, medianbounds, &lagrangebound, &niters) );
+
+   if( !SCIPisInfinity(scip, -lagrangebound) )
+   {
+      SCIP_CALL( updateStabilityCenter(scip, pricerdata, multipliers, medianbounds, &lagrangebound) );
+   }
+
+   pricerdata->stats.rootlagrangebound = lagrangebound;
+   pricerdata->stats.nlagrangeiters = niters;
+   pricerdata->lagrangedone = TRUE;
+
+   SCIPdebugMessage("Lagrangian relaxation: bound %g after %d iterations\n", lagrangebound, niters);
+
+   SCIPfreeBufferArray(scip, &medianbounds);
+   SCIPfreeBufferArray(scip, &multipliers);
+
+   return SCIP_OKAY;
+}
+
+
+/**
+ * record the reduced cost of an improving column in the statistics
+ */
+static
+void recordImprovingColumn(
+   SCIP_PRICERDATA*      pricerdata,         /* pricer data structure                                */
+   SCIP_Real             redcost             /* (negative) reduced cost of the column                */
+   )
+{
+   SCIP_Real threshold;
+   int bucket;
+
+   /* bucket b holds the reduced costs in (-10^(CPMP_NRCBUCKETS-1-b), -10^(CPMP_NRCBUCKETS-2-b)], the last one (-1,0) */
+   threshold = -1.0;
+   for( bucket = CPMP_NRCBUCKETS - 1; bucket > 0 && redcost <= threshold; --bucket )
+      threshold *= 10.0;
+
+   ++pricerdata->stats.rchistogram[bucket];
+   pricerdata->stats.minredcost = MIN(pricerdata->stats.minredcost, redcost);
+   pricerdata->stats.sumredcost += redcost;
+   pricerdata->roundminredcost = MIN(pricerdata->roundminredcost, redcost);
+}
+
+/** opens the trace file, if any, and writes the CSV header; the file is fully buffered, so that a row only costs a
+ *  formatted write to memory
+ */
+static
+SCIP_RETCODE openTrace(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_PRICERDATA*      pricerdata          /* pricer data structure                                */
+   )
+{
+   pricerdata->trace = NULL;
+   pricerdata->tracebuffer = NULL;
+   pricerdata->tracenode = -1;
+   pricerdata->traceround = 0;
+
+   if( pricerdata->tracefile[0] == '\0' )
+      return SCIP_OKAY;
+
+   pricerdata->trace = fopen(pricerdata->tracefile, "w");
+   if( pricerdata->trace == NULL )
+   {
+      SCIPwarningMessage(scip, "cannot open trace file <%s>, pricing rounds are not traced\n", pricerdata->tracefile);
+      return SCIP_OKAY;
+   }
+
+   SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->tracebuffer, TRACE_BUFFERSIZE) );
+   (void) setvbuf(pricerdata->trace, pricerdata->tracebuffer, _IOFBF, TRACE_BUFFERSIZE);
+
+   if( pricerdata->traceformat == 'c' )
+      fprintf(pricerdata->trace, "node,round,type,probing,lpobj,lagrangebound,ncolumns,minredcost,time,nlprows,nlpcols\n");
+
+   return SCIP_OKAY;
+}
+
+/** closes the trace file, if any, which flushes the remaining rows */
+static
+void closeTrace(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_PRICERDATA*      pricerdata          /* pricer data structure                                */
+   )
+{
+   if( pricerdata->trace != NULL )
+   {
+      (void) fclose(pricerdata->trace);
+      pricerdata->trace = NULL;
+   }
+   SCIPfreeMemoryArrayNull(scip, &pricerdata->tracebuffer);
+}
+
+/** writes the separator and, for JSON lines, the key of the next field of a trace row */
+static
+void writeTraceKey(
+   SCIP_PRICERDATA*      pricerdata,         /* pricer data structure                                */
+   const char*           key                 /* name of the field                                    */
+   )
+{
+   if( pricerdata->traceformat == 'j' )
+      fprintf(pricerdata->trace, ",\"%s\":", key);
+   else
+      fputc(',', pricerdata->trace);
+}
+
+/** writes a real field of a trace row; undefined values are left empty in CSV and written as null in JSON lines */
+static
+void writeTraceReal(
+   SCIP_PRICERDATA*      pricerdata,         /* pricer data structure                                */
+   const char*           key,                /* name of the field                                    */
+   SCIP_Real             val,                /* value of the field                                   */
+   SCIP_Bool             defined             /* is the value defined?                                */
+   )
+{
+   writeTraceKey(pricerdata, key);
+
+   if( defined )
+      fprintf(pricerdata->trace, "%.15g", val);
+   else if( pricerdata->traceformat == 'j' )
+      fputs("null", pricerdata->trace);
+}
+
+/** writes the row of a finished pricing round to the trace and restarts the round clock */
+static
+SCIP_RETCODE traceRound(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_PRICERDATA*      pricerdata,         /* pricer data structure                                */
+   SCIP_Bool             useredcost,         /* was reduced cost pricing or Farkas pricing performed? */
+   SCIP_Real             lagrangebound,      /* Lagrangian bound of the round, or -infinity          */
+   SCIP_Longint          ncolumns            /* number of columns added in the round                 */
+   )
+{
+   SCIP_Longint nodenumber;
+   SCIP_Real time;
+
+   SCIP_CALL( SCIPstopClock(scip, pricerdata->roundclock) );
+   time = SCIPgetClockTime(scip, pricerdata->roundclock);
+   SCIP_CALL( SCIPresetClock(scip, pricerdata->roundclock) );
+
+   nodenumber = SCIPnodeGetNumber(SCIPgetCurrentNode(scip));
+   if( nodenumber != pricerdata->tracenode )
+   {
+      pricerdata->tracenode = nodenumber;
+      pricerdata->traceround = 0;
+   }
+   ++pricerdata->traceround;
+
+   if( pricerdata->traceformat == 'j' )
+      fprintf(pricerdata->trace, "{\"node\":%" SCIP_LONGINT_FORMAT ",\"round\":%d,\"type\":\"%s\"", nodenumber,
+         pricerdata->traceround, useredcost ? "redcost" : "farkas");
+   else
+      fprintf(pricerdata->trace, "%" SCIP_LONGINT_FORMAT ",%d,%s", nodenumber, pricerdata->traceround,
+         useredcost ? "redcost" : "farkas");
+
+   writeTraceKey(pricerdata, "probing");
+   fprintf(pricerdata->trace, "%d", SCIPinProbing(scip) ? 1 : 0);
+   writeTraceReal(pricerdata, "lpobj", useredcost ? SCIPgetLPObjval(scip) : 0.0, useredcost);
+   writeTraceReal(pricerdata, "lagrangebound", lagrangebound, !SCIPisInfinity(scip, -lagrangebound));
+   writeTraceKey(pricerdata, "ncolumns");
+   fprintf(pricerdata->trace, "%" SCIP_LONGINT_FORMAT, ncolumns);
+   writeTraceReal(pricerdata, "minredcost", pricerdata->roundminredcost, useredcost && ncolumns > 0);
+   writeTraceReal(pricerdata, "time", time, TRUE);
+   writeTraceKey(pricerdata, "nlprows");
+   fprintf(pricerdata->trace, "%d", SCIPgetNLPRows(scip));
+   writeTraceKey(pricerdata, "nlpcols");
+   fprintf(pricerdata->trace, "%d", SCIPgetNLPCols(scip));
+
+   fputs(pricerdata->traceformat == 'j' ? "}\n" : "\n", pricerdata->trace);
+
+   return SCIP_OKAY;
+}
+
+/**
+ * Call the pricing routine
+ */
+static
+SCIP_RETCODE performPricing(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_PRICERDATA*      pricerdata,         /* pricer data structure                                */
+   SCIP_Bool             useredcost,         /* Is reduced cost pricing or Farkas pricing performed? */
+   SCIP_Real             alpha,              /* smoothing factor for the service duals (0.0: none)   */
+   SCIP_Real*            lagrangebound,      /* pointer to store the Lagrangian bound, or -infinity  */
+   SCIP_Bool*            improving,          /* pointer to store whether an improving column was found */
+   SCIP_RESULT*          result              /* SCIP result pointer                                  */
+   )
+{
+   int nlocations;
+   int nclusters;
+   SCIP_Longint** distances;
+   SCIP_Real** mediandistances;
+   SCIP_Longint* alldemands;
+   SCIP_Longint* capacities;
+   SCIP_CONS** serviceconss;
+   SCIP_CONS** convconss;
+   SCIP_CONS* mediancons;
+
+   int* items;                               /* array of items in the knapsack problem                                            */
+   int nitems;                               /* number of items                                                                   */
+   SCIP_Real* profits;                       /* array of item profits                                                             */
+   SCIP_Longint* demands;                    /* array of item demands                                                             */
+   int* solitems;                            /* array of items contained in the knapsack; to be filled by the knapsack solver     */
+   int nsolitems;                            /* number of items contained in the knapsack; to be set by the knapsack solver       */
+   int* nonsolitems;                         /* array of items not contained in the knapsack; to be filled by the knapsack solver */
+   int nnonsolitems;                         /* number of items not contained in the knapsack; to be set by the knapsack solver   */
+   SCIP_Real solval;                         /* total profit returned by the knapsack solver                                      */
+   SCIP_Bool success;                        /* indicates whether the knapsack problem was solved successfully                    */
+
+   SCIP_Real* pi_service;
+   SCIP_Real* pi_conv;
+   SCIP_Real pi_median;
+   SCIP_Real* pi_price;                      /* service duals the pricing problems are solved for (smoothed ones, if any)  */
+
+   SCIP_Real* rcbounds;                      /* for each median, lower bound on the reduced cost of its columns (if negative)     */
+   int nrcbounds;                            /* number of medians with a negative reduced cost bound                              */
+   SCIP_Bool boundvalid;                     /* do the reduced cost bounds cover all medians?                                     */
+   SCIP_Real* medianbounds;                  /* for each median, lower bound on the Lagrangian cost of its clusters                */
+   SCIP_Bool updatecenter;                   /* should the stability center be updated by this round?                             */
+   SCIP_Bool storeredcost;                   /* should the reduced cost bounds be stored for reduced cost fixing?                 */
+   SCIP_Bool capturing;                      /* are the pricing problems of this round captured?                                  */
+   int ncolumns;                             /* number of columns added in this round                                             */
+
+   int median;
+   int location;
+
+   /* get necessary problem data */
+   nlocations = SCIPprobdataGetNLocations(scip);
+   nclusters = SCIPprobdataGetNClusters(scip);
+   distances = SCIPprobdataGetDistances(scip);
+   mediandistances = SCIPprobdataGetMedianDistances(scip);
+   alldemands = SCIPprobdataGetDemands(scip);
+   capacities = SCIPprobdataGetCapacities(scip);
+   serviceconss = SCIPprobdataGetServiceconss(scip);
+   convconss = SCIPprobdataGetConvconss(scip);
+   mediancons = SCIPprobdataGetMediancons(scip);
+
+   assert(nlocations >= 0);
+   assert(distances != NULL);
+   assert(mediandistances != NULL);
+   assert(alldemands != NULL);
+   assert(capacities != NULL);
+   assert(serviceconss != NULL);
+   assert(convconss != NULL);
+   assert(mediancons != NULL);
+
+   /* allocate memory */
+   SCIP_CALL( SCIPallocBufferArray(scip, &items, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &profits, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &demands, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &solitems, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &nonsolitems, nlocations) );
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &pi_service, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &pi_conv, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &rcbounds, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &pi_price, nlocations) );
+   SCIP_CALL( SCIPallocClearBufferArray(scip, &medianbounds, nlocations) );
+
+   *result = SCIP_DIDNOTRUN;
+   *lagrangebound = -SCIPinfinity(scip);
+   *improving = FALSE;
+   nrcbounds = 0;
+   ncolumns = 0;
+
+   if( useredcost )
+      ++pricerdata->stats.nrounds;
+   else
+      ++pricerdata->stats.nfarkasrounds;
+
+   /* with smoothed duals, the reduced cost bounds do not refer to the LP duals any more */
+   boundvalid = useredcost && pricerdata->lagrangebound && alpha == 0.0;
+
+   /* the reduced cost information is overwritten by this round, so it is only valid again if the round completes */
+   storeredcost = boundvalid && !SCIPinProbing(scip);
+   if( storeredcost )
+      pricerdata->redcostnode = -1;
+   updatecenter = useredcost && SCIPgetDepth(scip) == 0 && !SCIPinProbing(scip);
+
+   SCIP_CALL( SCIPstartClock(scip, pricerdata->dualclock) );
+
+   /* get the dual values; they are the same for all pricing problems */
+   for( location = 0; location < nlocations; ++location )
+   {
+      if( useredcost )
+      {
+         pi_service[location] = SCIPgetDualsolLinear(scip, serviceconss[location]);
+         pi_conv[location] = SCIPgetDualsolLinear(scip, convconss[location]);
+      }
+      else
+      {
+         pi_service[location] = SCIPgetDualfarkasLinear(scip, serviceconss[location]);
+         pi_conv[location] = SCIPgetDualfarkasLinear(scip, convconss[location]);
+      }
+   }
+   if( useredcost )
+      pi_median = SCIPgetDualsolLinear(scip, mediancons);
+   else
+      pi_median = SCIPgetDualfarkasLinear(scip, mediancons);
+
+   /* Wentges smoothing: price with a convex combination of the stability center and the current duals */
+   for( location = 0; location < nlocations; ++location )
+   {
+      if( alpha > 0.0 )
+         pi_price[location] = alpha * pricerdata->stabcenter[location] + (1.0 - alpha) * pi_service[location];
+      else
+         pi_price[location] = pi_service[location];
+   }
+
+   /* the knapsack problems only depend on the service duals; if they changed, the cached solutions are outdated */
+   updateDualSnapshot(scip, pricerdata, pi_price, nlocations, useredcost);
+
+   SCIP_CALL( SCIPstopClock(scip, pricerdata->dualclock) );
+
+   /* in capture mode, the pricing problems are recorded for the microbenchmarks; pair restrictions are not captured */
+   capturing = pricerdata->capture != NULL && pricerdata->npairs == 0
+      && SCIPcaptureStartRoundCpmp(scip, pricerdata->capture, useredcost, pi_price);
+
+   for( median = 0; median < nlocations && !SCIPisStopped(scip); ++median )
+   {
+      SCIP_Real cutoff;
+      SCIP_Real pi_open;
+      SCIP_Real reductioncutoff;
+      SCIP_Real cachedval;
+      SCIP_Real cachebound;
+      SCIP_Real upperbound;
+      SCIP_Bool cached;
+      SCIP_Bool reusable;
+      SCIP_Bool usedcache;
+      SCIP_Bool optimal;
+      int nbounded;
+
+      nitems = 0;
+
+      /* a closed median cannot get any columns; its existing columns are fixed to zero */
+      if( pricerdata->closedmedians[median] > 0 )
+      {
+         if( storeredcost )
+            pricerdata->redcostbounds[median] = SCIPinfinity(scip);
+         continue;
+      }
+
+      /* dual value of the row forcing the median to be open */
+      pi_open = 0.0;
+      if( pricerdata->openconss[median] != NULL )
+      {
+         if( useredcost )
+            pi_open = SCIPgetDualsolLinear(scip, pricerdata->openconss[median]);
+         else
+            pi_open = SCIPgetDualfarkasLinear(scip, pricerdata->openconss[median]);
+      }
+
+      /* only knapsack solutions with a profit above the cutoff yield improving columns */
+      cutoff = -pi_median - pi_conv[median] - pi_open;
+
+      if( capturing )
+         SCIPcaptureProblemCpmp(pricerdata->capture, median, cutoff, pricerdata->forbiddenassignments[median]);
+
+      /* if the restrictions did not change, the cached solution is still optimal if the duals did not change either,
+       * and there is no improving column if the duals did not increase enough since it was computed
+       */
+      cachebound = computeCacheBound(scip, pricerdata, median);
+      cached = isCacheValid(pricerdata, median) || !SCIPisPositive(scip, cachebound - cutoff);
+      if( cached )
+      {
+         nsolitems = pricerdata->ncachedsolitems[median];
+         if( nsolitems > 0 )
+            BMScopyMemoryArray(solitems, pricerdata->cachedsolitems[median], nsolitems);
+         solval = rescoreCache(pricerdata, median, pi_price, distances, useredcost);
+         upperbound = MAX(solval, cachebound);
+         success = TRUE;
+         ++pricerdata->stats.ncachehits;
+
+         SCIPdebugMessage("  -> median %d: reuse cached knapsack solution, solval = %g\n", median + 1, solval);
+      }
+      else if( pricerdata->npairs > 0 )
+      {
+         /* under pair restrictions, the items are components of locations; these solutions are not cached */
+         SCIP_CALL( SCIPstartClock(scip, pricerdata->solveclock) );
+         SCIP_CALL( solvePairedPricingProblem(scip, pricerdata, median, pi_price,
+               useredcost ? mediandistances[median] : NULL, alldemands, capacities[median], cutoff,
+               solitems, &nsolitems, &solval, &upperbound, &success) );
+         SCIP_CALL( SCIPstopClock(scip, pricerdata->solveclock) );
+         ++pricerdata->stats.npairedcalls;
+      }
+      else
+      {
+         SCIP_CALL( SCIPstartClock(scip, pricerdata->setupclock) );
+
+         /* the items are the locations which may be assigned to the median under the branching restrictions; their
+          * profits are the (possibly smoothed) duals minus, in reduced cost pricing, the distances to the median;
+          * locations with non-positive profit can never improve a knapsack solution and are left out right away
+          */
+         nitems = SCIPcomputeProfitsCpmp((CPMP_SIMDLEVEL)pricerdata->simdlevel, nlocations, pi_price,
+            useredcost ? mediandistances[median] : NULL, pricerdata->forbiddenassignments[median], alldemands,
+            items, profits, demands);
+
+         ++pricerdata->stats.nknapsacks;
+         pricerdata->stats.nlocations += nlocations;
+         pricerdata->stats.npositive += nitems;
+
+         /* the cached solution is still feasible, so its current profit is a lower bound on the optimum */
+         reusable = isCacheFeasible(pricerdata, median);
+         cachedval = reusable ? rescoreCache(pricerdata, median, pi_price, distances, useredcost) : -SCIPinfinity(scip);
+         usedcache = FALSE;
+
+         /* remove the items which cannot be part of a solution that is better than the cutoff or the cached one */
+         reductioncutoff = MAX(cutoff, cachedval);
+         nbounded = 0;
+         if( pricerdata->reduceitems )
+         {
+            int noversized;
+            int ndominated;
+
+            SCIP_CALL( SCIPreduceKnapsackCpmp(scip, pricerdata->knapsack, &nitems, demands, profits, capacities[median],
+                  items, reductioncutoff, &noversized, &ndominated, &nbounded) );
+
+            pricerdata->stats.noversized += noversized;
+            pricerdata->stats.ndominated += ndominated;
+            pricerdata->stats.nbounded += nbounded;
+         }
+         pricerdata->stats.nitems += nitems;
+
+         SCIPdebugMessage("  -> median %d: %d items after reduction (%d by bound)\n", median + 1, nitems, nbounded);
+
+         SCIP_CALL( SCIPstopClock(scip, pricerdata->setupclock) );
+         SCIP_CALL( SCIPstartClock(scip, pricerdata->solveclock) );
+
+         success = FALSE;
+         optimal = FALSE;
+         if( pricerdata->knapsackalgo == 'c' )
+         {
+            ++pricerdata->stats.nspecificcalls;
+            SCIP_CALL( SCIPsolveKnapsackCpmp(scip, pricerdata->knapsack, nitems, demands, profits, capacities[median], items,
+                  reductioncutoff, solitems, &nsolitems, &solval, &upperbound, &success) );
+
+            /* the items removed by the bound only occur in solutions up to the reduction cutoff */
+            if( nbounded > 0 )
+               upperbound = MAX(upperbound, reductioncutoff);
+
+            if( success && reusable && cachedval >= solval )
+            {
+               nsolitems = pricerdata->ncachedsolitems[median];
+               if( nsolitems > 0 )
+                  BMScopyMemoryArray(solitems, pricerdata->cachedsolitems[median], nsolitems);
+               solval = cachedval;
+               usedcache = TRUE;
+            }
+            optimal = success && SCIPisGE(scip, solval, upperbound);
+         }
+
+         /* fall back to the general knapsack solver if the specific one hit its node limit */
+         if( !success )
+         {
+            ++pricerdata->stats.nscipcalls;
+            SCIP_CALL( SCIPsolveKnapsackExactly(scip, nitems, demands, profits, capacities[median], items, solitems, nonsolitems, &nsolitems, &nnonsolitems, &solval, &success) );
+            optimal = success && (nbounded == 0 || solval > reductioncutoff);
+            upperbound = nbounded == 0 ? solval : MAX(solval, reductioncutoff);
+         }
+
+         SCIP_CALL( SCIPstopClock(scip, pricerdata->solveclock) );
+
+         if( optimal && pricerdata->usecache )
+         {
+            if( usedcache )
+            {
+               pricerdata->cachedsolvals[median] = solval;
+               pricerdata->cachedsnapshots[median] = pricerdata->dualsnapshot;
+               pricerdata->cacheddrifts[median] = pricerdata->dualdrift;
+               cached = TRUE;
+            }
+            else
+            {
+               SCIP_CALL( storeCache(scip, pricerdata, median, solitems, nsolitems, solval) );
+            }
+         }
+         else
+            cached = usedcache;
+      }
+
+      if( success )
+      {
+         SCIP_Real score;
+
+         *result = SCIP_SUCCESS;
+
+         /* with smoothing, the profit of the column w.r.t. the LP duals has to be computed */
+         if( alpha > 0.0 )
+         {
+            int i;
+
+            solval = 0.0;
+            for( i = 0; i < nsolitems; ++i )
+               solval += pi_service[solitems[i]] - distances[solitems[i]][median];
+         }
+
+         /* calculate the reduced cost or Farkas value of the new column */
+         if( useredcost )
+            score = - solval - pi_median - pi_conv[median] - pi_open;
+         else
+            score = solval + pi_median + pi_conv[median] + pi_open;
+
+         SCIPdebugMessage("  -> obj = %g\n", score);
+
+         /* no column of this median has a smaller reduced cost than the one given by the knapsack upper bound */
+         if( boundvalid && SCIPisNegative(scip, cutoff - upperbound) )
+            rcbounds[nrcbounds++] = cutoff - upperbound;
+         if( storeredcost )
+            pricerdata->redcostbounds[median] = cutoff - upperbound;
+
+         /* no cluster of this median has a smaller cost minus the (priced) service duals of its locations */
+         medianbounds[median] = -upperbound;
+
+         /* If an improving column has been found, add it; a cached column is only added once, since
+          * an existing column cannot be improving w.r.t. the same service duals again
+          */
+         if( ((SCIPisNegative(scip, score) && useredcost) || (SCIPisPositive(scip, score) && !useredcost))
+            && !(cached && pricerdata->cachedadded[median])
+            && !isClusterExcluded(pricerdata, median, solitems, nsolitems) )
+         {
+            SCIP_CALL( SCIPstartClock(scip, pricerdata->addclock) );
+            SCIP_CALL( addColumn(scip, median, solitems, nsolitems, score, pricerdata->openconss[median], TRUE, NULL) );
+            SCIP_CALL( SCIPstopClock(scip, pricerdata->addclock) );
+            *improving = TRUE;
+            ++ncolumns;
+
+            if( useredcost )
+               recordImprovingColumn(pricerdata, score);
+
+            if( pricerdata->usecache )
+               pricerdata->cachedadded[median] = TRUE;
+         }
+      }
+      else
+      {
+         SCIPwarningMessage(scip, "Pricing problem for median %d could not be solved!\n", median + 1);
+         ++pricerdata->stats.nfailed;
+         boundvalid = FALSE;
+         updatecenter = FALSE;
+      }
+   }
+
+   if( capturing )
+      SCIPcaptureEndRoundCpmp(pricerdata->capture);
+
+   /* Lagrangian bound: since each median has at most one column and at most nclusters columns are chosen, no solution
+    * of the node is better than the LP value plus the nclusters most negative reduced cost bounds
+    */
+   if( boundvalid && median == nlocations )
+   {
+      int i;
+
+      SCIPsortReal(rcbounds, nrcbounds);
+
+      *lagrangebound = SCIPgetLPObjval(scip);
+      for( i = 0; i < nrcbounds && i < nclusters; ++i )
+         *lagrangebound += rcbounds[i];
+
+      SCIPdebugMessage("Lagrangian bound: %g (LP value %g)\n", *lagrangebound, SCIPgetLPObjval(scip));
+
+      if( storeredcost )
+      {
+         pricerdata->redcostnode = SCIPnodeGetNumber(SCIPgetCurrentNode(scip));
+         pricerdata->redcostlpobj = SCIPgetLPObjval(scip);
+         BMScopyMemoryArray(pricerdata->redcostduals, pi_service, nlocations);
+      }
+   }
+
+   /* relaxing only the service constraints gives a Lagrangian bound for the priced duals, which may become the new
+    * stability center
+    */
+   if( updatecenter && median == nlocations )
+   {
+      SCIP_Real centerbound;
+
+      SCIP_CALL( updateStabilityCenter(scip, pricerdata, pi_price, medianbounds, &centerbound) );
+      *lagrangebound = MAX(*lagrangebound, centerbound);
+   }
+
+   pricerdata->stats.ncolumns += ncolumns;
+   pricerdata->stats.maxroundcolumns = MAX(pricerdata->stats.maxroundcolumns, ncolumns);
+   pricerdata->stats.dualtime = SCIPgetClockTime(scip, pricerdata->dualclock);
+   pricerdata->stats.setuptime = SCIPgetClockTime(scip, pricerdata->setupclock);
+   pricerdata->stats.solvetime = SCIPgetClockTime(scip, pricerdata->solveclock);
+   pricerdata->stats.addtime = SCIPgetClockTime(scip, pricerdata->addclock);
+
+   SCIPfreeBufferArray(scip, &medianbounds);
+   SCIPfreeBufferArray(scip, &pi_price);
+   SCIPfreeBufferArray(scip, &rcbounds);
+   SCIPfreeBufferArray(scip, &pi_conv);
+   SCIPfreeBufferArray(scip, &pi_service);
+
+   SCIPfreeBufferArray(scip, &nonsolitems);
+   SCIPfreeBufferArray(scip, &solitems);
+   SCIPfreeBufferArray(scip, &demands);
+   SCIPfreeBufferArray(scip, &profits);
+   SCIPfreeBufferArray(scip, &items);
+
+   return SCIP_OKAY;
+}
+
+/** decides whether column generation at the current node can stop early: if the node bound shows that the node cannot
+ *  beat the incumbent, if the LP value cannot improve the node bound any more, or if the LP value is tailing off
+ */
+static
+SCIP_Bool isPricingFinished(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_PRICERDATA*      pricerdata,         /* pricer data structure                                */
+   SCIP_Real             lowerbound          /* lower bound found in this round, or -infinity        */
+   )
+{
+   SCIP_Longint nodenumber;
+   SCIP_Real lpobj;
+
+   nodenumber = SCIPnodeGetNumber(SCIPgetCurrentNode(scip));
+   lpobj = SCIPgetLPObjval(scip);
+
+   if( nodenumber != pricerdata->boundnode )
+   {
+      pricerdata->boundnode = nodenumber;
+      pricerdata->nodebound = -SCIPinfinity(scip);
+      pricerdata->lastlpobj = SCIPinfinity(scip);
+      pricerdata->ntailingrounds = 0;
+   }
+   pricerdata->nodebound = MAX(pricerdata->nodebound, lowerbound);
+
+   /* tailing off: count the consecutive rounds in which the LP value hardly decreased */
+   if( pricerdata->tailingoffrounds > 0 )
+   {
+      if( !SCIPisInfinity(scip, pricerdata->lastlpobj)
+         && pricerdata->lastlpobj - lpobj < pricerdata->tailingoffrel * MAX(REALABS(lpobj), 1.0) )
+         ++pricerdata->ntailingrounds;
+      else
+         pricerdata->ntailingrounds = 0;
+   }
+   pricerdata->lastlpobj = lpobj;
+
+   if( SCIPisInfinity(scip, -pricerdata->nodebound) )
+      return pricerdata->tailingoffrounds > 0 && pricerdata->ntailingrounds >= pricerdata->tailingoffrounds;
+
+   /* the node cannot contain a solution better than the incumbent */
+   if( SCIPisGE(scip, pricerdata->nodebound, SCIPgetCutoffbound(scip)) )
+   {
+      SCIPdebugMessage("stop pricing: node bound %g reaches cutoff bound %g\n", pricerdata->nodebound, SCIPgetCutoffbound(scip));
+      return TRUE;
+   }
+
+   /* further columns cannot improve the (rounded) node bound, or only within the accepted gap */
+   if( SCIPisLE(scip, lpobj, pricerdata->nodebound)
+      || (lpobj - pricerdata->nodebound) / MAX(REALABS(pricerdata->nodebound), 1.0) <= pricerdata->earlystopgap )
+   {
+      SCIPdebugMessage("stop pricing: LP value %g, node bound %g\n", lpobj, pricerdata->nodebound);
+      return TRUE;
+   }
+
+   return pricerdata->tailingoffrounds > 0 && pricerdata->ntailingrounds >= pricerdata->tailingoffrounds;
+}
+
+/*
+ * Callback methods of variable pricer
+ */
+
+/** destructor of variable pricer to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_PRICERFREE(pricerFreeCpmp)
+{  /*lint --e{715}*/
+   SCIP_PRICERDATA* pricerdata;
+
+   pricerdata = SCIPpricerGetData(pricer);
+   assert(pricerdata != NULL);
+
+   SCIPfreeMemoryArrayNull(scip, &pricerdata->initmedianbounds);
+   SCIPfreeMemoryArrayNull(scip, &pricerdata->initstabcenter);
+
+   SCIPfreeMemory(scip, &pricerdata);
+   SCIPpricerSetData(pricer, NULL);
+
+   return SCIP_OKAY;
+}
+
+
+/** solving process initialization method of variable pricer (called when branch and bound process is about to begin) */
+static
+SCIP_DECL_PRICERINITSOL(pricerInitsolCpmp)
+{  /*lint --e{715}*/
+   SCIP_PRICERDATA* pricerdata;
+   int nlocations;
+   int i;
+
+   pricerdata = SCIPpricerGetData(pricer);
+   assert(pricerdata != NULL);
+
+   nlocations = SCIPprobdataGetNLocations(scip);
+
+   SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->forbiddenassignments, nlocations) );
+   for( i = 0; i < nlocations; ++i )
+   {
+      SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->forbiddenassignments[i], nlocations) );
+      BMSclearMemoryArray(pricerdata->forbiddenassignments[i], nlocations);
+   }
+   SCIP_CALL( SCIPallocClearMemoryArray(scip, &pricerdata->forbiddenhashes, nlocations) );
+   pricerdata->pairhash = 0;
+
+   /* initialize the pricing result cache; snapshot 0 is never valid, so all entries start out outdated */
+   SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->lastduals, nlocations) );
+   SCIP_CALL( SCIPallocClearMemoryArray(scip, &pricerdata->cachedsolitems, nlocations) );
+   SCIP_CALL( SCIPallocClearMemoryArray(scip, &pricerdata->ncachedsolitems, nlocations) );
+   SCIP_CALL( SCIPallocClearMemoryArray(scip, &pricerdata->cachedsolvals, nlocations) );
+   SCIP_CALL( SCIPallocClearMemoryArray(scip, &pricerdata->cachedsnapshots, nlocations) );
+   SCIP_CALL( SCIPallocClearMemoryArray(scip, &pricerdata->cachedhashes, nlocations) );
+   SCIP_CALL( SCIPallocClearMemoryArray(scip, &pricerdata->cacheddrifts, nlocations) );
+   SCIP_CALL( SCIPallocClearMemoryArray(scip, &pricerdata->cachedadded, nlocations) );
+   pricerdata->lastuseredcost = TRUE;
+   pricerdata->dualsnapshot = 0;
+   pricerdata->typesnapshot = 0;
+   pricerdata->dualdrift = 0.0;
+
+   SCIP_CALL( SCIPallocClearMemoryArray(scip, &pricerdata->closedmedians, nlocations) );
+   SCIP_CALL( SCIPallocClearMemoryArray(scip, &pricerdata->openconss, nlocations) );
+   pricerdata->pairlocations1 = NULL;
+   pricerdata->pairlocations2 = NULL;
+   pricerdata->pairsame = NULL;
+   pricerdata->npairs = 0;
+   pricerdata->pairssize = 0;
+   pricerdata->excludedcols = NULL;
+   pricerdata->nexcludedcols = 0;
+   pricerdata->excludedcolssize = 0;
+
+   BMSclearMemory(&pricerdata->stats);
+   pricerdata->stats.rootlagrangebound = -SCIPinfinity(scip);
+
+   SCIP_CALL( SCIPcreateClock(scip, &pricerdata->dualclock) );
+   SCIP_CALL( SCIPcreateClock(scip, &pricerdata->setupclock) );
+   SCIP_CALL( SCIPcreateClock(scip, &pricerdata->solveclock) );
+   SCIP_CALL( SCIPcreateClock(scip, &pricerdata->addclock) );
+   SCIP_CALL( SCIPcreateWallClock(scip, &pricerdata->roundclock) );
+   pricerdata->boundnode = -1;
+
+   SCIP_CALL( openTrace(scip, pricerdata) );
+
+   pricerdata->capture = NULL;
+   if( pricerdata->capturefile[0] != '\0' )
+   {
+      SCIP_CALL( SCIPcreateCaptureWriterCpmp(scip, &pricerdata->capture, pricerdata->capturefile,
+            pricerdata->capturemaxrounds) );
+   }
+
+   SCIP_CALL( SCIPallocClearMemoryArray(scip, &pricerdata->stabcenter, nlocations) );
+   SCIP_CALL( SCIPallocClearMemoryArray(scip, &pricerdata->rootmedianbounds, nlocations) );
+   SCIP_CALL( SCIPallocClearMemoryArray(scip, &pricerdata->eliminated, nlocations) );
+   pricerdata->lagrangedone = FALSE;
+   pricerdata->rootbound = -SCIPinfinity(scip);
+   pricerdata->rootthreshold = 0.0;
+   pricerdata->elimcutoff = SCIPinfinity(scip);
+   pricerdata->elimoutdated = FALSE;
+
+   /* start with a stability center which was set before the solve; the Lagrangian relaxation is not repeated */
+   if( pricerdata->initstabcenter != NULL )
+   {
+      BMScopyMemoryArray(pricerdata->stabcenter, pricerdata->initstabcenter, nlocations);
+      BMScopyMemoryArray(pricerdata->rootmedianbounds, pricerdata->initmedianbounds, nlocations);
+      pricerdata->lagrangedone = TRUE;
+      pricerdata->rootbound = pricerdata->initrootbound;
+      pricerdata->rootthreshold = pricerdata->initthreshold;
+      pricerdata->elimoutdated = TRUE;
+
+      SCIPfreeMemoryArray(scip, &pricerdata->initmedianbounds);
+      SCIPfreeMemoryArray(scip, &pricerdata->initstabcenter);
+   }
+
+   SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->redcostbounds, nlocations) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->redcostduals, nlocations) );
+   pricerdata->redcostnode = -1;
+
+   SCIP_CALL( SCIPcreateKnapsackCpmp(scip, &pricerdata->knapsack, pricerdata->maxdpcells, pricerdata->maxbbnodes) );
+
+   return SCIP_OKAY;
+}
+
+
+/** solving process deinitialization method of variable pricer (called before branch and bound process data is freed) */
+static
+SCIP_DECL_PRICEREXITSOL(pricerExitsolCpmp)
+{  /*lint --e{715}*/
+   SCIP_PRICERDATA* pricerdata;
+   int nlocations;
+   int i;
+
+   pricerdata = SCIPpricerGetData(pricer);
+   assert(pricerdata != NULL);
+
+   nlocations = SCIPprobdataGetNLocations(scip);
+
+   SCIPfreeKnapsackCpmp(scip, &pricerdata->knapsack);
+
+   closeTrace(scip, pricerdata);
+   SCIPfreeCaptureWriterCpmp(scip, &pricerdata->capture);
+
+   SCIP_CALL( SCIPfreeClock(scip, &pricerdata->roundclock) );
+   SCIP_CALL( SCIPfreeClock(scip, &pricerdata->addclock) );
+   SCIP_CALL( SCIPfreeClock(scip, &pricerdata->solveclock) );
+   SCIP_CALL( SCIPfreeClock(scip, &pricerdata->setupclock) );
+   SCIP_CALL( SCIPfreeClock(scip, &pricerdata->dualclock) );
+
+   SCIPfreeMemoryArray(scip, &pricerdata->redcostduals);
+   SCIPfreeMemoryArray(scip, &pricerdata->redcostbounds);
+   SCIPfreeMemoryArray(scip, &pricerdata->eliminated);
+   SCIPfreeMemoryArray(scip, &pricerdata->rootmedianbounds);
+   SCIPfreeMemoryArray(scip, &pricerdata->stabcenter);
+
+   SCIPfreeMemoryArrayNull(scip, &pricerdata->excludedcols);
+   SCIPfreeMemoryArrayNull(scip, &pricerdata->pairsame);
+   SCIPfreeMemoryArrayNull(scip, &pricerdata->pairlocations2);
+   SCIPfreeMemoryArrayNull(scip, &pricerdata->pairlocations1);
+   SCIPfreeMemoryArray(scip, &pricerdata->openconss);
+   SCIPfreeMemoryArray(scip, &pricerdata->closedmedians);
+
+   for( i = 0; i < nlocations; ++i )
+   {
+      SCIPfreeMemoryArrayNull(scip, &pricerdata->cachedsolitems[i]);
+   }
+   SCIPfreeMemoryArray(scip, &pricerdata->cachedadded);
+   SCIPfreeMemoryArray(scip, &pricerdata->cacheddrifts);
+   SCIPfreeMemoryArray(scip, &pricerdata->cachedhashes);
+   SCIPfreeMemoryArray(scip, &pricerdata->cachedsnapshots);
+   SCIPfreeMemoryArray(scip, &pricerdata->cachedsolvals);
+   SCIPfreeMemoryArray(scip, &pricerdata->ncachedsolitems);
+   SCIPfreeMemoryArray(scip, &pricerdata->cachedsolitems);
+   SCIPfreeMemoryArray(scip, &pricerdata->lastduals);
+
+   SCIPfreeMemoryArray(scip, &pricerdata->forbiddenhashes);
+   for( i = 0; i < nlocations; ++i )
+   {
+      SCIPfreeMemoryArray(scip, &pricerdata->forbiddenassignments[i]);
+   }
+   SCIPfreeMemoryArray(scip, &pricerdata->forbiddenassignments);
+
+   return SCIP_OKAY;
+}
+
+
+/** reduced cost pricing method of variable pricer for feasible LPs */
+static
+SCIP_DECL_PRICERREDCOST(pricerRedcostCpmp)
+{  /*lint --e{715}*/
+   SCIP_PRICERDATA* pricerdata;
+   SCIP_Real lagrangebound;
+   SCIP_Real alpha;
+   SCIP_Bool improving;
+   SCIP_Bool atroot;
+   SCIP_Longint ncolumns;
+
+   pricerdata = SCIPpricerGetData(pricer);
+   assert(pricerdata != NULL);
+
+   ncolumns = pricerdata->stats.ncolumns;
+   pricerdata->roundminredcost = 0.0;
+   if( pricerdata->trace != NULL )
+   {
+      SCIP_CALL( SCIPstartClock(scip, pricerdata->roundclock) );
+   }
+
+   atroot = SCIPgetDepth(scip) == 0 && !SCIPinProbing(scip);
+
+   /* the Lagrangian relaxation provides a root bound and a stability center before the first columns are priced */
+   if( atroot && !pricerdata->lagrangedone && pricerdata->lagrangeiters > 0 )
+   {
+      SCIP_CALL( solveLagrangianRelaxation(scip, pricerdata) );
+   }
+
+   /* dual smoothing is only applied at the root, where the stability center is meaningful */
+   alpha = atroot && !SCIPisInfinity(scip, -pricerdata->rootbound) && pricerdata->npairs == 0 ? pricerdata->smoothing : 0.0;
+
+   SCIP_CALL( performPricing(scip, pricerdata, TRUE, alpha, &lagrangebound, &improving, result) );
+
+   /* mispricing: the smoothed duals did not yield an improving column, so price with the LP duals */
+   if( alpha > 0.0 && !improving && *result == SCIP_SUCCESS )
+   {
+      SCIP_Real lpbound;
+
+      ++pricerdata->stats.nmisprices;
+      SCIP_CALL( performPricing(scip, pricerdata, TRUE, 0.0, &lpbound, &improving, result) );
+      lagrangebound = MAX(lagrangebound, lpbound);
+   }
+
+   if( atroot )
+   {
+      lagrangebound = MAX(lagrangebound, pricerdata->rootbound);
+      SCIP_CALL( eliminateMedians(scip, pricerdata) );
+      pricerdata->stats.roottime = SCIPgetSolvingTime(scip);
+   }
+
+   if( !SCIPisInfinity(scip, -lagrangebound) )
+   {
+      /* all column costs are integral, so is the objective value of every solution of the node */
+      *lowerbound = SCIPceil(scip, lagrangebound);
+      ++pricerdata->stats.nlagrangebounds;
+   }
+
+   *stopearly = isPricingFinished(scip, pricerdata, *lowerbound);
+   if( *stopearly )
+      ++pricerdata->stats.nearlystops;
+
+   if( pricerdata->trace != NULL )
+   {
+      SCIP_CALL( traceRound(scip, pricerdata, TRUE, lagrangebound, pricerdata->stats.ncolumns - ncolumns) );
+   }
+
+   return SCIP_OKAY;
+}
+
+
+/** Farkas pricing method of variable pricer for infeasible LPs */
+static
+SCIP_DECL_PRICERFARKAS(pricerFarkasCpmp)
+{  /*lint --e{715}*/
+   SCIP_PRICERDATA* pricerdata;
+   SCIP_Real lagrangebound;
+   SCIP_Bool improving;
+   SCIP_Longint ncolumns;
+
+   pricerdata = SCIPpricerGetData(pricer);
+   assert(pricerdata != NULL);
+
+   ncolumns = pricerdata->stats.ncolumns;
+   pricerdata->roundminredcost = 0.0;
+   if( pricerdata->trace != NULL )
+   {
+      SCIP_CALL( SCIPstartClock(scip, pricerdata->roundclock) );
+   }
+
+   SCIP_CALL( performPricing(scip, pricerdata, FALSE, 0.0, &lagrangebound, &improving, result) );
+
+   if( pricerdata->trace != NULL )
+   {
+      SCIP_CALL( traceRound(scip, pricerdata, FALSE, lagrangebound, pricerdata->stats.ncolumns - ncolumns) );
+   }
+
+   return SCIP_OKAY;
+}
+
+
+
+
+/*
+ * variable pricer specific interface methods
+ */
+
+/** creates the cpmp variable pricer and includes it in SCIP */
+SCIP_RETCODE SCIPincludePricerCpmp(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_PRICERDATA* pricerdata;
+   SCIP_PRICER* pricer;
+
+   /* create cpmp variable pricer data */
+   pricerdata = NULL;
+   SCIP_CALL( SCIPallocMemory(scip, &pricerdata) );
+   assert(pricerdata != NULL);
+   BMSclearMemory(&pricerdata->stats);
+   pricerdata->initstabcenter = NULL;
+   pricerdata->initmedianbounds = NULL;
+
+   /* include variable pricer */
+   pricer = NULL;
+   SCIP_CALL( SCIPincludePricerBasic(scip, &pricer, PRICER_NAME, PRICER_DESC, PRICER_PRIORITY, PRICER_DELAY,
+         pricerRedcostCpmp, pricerFarkasCpmp, pricerdata) );
+   assert(pricer != NULL);
+
+   /* set non fundamental callbacks via setter functions */
+   SCIP_CALL( SCIPsetPricerFree(scip, pricer, pricerFreeCpmp) );
+   SCIP_CALL( SCIPsetPricerInitsol(scip, pricer, pricerInitsolCpmp) );
+   SCIP_CALL( SCIPsetPricerExitsol(scip, pricer, pricerExitsolCpmp) );
+
+   /* add cpmp variable pricer parameters */
+   SCIP_CALL( SCIPaddBoolParam(scip, "pricers/" PRICER_NAME "/usecache",
+         "should pricing results be cached per median and reused while the restrictions are the same and the duals did not increase enough to yield an improving column?",
+         &pricerdata->usecache, FALSE, DEFAULT_USECACHE, NULL, NULL) );
+   SCIP_CALL( SCIPaddCharParam(scip, "pricers/" PRICER_NAME "/knapsackalgo",
+         "knapsack algorithm for the pricing problems: 'c'pmp specific solver or 's'cip's general solver",
+         &pricerdata->knapsackalgo, FALSE, DEFAULT_KNAPSACKALGO, "cs", NULL, NULL) );
+   SCIP_CALL( SCIPaddLongintParam(scip, "pricers/" PRICER_NAME "/maxdpcells",
+         "maximal number of (item, capacity) cells for which the pricing knapsack is solved by dynamic programming",
+         &pricerdata->maxdpcells, TRUE, DEFAULT_MAXDPCELLS, 0LL, SCIP_LONGINT_MAX, NULL, NULL) );
+   SCIP_CALL( SCIPaddLongintParam(scip, "pricers/" PRICER_NAME "/maxbbnodes",
+         "maximal number of branch-and-bound nodes of the cpmp knapsack solver before falling back to scip's (-1: no limit)",
+         &pricerdata->maxbbnodes, TRUE, DEFAULT_MAXBBNODES, -1LL, SCIP_LONGINT_MAX, NULL, NULL) );
+   SCIP_CALL( SCIPaddBoolParam(scip, "pricers/" PRICER_NAME "/reduceitems",
+         "should the knapsack items be reduced by the capacity, dominance and bounds before solving?",
+         &pricerdata->reduceitems, FALSE, DEFAULT_REDUCEITEMS, NULL, NULL) );
+   SCIP_CALL( SCIPaddBoolParam(scip, "pricers/" PRICER_NAME "/lagrangebound",
+         "should the Lagrangian bound be computed in reduced cost pricing and passed to SCIP as lower bound?",
+         &pricerdata->lagrangebound, FALSE, DEFAULT_LAGRANGEBOUND, NULL, NULL) );
+   SCIP_CALL( SCIPaddRealParam(scip, "pricers/" PRICER_NAME "/earlystopgap",
+         "relative gap between LP value and Lagrangian bound at which pricing at a node is stopped",
+         &pricerdata->earlystopgap, FALSE, DEFAULT_EARLYSTOPGAP, 0.0, SCIP_REAL_MAX, NULL, NULL) );
+   SCIP_CALL( SCIPaddIntParam(scip, "pricers/" PRICER_NAME "/tailingoffrounds",
+         "number of consecutive rounds without sufficient LP progress after which pricing at a node is stopped (0: never)",
+         &pricerdata->tailingoffrounds, FALSE, DEFAULT_TAILINGOFFROUNDS, 0, INT_MAX, NULL, NULL) );
+   SCIP_CALL( SCIPaddRealParam(scip, "pricers/" PRICER_NAME "/tailingoffrel",
+         "minimal relative decrease of the LP value per pricing round for tailing-off control",
+         &pricerdata->tailingoffrel, FALSE, DEFAULT_TAILINGOFFREL, 0.0, 1.0, NULL, NULL) );
+   SCIP_CALL( SCIPaddIntParam(scip, "pricers/" PRICER_NAME "/simdlevel",
+         "instruction set for computing the pricing profits: 0 scalar, 1 AVX2, 2 AVX-512 (reduced to what the processor supports)",
+         &pricerdata->simdlevel, TRUE, DEFAULT_SIMDLEVEL, 0, 2, NULL, NULL) );
+   SCIP_CALL( SCIPaddIntParam(scip, "pricers/" PRICER_NAME "/lagrangeiters",
+         "maximal number of subgradient iterations of the Lagrangian relaxation before root column generation (0: off)",
+         &pricerdata->lagrangeiters, FALSE, DEFAULT_LAGRANGEITERS, 0, INT_MAX, NULL, NULL) );
+   SCIP_CALL( SCIPaddRealParam(scip, "pricers/" PRICER_NAME "/lagrangetime",
+         "time limit in seconds for the Lagrangian relaxation",
+         &pricerdata->lagrangetime, FALSE, DEFAULT_LAGRANGETIME, 0.0, SCIP_REAL_MAX, NULL, NULL) );
+   SCIP_CALL( SCIPaddRealParam(scip, "pricers/" PRICER_NAME "/smoothing",
+         "Wentges smoothing factor for the service duals towards the stability center at the root (0.0: off)",
+         &pricerdata->smoothing, FALSE, DEFAULT_SMOOTHING, 0.0, 0.99, NULL, NULL) );
+   SCIP_CALL( SCIPaddBoolParam(scip, "pricers/" PRICER_NAME "/eliminatemedians",
+         "should medians whose Lagrangian bound at the root reaches the cutoff bound be eliminated?",
+         &pricerdata->eliminatemedians, FALSE, DEFAULT_ELIMINATEMEDIANS, NULL, NULL) );
+   SCIP_CALL( SCIPaddStringParam(scip, "pricers/" PRICER_NAME "/tracefile",
+         "file to write a trace with one row per pricing round to (\"\": no trace)",
+         &pricerdata->tracefile, FALSE, DEFAULT_TRACEFILE, NULL, NULL) );
+   SCIP_CALL( SCIPaddCharParam(scip, "pricers/" PRICER_NAME "/traceformat",
+         "format of the pricing trace: 'c'sv or 'j'son lines",
+         &pricerdata->traceformat, FALSE, DEFAULT_TRACEFORMAT, "cj", NULL, NULL) );
+   SCIP_CALL( SCIPaddStringParam(scip, "pricers/" PRICER_NAME "/capturefile",
+         "file to capture the pricing problems in for replay by the microbenchmarks (\"\": no capture)",
+         &pricerdata->capturefile, FALSE, DEFAULT_CAPTUREFILE, NULL, NULL) );
+   SCIP_CALL( SCIPaddIntParam(scip, "pricers/" PRICER_NAME "/capturemaxrounds",
+         "maximal number of pricing rounds to capture (-1: no limit)",
+         &pricerdata->capturemaxrounds, FALSE, DEFAULT_CAPTUREMAXROUNDS, -1, INT_MAX, NULL, NULL) );
+
+   return SCIP_OKAY;
+}
+
+/** forbid assignments for a certain location */
+void SCIPpricerCpmpForbidAssignments(
+   SCIP*                 scip,               /**< SCIP data structure */
+   int                   location,
+   SCIP_Bool*            forbidden
+   )
+{
+   SCIP_PRICER* pricer;
+   SCIP_PRICERDATA* pricerdata;
+   int nlocations;
+
+   int median;
+
+   pricer = SCIPfindPricer(scip, PRICER_NAME);
+   assert(pricer != NULL);
+
+   pricerdata = SCIPpricerGetData(pricer);
+   assert(pricerdata != NULL);
+
+   nlocations = SCIPprobdataGetNLocations(scip);
+
+   for( median = 0; median < nlocations; ++median )
+      if( forbidden[median] && !pricerdata->forbiddenassignments[median][location] )
+      {
+         pricerdata->forbiddenassignments[median][location] = TRUE;
+         pricerdata->forbiddenhashes[median] ^= computeRestrictionKey(median, location, 0);
+      }
+
+   return;
+}
+
+/** forbid assignments for a certain location */
+void SCIPpricerCpmpForbidAssignment(
+   SCIP*                 scip,               /**< SCIP data structure */
+   int                   median,
+   int                   location
+   )
+{
+   SCIP_PRICER* pricer;
+   SCIP_PRICERDATA* pricerdata;
+
+   pricer = SCIPfindPricer(scip, PRICER_NAME);
+   assert(pricer != NULL);
+
+   pricerdata = SCIPpricerGetData(pricer);
+   assert(pricerdata != NULL);
+
+   assert(location < SCIPprobdataGetNLocations(scip) && location >= 0);
+   assert(median < SCIPprobdataGetNLocations(scip) && median >= 0);
+
+   if( !pricerdata->forbiddenassignments[median][location] )
+   {
+      pricerdata->forbiddenassignments[median][location] = TRUE;
+      pricerdata->forbiddenhashes[median] ^= computeRestrictionKey(median, location, 0);
+   }
+
+   return;
+}
+
+
+/** allow previously forbidden assignments for a certain location */
+void SCIPpricerCpmpAllowAssignments(
+   SCIP*                 scip,               /**< SCIP data structure */
+   int                   location,
+   SCIP_Bool*            forbidden
+   )
+{
+   SCIP_PRICER* pricer;
+   SCIP_PRICERDATA* pricerdata;
+   int nlocations;
+
+   int median;
+
+   pricer = SCIPfindPricer(scip, PRICER_NAME);
+   assert(pricer != NULL);
+
+   pricerdata = SCIPpricerGetData(pricer);
+   assert(pricerdata != NULL);
+
+   nlocations = SCIPprobdataGetNLocations(scip);
+
+   for( median = 0; median < nlocations; ++median )
+      if( forbidden[median] && pricerdata->forbiddenassignments[median][location] )
+      {
+         pricerdata->forbiddenassignments[median][location] = FALSE;
+         pricerdata->forbiddenhashes[median] ^= computeRestrictionKey(median, location, 0);
+      }
+
+   return;
+}
+
+/** allow assignments for a certain location */
+void SCIPpricerCpmpAllowAssignment(
+   SCIP*                 scip,               /**< SCIP data structure */
+   int                   median,
+   int                   location
+   )
+{
+   SCIP_PRICER* pricer;
+   SCIP_PRICERDATA* pricerdata;
+
+   pricer = SCIPfindPricer(scip, PRICER_NAME);
+   assert(pricer != NULL);
+
+   pricerdata = SCIPpricerGetData(pricer);
+   assert(pricerdata != NULL);
+
+   assert(location < SCIPprobdataGetNLocations(scip) && location >= 0);
+   assert(median < SCIPprobdataGetNLocations(scip) && median >= 0);
+
+   if( pricerdata->forbiddenassignments[median][location] )
+   {
+      pricerdata->forbiddenassignments[median][location] = FALSE;
+      pricerdata->forbiddenhashes[median] ^= computeRestrictionKey(median, location, 0);
+   }
+
+   return;
+}
+/** check whether a certain assignment is currently forbidden */
+SCIP_Bool SCIPpricerCpmpIsAssignmentForbidden(
+   SCIP*                 scip,               /**< SCIP data structure */
+   int                   median,
+   int                   location
+   )
+{
+   SCIP_PRICER* pricer;
+   SCIP_PRICERDATA* pricerdata;
 
-      if( success )
-      {
-         SCIP_Real score;
+   pricer = SCIPfindPricer(scip, PRICER_NAME);
+   assert(pricer != NULL);
 
-         *result = SCIP_SUCCESS;
+   pricerdata = SCIPpricerGetData(pricer);
+   assert(pricerdata != NULL);
 
-         /* ****************************************************************************************************
-          * TODO: now that a column has been calculated, calculate its reduced cost or Farkas coefficient
-          * (to be stored in 'score'); then, check whether it can be added and if so, use the addColumn()
-          * method to add it to the master problem
-          * ****************************************************************************************************
-          */
+   return pricerdata->forbiddenassignments[median][location];
+}
 
-         /* calculate the reduced cost or Farkas value of the new column */
-         if (useredcost) score = - solval - pi_median - pi_conv[median]; else score = solval + pi_median + pi_conv[median];
+/** closes a median: its pricing problem is not solved any more until it is reopened */
+void SCIPpricerCpmpCloseMedian(
+   SCIP*                 scip,               /**< SCIP data structure */
+   int                   median              /**< median to close */
+   )
+{
+   SCIP_PRICER* pricer;
+   SCIP_PRICERDATA* pricerdata;
 
-         SCIPdebugMessage("  -> obj = %g\n", score);
+   pricer = SCIPfindPricer(scip, PRICER_NAME);
+   assert(pricer != NULL);
 
-         /* If an improving column has been found, add it */
-         if( (SCIPisNegative(scip, score) && useredcost) || (SCIPisPositive(scip, score) && !useredcost) ) addColumn(scip, median, solitems, nsolitems, score);
-      }
-      else
-      {
-         SCIPwarningMessage(scip, "Pricing problem for median %d could not be solved!\n", median + 1);
-      }
-   }
-   SCIPfreeBufferArray(scip, &pi_service);
-   SCIPfreeBufferArray(scip, &pi_conv);
+   pricerdata = SCIPpricerGetData(pricer);
+   assert(pricerdata != NULL);
 
-   SCIPfreeBufferArray(scip, &nonsolitems);
-   SCIPfreeBufferArray(scip, &solitems);
-   SCIPfreeBufferArray(scip, &demands);
-   SCIPfreeBufferArray(scip, &profits);
-   SCIPfreeBufferArray(scip, &items);
+   assert(median < SCIPprobdataGetNLocations(scip) && median >= 0);
 
-   return SCIP_OKAY;
+   ++pricerdata->closedmedians[median];
 }
 
-/*
- * Callback methods of variable pricer
- */
-
-/** destructor of variable pricer to free user data (called when SCIP is exiting) */
-static
-SCIP_DECL_PRICERFREE(pricerFreeCpmp)
-{  /*lint --e{715}*/
+/** reopens a median which has been closed before */
+void SCIPpricerCpmpReopenMedian(
+   SCIP*                 scip,               /**< SCIP data structure */
+   int                   median              /**< median to reopen */
+   )
+{
+   SCIP_PRICER* pricer;
    SCIP_PRICERDATA* pricerdata;
 
+   pricer = SCIPfindPricer(scip, PRICER_NAME);
+   assert(pricer != NULL);
+
    pricerdata = SCIPpricerGetData(pricer);
    assert(pricerdata != NULL);
 
-   SCIPfreeMemory(scip, &pricerdata);
-   SCIPpricerSetData(pricer, NULL);
+   assert(median < SCIPprobdataGetNLocations(scip) && median >= 0);
+   assert(pricerdata->closedmedians[median] > 0);
 
-   return SCIP_OKAY;
+   --pricerdata->closedmedians[median];
 }
 
-
-/** solving process initialization method of variable pricer (called when branch and bound process is about to begin) */
-static
-SCIP_DECL_PRICERINITSOL(pricerInitsolCpmp)
-{  /*lint --e{715}*/
+/** excludes the cluster of a column, e.g. of a column fixed to zero while diving: the pricer does not generate a column
+ *  for it until it is included again; the pricing problems are not changed, so the pricing is not exact meanwhile
+ */
+SCIP_RETCODE SCIPpricerCpmpExcludeColumn(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_VAR*             var                 /**< column to exclude */
+   )
+{
+   SCIP_PRICER* pricer;
    SCIP_PRICERDATA* pricerdata;
-   int nlocations;
-   int i;
+
+   pricer = SCIPfindPricer(scip, PRICER_NAME);
+   assert(pricer != NULL);
 
    pricerdata = SCIPpricerGetData(pricer);
    assert(pricerdata != NULL);
 
-   nlocations = SCIPprobdataGetNLocations(scip);
+   assert(var != NULL);
 
-   SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->forbiddenassignments, nlocations) );
-   for( i = 0; i < nlocations; ++i )
+   if( pricerdata->nexcludedcols == pricerdata->excludedcolssize )
    {
-      SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->forbiddenassignments[i], nlocations) );
-      BMSclearMemoryArray(pricerdata->forbiddenassignments[i], nlocations);
+      pricerdata->excludedcolssize = SCIPcalcMemGrowSize(scip, pricerdata->nexcludedcols + 1);
+      SCIP_CALL( SCIPreallocMemoryArray(scip, &pricerdata->excludedcols, pricerdata->excludedcolssize) );
    }
 
+   pricerdata->excludedcols[pricerdata->nexcludedcols] = var;
+   ++pricerdata->nexcludedcols;
+
    return SCIP_OKAY;
 }
 
-
-/** solving process deinitialization method of variable pricer (called before branch and bound process data is freed) */
-static
-SCIP_DECL_PRICEREXITSOL(pricerExitsolCpmp)
-{  /*lint --e{715}*/
+/** includes a column again which has been excluded before */
+void SCIPpricerCpmpIncludeColumn(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_VAR*             var                 /**< column to include */
+   )
+{
+   SCIP_PRICER* pricer;
    SCIP_PRICERDATA* pricerdata;
-   int nlocations;
-   int i;
+   int c;
+
+   pricer = SCIPfindPricer(scip, PRICER_NAME);
+   assert(pricer != NULL);
 
    pricerdata = SCIPpricerGetData(pricer);
    assert(pricerdata != NULL);
 
-   nlocations = SCIPprobdataGetNLocations(scip);
-
-   for( i = 0; i < nlocations; ++i )
+   /* the columns are usually included in the reverse order of their exclusion */
+   for( c = pricerdata->nexcludedcols - 1; c >= 0; --c )
    {
-      SCIPfreeMemoryArray(scip, &pricerdata->forbiddenassignments[i]);
+      if( pricerdata->excludedcols[c] == var )
+         break;
    }
-   SCIPfreeMemoryArray(scip, &pricerdata->forbiddenassignments);
+   assert(c >= 0);
+   if( c < 0 )
+      return;
 
-   return SCIP_OKAY;
+   --pricerdata->nexcludedcols;
+   pricerdata->excludedcols[c] = pricerdata->excludedcols[pricerdata->nexcludedcols];
 }
 
-
-/** reduced cost pricing method of variable pricer for feasible LPs */
-static
-SCIP_DECL_PRICERREDCOST(pricerRedcostCpmp)
-{  /*lint --e{715}*/
+/** checks whether a median is currently closed, by branching or by elimination */
+SCIP_Bool SCIPpricerCpmpIsMedianClosed(
+   SCIP*                 scip,               /**< SCIP data structure */
+   int                   median              /**< median */
+   )
+{
+   SCIP_PRICER* pricer;
    SCIP_PRICERDATA* pricerdata;
 
+   pricer = SCIPfindPricer(scip, PRICER_NAME);
+   assert(pricer != NULL);
+
    pricerdata = SCIPpricerGetData(pricer);
    assert(pricerdata != NULL);
 
-   SCIP_CALL( performPricing(scip, pricerdata, TRUE, result) );
+   assert(median < SCIPprobdataGetNLocations(scip) && median >= 0);
 
-   return SCIP_OKAY;
+   return pricerdata->closedmedians[median] > 0;
 }
 
-
-/** Farkas pricing method of variable pricer for infeasible LPs */
-static
-SCIP_DECL_PRICERFARKAS(pricerFarkasCpmp)
-{  /*lint --e{715}*/
+/** checks whether Ryan-Foster pair restrictions are currently active; the pricing problems then treat the locations of
+ *  a pair which must be in the same cluster as one item
+ */
+SCIP_Bool SCIPpricerCpmpHasPairRestrictions(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_PRICER* pricer;
    SCIP_PRICERDATA* pricerdata;
 
+   pricer = SCIPfindPricer(scip, PRICER_NAME);
+   assert(pricer != NULL);
+
    pricerdata = SCIPpricerGetData(pricer);
    assert(pricerdata != NULL);
 
-   SCIP_CALL( performPricing(scip, pricerdata, FALSE, result) );
-
-   return SCIP_OKAY;
+   return pricerdata->npairs > 0;
 }
 
+/** sets the local row which forces a median to be open; new columns of the median are added to it, and its dual
+ *  value is taken into account in pricing; pass NULL to remove the row again
+ */
+void SCIPpricerCpmpSetOpenCons(
+   SCIP*                 scip,               /**< SCIP data structure */
+   int                   median,             /**< median which is forced to be open */
+   SCIP_CONS*            cons                /**< linear constraint forcing the median to be open, or NULL */
+   )
+{
+   SCIP_PRICER* pricer;
+   SCIP_PRICERDATA* pricerdata;
 
+   pricer = SCIPfindPricer(scip, PRICER_NAME);
+   assert(pricer != NULL);
 
+   pricerdata = SCIPpricerGetData(pricer);
+   assert(pricerdata != NULL);
 
-/*
- * variable pricer specific interface methods
- */
+   assert(median < SCIPprobdataGetNLocations(scip) && median >= 0);
+   assert(cons == NULL || pricerdata->openconss[median] == NULL);
 
-/** creates the cpmp variable pricer and includes it in SCIP */
-SCIP_RETCODE SCIPincludePricerCpmp(
-   SCIP*                 scip                /**< SCIP data structure */
+   pricerdata->openconss[median] = cons;
+}
+
+/** requires that two locations are either assigned to the same median or not to the same median in all new columns */
+SCIP_RETCODE SCIPpricerCpmpAddPair(
+   SCIP*                 scip,               /**< SCIP data structure */
+   int                   location1,          /**< first location of the pair */
+   int                   location2,          /**< second location of the pair */
+   SCIP_Bool             same                /**< must the locations be in the same cluster (or in different ones)? */
    )
 {
-   SCIP_PRICERDATA* pricerdata;
    SCIP_PRICER* pricer;
+   SCIP_PRICERDATA* pricerdata;
+   int nlocations;
 
-   /* create cpmp variable pricer data */
-   pricerdata = NULL;
-   SCIP_CALL( SCIPallocMemory(scip, &pricerdata) );
+   pricer = SCIPfindPricer(scip, PRICER_NAME);
+   assert(pricer != NULL);
+
+   pricerdata = SCIPpricerGetData(pricer);
    assert(pricerdata != NULL);
 
-   /* include variable pricer */
-   pricer = NULL;
-   SCIP_CALL( SCIPincludePricerBasic(scip, &pricer, PRICER_NAME, PRICER_DESC, PRICER_PRIORITY, PRICER_DELAY,
-         pricerRedcostCpmp, pricerFarkasCpmp, pricerdata) );
-   assert(pricer != NULL);
+   nlocations = SCIPprobdataGetNLocations(scip);
+   assert(location1 < nlocations && location1 >= 0);
+   assert(location2 < nlocations && location2 >= 0);
 
-   /* set non fundamental callbacks via setter functions */
-   SCIP_CALL( SCIPsetPricerFree(scip, pricer, pricerFreeCpmp) );
-   SCIP_CALL( SCIPsetPricerInitsol(scip, pricer, pricerInitsolCpmp) );
-   SCIP_CALL( SCIPsetPricerExitsol(scip, pricer, pricerExitsolCpmp) );
+   if( pricerdata->npairs == pricerdata->pairssize )
+   {
+      pricerdata->pairssize = SCIPcalcMemGrowSize(scip, pricerdata->npairs + 1);
+      SCIP_CALL( SCIPreallocMemoryArray(scip, &pricerdata->pairlocations1, pricerdata->pairssize) );
+      SCIP_CALL( SCIPreallocMemoryArray(scip, &pricerdata->pairlocations2, pricerdata->pairssize) );
+      SCIP_CALL( SCIPreallocMemoryArray(scip, &pricerdata->pairsame, pricerdata->pairssize) );
+   }
+
+   pricerdata->pairlocations1[pricerdata->npairs] = location1;
+   pricerdata->pairlocations2[pricerdata->npairs] = location2;
+   pricerdata->pairsame[pricerdata->npairs] = same;
+   ++pricerdata->npairs;
+
+   /* the restriction changes the pricing problems of all medians; the keys are added, since a pair may occur twice */
+   pricerdata->pairhash += computeRestrictionKey(location1, location2, same ? 2 : 1);
 
    return SCIP_OKAY;
 }
 
-/** forbid assignments for a certain location */
-void SCIPpricerCpmpForbidAssignments(
+/** removes a pair restriction which has been added before */
+void SCIPpricerCpmpRemovePair(
    SCIP*                 scip,               /**< SCIP data structure */
-   int                   location,
-   SCIP_Bool*            forbidden
+   int                   location1,          /**< first location of the pair */
+   int                   location2,          /**< second location of the pair */
+   SCIP_Bool             same                /**< must the locations be in the same cluster (or in different ones)? */
    )
 {
    SCIP_PRICER* pricer;
    SCIP_PRICERDATA* pricerdata;
-   int nlocations;
-
-   int median;
+   int i;
 
    pricer = SCIPfindPricer(scip, PRICER_NAME);
    assert(pricer != NULL);
@@ -423,20 +2226,35 @@ void SCIPpricerCpmpForbidAssignments(
    pricerdata = SCIPpricerGetData(pricer);
    assert(pricerdata != NULL);
 
-   nlocations = SCIPprobdataGetNLocations(scip);
+   /* the restrictions are usually removed in the reverse order of their addition */
+   for( i = pricerdata->npairs - 1; i >= 0; --i )
+   {
+      if( pricerdata->pairlocations1[i] == location1 && pricerdata->pairlocations2[i] == location2
+         && pricerdata->pairsame[i] == same )
+         break;
+   }
+   assert(i >= 0);
+   if( i < 0 )
+      return;
 
-   for( median = 0; median < nlocations; ++median )
-      if( forbidden[median] )
-         pricerdata->forbiddenassignments[median][location] = TRUE;
+   --pricerdata->npairs;
+   pricerdata->pairlocations1[i] = pricerdata->pairlocations1[pricerdata->npairs];
+   pricerdata->pairlocations2[i] = pricerdata->pairlocations2[pricerdata->npairs];
+   pricerdata->pairsame[i] = pricerdata->pairsame[pricerdata->npairs];
 
-   return;
+   pricerdata->pairhash -= computeRestrictionKey(location1, location2, same ? 2 : 1);
 }
 
-/** forbid assignments for a certain location */
-void SCIPpricerCpmpForbidAssignment(
+/** creates a column for a cluster outside of pricing, e.g. for a solution found by a heuristic, and adds it to the
+ *  master problem; if the column violates the branching restrictions of the current node, it is fixed to zero there;
+ *  in the problem stage, the column is added to the original problem
+ */
+SCIP_RETCODE SCIPpricerCpmpAddColumn(
    SCIP*                 scip,               /**< SCIP data structure */
-   int                   median,
-   int                   location
+   int                   median,             /**< median of the cluster */
+   int*                  locations,          /**< locations contained in the cluster */
+   int                   nlocations,         /**< number of locations */
+   SCIP_VAR**            var                 /**< pointer to store the captured column */
    )
 {
    SCIP_PRICER* pricer;
@@ -448,27 +2266,42 @@ void SCIPpricerCpmpForbidAssignment(
    pricerdata = SCIPpricerGetData(pricer);
    assert(pricerdata != NULL);
 
-   assert(location < SCIPprobdataGetNLocations(scip) && location >= 0);
    assert(median < SCIPprobdataGetNLocations(scip) && median >= 0);
+   assert(var != NULL);
 
-   pricerdata->forbiddenassignments[median][location] = TRUE;
+   /* a column of the original problem, e.g. of a solution found by another SCIP, is not subject to any branching */
+   if( SCIPgetStage(scip) == SCIP_STAGE_PROBLEM )
+   {
+      SCIP_CALL( addColumn(scip, median, locations, nlocations, 0.0, NULL, FALSE, var) );
+      return SCIP_OKAY;
+   }
 
-   return;
-}
+   SCIP_CALL( addColumn(scip, median, locations, nlocations, 0.0, pricerdata->openconss[median], FALSE, var) );
 
+   /* the constraint handlers only propagate the branching decisions of the current path to columns which
+    * exist when a node is entered, so a violating column is excluded here for the current subtree
+    */
+   if( !isColumnAllowed(pricerdata, *var) )
+   {
+      SCIP_CALL( SCIPchgVarUbNode(scip, SCIPgetCurrentNode(scip), *var, 0.0) );
+   }
 
-/** allow previously forbidden assignments for a certain location */
-void SCIPpricerCpmpAllowAssignments(
+   return SCIP_OKAY;
+}
+
+/** returns the reduced cost information of the last complete reduced cost pricing round if it belongs to the current
+ *  node: the LP value of the round, for each median a lower bound on the reduced costs of its columns (infinity for
+ *  closed medians), and the service duals; returns FALSE if there is no such information
+ */
+SCIP_Bool SCIPpricerCpmpGetRedcostData(
    SCIP*                 scip,               /**< SCIP data structure */
-   int                   location,
-   SCIP_Bool*            forbidden
+   SCIP_Real*            lpobj,              /**< pointer to store the LP value of the round */
+   SCIP_Real**           rcbounds,           /**< pointer to store the reduced cost bounds of the medians */
+   SCIP_Real**           duals               /**< pointer to store the service duals */
    )
 {
    SCIP_PRICER* pricer;
    SCIP_PRICERDATA* pricerdata;
-   int nlocations;
-
-   int median;
 
    pricer = SCIPfindPricer(scip, PRICER_NAME);
    assert(pricer != NULL);
@@ -476,20 +2309,30 @@ void SCIPpricerCpmpAllowAssignments(
    pricerdata = SCIPpricerGetData(pricer);
    assert(pricerdata != NULL);
 
-   nlocations = SCIPprobdataGetNLocations(scip);
+   assert(lpobj != NULL);
+   assert(rcbounds != NULL);
+   assert(duals != NULL);
 
-   for( median = 0; median < nlocations; ++median )
-      if( forbidden[median] )
-         pricerdata->forbiddenassignments[median][location] = FALSE;
+   if( pricerdata->redcostnode == -1 || pricerdata->redcostnode != SCIPnodeGetNumber(SCIPgetCurrentNode(scip)) )
+      return FALSE;
 
-   return;
+   *lpobj = pricerdata->redcostlpobj;
+   *rcbounds = pricerdata->redcostbounds;
+   *duals = pricerdata->redcostduals;
+
+   return TRUE;
 }
 
-/** allow assignments for a certain location */
-void SCIPpricerCpmpAllowAssignment(
+/** returns the stability center of the Lagrangian bound at the root: the service duals, the lower bounds on the
+ *  cluster values of the medians, the Lagrangian bound and the nclusters-th smallest median bound; returns FALSE if
+ *  there is no stability center yet
+ */
+SCIP_Bool SCIPpricerCpmpGetStabilityCenter(
    SCIP*                 scip,               /**< SCIP data structure */
-   int                   median,
-   int                   location
+   SCIP_Real**           center,             /**< pointer to store the service duals of the stability center */
+   SCIP_Real**           medianbounds,       /**< pointer to store the median bounds at the stability center */
+   SCIP_Real*            bound,              /**< pointer to store the Lagrangian bound at the stability center */
+   SCIP_Real*            threshold           /**< pointer to store the nclusters-th smallest median bound */
    )
 {
    SCIP_PRICER* pricer;
@@ -501,22 +2344,39 @@ void SCIPpricerCpmpAllowAssignment(
    pricerdata = SCIPpricerGetData(pricer);
    assert(pricerdata != NULL);
 
-   assert(location < SCIPprobdataGetNLocations(scip) && location >= 0);
-   assert(median < SCIPprobdataGetNLocations(scip) && median >= 0);
+   assert(center != NULL);
+   assert(medianbounds != NULL);
+   assert(bound != NULL);
+   assert(threshold != NULL);
 
-   pricerdata->forbiddenassignments[median][location] = FALSE;
+   if( SCIPgetStage(scip) < SCIP_STAGE_INITSOLVE || SCIPgetStage(scip) > SCIP_STAGE_SOLVED
+      || SCIPisInfinity(scip, -pricerdata->rootbound) )
+      return FALSE;
 
-   return;
+   *center = pricerdata->stabcenter;
+   *medianbounds = pricerdata->rootmedianbounds;
+   *bound = pricerdata->rootbound;
+   *threshold = pricerdata->rootthreshold;
+
+   return TRUE;
 }
-/** check whether a certain assignment is currently forbidden */
-SCIP_Bool SCIPpricerCpmpIsAssignmentForbidden(
+
+/** sets the stability center the next solve starts with instead of solving the Lagrangian relaxation (e.g., the one of
+ *  an earlier run); the arrays are copied
+ */
+SCIP_RETCODE SCIPpricerCpmpSetStabilityCenter(
    SCIP*                 scip,               /**< SCIP data structure */
-   int                   median,
-   int                   location
+   SCIP_Real*            center,             /**< service duals of the stability center */
+   SCIP_Real*            medianbounds,       /**< lower bounds on the cluster values of the medians at the center */
+   SCIP_Real             bound,              /**< Lagrangian bound at the stability center */
+   SCIP_Real             threshold           /**< nclusters-th smallest median bound at the stability center */
    )
 {
    SCIP_PRICER* pricer;
    SCIP_PRICERDATA* pricerdata;
+   int nlocations;
+
+   assert(SCIPgetStage(scip) == SCIP_STAGE_PROBLEM);
 
    pricer = SCIPfindPricer(scip, PRICER_NAME);
    assert(pricer != NULL);
@@ -524,5 +2384,32 @@ SCIP_Bool SCIPpricerCpmpIsAssignmentForbidden(
    pricerdata = SCIPpricerGetData(pricer);
    assert(pricerdata != NULL);
 
-   return pricerdata->forbiddenassignments[median][location];
+   nlocations = SCIPprobdataGetNLocations(scip);
+
+   SCIPfreeMemoryArrayNull(scip, &pricerdata->initmedianbounds);
+   SCIPfreeMemoryArrayNull(scip, &pricerdata->initstabcenter);
+
+   SCIP_CALL( SCIPduplicateMemoryArray(scip, &pricerdata->initstabcenter, center, nlocations) );
+   SCIP_CALL( SCIPduplicateMemoryArray(scip, &pricerdata->initmedianbounds, medianbounds, nlocations) );
+   pricerdata->initrootbound = bound;
+   pricerdata->initthreshold = threshold;
+
+   return SCIP_OKAY;
+}
+
+/** returns the statistics of the cpmp pricer */
+const CPMP_PRICERSTATS* SCIPpricerCpmpGetStats(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_PRICER* pricer;
+   SCIP_PRICERDATA* pricerdata;
+
+   pricer = SCIPfindPricer(scip, PRICER_NAME);
+   assert(pricer != NULL);
+
+   pricerdata = SCIPpricerGetData(pricer);
+   assert(pricerdata != NULL);
+
+   return &pricerdata->stats;
 }
@@ -31,6 +31,47 @@
 extern "C" {
 #endif
 
+/** number of buckets of the histogram of improving reduced costs: bucket b counts the reduced costs in
+ *  (-10^(CPMP_NRCBUCKETS-1-b), -10^(CPMP_NRCBUCKETS-2-b)], the first one is unbounded and the last one is (-1, 0)
+ */
+#define CPMP_NRCBUCKETS 6
+
+/** statistics of the cpmp pricer */
+struct CPMP_PricerStats
+{
+   SCIP_Longint          nrounds;            /**< number of reduced cost pricing rounds                              */
+   SCIP_Longint          nfarkasrounds;      /**< number of Farkas pricing rounds                                    */
+   SCIP_Longint          ncachehits;         /**< number of pricing problems answered by the result cache            */
+   SCIP_Longint          nspecificcalls;     /**< number of calls of the cpmp specific knapsack solver               */
+   SCIP_Longint          nscipcalls;         /**< number of calls of scip's knapsack solver, e.g. as fallback        */
+   SCIP_Longint          npairedcalls;       /**< number of knapsack problems with conflicts solved as sub-SCIPs     */
+   SCIP_Longint          nfailed;            /**< number of pricing problems which could not be solved               */
+   SCIP_Longint          ncolumns;           /**< number of columns added                                            */
+   int                   maxroundcolumns;    /**< maximal number of columns added in a single round                  */
+   SCIP_Real             dualtime;           /**< time for extracting the duals                                      */
+   SCIP_Real             setuptime;          /**< time for setting up and reducing the knapsack problems             */
+   SCIP_Real             solvetime;          /**< time for solving the knapsack problems                             */
+   SCIP_Real             addtime;            /**< time for adding columns                                            */
+   SCIP_Real             roottime;           /**< solving time at the end of the last pricing round at the root      */
+   SCIP_Longint          rchistogram[CPMP_NRCBUCKETS]; /**< histogram of the reduced costs of improving columns      */
+   SCIP_Real             minredcost;         /**< most negative reduced cost of an improving column                  */
+   SCIP_Real             sumredcost;         /**< total reduced cost of the improving columns                        */
+   SCIP_Longint          nknapsacks;         /**< number of knapsack problems set up                                 */
+   SCIP_Longint          nlocations;         /**< total number of locations considered for the knapsack problems     */
+   SCIP_Longint          npositive;          /**< total number of allowed locations with positive profit             */
+   SCIP_Longint          noversized;         /**< total number of items removed since their demand exceeds capacity  */
+   SCIP_Longint          ndominated;         /**< total number of items removed by dominance                         */
+   SCIP_Longint          nbounded;           /**< total number of items removed by the knapsack bound                */
+   SCIP_Longint          nitems;             /**< total number of items passed to the knapsack solvers               */
+   SCIP_Longint          nlagrangebounds;    /**< number of reduced cost rounds which provided a Lagrangian bound    */
+   SCIP_Longint          nearlystops;        /**< number of nodes at which column generation was stopped early      */
+   SCIP_Longint          nmisprices;         /**< number of smoothed pricing rounds without an improving column     */
+   SCIP_Real             rootlagrangebound;  /**< bound of the Lagrangian relaxation before root column generation  */
+   int                   nlagrangeiters;     /**< number of subgradient iterations of the Lagrangian relaxation     */
+   int                   neliminated;        /**< number of medians eliminated by their Lagrangian bounds           */
+};
+typedef struct CPMP_PricerStats CPMP_PRICERSTATS;
+
 /** creates the cpmp variable pricer and includes it in SCIP */
 EXTERN
 SCIP_RETCODE SCIPincludePricerCpmp(
@@ -77,6 +118,135 @@ SCIP_Bool SCIPpricerCpmpIsAssignmentForbidden(
    int                   location
    );
 
+/** closes a median: its pricing problem is not solved any more until it is reopened */
+EXTERN
+void SCIPpricerCpmpCloseMedian(
+   SCIP*                 scip,               /**< SCIP data structure */
+   int                   median              /**< median to close */
+   );
+
+/** reopens a median which has been closed before */
+EXTERN
+void SCIPpricerCpmpReopenMedian(
+   SCIP*                 scip,               /**< SCIP data structure */
+   int                   median              /**< median to reopen */
+   );
+
+/** excludes the cluster of a column, e.g. of a column fixed to zero while diving: the pricer does not generate a column
+ *  for it until it is included again; the pricing problems are not changed, so the pricing is not exact meanwhile
+ */
+EXTERN
+SCIP_RETCODE SCIPpricerCpmpExcludeColumn(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_VAR*             var                 /**< column to exclude */
+   );
+
+/** includes a column again which has been excluded before */
+EXTERN
+void SCIPpricerCpmpIncludeColumn(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_VAR*             var                 /**< column to include */
+   );
+
+/** checks whether a median is currently closed, by branching or by elimination */
+EXTERN
+SCIP_Bool SCIPpricerCpmpIsMedianClosed(
+   SCIP*                 scip,               /**< SCIP data structure */
+   int                   median              /**< median */
+   );
+
+/** checks whether Ryan-Foster pair restrictions are currently active; the pricing problems then treat the locations of
+ *  a pair which must be in the same cluster as one item
+ */
+EXTERN
+SCIP_Bool SCIPpricerCpmpHasPairRestrictions(
+   SCIP*                 scip                /**< SCIP data structure */
+   );
+
+/** sets the local row which forces a median to be open; new columns of the median are added to it, and its dual
+ *  value is taken into account in pricing; pass NULL to remove the row again
+ */
+EXTERN
+void SCIPpricerCpmpSetOpenCons(
+   SCIP*                 scip,               /**< SCIP data structure */
+   int                   median,             /**< median which is forced to be open */
+   SCIP_CONS*            cons                /**< linear constraint forcing the median to be open, or NULL */
+   );
+
+/** requires that two locations are either assigned to the same median or not to the same median in all new columns */
+EXTERN
+SCIP_RETCODE SCIPpricerCpmpAddPair(
+   SCIP*                 scip,               /**< SCIP data structure */
+   int                   location1,          /**< first location of the pair */
+   int                   location2,          /**< second location of the pair */
+   SCIP_Bool             same                /**< must the locations be in the same cluster (or in different ones)? */
+   );
+
+/** removes a pair restriction which has been added before */
+EXTERN
+void SCIPpricerCpmpRemovePair(
+   SCIP*                 scip,               /**< SCIP data structure */
+   int                   location1,          /**< first location of the pair */
+   int                   location2,          /**< second location of the pair */
+   SCIP_Bool             same                /**< must the locations be in the same cluster (or in different ones)? */
+   );
+
+/** creates a column for a cluster outside of pricing, e.g. for a solution found by a heuristic, and adds it to the
+ *  master problem; if the column violates the branching restrictions of the current node, it is fixed to zero there;
+ *  in the problem stage, the column is added to the original problem
+ */
+EXTERN
+SCIP_RETCODE SCIPpricerCpmpAddColumn(
+   SCIP*                 scip,               /**< SCIP data structure */
+   int                   median,             /**< median of the cluster */
+   int*                  locations,          /**< locations contained in the cluster */
+   int                   nlocations,         /**< number of locations */
+   SCIP_VAR**            var                 /**< pointer to store the captured column */
+   );
+
+/** returns the reduced cost information of the last complete reduced cost pricing round if it belongs to the current
+ *  node: the LP value of the round, for each median a lower bound on the reduced costs of its columns (infinity for
+ *  closed medians), and the service duals; returns FALSE if there is no such information
+ */
+EXTERN
+SCIP_Bool SCIPpricerCpmpGetRedcostData(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_Real*            lpobj,              /**< pointer to store the LP value of the round */
+   SCIP_Real**           rcbounds,           /**< pointer to store the reduced cost bounds of the medians */
+   SCIP_Real**           duals               /**< pointer to store the service duals */
+   );
+
+/** returns the stability center of the Lagrangian bound at the root: the service duals, the lower bounds on the
+ *  cluster values of the medians, the Lagrangian bound and the nclusters-th smallest median bound; returns FALSE if
+ *  there is no stability center yet
+ */
+EXTERN
+SCIP_Bool SCIPpricerCpmpGetStabilityCenter(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_Real**           center,             /**< pointer to store the service duals of the stability center */
+   SCIP_Real**           medianbounds,       /**< pointer to store the median bounds at the stability center */
+   SCIP_Real*            bound,              /**< pointer to store the Lagrangian bound at the stability center */
+   SCIP_Real*            threshold           /**< pointer to store the nclusters-th smallest median bound */
+   );
+
+/** sets the stability center the next solve starts with instead of solving the Lagrangian relaxation (e.g., the one of
+ *  an earlier run); the arrays are copied
+ */
+EXTERN
+SCIP_RETCODE SCIPpricerCpmpSetStabilityCenter(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_Real*            center,             /**< service duals of the stability center */
+   SCIP_Real*            medianbounds,       /**< lower bounds on the cluster values of the medians at the center */
+   SCIP_Real             bound,              /**< Lagrangian bound at the stability center */
+   SCIP_Real             threshold           /**< nclusters-th smallest median bound at the stability center */
+   );
+
+/** returns the statistics of the cpmp pricer */
+EXTERN
+const CPMP_PRICERSTATS* SCIPpricerCpmpGetStats(
+   SCIP*                 scip                /**< SCIP data structure */
+   );
+
 #ifdef __cplusplus
 }
 #endif
@@ -29,7 +29,9 @@
 #include "scip/cons_setppc.h"
 
 
-/** create problem data */
+/** create problem data; if the transposed distances are given, the instance data is shared read-only with the
+ *  problem data it belongs to instead of being copied
+ */
 static
 SCIP_RETCODE createProbData(
    SCIP*                 scip,
@@ -38,10 +40,12 @@ SCIP_RETCODE createProbData(
    int                   nclusters,
    SCIP_Longint**        distances,
    SCIP_Longint*         demands,
-   SCIP_Longint*         capacities
+   SCIP_Longint*         capacities,
+   SCIP_Real**           mediandistances     /* transposed distances to share, or NULL to copy the instance data */
    )
 {
    int i;
+   int j;
 
    assert(scip != NULL);
 
@@ -55,19 +59,60 @@ SCIP_RETCODE createProbData(
    (*probdata)->nlocations = nlocations;
    (*probdata)->nclusters = nclusters;
 
-   SCIP_CALL( SCIPallocMemoryArray(scip, &(*probdata)->distances, nlocations) );
    SCIP_CALL( SCIPallocMemoryArray(scip, &(*probdata)->serviceconss, nlocations) );
    SCIP_CALL( SCIPallocMemoryArray(scip, &(*probdata)->convconss, nlocations) );
    for( i = 0; i < nlocations; ++i )
    {
-      SCIP_CALL( SCIPduplicateMemoryArray(scip, &(*probdata)->distances[i], distances[i], nlocations) );
       (*probdata)->serviceconss[i] = NULL;
       (*probdata)->convconss[i] = NULL;
    }
+   (*probdata)->mediancons = NULL;
+
+   /* the instance data is never modified, so the transformed problem and the problems of other SCIPs racing on the
+    * same instance can use the arrays of the original problem
+    */
+   (*probdata)->ownsdata = (mediandistances == NULL);
+   if( !(*probdata)->ownsdata )
+   {
+      (*probdata)->distances = distances;
+      (*probdata)->mediandistances = mediandistances;
+      (*probdata)->demands = demands;
+      (*probdata)->capacities = capacities;
+
+      return SCIP_OKAY;
+   }
+
+   SCIP_CALL( SCIPallocMemoryArray(scip, &(*probdata)->distances, nlocations) );
+   for( i = 0; i < nlocations; ++i )
+   {
+      SCIP_CALL( SCIPduplicateMemoryArray(scip, &(*probdata)->distances[i], distances[i], nlocations) );
+   }
    SCIP_CALL( SCIPduplicateMemoryArray(scip, &(*probdata)->demands, demands, nlocations) );
    SCIP_CALL( SCIPduplicateMemoryArray(scip, &(*probdata)->capacities, capacities, nlocations) );
 
-   (*probdata)->mediancons = NULL;
+   /* the pricing problems read the distances of all locations to one median, i.e., a column of distances, which is
+    * strided in memory; the profit kernels need it as one contiguous row of reals, so the transposed matrix is kept
+    * as one block in addition, which saves the gather and conversion in every pricing problem
+    *
+    * The block costs 8 n^2 bytes on top of the 8 n^2 bytes of the distance matrix, e.g. 200 MB for 5000 locations.
+    * The racing and parallel workers share it with the main problem, but the batch mode holds one block per instance
+    * that is solved at the same time. It is not stored as int or float, since the distances are SCIP_Longint and the
+    * profits, which decide about improving columns and the Lagrangian bounds, must be exact.
+    */
+   if( nlocations == 0 )
+   {
+      (*probdata)->mediandistances = NULL;
+      return SCIP_OKAY;
+   }
+
+   SCIP_CALL( SCIPallocMemoryArray(scip, &(*probdata)->mediandistances, nlocations) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &(*probdata)->mediandistances[0], (size_t)nlocations * nlocations) );
+   for( j = 0; j < nlocations; ++j )
+   {
+      (*probdata)->mediandistances[j] = (*probdata)->mediandistances[0] + (size_t)j * nlocations;
+      for( i = 0; i < nlocations; ++i )
+         (*probdata)->mediandistances[j][i] = (SCIP_Real)distances[i][j];
+   }
 
    return SCIP_OKAY;
 }
@@ -87,17 +132,29 @@ SCIP_RETCODE freeProbData(
 
    /* free problem data */
    SCIP_CALL( SCIPreleaseCons(scip, &(*probdata)->mediancons) );
-   SCIPfreeMemoryArray(scip, &(*probdata)->capacities);
-   SCIPfreeMemoryArray(scip, &(*probdata)->demands);
    for( i = 0; i < (*probdata)->nlocations; ++i )
    {
       SCIP_CALL( SCIPreleaseCons(scip, &(*probdata)->convconss[i]) );
       SCIP_CALL( SCIPreleaseCons(scip, &(*probdata)->serviceconss[i]) );
-      SCIPfreeMemoryArray(scip, &(*probdata)->distances[i]);
    }
    SCIPfreeMemoryArray(scip, &(*probdata)->convconss);
    SCIPfreeMemoryArray(scip, &(*probdata)->serviceconss);
-   SCIPfreeMemoryArray(scip, &(*probdata)->distances);
+
+   if( (*probdata)->ownsdata )
+   {
+      if( (*probdata)->mediandistances != NULL )
+      {
+         SCIPfreeMemoryArray(scip, &(*probdata)->mediandistances[0]);
+         SCIPfreeMemoryArray(scip, &(*probdata)->mediandistances);
+      }
+      SCIPfreeMemoryArray(scip, &(*probdata)->capacities);
+      SCIPfreeMemoryArray(scip, &(*probdata)->demands);
+      for( i = 0; i < (*probdata)->nlocations; ++i )
+      {
+         SCIPfreeMemoryArray(scip, &(*probdata)->distances[i]);
+      }
+      SCIPfreeMemoryArray(scip, &(*probdata)->distances);
+   }
 
    /* free probdata structure */
    SCIPfreeMemory(scip, probdata);
@@ -117,22 +174,16 @@ SCIP_RETCODE createConstraints(
 {
    char name[SCIP_MAXSTRLEN];
 
-   /* ****************************************************************************************************
-    * TODO: create the master constraints; you need the following:
-    *   * probdata->serviceconss: for each location, at least one cluster containing it must be chosen
-    *   * probdata->convconss: each location can be the median of at most one cluster
-    *   * probdata->mediancons: form exactly nclusters many clusters (i.e. select nclusters many medians)
-    *
-    * NOTE: The constraints do not contain any variable yet
-    * ****************************************************************************************************
+   /* every location is served by some cluster, is the median of at most one cluster, and exactly nclusters medians
+    * are chosen; the columns are added to the constraints when they are created
     */
 
    for (int i = 0;i < nlocations; ++i) {
-		SCIPsnprintf(name, 13, "serviceconss" + (i + '0'));
+		(void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "serviceconss_%d", i + 1);
 		SCIP_CALL(SCIPcreateConsLinear(scip, &(probdata->serviceconss[i]), name, 0, NULL, NULL, 1, SCIPinfinity(scip), 1, 1, 1, 1, 1, 0, 1, 0, 0, 0));
 		SCIP_CALL(SCIPaddCons(scip, probdata->serviceconss[i]));
 
-		SCIPsnprintf(name, 13, "convconss" + (i + '0'));
+		(void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "convconss_%d", i + 1);
 		SCIP_CALL(SCIPcreateConsLinear(scip, &(probdata->convconss[i]), name, 0, NULL, NULL, 0, 1, 1, 1, 1, 1, 1, 0, 1, 0, 0, 0));
 		SCIP_CALL(SCIPaddCons(scip, probdata->convconss[i]));
    }
@@ -166,7 +217,9 @@ SCIP_DECL_PROBTRANS(probdataTrans)
    assert(scip != NULL);
    assert(sourcedata != NULL);
 
-   SCIP_CALL( createProbData(scip, targetdata, sourcedata->nlocations, sourcedata->nclusters, sourcedata->distances, sourcedata->demands, sourcedata->capacities) );
+   /* the original problem outlives the transformed one, so its instance data is shared */
+   SCIP_CALL( createProbData(scip, targetdata, sourcedata->nlocations, sourcedata->nclusters, sourcedata->distances,
+         sourcedata->demands, sourcedata->capacities, sourcedata->mediandistances) );
 
    /* transform the constraints */
    SCIP_CALL( SCIPtransformConss(scip, sourcedata->nlocations, sourcedata->serviceconss, (*targetdata)->serviceconss) );
@@ -187,6 +240,32 @@ SCIP_DECL_PROBDELTRANS(probdataDeltrans)
 }
 
 
+/** sets up the problem around the given problem data: callbacks, master constraints and the pricer */
+static
+SCIP_RETCODE setupProb(
+   SCIP*                 scip,
+   SCIP_PROBDATA*        probdata
+   )
+{
+   SCIP_PRICER* pricer;
+
+   /* notify SCIP about the data structure and set the destructors and transformation callback */
+   SCIP_CALL( SCIPsetProbData(scip, probdata) );
+   SCIP_CALL( SCIPsetProbDelorig(scip, probdataDelorig) );
+   SCIP_CALL( SCIPsetProbTrans(scip, probdataTrans) );
+   SCIP_CALL( SCIPsetProbDeltrans(scip, probdataDeltrans) );
+
+   SCIP_CALL( createConstraints(scip, probdata, probdata->nclusters, probdata->nlocations) );
+
+   /* activate the pricer in SCIP, such that SCIP calls it to price in new variables during LP solving */
+   pricer = SCIPfindPricer(scip, "cpmp");
+   assert(pricer != NULL);
+   SCIP_CALL( SCIPactivatePricer(scip, pricer) );
+
+   return SCIP_OKAY;
+}
+
+
 /** create capacitated p-median SCIP instance and save the problem specific data */
 SCIP_RETCODE SCIPcreateProbCpmp(
    SCIP*                 scip,
@@ -197,25 +276,38 @@ SCIP_RETCODE SCIPcreateProbCpmp(
    SCIP_Longint*         capacities
    )
 {
-   SCIP_PRICER* pricer;
    SCIP_PROBDATA* probdata;
 
    assert(scip != NULL);
 
-   SCIP_CALL( createProbData(scip, &probdata, nlocations, nclusters, distances, demands, capacities) );
+   SCIP_CALL( createProbData(scip, &probdata, nlocations, nclusters, distances, demands, capacities, NULL) );
+   SCIP_CALL( setupProb(scip, probdata) );
 
-   /* notify SCIP about the data structure and set the destructors and transformation callback */
-   SCIP_CALL( SCIPsetProbData(scip, probdata) );
-   SCIP_CALL( SCIPsetProbDelorig(scip, probdataDelorig) );
-   SCIP_CALL( SCIPsetProbTrans(scip, probdataTrans) );
-   SCIP_CALL( SCIPsetProbDeltrans(scip, probdataDeltrans) );
+   return SCIP_OKAY;
+}
 
-   SCIP_CALL( createConstraints(scip, probdata, nclusters, nlocations) );
 
-   /* activate the pricer in SCIP, such that SCIP calls it to price in new variables during LP solving */
-   pricer = SCIPfindPricer(scip, "cpmp");
-   assert(pricer != NULL);
-   SCIP_CALL( SCIPactivatePricer(scip, pricer) );
+/** create capacitated p-median SCIP instance on the instance data of the original problem of another SCIP, which is
+ *  shared read-only; the problem of the other SCIP must not be freed before this one
+ */
+SCIP_RETCODE SCIPcreateProbCpmpShared(
+   SCIP*                 scip,
+   SCIP*                 sourcescip
+   )
+{
+   SCIP_PROBDATA* sourcedata;
+   SCIP_PROBDATA* probdata;
+
+   assert(scip != NULL);
+   assert(sourcescip != NULL);
+   assert(SCIPgetStage(sourcescip) == SCIP_STAGE_PROBLEM);
+
+   sourcedata = SCIPgetProbData(sourcescip);
+   assert(sourcedata != NULL);
+
+   SCIP_CALL( createProbData(scip, &probdata, sourcedata->nlocations, sourcedata->nclusters, sourcedata->distances,
+         sourcedata->demands, sourcedata->capacities, sourcedata->mediandistances) );
+   SCIP_CALL( setupProb(scip, probdata) );
 
    return SCIP_OKAY;
 }
@@ -289,6 +381,22 @@ int SCIPprobdataGetNLocations(
 }
 
 
+/** get number of clusters */
+int SCIPprobdataGetNClusters(
+   SCIP*                 scip
+   )
+{
+   SCIP_PROBDATA* probdata;
+
+   assert(scip != NULL);
+
+   probdata = SCIPgetProbData(scip);
+   assert(probdata != NULL);
+
+   return probdata->nclusters;
+}
+
+
 /** get distances */
 SCIP_Longint** SCIPprobdataGetDistances(
    SCIP*                 scip
@@ -305,6 +413,24 @@ SCIP_Longint** SCIPprobdataGetDistances(
 }
 
 
+/** get distances of all locations to each median as contiguous rows, i.e. entry [j][i] is the distance of location i
+ *  to median j
+ */
+SCIP_Real** SCIPprobdataGetMedianDistances(
+   SCIP*                 scip
+   )
+{
+   SCIP_PROBDATA* probdata;
+
+   assert(scip != NULL);
+
+   probdata = SCIPgetProbData(scip);
+   assert(probdata != NULL);
+
+   return probdata->mediandistances;
+}
+
+
 /** get demands */
 SCIP_Longint* SCIPprobdataGetDemands(
    SCIP*                 scip
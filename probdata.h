@@ -36,4 +36,13 @@ SCIP_RETCODE SCIPcreateProbCpmp(
    SCIP_Longint*         capacities
    );
 
+/** create capacitated p-median SCIP instance on the instance data of the original problem of another SCIP, which is
+ *  shared read-only; the problem of the other SCIP must not be freed before this one
+ */
+extern
+SCIP_RETCODE SCIPcreateProbCpmpShared(
+   SCIP*                 scip,
+   SCIP*                 sourcescip
+   );
+
 #endif
@@ -0,0 +1,200 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   prof_cpmp.c
+ * @brief  lightweight profiling of the hot paths of the capacitated p-median plugins
+ * @author Christian Puchert
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "prof_cpmp.h"
+
+
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_THREADS__)
+#define CPMP_THREADLOCAL _Thread_local
+#elif defined(__GNUC__)
+#define CPMP_THREADLOCAL __thread
+#elif defined(_MSC_VER)
+#define CPMP_THREADLOCAL __declspec(thread)
+#else
+#define CPMP_THREADLOCAL
+#endif
+
+
+/*
+ * Data structures
+ */
+
+/** plugin and phase names of the timers, in the order of CPMP_PROFTIMER */
+static const char* timernames[CPMP_PROF_NTIMERS][2] = {
+   { "semiassign (cons)",   "propagate"  },
+   { "semiassign (cons)",   "activate"   },
+   { "semiassign (cons)",   "deactivate" },
+   { "semiassign (branch)", "compute"    },
+   { "semiassign (branch)", "choose"     },
+   { "semiassign (branch)", "sort"       },
+   { "semiassign (branch)", "children"   },
+   { "cpmp (reader)",       "read"       }
+};
+
+/** plugin and event names of the counters, in the order of CPMP_PROFCOUNTER */
+static const char* counternames[CPMP_PROF_NCOUNTERS][2] = {
+   { "semiassign (cons)",   "columns scanned"      },
+   { "semiassign (cons)",   "columns fixed"        },
+   { "semiassign (cons)",   "repropagations"       },
+   { "semiassign (branch)", "assignment entries"   },
+   { "semiassign (branch)", "children"             },
+   { "cpmp (reader)",       "lines"                }
+};
+
+#ifndef CPMP_NO_PROFILE
+static CPMP_THREADLOCAL double       timerstarts[CPMP_PROF_NTIMERS];   /* start times of the running timers    */
+static CPMP_THREADLOCAL double       timertotals[CPMP_PROF_NTIMERS];   /* total times of the timers            */
+static CPMP_THREADLOCAL SCIP_Longint timercalls[CPMP_PROF_NTIMERS];    /* number of times the timers were started */
+static CPMP_THREADLOCAL SCIP_Longint countervalues[CPMP_PROF_NCOUNTERS]; /* values of the counters             */
+#endif
+
+
+/*
+ * Local methods
+ */
+
+#ifndef CPMP_NO_PROFILE
+/** returns the current time of a monotonic clock in seconds */
+static
+double getMonotonicTime(
+   void
+   )
+{
+#if defined(_WIN32)
+   LARGE_INTEGER frequency;
+   LARGE_INTEGER counter;
+
+   (void) QueryPerformanceFrequency(&frequency);
+   (void) QueryPerformanceCounter(&counter);
+
+   return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+   struct timespec ts;
+
+   (void) clock_gettime(CLOCK_MONOTONIC, &ts);
+
+   return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+#endif
+}
+#endif
+
+
+/*
+ * Interface methods
+ */
+
+/** starts a timer; timers must not be started again before they are stopped */
+void SCIPprofileStartCpmp(
+   CPMP_PROFTIMER        timer               /**< timer to start */
+   )
+{
+#ifndef CPMP_NO_PROFILE
+   assert(0 <= (int)timer && (int)timer < CPMP_PROF_NTIMERS);
+
+   timerstarts[timer] = getMonotonicTime();
+   ++timercalls[timer];
+#endif
+}
+
+/** stops a timer and adds the elapsed time */
+void SCIPprofileStopCpmp(
+   CPMP_PROFTIMER        timer               /**< timer to stop */
+   )
+{
+#ifndef CPMP_NO_PROFILE
+   assert(0 <= (int)timer && (int)timer < CPMP_PROF_NTIMERS);
+
+   timertotals[timer] += getMonotonicTime() - timerstarts[timer];
+#endif
+}
+
+/** adds a value to a counter */
+void SCIPprofileCountCpmp(
+   CPMP_PROFCOUNTER      counter,            /**< counter */
+   SCIP_Longint          value               /**< value to add */
+   )
+{
+#ifndef CPMP_NO_PROFILE
+   assert(0 <= (int)counter && (int)counter < CPMP_PROF_NCOUNTERS);
+
+   countervalues[counter] += value;
+#endif
+}
+
+/** resets all timers and counters of the calling thread */
+void SCIPprofileResetCpmp(
+   void
+   )
+{
+#ifndef CPMP_NO_PROFILE
+   int i;
+
+   for( i = 0; i < CPMP_PROF_NTIMERS; ++i )
+   {
+      timertotals[i] = 0.0;
+      timercalls[i] = 0;
+   }
+   for( i = 0; i < CPMP_PROF_NCOUNTERS; ++i )
+      countervalues[i] = 0;
+#endif
+}
+
+/** prints the per-plugin breakdown of the timers and counters of the calling thread */
+void SCIPprintProfileCpmp(
+   SCIP*                 scip,               /**< SCIP data structure */
+   FILE*                 file                /**< output file, or NULL for standard output */
+   )
+{
+#ifdef CPMP_NO_PROFILE
+   SCIPinfoMessage(scip, file, "cpmp profiling was disabled at compile time (CPMP_NO_PROFILE)\n");
+#else
+   double total;
+   int i;
+
+   total = 0.0;
+   for( i = 0; i < CPMP_PROF_NTIMERS; ++i )
+      total += timertotals[i];
+
+   SCIPinfoMessage(scip, file, "CPMP Profile        : Phase            Calls    Time (s)  Avg (us)   Share\n");
+   for( i = 0; i < CPMP_PROF_NTIMERS; ++i )
+   {
+      SCIPinfoMessage(scip, file, "  %-18s: %-10s %11" SCIP_LONGINT_FORMAT " %11.4f %9.2f %6.1f%%\n", timernames[i][0],
+         timernames[i][1], timercalls[i], timertotals[i], timercalls[i] > 0 ? 1e6 * timertotals[i] / timercalls[i] : 0.0,
+         total > 0.0 ? 100.0 * timertotals[i] / total : 0.0);
+   }
+
+   SCIPinfoMessage(scip, file, "CPMP Counters       : Event                          Value\n");
+   for( i = 0; i < CPMP_PROF_NCOUNTERS; ++i )
+   {
+      SCIPinfoMessage(scip, file, "  %-18s: %-22s %12" SCIP_LONGINT_FORMAT "\n", counternames[i][0], counternames[i][1],
+         countervalues[i]);
+   }
+#endif
+}
@@ -0,0 +1,114 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   prof_cpmp.h
+ * @brief  lightweight profiling of the hot paths of the capacitated p-median plugins
+ * @author Christian Puchert
+ *
+ * Each timer measures the wall clock time spent between CPMP_PROF_START() and CPMP_PROF_STOP() with a monotonic
+ * clock and counts how often it was started; each counter accumulates the values passed to CPMP_PROF_COUNT(). The
+ * data is kept per thread, so that concurrent solves do not disturb each other's measurements, and is reset
+ * whenever a new problem is read. Compiling with CPMP_NO_PROFILE removes all measurements from the plugins.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __CPMP_PROF_CPMP_H__
+#define __CPMP_PROF_CPMP_H__
+
+
+#include <stdio.h>
+
+#include "scip/scip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** profiled phases */
+enum CPMP_ProfTimer
+{
+   CPMP_PROF_CONSPROP_SEMIASSIGN     = 0,    /**< propagation of semiassign constraints                 */
+   CPMP_PROF_CONSACTIVE_SEMIASSIGN   = 1,    /**< activation of semiassign constraints                  */
+   CPMP_PROF_CONSDEACTIVE_SEMIASSIGN = 2,    /**< deactivation of semiassign constraints                */
+   CPMP_PROF_BRANCH_COMPUTE          = 3,    /**< computation of the assignments of the LP solution     */
+   CPMP_PROF_BRANCH_CHOOSE           = 4,    /**< choice of the branching location                      */
+   CPMP_PROF_BRANCH_SORT             = 5,    /**< sorting of the medians of the branching location      */
+   CPMP_PROF_BRANCH_CREATE           = 6,    /**< creation of the children                              */
+   CPMP_PROF_READER_READ             = 7,    /**< reading a problem file                                */
+   CPMP_PROF_NTIMERS                 = 8     /**< number of timers                                      */
+};
+typedef enum CPMP_ProfTimer CPMP_PROFTIMER;
+
+/** profiled events */
+enum CPMP_ProfCounter
+{
+   CPMP_PROF_SEMIASSIGN_SCANNED      = 0,    /**< columns scanned by semiassign propagation             */
+   CPMP_PROF_SEMIASSIGN_FIXED        = 1,    /**< columns fixed to zero by semiassign propagation       */
+   CPMP_PROF_SEMIASSIGN_REPROPS      = 2,    /**< repropagations requested by semiassign activations    */
+   CPMP_PROF_BRANCH_ENTRIES          = 3,    /**< nonzero assignments computed for branching            */
+   CPMP_PROF_BRANCH_CHILDREN         = 4,    /**< children created by semiassign branching              */
+   CPMP_PROF_READER_LINES            = 5,    /**< lines read from problem files                         */
+   CPMP_PROF_NCOUNTERS               = 6     /**< number of counters                                    */
+};
+typedef enum CPMP_ProfCounter CPMP_PROFCOUNTER;
+
+#ifdef CPMP_NO_PROFILE
+#define CPMP_PROF_START(timer)          /**/
+#define CPMP_PROF_STOP(timer)           /**/
+#define CPMP_PROF_COUNT(counter, n)     /**/
+#else
+#define CPMP_PROF_START(timer)          SCIPprofileStartCpmp(timer)
+#define CPMP_PROF_STOP(timer)           SCIPprofileStopCpmp(timer)
+#define CPMP_PROF_COUNT(counter, n)     SCIPprofileCountCpmp(counter, (SCIP_Longint)(n))
+#endif
+
+/** starts a timer; timers must not be started again before they are stopped */
+EXTERN
+void SCIPprofileStartCpmp(
+   CPMP_PROFTIMER        timer               /**< timer to start */
+   );
+
+/** stops a timer and adds the elapsed time */
+EXTERN
+void SCIPprofileStopCpmp(
+   CPMP_PROFTIMER        timer               /**< timer to stop */
+   );
+
+/** adds a value to a counter */
+EXTERN
+void SCIPprofileCountCpmp(
+   CPMP_PROFCOUNTER      counter,            /**< counter */
+   SCIP_Longint          value               /**< value to add */
+   );
+
+/** resets all timers and counters of the calling thread */
+EXTERN
+void SCIPprofileResetCpmp(
+   void
+   );
+
+/** prints the per-plugin breakdown of the timers and counters of the calling thread */
+EXTERN
+void SCIPprintProfileCpmp(
+   SCIP*                 scip,               /**< SCIP data structure */
+   FILE*                 file                /**< output file, or NULL for standard output */
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,268 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   profits_cpmp.c
+ * @brief  construction of the knapsack items of the cpmp pricing problems
+ * @author Christian Puchert
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+
+#include "profits_cpmp.h"
+
+#if !defined(CPMP_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CPMP_HAVE_SIMD
+#include <immintrin.h>
+#endif
+
+
+/*
+ * Local methods
+ */
+
+/** scalar version of the profit computation */
+static
+int computeProfitsScalar(
+   int                   nlocations,         /* number of locations                                  */
+   const SCIP_Real*      duals,              /* service duals (or Farkas values) of the locations    */
+   const SCIP_Real*      distrow,            /* distances to the median, or NULL in Farkas pricing   */
+   const SCIP_Bool*      forbidden,          /* for each location, is the assignment forbidden?      */
+   const SCIP_Longint*   alldemands,         /* demands of the locations                             */
+   int*                  items,              /* array to store the locations of the items            */
+   SCIP_Real*            profits,            /* array to store the item profits                      */
+   SCIP_Longint*         demands             /* array to store the item demands                      */
+   )
+{
+   int nitems;
+   int location;
+
+   nitems = 0;
+   for( location = 0; location < nlocations; ++location )
+   {
+      SCIP_Real profit;
+
+      profit = distrow != NULL ? duals[location] - distrow[location] : duals[location];
+
+      if( !forbidden[location] && profit > 0.0 )
+      {
+         items[nitems] = location;
+         profits[nitems] = profit;
+         demands[nitems] = alldemands[location];
+         ++nitems;
+      }
+   }
+
+   return nitems;
+}
+
+#ifdef CPMP_HAVE_SIMD
+
+/** AVX2 version of the profit computation: the profits of four locations are computed at once,
+ *  and the locations passing the filter are extracted from the resulting bit mask
+ */
+static
+__attribute__((target("avx2")))
+int computeProfitsAVX2(
+   int                   nlocations,         /* number of locations                                  */
+   const SCIP_Real*      duals,              /* service duals (or Farkas values) of the locations    */
+   const SCIP_Real*      distrow,            /* distances to the median, or NULL in Farkas pricing   */
+   const SCIP_Bool*      forbidden,          /* for each location, is the assignment forbidden?      */
+   const SCIP_Longint*   alldemands,         /* demands of the locations                             */
+   int*                  items,              /* array to store the locations of the items            */
+   SCIP_Real*            profits,            /* array to store the item profits                      */
+   SCIP_Longint*         demands             /* array to store the item demands                      */
+   )
+{
+   SCIP_Real buffer[4];
+   __m256d zero;
+   int nitems;
+   int location;
+
+   zero = _mm256_setzero_pd();
+   nitems = 0;
+
+   for( location = 0; location + 4 <= nlocations; location += 4 )
+   {
+      __m256d profit;
+      __m256d allowed;
+      unsigned int mask;
+
+      profit = _mm256_loadu_pd(duals + location);
+      if( distrow != NULL )
+         profit = _mm256_sub_pd(profit, _mm256_loadu_pd(distrow + location));
+
+      /* widen the 32 bit forbidden flags to 64 bit lanes and combine them with the sign test */
+      allowed = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(_mm_cmpeq_epi32(
+               _mm_loadu_si128((const __m128i*)(forbidden + location)), _mm_setzero_si128())));
+      mask = (unsigned int)_mm256_movemask_pd(_mm256_and_pd(allowed, _mm256_cmp_pd(profit, zero, _CMP_GT_OQ)));
+
+      if( mask == 0 )
+         continue;
+
+      _mm256_storeu_pd(buffer, profit);
+      while( mask != 0 )
+      {
+         int k = __builtin_ctz(mask);
+
+         items[nitems] = location + k;
+         profits[nitems] = buffer[k];
+         demands[nitems] = alldemands[location + k];
+         ++nitems;
+         mask &= mask - 1;
+      }
+   }
+
+   /* remaining locations */
+   for( ; location < nlocations; ++location )
+   {
+      SCIP_Real profit;
+
+      profit = distrow != NULL ? duals[location] - distrow[location] : duals[location];
+
+      if( !forbidden[location] && profit > 0.0 )
+      {
+         items[nitems] = location;
+         profits[nitems] = profit;
+         demands[nitems] = alldemands[location];
+         ++nitems;
+      }
+   }
+
+   return nitems;
+}
+
+/** AVX-512 version of the profit computation: the profits of eight locations are computed at once
+ *  and written with compress stores, which also handle the remaining locations by masking
+ */
+static
+__attribute__((target("avx512f")))
+int computeProfitsAVX512(
+   int                   nlocations,         /* number of locations                                  */
+   const SCIP_Real*      duals,              /* service duals (or Farkas values) of the locations    */
+   const SCIP_Real*      distrow,            /* distances to the median, or NULL in Farkas pricing   */
+   const SCIP_Bool*      forbidden,          /* for each location, is the assignment forbidden?      */
+   const SCIP_Longint*   alldemands,         /* demands of the locations                             */
+   int*                  items,              /* array to store the locations of the items            */
+   SCIP_Real*            profits,            /* array to store the item profits                      */
+   SCIP_Longint*         demands             /* array to store the item demands                      */
+   )
+{
+   __m512d zero;
+   __m512i indices;
+   __m512i step;
+   int nitems;
+   int location;
+
+   zero = _mm512_setzero_pd();
+   indices = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 0, 0, 0, 0, 0, 0, 0, 0);
+   step = _mm512_set1_epi32(8);
+   nitems = 0;
+
+   for( location = 0; location < nlocations; location += 8 )
+   {
+      __m512d profit;
+      __mmask8 lanes;
+      __mmask8 mask;
+
+      lanes = (nlocations - location >= 8) ? (__mmask8)0xFF : (__mmask8)((1u << (nlocations - location)) - 1);
+
+      profit = _mm512_maskz_loadu_pd(lanes, duals + location);
+      if( distrow != NULL )
+         profit = _mm512_sub_pd(profit, _mm512_maskz_loadu_pd(lanes, distrow + location));
+
+      mask = _mm512_mask_cmp_pd_mask(lanes, profit, zero, _CMP_GT_OQ);
+      mask &= (__mmask8)_mm512_mask_cmpeq_epi32_mask((__mmask16)lanes,
+         _mm512_maskz_loadu_epi32((__mmask16)lanes, forbidden + location), _mm512_setzero_si512());
+
+      if( mask != 0 )
+      {
+         _mm512_mask_compressstoreu_pd(profits + nitems, mask, profit);
+         _mm512_mask_compressstoreu_epi32(items + nitems, (__mmask16)mask, indices);
+         _mm512_mask_compressstoreu_epi64(demands + nitems, mask, _mm512_maskz_loadu_epi64(lanes, alldemands + location));
+         nitems += __builtin_popcount(mask);
+      }
+
+      indices = _mm512_add_epi32(indices, step);
+   }
+
+   return nitems;
+}
+
+#endif
+
+
+/*
+ * interface methods
+ */
+
+/** returns the best instruction set supported by the running processor and the build */
+CPMP_SIMDLEVEL SCIPgetSimdLevelCpmp(
+   void
+   )
+{
+#ifdef CPMP_HAVE_SIMD
+   static int simdlevel = -1;
+
+   /* the detection is idempotent, so concurrent first calls are harmless */
+   if( simdlevel < 0 )
+   {
+      __builtin_cpu_init();
+      if( __builtin_cpu_supports("avx512f") )
+         simdlevel = (int)CPMP_SIMD_AVX512;
+      else if( __builtin_cpu_supports("avx2") )
+         simdlevel = (int)CPMP_SIMD_AVX2;
+      else
+         simdlevel = (int)CPMP_SIMD_NONE;
+   }
+
+   return (CPMP_SIMDLEVEL)simdlevel;
+#else
+   return CPMP_SIMD_NONE;
+#endif
+}
+
+/** computes the profits of all locations for a median and stores the non-forbidden locations with
+ *  positive profit as knapsack items; returns the number of items
+ */
+int SCIPcomputeProfitsCpmp(
+   CPMP_SIMDLEVEL        simdlevel,          /**< instruction set to use; is reduced to the supported one             */
+   int                   nlocations,         /**< number of locations                                                 */
+   const SCIP_Real*      duals,              /**< service duals (or Farkas values) of the locations                   */
+   const SCIP_Real*      distrow,            /**< distances of the locations to the median, or NULL in Farkas pricing */
+   const SCIP_Bool*      forbidden,          /**< for each location, is the assignment to the median forbidden?       */
+   const SCIP_Longint*   alldemands,         /**< demands of the locations                                            */
+   int*                  items,              /**< array to store the locations of the items                           */
+   SCIP_Real*            profits,            /**< array to store the item profits                                     */
+   SCIP_Longint*         demands             /**< array to store the item demands                                     */
+   )
+{
+   assert(nlocations >= 0);
+   assert(duals != NULL);
+   assert(forbidden != NULL);
+   assert(alldemands != NULL);
+
+   simdlevel = MIN(simdlevel, SCIPgetSimdLevelCpmp());
+
+#ifdef CPMP_HAVE_SIMD
+   if( simdlevel == CPMP_SIMD_AVX512 )
+      return computeProfitsAVX512(nlocations, duals, distrow, forbidden, alldemands, items, profits, demands);
+   if( simdlevel == CPMP_SIMD_AVX2 )
+      return computeProfitsAVX2(nlocations, duals, distrow, forbidden, alldemands, items, profits, demands);
+#endif
+
+   return computeProfitsScalar(nlocations, duals, distrow, forbidden, alldemands, items, profits, demands);
+}
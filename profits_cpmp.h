@@ -0,0 +1,73 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   profits_cpmp.h
+ * @brief  construction of the knapsack items of the cpmp pricing problems
+ * @author Christian Puchert
+ *
+ * For a median, the items of its pricing problem are the locations which may be assigned to it and have a positive
+ * profit, i.e. dual value minus distance to the median (or just the Farkas value in Farkas pricing). The profits are
+ * computed and the items compacted in one pass over the contiguous distance row of the median. On x86, AVX2 and
+ * AVX-512 versions are selected at runtime; compiling with CPMP_NO_SIMD leaves only the scalar version.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __CPMP_PROFITS_CPMP_H__
+#define __CPMP_PROFITS_CPMP_H__
+
+
+#include "scip/scip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** instruction set used for computing the profits */
+enum CPMP_SimdLevel
+{
+   CPMP_SIMD_NONE   = 0,                     /**< scalar code */
+   CPMP_SIMD_AVX2   = 1,                     /**< AVX2 (4 locations per instruction) */
+   CPMP_SIMD_AVX512 = 2                      /**< AVX-512F (8 locations per instruction, compress stores) */
+};
+typedef enum CPMP_SimdLevel CPMP_SIMDLEVEL;
+
+/** returns the best instruction set supported by the running processor and the build */
+EXTERN
+CPMP_SIMDLEVEL SCIPgetSimdLevelCpmp(
+   void
+   );
+
+/** computes the profits of all locations for a median and stores the non-forbidden locations with
+ *  positive profit as knapsack items; returns the number of items
+ */
+EXTERN
+int SCIPcomputeProfitsCpmp(
+   CPMP_SIMDLEVEL        simdlevel,          /**< instruction set to use; is reduced to the supported one             */
+   int                   nlocations,         /**< number of locations                                                 */
+   const SCIP_Real*      duals,              /**< service duals (or Farkas values) of the locations                   */
+   const SCIP_Real*      distrow,            /**< distances of the locations to the median, or NULL in Farkas pricing */
+   const SCIP_Bool*      forbidden,          /**< for each location, is the assignment to the median forbidden?       */
+   const SCIP_Longint*   alldemands,         /**< demands of the locations                                            */
+   int*                  items,              /**< array to store the locations of the items                           */
+   SCIP_Real*            profits,            /**< array to store the item profits                                     */
+   SCIP_Longint*         demands             /**< array to store the item demands                                     */
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,357 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   prop_cpmpredcost.c
+ * @ingroup PROPAGATORS
+ * @brief  reduced cost fixing of medians and assignments for capacitated p-median problems
+ * @author Christian Puchert
+ *
+ * For the service duals pi of a reduced cost pricing round with LP value z, every solution x of the node satisfies
+ * c(x) >= z + sum of the reduced costs of its columns. A solution has at most nclusters columns and at most one per
+ * median, so c(x) >= z + S, where S is the sum of the nclusters most negative reduced cost bounds rc_j of the medians.
+ * If x contains a column of median j, its other columns contribute at least S - t, where t is the nclusters-th most
+ * negative bound (or 0), which yields the bound z + S - t + rc_j. If the column also contains location i, whose
+ * profit pi_i - d_ij in the knapsack problem of j is negative, its reduced cost is larger than rc_j by at least
+ * d_ij - pi_i. Under Ryan-Foster pair restrictions, this only holds for the whole pair, so assignments are only
+ * fixed without them.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+
+#include "prop_cpmpredcost.h"
+#include "cons_median.h"
+#include "cons_semiassign.h"
+#include "pricer_cpmp.h"
+#include "pub_probdata.h"
+
+
+#define PROP_NAME              "cpmpredcost"
+#define PROP_DESC              "reduced cost fixing of medians and assignments for capacitated p-median problems"
+#define PROP_PRIORITY          1000000
+#define PROP_FREQ              1
+#define PROP_DELAY             FALSE
+#define PROP_TIMING            SCIP_PROPTIMING_AFTERLPLOOP
+
+#define DEFAULT_FIXMEDIANS     TRUE   /**< should medians be closed by reduced cost fixing?                         */
+#define DEFAULT_FIXASSIGNMENTS TRUE   /**< should assignments be forbidden by reduced cost fixing?                  */
+
+
+/*
+ * Data structures
+ */
+
+/** propagator data */
+struct SCIP_PropData
+{
+   SCIP_Bool             fixmedians;         /* should medians be closed by reduced cost fixing?                         */
+   SCIP_Bool             fixassignments;     /* should assignments be forbidden by reduced cost fixing?                  */
+   SCIP_Longint          lastnode;           /* number of the node the propagator was last run at                        */
+   SCIP_Real             lastcutoff;         /* cutoff bound of the last run                                             */
+   SCIP_Longint          nclosedmedians;     /* total number of medians closed                                           */
+   SCIP_Longint          nforbidden;         /* total number of assignments forbidden                                    */
+};
+
+
+/*
+ * Local methods
+ */
+
+/** computes the sum of the nclusters most negative reduced cost bounds and the nclusters-th most negative one */
+static
+SCIP_RETCODE computeRedcostSum(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_Real*            rcbounds,           /* reduced cost bounds of the medians                   */
+   int                   nlocations,         /* number of locations                                  */
+   int                   nclusters,          /* maximal number of clusters                           */
+   SCIP_Real*            sum,                /* pointer to store the sum                             */
+   SCIP_Real*            threshold           /* pointer to store the nclusters-th most negative bound, or 0.0 */
+   )
+{
+   SCIP_Real* sorted;
+   int i;
+
+   SCIP_CALL( SCIPduplicateBufferArray(scip, &sorted, rcbounds, nlocations) );
+   SCIPsortReal(sorted, nlocations);
+
+   *sum = 0.0;
+   for( i = 0; i < nclusters && i < nlocations && sorted[i] < 0.0; ++i )
+      *sum += sorted[i];
+   *threshold = (nclusters > 0 && i == nclusters) ? sorted[nclusters - 1] : 0.0;
+
+   SCIPfreeBufferArray(scip, &sorted);
+
+   return SCIP_OKAY;
+}
+
+/** closes a median in the subtree of the current node by a local median constraint */
+static
+SCIP_RETCODE closeMedian(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   int                   median              /* median to close                                      */
+   )
+{
+   SCIP_CONS* cons;
+   char name[SCIP_MAXSTRLEN];
+
+   (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "redcost_closed_%d", median);
+   SCIP_CALL( SCIPcreateConsMedian(scip, &cons, name, median, CPMP_MEDIAN_CLOSED, SCIPgetCurrentNode(scip)) );
+   SCIP_CALL( SCIPaddConsNode(scip, SCIPgetCurrentNode(scip), cons, NULL) );
+   SCIP_CALL( SCIPreleaseCons(scip, &cons) );
+
+   return SCIP_OKAY;
+}
+
+/** forbids the assignments of a location to some medians in the subtree of the current node by a local semiassign
+ *  constraint
+ */
+static
+SCIP_RETCODE forbidAssignments(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   int                   location,           /* location                                             */
+   SCIP_Bool*            forbidden           /* for each median, should the assignment be forbidden? */
+   )
+{
+   SCIP_CONS* cons;
+   char name[SCIP_MAXSTRLEN];
+
+   (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "redcost_forbidden_%d", location);
+   SCIP_CALL( SCIPcreateConsSemiassign(scip, &cons, name, location, forbidden, SCIPgetCurrentNode(scip)) );
+   SCIP_CALL( SCIPaddConsNode(scip, SCIPgetCurrentNode(scip), cons, NULL) );
+   SCIP_CALL( SCIPreleaseCons(scip, &cons) );
+
+   return SCIP_OKAY;
+}
+
+
+/*
+ * Callback methods of propagator
+ */
+
+/** destructor of propagator to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_PROPFREE(propFreeCpmpredcost)
+{  /*lint --e{715}*/
+   SCIP_PROPDATA* propdata;
+
+   propdata = SCIPpropGetData(prop);
+   assert(propdata != NULL);
+
+   SCIPfreeMemory(scip, &propdata);
+   SCIPpropSetData(prop, NULL);
+
+   return SCIP_OKAY;
+}
+
+/** solving process initialization method of propagator (called when branch and bound process is about to begin) */
+static
+SCIP_DECL_PROPINITSOL(propInitsolCpmpredcost)
+{  /*lint --e{715}*/
+   SCIP_PROPDATA* propdata;
+
+   propdata = SCIPpropGetData(prop);
+   assert(propdata != NULL);
+
+   propdata->lastnode = -1;
+   propdata->lastcutoff = SCIPinfinity(scip);
+   propdata->nclosedmedians = 0;
+   propdata->nforbidden = 0;
+
+   return SCIP_OKAY;
+}
+
+/** solving process deinitialization method of propagator (called before branch and bound process data is freed) */
+static
+SCIP_DECL_PROPEXITSOL(propExitsolCpmpredcost)
+{  /*lint --e{715}*/
+   SCIP_PROPDATA* propdata;
+
+   propdata = SCIPpropGetData(prop);
+   assert(propdata != NULL);
+
+   SCIPdebugMessage("reduced cost fixing: %" SCIP_LONGINT_FORMAT " medians closed, %" SCIP_LONGINT_FORMAT
+      " assignments forbidden\n", propdata->nclosedmedians, propdata->nforbidden);
+
+   return SCIP_OKAY;
+}
+
+/** execution method of propagator */
+static
+SCIP_DECL_PROPEXEC(propExecCpmpredcost)
+{  /*lint --e{715}*/
+   SCIP_PROPDATA* propdata;
+   SCIP_Longint nodenumber;
+   SCIP_Real cutoffbound;
+   SCIP_Real lpobj;
+   SCIP_Real* rcbounds;
+   SCIP_Real* duals;
+   SCIP_Real sum;
+   SCIP_Real threshold;
+   SCIP_Real lowerbound;
+   SCIP_Longint** distances;
+   SCIP_Bool* closed;
+   SCIP_Bool* forbidden;
+   int nlocations;
+   int nclusters;
+   int location;
+   int median;
+
+   propdata = SCIPpropGetData(prop);
+   assert(propdata != NULL);
+
+   *result = SCIP_DIDNOTRUN;
+
+   if( SCIPinProbing(scip) || (!propdata->fixmedians && !propdata->fixassignments) )
+      return SCIP_OKAY;
+
+   cutoffbound = SCIPgetCutoffbound(scip);
+   if( SCIPisInfinity(scip, cutoffbound) )
+      return SCIP_OKAY;
+
+   /* the pricer provides the reduced cost bounds of the last pricing round at this node */
+   if( !SCIPpricerCpmpGetRedcostData(scip, &lpobj, &rcbounds, &duals) )
+      return SCIP_OKAY;
+
+   /* only a better incumbent can lead to new fixings for the same reduced cost information */
+   nodenumber = SCIPnodeGetNumber(SCIPgetCurrentNode(scip));
+   if( nodenumber == propdata->lastnode && cutoffbound >= propdata->lastcutoff )
+      return SCIP_OKAY;
+   propdata->lastnode = nodenumber;
+   propdata->lastcutoff = cutoffbound;
+
+   *result = SCIP_DIDNOTFIND;
+
+   nlocations = SCIPprobdataGetNLocations(scip);
+   nclusters = SCIPprobdataGetNClusters(scip);
+   distances = SCIPprobdataGetDistances(scip);
+
+   SCIP_CALL( computeRedcostSum(scip, rcbounds, nlocations, nclusters, &sum, &threshold) );
+   lowerbound = lpobj + sum;
+
+   /* the node itself is pruned via the pricer's lower bound */
+   if( SCIPisFeasGE(scip, SCIPfeasCeil(scip, lowerbound), cutoffbound) )
+      return SCIP_OKAY;
+
+   SCIPdebugMessage("reduced cost fixing at node %" SCIP_LONGINT_FORMAT ": bound %g, cutoff bound %g\n", nodenumber,
+      lowerbound, cutoffbound);
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &closed, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &forbidden, nlocations) );
+
+   /* medians whose columns alone increase the bound to the cutoff bound */
+   for( median = 0; median < nlocations; ++median )
+   {
+      closed[median] = SCIPisInfinity(scip, rcbounds[median]) || SCIPpricerCpmpIsMedianClosed(scip, median);
+      if( closed[median] )
+         continue;
+
+      if( propdata->fixmedians
+         && SCIPisFeasGE(scip, SCIPfeasCeil(scip, lowerbound - threshold + rcbounds[median]), cutoffbound) )
+      {
+         SCIP_CALL( closeMedian(scip, median) );
+         closed[median] = TRUE;
+         ++propdata->nclosedmedians;
+         *result = SCIP_REDUCEDDOM;
+      }
+   }
+
+   /* assignments whose negative profit increases the reduced cost of the median's columns enough; the loss assumes
+    * that a column without the location is still a column, which does not hold if it must be in the same cluster as
+    * another location, so no assignments are forbidden under pair restrictions
+    */
+   for( location = 0; location < nlocations && propdata->fixassignments && !SCIPpricerCpmpHasPairRestrictions(scip);
+        ++location )
+   {
+      int nforbidden;
+
+      nforbidden = 0;
+      for( median = 0; median < nlocations; ++median )
+      {
+         SCIP_Real loss;
+
+         forbidden[median] = FALSE;
+
+         if( closed[median] || SCIPpricerCpmpIsAssignmentForbidden(scip, median, location) )
+            continue;
+
+         loss = distances[location][median] - duals[location];
+         if( loss <= 0.0 )
+            continue;
+
+         if( SCIPisFeasGE(scip, SCIPfeasCeil(scip, lowerbound - threshold + rcbounds[median] + loss), cutoffbound) )
+         {
+            forbidden[median] = TRUE;
+            ++nforbidden;
+         }
+      }
+
+      if( nforbidden > 0 )
+      {
+         SCIPdebugMessage("   -> location %d: %d assignments forbidden\n", location + 1, nforbidden);
+
+         SCIP_CALL( forbidAssignments(scip, location, forbidden) );
+         propdata->nforbidden += nforbidden;
+         *result = SCIP_REDUCEDDOM;
+      }
+   }
+
+   SCIPfreeBufferArray(scip, &forbidden);
+   SCIPfreeBufferArray(scip, &closed);
+
+   return SCIP_OKAY;
+}
+
+
+/*
+ * propagator specific interface methods
+ */
+
+/** creates the cpmp reduced cost fixing propagator and includes it in SCIP */
+SCIP_RETCODE SCIPincludePropCpmpredcost(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_PROPDATA* propdata;
+   SCIP_PROP* prop;
+
+   /* create cpmp reduced cost fixing propagator data */
+   propdata = NULL;
+   SCIP_CALL( SCIPallocMemory(scip, &propdata) );
+   propdata->lastnode = -1;
+   propdata->lastcutoff = SCIP_REAL_MAX;
+   propdata->nclosedmedians = 0;
+   propdata->nforbidden = 0;
+
+   /* include propagator */
+   prop = NULL;
+   SCIP_CALL( SCIPincludePropBasic(scip, &prop, PROP_NAME, PROP_DESC, PROP_PRIORITY, PROP_FREQ, PROP_DELAY,
+         PROP_TIMING, propExecCpmpredcost, propdata) );
+   assert(prop != NULL);
+
+   SCIP_CALL( SCIPsetPropFree(scip, prop, propFreeCpmpredcost) );
+   SCIP_CALL( SCIPsetPropInitsol(scip, prop, propInitsolCpmpredcost) );
+   SCIP_CALL( SCIPsetPropExitsol(scip, prop, propExitsolCpmpredcost) );
+
+   /* add cpmp reduced cost fixing propagator parameters */
+   SCIP_CALL( SCIPaddBoolParam(scip, "propagating/" PROP_NAME "/fixmedians",
+         "should medians whose columns cannot be part of a better solution be closed in the subtree?",
+         &propdata->fixmedians, FALSE, DEFAULT_FIXMEDIANS, NULL, NULL) );
+   SCIP_CALL( SCIPaddBoolParam(scip, "propagating/" PROP_NAME "/fixassignments",
+         "should assignments which cannot be part of a better solution be forbidden in the subtree?",
+         &propdata->fixassignments, FALSE, DEFAULT_FIXASSIGNMENTS, NULL, NULL) );
+
+   return SCIP_OKAY;
+}
@@ -0,0 +1,51 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   prop_cpmpredcost.h
+ * @ingroup PROPAGATORS
+ * @brief  reduced cost fixing of medians and assignments for capacitated p-median problems
+ * @author Christian Puchert
+ *
+ * The pricer bounds the reduced costs of all columns of each median by the upper bound of its knapsack problem.
+ * Together with the LP value, these bounds show how much the objective value increases at least if a solution of
+ * the subtree contains a cluster of a certain median, or a cluster of a median that contains a certain location.
+ * If this exceeds the cutoff bound, the median is closed by a local median constraint, or the assignment is
+ * forbidden by a local semiassign constraint. Both shrink the pricing problems of the subtree and fix the existing
+ * columns which violate them to zero.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __CPMP_PROP_CPMPREDCOST_H__
+#define __CPMP_PROP_CPMPREDCOST_H__
+
+
+#include "scip/scip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** creates the cpmp reduced cost fixing propagator and includes it in SCIP */
+EXTERN
+SCIP_RETCODE SCIPincludePropCpmpredcost(
+   SCIP*                 scip                /**< SCIP data structure */
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
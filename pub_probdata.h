@@ -37,12 +37,26 @@ int SCIPprobdataGetNLocations(
    SCIP*                 scip
    );
 
+/** get number of clusters */
+extern
+int SCIPprobdataGetNClusters(
+   SCIP*                 scip
+   );
+
 /** get distances */
 extern
 SCIP_Longint** SCIPprobdataGetDistances(
    SCIP*                 scip
    );
 
+/** get distances of all locations to each median as contiguous rows, i.e. entry [j][i] is the distance of location i
+ *  to median j
+ */
+extern
+SCIP_Real** SCIPprobdataGetMedianDistances(
+   SCIP*                 scip
+   );
+
 /** get demands */
 extern
 SCIP_Longint* SCIPprobdataGetDemands(
@@ -64,4 +64,13 @@ SCIP_Bool SCIPisLocationInCluster(
    int                   location
    );
 
+/* find a column of the problem which is not globally fixed to zero and represents a given cluster, or return NULL */
+extern
+SCIP_VAR* SCIPfindClusterVar(
+   SCIP*                 scip,
+   int                   median,
+   int*                  locations,
+   int                   nlocations
+   );
+
 #endif
@@ -0,0 +1,1024 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   race_cpmp.c
+ * @brief  racing of differently configured SCIPs on one capacitated p-median instance
+ * @author Christian Puchert
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "cpmpplugins.h"
+#include "pricer_cpmp.h"
+#include "probdata.h"
+#include "pub_probdata.h"
+#include "pub_vardata.h"
+#include "race_cpmp.h"
+
+
+#define HEUR_NAME             "cpmprace"
+#define HEUR_DESC             "exchange of solutions and columns between racing cpmp workers"
+#define HEUR_DISPCHAR         'R'
+#define HEUR_PRIORITY         1000000
+#define HEUR_FREQ             1
+#define HEUR_FREQOFS          0
+#define HEUR_MAXDEPTH         -1
+#define HEUR_TIMING           (SCIP_HEURTIMING_DURINGPRICINGLOOP | SCIP_HEURTIMING_AFTERNODE)
+#define HEUR_USESSUBSCIP      FALSE  /**< does the heuristic use a secondary SCIP instance? */
+
+#define RACE_MAXWORKERS        256      /**< maximal number of racing workers                                            */
+#define RACE_MAXPOOLCOLUMNS    200000   /**< maximal number of columns in the pool                                      */
+#define RACE_MAXIMPORT         2000     /**< maximal number of columns a worker takes from the pool per call            */
+#define RACE_NCONFIGS          7        /**< number of built-in configurations                                          */
+
+
+/*
+ * Data structures
+ */
+
+/** pool shared by the racing workers */
+struct RacePool
+{
+   pthread_mutex_t       mutex;              /* mutex protecting all other members                                          */
+   SCIP_Bool             stop;               /* should the workers stop?                                                    */
+   int                   winner;             /* worker which finished the solve first, or -1                                */
+
+   SCIP_Real             bestobj;            /* objective value of the best solution                                        */
+   int                   bestworker;         /* worker which found the best solution, or -1                                 */
+   int*                  bestmedians;        /* medians of the clusters of the best solution                                */
+   int*                  bestbeg;            /* start of the locations of each cluster, and their total number at the end   */
+   int*                  bestlocations;      /* locations of the clusters of the best solution                              */
+   int                   nbestclusters;      /* number of clusters of the best solution                                     */
+
+   int*                  colmedians;         /* medians of the pooled columns                                               */
+   int*                  colworkers;         /* workers which published the pooled columns                                  */
+   int*                  colbeg;             /* start of the locations of each column, and their total number at the end    */
+   int*                  collocations;       /* locations of the pooled columns                                             */
+   int                   ncols;              /* number of pooled columns                                                    */
+   int                   colssize;           /* size of the column arrays                                                   */
+   int                   locationssize;      /* size of collocations                                                        */
+   uint64_t*             fingerprints;       /* open addressing table of the fingerprints of the pooled columns (0: empty)  */
+   int                   tablesize;          /* size of the fingerprint table, a power of two                               */
+};
+typedef struct RacePool RACEPOOL;
+
+/** racing worker */
+struct RaceWorker
+{
+   SCIP*                 scip;               /* SCIP of the worker                                                          */
+   RACEPOOL*             pool;               /* pool shared by the workers                                                  */
+   int                   index;              /* index of the worker                                                         */
+   char                  config[SCIP_MAXSTRLEN]; /* name of the configuration                                               */
+   pthread_t             thread;             /* thread of the worker                                                        */
+   SCIP_RETCODE          retcode;            /* return code of the solve                                                    */
+};
+typedef struct RaceWorker RACEWORKER;
+
+/** primal heuristic data of the exchange heuristic of a worker */
+struct SCIP_HeurData
+{
+   RACEPOOL*             pool;               /* pool shared by the workers                                                  */
+   int                   worker;             /* index of the worker                                                         */
+   SCIP_HASHMAP*         known;              /* columns which are in the pool or have been taken from it                    */
+   int                   poolpos;            /* number of pooled columns which have been looked at                          */
+   SCIP_Real             exportedobj;        /* objective value of the last published solution                              */
+   SCIP_Longint          nexported;          /* number of columns published                                                 */
+   SCIP_Longint          nimported;          /* number of columns taken from the pool                                       */
+   int                   nsolsexported;      /* number of solutions published                                               */
+   int                   nsolsimported;      /* number of solutions taken over from the pool                                */
+};
+
+
+/*
+ * Local methods
+ */
+
+/** computes a fingerprint of a column which does not depend on the order of its locations */
+static
+uint64_t computeFingerprint(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   int                   median,             /* median of the column                                 */
+   int*                  locations,          /* locations of the column                              */
+   int                   nlocations,         /* number of locations                                  */
+   int*                  sorted              /* buffer of size nlocations                            */
+   )
+{
+   uint64_t fingerprint;
+   int i;
+
+   BMScopyMemoryArray(sorted, locations, nlocations);
+   SCIPsortInt(sorted, nlocations);
+
+   /* FNV-1a over the median and the sorted locations */
+   fingerprint = 14695981039346656037ULL;
+   fingerprint = (fingerprint ^ (uint64_t)median) * 1099511628211ULL;
+   for( i = 0; i < nlocations; ++i )
+      fingerprint = (fingerprint ^ (uint64_t)sorted[i]) * 1099511628211ULL;
+
+   return fingerprint != 0 ? fingerprint : 1;
+}
+
+/** inserts a fingerprint into the table of the pool; returns FALSE if it is already there */
+static
+SCIP_Bool insertFingerprint(
+   RACEPOOL*             pool,               /* pool                                                 */
+   uint64_t              fingerprint         /* fingerprint of a column                              */
+   )
+{
+   int pos;
+
+   pos = (int)(fingerprint & (uint64_t)(pool->tablesize - 1));
+   while( pool->fingerprints[pos] != 0 )
+   {
+      if( pool->fingerprints[pos] == fingerprint )
+         return FALSE;
+      pos = (pos + 1) & (pool->tablesize - 1);
+   }
+   pool->fingerprints[pos] = fingerprint;
+
+   return TRUE;
+}
+
+/** creates the pool */
+static
+SCIP_RETCODE createPool(
+   RACEPOOL**            pool                /* pointer to store the pool                            */
+   )
+{
+   SCIP_ALLOC( BMSallocMemory(pool) );
+   BMSclearMemory(*pool);
+
+   (*pool)->winner = -1;
+   (*pool)->bestobj = SCIP_REAL_MAX;
+   (*pool)->bestworker = -1;
+
+   /* the table is at most half full */
+   (*pool)->tablesize = 1;
+   while( (*pool)->tablesize < 2 * RACE_MAXPOOLCOLUMNS )
+      (*pool)->tablesize *= 2;
+   SCIP_ALLOC( BMSallocClearMemoryArray(&(*pool)->fingerprints, (*pool)->tablesize) );
+
+   (void) pthread_mutex_init(&(*pool)->mutex, NULL);
+
+   return SCIP_OKAY;
+}
+
+/** frees the pool */
+static
+void freePool(
+   RACEPOOL**            pool                /* pointer to the pool                                  */
+   )
+{
+   (void) pthread_mutex_destroy(&(*pool)->mutex);
+
+   BMSfreeMemoryArray(&(*pool)->fingerprints);
+   BMSfreeMemoryArrayNull(&(*pool)->collocations);
+   BMSfreeMemoryArrayNull(&(*pool)->colbeg);
+   BMSfreeMemoryArrayNull(&(*pool)->colworkers);
+   BMSfreeMemoryArrayNull(&(*pool)->colmedians);
+   BMSfreeMemoryArrayNull(&(*pool)->bestlocations);
+   BMSfreeMemoryArrayNull(&(*pool)->bestbeg);
+   BMSfreeMemoryArrayNull(&(*pool)->bestmedians);
+   BMSfreeMemory(pool);
+}
+
+/** publishes the best solution of the worker if it improved since the last call */
+static
+SCIP_RETCODE exportSolution(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_HEUR*            heur,               /* exchange heuristic                                   */
+   SCIP_HEURDATA*        heurdata            /* data of the exchange heuristic                       */
+   )
+{
+   RACEPOOL* pool;
+   SCIP_SOL* sol;
+   SCIP_VAR** vars;
+   SCIP_Real obj;
+   int* medians;
+   int* beg;
+   int* locations;
+   int nclusters;
+   int nvars;
+   int v;
+
+   sol = SCIPgetBestSol(scip);
+
+   /* solutions taken from the pool are not published again */
+   if( sol == NULL || SCIPsolGetHeur(sol) == heur )
+      return SCIP_OKAY;
+
+   obj = SCIPgetSolOrigObj(scip, sol);
+   if( !SCIPisLT(scip, obj, heurdata->exportedobj) )
+      return SCIP_OKAY;
+   heurdata->exportedobj = obj;
+
+   vars = SCIPgetVars(scip);
+   nvars = SCIPgetNVars(scip);
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &medians, SCIPprobdataGetNLocations(scip)) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &beg, SCIPprobdataGetNLocations(scip) + 1) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &locations, SCIPprobdataGetNLocations(scip)) );
+
+   /* the clusters of a solution usually partition the locations; a solution covering locations several times, which
+    * would not fit into the arrays, is not published
+    */
+   nclusters = 0;
+   beg[0] = 0;
+   for( v = 0; v < nvars; ++v )
+   {
+      int nlocations;
+
+      if( SCIPgetSolVal(scip, sol, vars[v]) < 0.5 )
+         continue;
+
+      nlocations = SCIPvarGetNLocations(vars[v]);
+      if( nclusters >= SCIPprobdataGetNLocations(scip) || beg[nclusters] + nlocations > SCIPprobdataGetNLocations(scip) )
+         break;
+
+      medians[nclusters] = SCIPvarGetMedian(vars[v]);
+      BMScopyMemoryArray(&locations[beg[nclusters]], SCIPvarGetLocations(vars[v]), nlocations);
+      beg[nclusters + 1] = beg[nclusters] + nlocations;
+      ++nclusters;
+   }
+
+   if( v == nvars )
+   {
+      pool = heurdata->pool;
+
+      (void) pthread_mutex_lock(&pool->mutex);
+      if( obj < pool->bestobj )
+      {
+         if( pool->bestmedians == NULL )
+         {
+            int n;
+
+            n = SCIPprobdataGetNLocations(scip);
+            if( BMSallocMemoryArray(&pool->bestmedians, n) == NULL || BMSallocMemoryArray(&pool->bestbeg, n + 1) == NULL
+               || BMSallocMemoryArray(&pool->bestlocations, n) == NULL )
+            {
+               (void) pthread_mutex_unlock(&pool->mutex);
+               return SCIP_NOMEMORY;
+            }
+         }
+
+         BMScopyMemoryArray(pool->bestmedians, medians, nclusters);
+         BMScopyMemoryArray(pool->bestbeg, beg, nclusters + 1);
+         BMScopyMemoryArray(pool->bestlocations, locations, beg[nclusters]);
+         pool->nbestclusters = nclusters;
+         pool->bestobj = obj;
+         pool->bestworker = heurdata->worker;
+         ++heurdata->nsolsexported;
+      }
+      (void) pthread_mutex_unlock(&pool->mutex);
+   }
+
+   SCIPfreeBufferArray(scip, &locations);
+   SCIPfreeBufferArray(scip, &beg);
+   SCIPfreeBufferArray(scip, &medians);
+
+   return SCIP_OKAY;
+}
+
+/** takes over the best solution of the pool if it is better than the incumbent of the worker */
+static
+SCIP_RETCODE importSolution(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_HEUR*            heur,               /* exchange heuristic                                   */
+   SCIP_HEURDATA*        heurdata,           /* data of the exchange heuristic                       */
+   SCIP_RESULT*          result              /* pointer to store the result                          */
+   )
+{
+   RACEPOOL* pool;
+   SCIP_SOL* sol;
+   SCIP_Bool stored;
+   SCIP_Real obj;
+   int* medians;
+   int* beg;
+   int* locations;
+   int nclusters;
+   int nlocations;
+   int c;
+
+   pool = heurdata->pool;
+   nlocations = SCIPprobdataGetNLocations(scip);
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &medians, nlocations) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &beg, nlocations + 1) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &locations, nlocations) );
+
+   (void) pthread_mutex_lock(&pool->mutex);
+   nclusters = 0;
+   obj = pool->bestobj;
+   if( pool->bestworker != heurdata->worker && pool->bestmedians != NULL
+      && SCIPisLT(scip, obj, SCIPgetPrimalbound(scip)) )
+   {
+      nclusters = pool->nbestclusters;
+      BMScopyMemoryArray(medians, pool->bestmedians, nclusters);
+      BMScopyMemoryArray(beg, pool->bestbeg, nclusters + 1);
+      BMScopyMemoryArray(locations, pool->bestlocations, pool->bestbeg[nclusters]);
+   }
+   (void) pthread_mutex_unlock(&pool->mutex);
+
+   if( nclusters > 0 )
+   {
+      SCIP_CALL( SCIPcreateSol(scip, &sol, heur) );
+
+      /* the worker may already have a column of a cluster, e.g. imported from the pool or generated itself */
+      for( c = 0; c < nclusters; ++c )
+      {
+         SCIP_VAR* var;
+
+         var = SCIPfindClusterVar(scip, medians[c], &locations[beg[c]], beg[c + 1] - beg[c]);
+         if( var != NULL )
+         {
+            SCIP_CALL( SCIPsetSolVal(scip, sol, var, 1.0) );
+         }
+         else
+         {
+            SCIP_CALL( SCIPpricerCpmpAddColumn(scip, medians[c], &locations[beg[c]], beg[c + 1] - beg[c], &var) );
+            SCIP_CALL( SCIPhashmapInsert(heurdata->known, var, NULL) );
+            SCIP_CALL( SCIPsetSolVal(scip, sol, var, 1.0) );
+            SCIP_CALL( SCIPreleaseVar(scip, &var) );
+         }
+      }
+
+      SCIP_CALL( SCIPtrySolFree(scip, &sol, FALSE, FALSE, TRUE, TRUE, TRUE, &stored) );
+      if( stored )
+      {
+         ++heurdata->nsolsimported;
+         *result = SCIP_FOUNDSOL;
+      }
+
+      /* do not publish the solution of another worker as own solution */
+      heurdata->exportedobj = MIN(heurdata->exportedobj, obj);
+   }
+
+   SCIPfreeBufferArray(scip, &locations);
+   SCIPfreeBufferArray(scip, &beg);
+   SCIPfreeBufferArray(scip, &medians);
+
+   return SCIP_OKAY;
+}
+
+/** publishes the columns with a positive value in the current LP solution which are not in the pool yet */
+static
+SCIP_RETCODE exportColumns(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_HEURDATA*        heurdata            /* data of the exchange heuristic                       */
+   )
+{
+   RACEPOOL* pool;
+   SCIP_VAR** vars;
+   SCIP_VAR** newvars;
+   uint64_t* fingerprints;
+   int* sorted;
+   int nnewvars;
+   int nvars;
+   int v;
+
+   vars = SCIPgetVars(scip);
+   nvars = SCIPgetNVars(scip);
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &newvars, nvars) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &fingerprints, nvars) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &sorted, SCIPprobdataGetNLocations(scip)) );
+
+   nnewvars = 0;
+   for( v = 0; v < nvars; ++v )
+   {
+      if( !SCIPisFeasPositive(scip, SCIPvarGetLPSol(vars[v])) || SCIPhashmapExists(heurdata->known, vars[v]) )
+         continue;
+
+      SCIP_CALL( SCIPhashmapInsert(heurdata->known, vars[v], NULL) );
+      fingerprints[nnewvars] = computeFingerprint(scip, SCIPvarGetMedian(vars[v]), SCIPvarGetLocations(vars[v]),
+         SCIPvarGetNLocations(vars[v]), sorted);
+      newvars[nnewvars++] = vars[v];
+   }
+
+   if( nnewvars > 0 )
+   {
+      SCIP_RETCODE retcode;
+
+      pool = heurdata->pool;
+      retcode = SCIP_OKAY;
+
+      (void) pthread_mutex_lock(&pool->mutex);
+      for( v = 0; v < nnewvars && pool->ncols < RACE_MAXPOOLCOLUMNS; ++v )
+      {
+         int nlocations;
+
+         if( !insertFingerprint(pool, fingerprints[v]) )
+            continue;
+
+         nlocations = SCIPvarGetNLocations(newvars[v]);
+
+         if( pool->ncols + 1 >= pool->colssize )
+         {
+            int newsize;
+
+            newsize = MAX(2 * pool->colssize, 1024);
+            if( BMSreallocMemoryArray(&pool->colmedians, newsize) == NULL
+               || BMSreallocMemoryArray(&pool->colworkers, newsize) == NULL
+               || BMSreallocMemoryArray(&pool->colbeg, newsize + 1) == NULL )
+            {
+               retcode = SCIP_NOMEMORY;
+               break;
+            }
+            if( pool->colssize == 0 )
+               pool->colbeg[0] = 0;
+            pool->colssize = newsize;
+         }
+         if( pool->colbeg[pool->ncols] + nlocations > pool->locationssize )
+         {
+            int newsize;
+
+            newsize = MAX(2 * pool->locationssize, pool->colbeg[pool->ncols] + nlocations);
+            if( BMSreallocMemoryArray(&pool->collocations, newsize) == NULL )
+            {
+               retcode = SCIP_NOMEMORY;
+               break;
+            }
+            pool->locationssize = newsize;
+         }
+
+         pool->colmedians[pool->ncols] = SCIPvarGetMedian(newvars[v]);
+         pool->colworkers[pool->ncols] = heurdata->worker;
+         BMScopyMemoryArray(&pool->collocations[pool->colbeg[pool->ncols]], SCIPvarGetLocations(newvars[v]), nlocations);
+         pool->colbeg[pool->ncols + 1] = pool->colbeg[pool->ncols] + nlocations;
+         ++pool->ncols;
+         ++heurdata->nexported;
+      }
+      (void) pthread_mutex_unlock(&pool->mutex);
+
+      SCIP_CALL( retcode );
+   }
+
+   SCIPfreeBufferArray(scip, &sorted);
+   SCIPfreeBufferArray(scip, &fingerprints);
+   SCIPfreeBufferArray(scip, &newvars);
+
+   return SCIP_OKAY;
+}
+
+/** adds the columns which other workers published since the last call to the problem of the worker */
+static
+SCIP_RETCODE importColumns(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_HEURDATA*        heurdata            /* data of the exchange heuristic                       */
+   )
+{
+   RACEPOOL* pool;
+   int* medians;
+   int* beg;
+   int* locations;
+   int ncols;
+   int c;
+
+   pool = heurdata->pool;
+   medians = NULL;
+   beg = NULL;
+   locations = NULL;
+
+   (void) pthread_mutex_lock(&pool->mutex);
+   ncols = 0;
+   for( c = heurdata->poolpos; c < pool->ncols && ncols < RACE_MAXIMPORT; ++c )
+   {
+      if( pool->colworkers[c] != heurdata->worker )
+         ++ncols;
+   }
+   if( ncols > 0 )
+   {
+      int nlocations;
+
+      nlocations = pool->colbeg[c] - pool->colbeg[heurdata->poolpos];
+
+      /* buffer memory of the worker's own SCIP is safe to use here */
+      if( SCIPallocBufferArray(scip, &medians, ncols) != SCIP_OKAY
+         || SCIPallocBufferArray(scip, &beg, ncols + 1) != SCIP_OKAY
+         || SCIPallocBufferArray(scip, &locations, nlocations) != SCIP_OKAY )
+      {
+         (void) pthread_mutex_unlock(&pool->mutex);
+         SCIPfreeBufferArrayNull(scip, &locations);
+         SCIPfreeBufferArrayNull(scip, &beg);
+         SCIPfreeBufferArrayNull(scip, &medians);
+         return SCIP_NOMEMORY;
+      }
+
+      ncols = 0;
+      beg[0] = 0;
+      for( c = heurdata->poolpos; c < pool->ncols && ncols < RACE_MAXIMPORT; ++c )
+      {
+         if( pool->colworkers[c] == heurdata->worker )
+            continue;
+
+         medians[ncols] = pool->colmedians[c];
+         beg[ncols + 1] = beg[ncols] + pool->colbeg[c + 1] - pool->colbeg[c];
+         BMScopyMemoryArray(&locations[beg[ncols]], &pool->collocations[pool->colbeg[c]], beg[ncols + 1] - beg[ncols]);
+         ++ncols;
+      }
+   }
+   heurdata->poolpos = c;
+   (void) pthread_mutex_unlock(&pool->mutex);
+
+   if( ncols == 0 )
+      return SCIP_OKAY;
+
+   /* the columns enter the LP through the pricing of problem variables if they have negative reduced costs */
+   for( c = 0; c < ncols; ++c )
+   {
+      SCIP_VAR* var;
+
+      SCIP_CALL( SCIPpricerCpmpAddColumn(scip, medians[c], &locations[beg[c]], beg[c + 1] - beg[c], &var) );
+      SCIP_CALL( SCIPhashmapInsert(heurdata->known, var, NULL) );
+      SCIP_CALL( SCIPreleaseVar(scip, &var) );
+   }
+   heurdata->nimported += ncols;
+
+   SCIPfreeBufferArray(scip, &locations);
+   SCIPfreeBufferArray(scip, &beg);
+   SCIPfreeBufferArray(scip, &medians);
+
+   return SCIP_OKAY;
+}
+
+
+/*
+ * Callback methods of primal heuristic
+ */
+
+/** destructor of primal heuristic to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_HEURFREE(heurFreeCpmprace)
+{  /*lint --e{715}*/
+   SCIP_HEURDATA* heurdata;
+
+   heurdata = SCIPheurGetData(heur);
+   assert(heurdata != NULL);
+
+   SCIPfreeBlockMemory(scip, &heurdata);
+   SCIPheurSetData(heur, NULL);
+
+   return SCIP_OKAY;
+}
+
+/** solving process initialization method of primal heuristic (called when branch and bound process is about to begin) */
+static
+SCIP_DECL_HEURINITSOL(heurInitsolCpmprace)
+{  /*lint --e{715}*/
+   SCIP_HEURDATA* heurdata;
+
+   heurdata = SCIPheurGetData(heur);
+   assert(heurdata != NULL);
+
+   SCIP_CALL( SCIPhashmapCreate(&heurdata->known, SCIPblkmem(scip), 1024) );
+   heurdata->poolpos = 0;
+   heurdata->exportedobj = SCIPinfinity(scip);
+
+   return SCIP_OKAY;
+}
+
+/** solving process deinitialization method of primal heuristic (called before branch and bound process data is freed) */
+static
+SCIP_DECL_HEUREXITSOL(heurExitsolCpmprace)
+{  /*lint --e{715}*/
+   SCIP_HEURDATA* heurdata;
+
+   heurdata = SCIPheurGetData(heur);
+   assert(heurdata != NULL);
+
+   SCIPhashmapFree(&heurdata->known);
+
+   return SCIP_OKAY;
+}
+
+/** execution method of primal heuristic */
+static
+SCIP_DECL_HEUREXEC(heurExecCpmprace)
+{  /*lint --e{715}*/
+   SCIP_HEURDATA* heurdata;
+   SCIP_Bool stop;
+
+   heurdata = SCIPheurGetData(heur);
+   assert(heurdata != NULL);
+
+   *result = SCIP_DIDNOTRUN;
+
+   (void) pthread_mutex_lock(&heurdata->pool->mutex);
+   stop = heurdata->pool->stop;
+   (void) pthread_mutex_unlock(&heurdata->pool->mutex);
+
+   /* another worker has finished */
+   if( stop )
+   {
+      SCIP_CALL( SCIPinterruptSolve(scip) );
+      return SCIP_OKAY;
+   }
+
+   *result = SCIP_DIDNOTFIND;
+
+   SCIP_CALL( exportSolution(scip, heur, heurdata) );
+   if( SCIPhasCurrentNodeLP(scip) && SCIPgetLPSolstat(scip) == SCIP_LPSOLSTAT_OPTIMAL )
+   {
+      SCIP_CALL( exportColumns(scip, heurdata) );
+   }
+   SCIP_CALL( importSolution(scip, heur, heurdata, result) );
+   SCIP_CALL( importColumns(scip, heurdata) );
+
+   return SCIP_OKAY;
+}
+
+/** includes the exchange heuristic of a racing worker in its SCIP */
+static
+SCIP_RETCODE includeHeurCpmprace(
+   SCIP*                 scip,               /* SCIP data structure of the worker                    */
+   RACEPOOL*             pool,               /* pool shared by the workers                           */
+   int                   worker              /* index of the worker                                  */
+   )
+{
+   SCIP_HEURDATA* heurdata;
+   SCIP_HEUR* heur;
+
+   SCIP_CALL( SCIPallocBlockMemory(scip, &heurdata) );
+   BMSclearMemory(heurdata);
+   heurdata->pool = pool;
+   heurdata->worker = worker;
+
+   SCIP_CALL( SCIPincludeHeurBasic(scip, &heur, HEUR_NAME, HEUR_DESC, HEUR_DISPCHAR, HEUR_PRIORITY, HEUR_FREQ,
+         HEUR_FREQOFS, HEUR_MAXDEPTH, HEUR_TIMING, HEUR_USESSUBSCIP, heurExecCpmprace, heurdata) );
+   assert(heur != NULL);
+
+   SCIP_CALL( SCIPsetHeurFree(scip, heur, heurFreeCpmprace) );
+   SCIP_CALL( SCIPsetHeurInitsol(scip, heur, heurInitsolCpmprace) );
+   SCIP_CALL( SCIPsetHeurExitsol(scip, heur, heurExitsolCpmprace) );
+
+   return SCIP_OKAY;
+}
+
+
+/*
+ * Racing
+ */
+
+/** applies a built-in configuration to the SCIP of a worker and stores its name */
+static
+SCIP_RETCODE applyConfig(
+   SCIP*                 scip,               /* SCIP data structure of the worker                    */
+   int                   config,             /* index of the configuration                           */
+   char*                 name                /* buffer of size SCIP_MAXSTRLEN to store the name      */
+   )
+{
+   switch( config )
+   {
+   case 0:
+      (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "default");
+      break;
+   case 1:
+      (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "smoothing");
+      SCIP_CALL( SCIPsetRealParam(scip, "pricers/cpmp/smoothing", 0.8) );
+      break;
+   case 2:
+      (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "medianbranching");
+      SCIP_CALL( SCIPsetIntParam(scip, "branching/median/priority", 60000) );
+      break;
+   case 3:
+      (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "ryanfoster");
+      SCIP_CALL( SCIPsetIntParam(scip, "branching/ryanfoster/priority", 60000) );
+      break;
+   case 4:
+      (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "reliability");
+      SCIP_CALL( SCIPsetCharParam(scip, "branching/semiassign/scoring", 'r') );
+      break;
+   case 5:
+      (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "earlystop");
+      SCIP_CALL( SCIPsetRealParam(scip, "pricers/cpmp/earlystopgap", 1e-3) );
+      SCIP_CALL( SCIPsetIntParam(scip, "pricers/cpmp/tailingoffrounds", 5) );
+      break;
+   case 6:
+      (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "smoothing+median");
+      SCIP_CALL( SCIPsetRealParam(scip, "pricers/cpmp/smoothing", 0.8) );
+      SCIP_CALL( SCIPsetIntParam(scip, "branching/median/priority", 60000) );
+      break;
+   default:
+      SCIPerrorMessage("unknown racing configuration %d\n", config);
+      return SCIP_INVALIDDATA;
+   }
+
+   return SCIP_OKAY;
+}
+
+/** creates the SCIP of a worker: plugins, exchange heuristic, settings and the shared problem */
+static
+SCIP_RETCODE createWorker(
+   SCIP*                 scip,               /* SCIP data structure with the problem                 */
+   RACEWORKER*           worker,             /* worker                                               */
+   char**                settingsfiles,      /* settings files of the workers                        */
+   int                   nsettingsfiles      /* number of settings files (0: built-in configurations) */
+   )
+{
+   int nconfigs;
+
+   SCIP_CALL( SCIPcreate(&worker->scip) );
+   SCIP_CALL( SCIPincludeCpmpPlugins(worker->scip) );
+   SCIP_CALL( includeHeurCpmprace(worker->scip, worker->pool, worker->index) );
+   SCIP_CALL( SCIPcopyParamSettings(scip, worker->scip) );
+
+   if( nsettingsfiles > 0 )
+   {
+      SCIP_CALL( SCIPreadParams(worker->scip, settingsfiles[worker->index % nsettingsfiles]) );
+      (void) SCIPsnprintf(worker->config, SCIP_MAXSTRLEN, "%s", settingsfiles[worker->index % nsettingsfiles]);
+      nconfigs = nsettingsfiles;
+   }
+   else
+   {
+      SCIP_CALL( applyConfig(worker->scip, worker->index % RACE_NCONFIGS, worker->config) );
+      nconfigs = RACE_NCONFIGS;
+   }
+
+   /* workers beyond the configurations repeat them with different random seeds */
+   if( worker->index >= nconfigs )
+   {
+      SCIP_CALL( SCIPsetIntParam(worker->scip, "randomization/randomseedshift", worker->index / nconfigs) );
+   }
+
+   /* the workers would all write to the same checkpoint, trace and capture files */
+   SCIP_CALL( SCIPsetStringParam(worker->scip, "cpmp/checkpoint/file", "") );
+   SCIP_CALL( SCIPsetStringParam(worker->scip, "pricers/cpmp/tracefile", "") );
+   SCIP_CALL( SCIPsetStringParam(worker->scip, "pricers/cpmp/capturefile", "") );
+
+   /* the workers would only interleave their logs; the result table is printed at the end */
+   SCIPsetMessagehdlrQuiet(worker->scip, TRUE);
+
+   SCIP_CALL( SCIPcreateProbBasic(worker->scip, SCIPgetProbName(scip)) );
+   SCIP_CALL( SCIPcreateProbCpmpShared(worker->scip, scip) );
+
+   return SCIP_OKAY;
+}
+
+/** thread function of a worker */
+static
+void* workerThread(
+   void*                 arg                 /* worker                                               */
+   )
+{
+   RACEWORKER* worker;
+   RACEPOOL* pool;
+
+   worker = (RACEWORKER*)arg;
+   pool = worker->pool;
+
+   worker->retcode = SCIPsolve(worker->scip);
+
+   (void) pthread_mutex_lock(&pool->mutex);
+   if( worker->retcode != SCIP_OKAY )
+      pool->stop = TRUE;
+   else if( !pool->stop && (SCIPgetStatus(worker->scip) == SCIP_STATUS_OPTIMAL
+         || SCIPgetStatus(worker->scip) == SCIP_STATUS_INFEASIBLE) )
+   {
+      pool->stop = TRUE;
+      pool->winner = worker->index;
+   }
+   (void) pthread_mutex_unlock(&pool->mutex);
+
+   return NULL;
+}
+
+/** prints the results of the workers */
+static
+void printResults(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   RACEWORKER*           workers,            /* workers                                              */
+   int                   nworkers            /* number of workers                                    */
+   )
+{
+   int w;
+
+   SCIPinfoMessage(scip, NULL, "%-3s %-24s %-10s %16s %16s %9s %9s %9s %9s %7s %6s\n", "", "configuration",
+      "status", "primal", "dual", "time", "nodes", "colsout", "colsin", "solsout", "solsin");
+
+   for( w = 0; w < nworkers; ++w )
+   {
+      SCIP_HEURDATA* heurdata;
+      SCIP* workerscip;
+      const char* status;
+
+      workerscip = workers[w].scip;
+      heurdata = SCIPheurGetData(SCIPfindHeur(workerscip, HEUR_NAME));
+      assert(heurdata != NULL);
+
+      if( workers[w].retcode != SCIP_OKAY )
+         status = "error";
+      else if( SCIPgetStatus(workerscip) == SCIP_STATUS_OPTIMAL )
+         status = "optimal";
+      else if( SCIPgetStatus(workerscip) == SCIP_STATUS_INFEASIBLE )
+         status = "infeasible";
+      else if( SCIPgetStatus(workerscip) == SCIP_STATUS_USERINTERRUPT )
+         status = "stopped";
+      else
+         status = "limit";
+
+      SCIPinfoMessage(scip, NULL, "%-3s %-24s %-10s %16.9g %16.9g %9.2f %9" SCIP_LONGINT_FORMAT " %9" SCIP_LONGINT_FORMAT
+         " %9" SCIP_LONGINT_FORMAT " %7d %6d\n", workers[w].pool->winner == w ? "*" : "", workers[w].config, status,
+         SCIPgetPrimalbound(workerscip), SCIPgetDualbound(workerscip), SCIPgetSolvingTime(workerscip),
+         SCIPgetNTotalNodes(workerscip), heurdata->nexported, heurdata->nimported, heurdata->nsolsexported,
+         heurdata->nsolsimported);
+   }
+}
+
+/** adds the best solution of the pool to the original problem */
+static
+SCIP_RETCODE transferSolution(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   RACEPOOL*             pool                /* pool                                                 */
+   )
+{
+   SCIP_SOL* sol;
+   SCIP_Bool stored;
+   int c;
+
+   assert(SCIPgetStage(scip) == SCIP_STAGE_PROBLEM);
+
+   if( pool->bestmedians == NULL )
+      return SCIP_OKAY;
+
+   SCIP_CALL( SCIPcreateOrigSol(scip, &sol, NULL) );
+
+   for( c = 0; c < pool->nbestclusters; ++c )
+   {
+      SCIP_VAR* var;
+
+      SCIP_CALL( SCIPpricerCpmpAddColumn(scip, pool->bestmedians[c], &pool->bestlocations[pool->bestbeg[c]],
+            pool->bestbeg[c + 1] - pool->bestbeg[c], &var) );
+      SCIP_CALL( SCIPsetSolVal(scip, sol, var, 1.0) );
+      SCIP_CALL( SCIPreleaseVar(scip, &var) );
+   }
+
+   SCIP_CALL( SCIPaddSolFree(scip, &sol, &stored) );
+
+   return SCIP_OKAY;
+}
+
+/** splits a list of settings files separated by ';' in place */
+static
+SCIP_RETCODE splitSettingsFiles(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   char*                 list,               /* list of settings files, modified                     */
+   char***               files,              /* pointer to store the settings files                  */
+   int*                  nfiles              /* pointer to store the number of settings files        */
+   )
+{
+   char* file;
+   int size;
+
+   *files = NULL;
+   *nfiles = 0;
+   size = 0;
+
+   for( file = strtok(list, ";"); file != NULL; file = strtok(NULL, ";") )
+   {
+      while( *file == ' ' )
+         ++file;
+      if( *file == '\0' )
+         continue;
+
+      if( *nfiles >= size )
+      {
+         size = SCIPcalcMemGrowSize(scip, *nfiles + 1);
+         SCIP_CALL( SCIPreallocBufferArray(scip, files, size) );
+      }
+      (*files)[(*nfiles)++] = file;
+   }
+
+   return SCIP_OKAY;
+}
+
+
+/*
+ * Interface methods
+ */
+
+/** races several differently configured SCIPs on the problem of the given SCIP until one of them finishes, prints the
+ *  results of the workers and adds the best solution found to the original problem; a transformed problem of the given
+ *  SCIP is freed before
+ */
+SCIP_RETCODE SCIPraceCpmp(
+   SCIP*                 scip,               /**< SCIP data structure with the cpmp plugins and a cpmp problem */
+   int                   nworkers,           /**< number of racing workers */
+   const char*           settingsfiles       /**< settings files of the workers separated by ';', or "" for the built-in
+                                              *   configurations */
+   )
+{
+   RACEWORKER* workers;
+   RACEPOOL* pool;
+   SCIP_RETCODE retcode;
+   char* settingslist;
+   char** files;
+   int nfiles;
+   int nstarted;
+   int w;
+
+   assert(scip != NULL);
+   assert(nworkers >= 1);
+   assert(settingsfiles != NULL);
+
+   if( SCIPgetStage(scip) < SCIP_STAGE_PROBLEM || SCIPgetProbData(scip) == NULL )
+   {
+      SCIPerrorMessage("no cpmp problem to race on\n");
+      return SCIP_INVALIDCALL;
+   }
+
+   /* the workers share the instance data of the original problem */
+   if( SCIPgetStage(scip) > SCIP_STAGE_PROBLEM )
+   {
+      SCIP_CALL( SCIPfreeTransform(scip) );
+   }
+
+   nworkers = MIN(nworkers, RACE_MAXWORKERS);
+
+   SCIP_CALL( SCIPduplicateBufferArray(scip, &settingslist, settingsfiles, (int)strlen(settingsfiles) + 1) );
+   SCIP_CALL( splitSettingsFiles(scip, settingslist, &files, &nfiles) );
+
+   SCIP_CALL( createPool(&pool) );
+   SCIP_CALL( SCIPallocClearBufferArray(scip, &workers, nworkers) );
+
+   /* set up all SCIPs before starting any thread, since the parameters of scip are read while copying */
+   retcode = SCIP_OKAY;
+   for( w = 0; w < nworkers && retcode == SCIP_OKAY; ++w )
+   {
+      workers[w].pool = pool;
+      workers[w].index = w;
+      retcode = createWorker(scip, &workers[w], files, nfiles);
+   }
+   nworkers = w;
+
+   nstarted = 0;
+   if( retcode == SCIP_OKAY )
+   {
+      SCIPinfoMessage(scip, NULL, "racing %d workers on <%s>\n", nworkers, SCIPgetProbName(scip));
+
+      for( ; nstarted < nworkers; ++nstarted )
+      {
+         if( pthread_create(&workers[nstarted].thread, NULL, workerThread, &workers[nstarted]) != 0 )
+         {
+            SCIPerrorMessage("cannot start worker thread %d\n", nstarted);
+            break;
+         }
+      }
+      if( nstarted == 0 )
+         retcode = SCIP_ERROR;
+   }
+
+   for( w = 0; w < nstarted; ++w )
+   {
+      (void) pthread_join(workers[w].thread, NULL);
+      if( retcode == SCIP_OKAY )
+         retcode = workers[w].retcode;
+   }
+
+   if( nstarted > 0 )
+      printResults(scip, workers, nstarted);
+
+   if( retcode == SCIP_OKAY )
+   {
+      retcode = transferSolution(scip, pool);
+
+      if( pool->winner >= 0 )
+         SCIPinfoMessage(scip, NULL, "worker %d (%s) finished first\n", pool->winner, workers[pool->winner].config);
+      else
+         SCIPinfoMessage(scip, NULL, "no worker finished\n");
+      if( pool->bestmedians != NULL )
+         SCIPinfoMessage(scip, NULL, "best solution: %.9g, found by worker %d\n", pool->bestobj, pool->bestworker);
+   }
+
+   /* the problems of the workers refer to the instance data of scip, so they are freed first */
+   for( w = nworkers - 1; w >= 0; --w )
+   {
+      if( workers[w].scip != NULL )
+      {
+         SCIP_CALL( SCIPfree(&workers[w].scip) );
+      }
+   }
+
+   SCIPfreeBufferArray(scip, &workers);
+   freePool(&pool);
+   SCIPfreeBufferArrayNull(scip, &files);
+   SCIPfreeBufferArray(scip, &settingslist);
+
+   return retcode;
+}
@@ -0,0 +1,61 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   race_cpmp.h
+ * @brief  racing of differently configured SCIPs on one capacitated p-median instance
+ * @author Christian Puchert
+ *
+ * Each racing worker is a thread with its own SCIP, which solves the problem of the given SCIP with a configuration
+ * of its own. The instance data of the given SCIP is shared read-only by all workers. A heuristic plugin of the
+ * workers exchanges solutions and columns through a pool: it publishes new incumbents and the columns of the LP
+ * solutions, and it takes over better incumbents and the columns of the other workers, also during the pricing loop
+ * at the root. As soon as one worker solves the problem to optimality (or proves infeasibility), the other workers are
+ * interrupted. The best solution is handed over to the original problem of the given SCIP afterwards.
+ *
+ * The configurations vary dual smoothing, the branching rule, the scoring of semiassign branching and the control of
+ * column generation (Lagrangian relaxation, tailing off). Alternatively, a list of settings files can be given; the
+ * workers then cycle through them. Racing requires a SCIP library with thread-safe memory management (e.g., built
+ * with PARASCIP=true or with a TPI).
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __CPMP_RACE_CPMP_H__
+#define __CPMP_RACE_CPMP_H__
+
+
+#include "scip/scip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** races several differently configured SCIPs on the problem of the given SCIP until one of them finishes, prints the
+ *  results of the workers and adds the best solution found to the original problem; a transformed problem of the given
+ *  SCIP is freed before
+ */
+EXTERN
+SCIP_RETCODE SCIPraceCpmp(
+   SCIP*                 scip,               /**< SCIP data structure with the cpmp plugins and a cpmp problem */
+   int                   nworkers,           /**< number of racing workers */
+   const char*           settingsfiles       /**< settings files of the workers separated by ';', or "" for the built-in
+                                              *   configurations */
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
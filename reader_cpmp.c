@@ -22,9 +22,11 @@
 
 #include <assert.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 #include "reader_cpmp.h"
 #include "probdata.h"
+#include "prof_cpmp.h"
 
 
 #define READER_NAME             "cpmp"
@@ -56,12 +58,19 @@ SCIP_DECL_READERREAD(readerReadCpmp)
 
    *result = SCIP_DIDNOTRUN;
 
+   /* a new problem starts a new profile */
+#ifndef CPMP_NO_PROFILE
+   SCIPprofileResetCpmp();
+#endif
+   CPMP_PROF_START(CPMP_PROF_READER_READ);
+
    /* open file */
    file = SCIPfopen(filename, "r");
    if( file == NULL )
    {
       SCIPerrorMessage("cannot open file <%s> for reading\n", filename);
       SCIPprintSysError(filename);
+      CPMP_PROF_STOP(CPMP_PROF_READER_READ);
       return SCIP_NOFILE;
    }
 
@@ -98,38 +107,16 @@ SCIP_DECL_READERREAD(readerReadCpmp)
       SCIP_CALL( SCIPallocBufferArray(scip, &distances[i], nlocations) );
    }
 
-   /* ********************************************************************************
-    * TODO: read in the distance matrix; complete the 'while' loop first
-    * by replacing the 'TRUE'.
-    * How  many lines do you need to read in?
-    * ********************************************************************************
-    */
    /* read the distance matrix */
    while( !SCIPfeof(file) && !readerror && nlines <= nlocations )
    {
-      char* pos;                             /* current position in the input line */
-      char* next;                            /* next position in the input line    */
-      SCIP_Longint entry;                    /* current entry                      */
       int nentries;                          /* number of entries read to far      */
 
-      /* ********************************************************************************
-       * TODO: read the current line on the distance matrix;
-       * each line contains nlocations many entries
-       * ********************************************************************************
-       */
-
       if ( SCIPfgets(buffer, (int)sizeof(buffer), file) == NULL )
         readerror = TRUE;
 
-      for ( pos = buffer, nentries = 0; nentries < nlocations; pos = next, ++nentries )
-      {
-         entry = strtol(pos, &next, 10);
-
-         if( next != pos )
-            distances[nlines - 1][nentries] = entry;
-         else
-            break;
-      }
+      /* go through all entries in this line */
+      nentries = SCIPparseLongintsCpmp(buffer, distances[nlines - 1], nlocations);
 
       ++nlines;
 
@@ -151,9 +138,6 @@ SCIP_DECL_READERREAD(readerReadCpmp)
    /* read the demands */
    if( !SCIPfeof(file) && !readerror )
    {
-      char* pos;                             /* current position in the input line */
-      char* next;                            /* next position in the input line    */
-      SCIP_Longint entry;                    /* current entry                      */
       int nentries;                          /* number of entries read to far      */
 
       /* get next line */
@@ -161,15 +145,7 @@ SCIP_DECL_READERREAD(readerReadCpmp)
          readerror = TRUE;
 
       /* go through all entries in this line */
-      for( pos = buffer, nentries = 0; nentries < nlocations; pos = next, ++nentries )
-      {
-         entry = strtol(pos, &next, 10);
-
-         if( next != pos )
-            demands[nentries] = entry;
-         else
-            break;
-      }
+      nentries = SCIPparseLongintsCpmp(buffer, demands, nlocations);
 
       ++nlines;
 
@@ -186,9 +162,6 @@ SCIP_DECL_READERREAD(readerReadCpmp)
    /* read the capacities */
    if( !SCIPfeof(file) && !readerror )
    {
-      char* pos;                             /* current position in the input line */
-      char* next;                            /* next position in the input line    */
-      SCIP_Longint entry;                    /* current entry                      */
       int nentries;                          /* number of entries read to far      */
 
       /* get next line */
@@ -196,15 +169,7 @@ SCIP_DECL_READERREAD(readerReadCpmp)
          readerror = TRUE;
 
       /* go through all entries in this line */
-      for( pos = buffer, nentries = 0; nentries < nlocations; pos = next, ++nentries )
-      {
-         entry = strtol(pos, &next, 10);
-
-         if( next != pos )
-            capacities[nentries] = entry;
-         else
-            break;
-      }
+      nentries = SCIPparseLongintsCpmp(buffer, capacities, nlocations);
 
       ++nlines;
 
@@ -236,6 +201,9 @@ SCIP_DECL_READERREAD(readerReadCpmp)
 
    (void) SCIPfclose(file);
 
+   CPMP_PROF_STOP(CPMP_PROF_READER_READ);
+   CPMP_PROF_COUNT(CPMP_PROF_READER_LINES, nlines);
+
    if( readerror )
       return SCIP_READERROR;
 
@@ -248,6 +216,33 @@ SCIP_DECL_READERREAD(readerReadCpmp)
  * reader specific interface methods
  */
 
+/** parses up to nvalues integers separated by white space from a line; returns the number of integers parsed */
+int SCIPparseLongintsCpmp(
+   const char*           line,               /**< line to parse */
+   SCIP_Longint*         values,             /**< array to store the integers */
+   int                   nvalues             /**< maximal number of integers to parse */
+   )
+{
+   const char* pos;                          /* current position in the input line */
+   char* next;                               /* next position in the input line    */
+   int nentries;                             /* number of entries read so far      */
+
+   for( pos = line, nentries = 0; nentries < nvalues; pos = next, ++nentries )
+   {
+      SCIP_Longint entry;
+
+      entry = strtoll(pos, &next, 10);
+
+      if( next == pos )
+         break;
+
+      values[nentries] = entry;
+   }
+
+   return nentries;
+}
+
+
 /** includes the cpmp file reader in SCIP */
 SCIP_RETCODE SCIPincludeReaderCpmp(
    SCIP*                 scip                /**< SCIP data structure */
@@ -37,6 +37,14 @@ SCIP_RETCODE SCIPincludeReaderCpmp(
    SCIP*                 scip                /**< SCIP data structure */
    );
 
+/** parses up to nvalues integers separated by white space from a line; returns the number of integers parsed */
+EXTERN
+int SCIPparseLongintsCpmp(
+   const char*           line,               /**< line to parse */
+   SCIP_Longint*         values,             /**< array to store the integers */
+   int                   nvalues             /**< maximal number of integers to parse */
+   );
+
 #ifdef __cplusplus
 }
 #endif
@@ -31,8 +31,10 @@ struct SCIP_ProbData
    int                   nlocations;         /**< number of locations                                                   */
    int                   nclusters;          /**< number of clusters (the 'p')                                          */
    SCIP_Longint**        distances;          /**< distances between the locations, matrix of size nlocations*nlocations */
+   SCIP_Real**           mediandistances;    /**< distances to the medians, row of median j contiguous (transposed)     */
    SCIP_Longint*         demands;            /**< demands of the locations, vector of size nlocations                   */
    SCIP_Longint*         capacities;         /**< capacities of the locations, vector of size nlocations                */
+   SCIP_Bool             ownsdata;           /**< are the arrays above owned, or shared read-only with other problem data? */
 
    SCIP_CONS**           serviceconss;
    SCIP_CONS**           convconss;
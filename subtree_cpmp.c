@@ -0,0 +1,261 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   subtree_cpmp.c
+ * @brief  serialization of subtrees of the branch-and-price tree by their branching restrictions
+ * @author Christian Puchert
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <string.h>
+
+#include "cons_median.h"
+#include "cons_samediff.h"
+#include "cons_semiassign.h"
+#include "pub_probdata.h"
+#include "subtree_cpmp.h"
+
+
+/*
+ * Local methods
+ */
+
+/** ensures that an integer array can hold the given number of entries */
+static
+SCIP_RETCODE ensureDataSize(
+   int**                 data,               /* pointer to the array                                 */
+   int*                  size,               /* pointer to the size of the array                     */
+   int                   needed              /* number of entries needed                             */
+   )
+{
+   if( needed > *size )
+   {
+      int newsize;
+
+      newsize = MAX(2 * *size, needed);
+      SCIP_ALLOC( BMSreallocMemoryArray(data, newsize) );
+      *size = newsize;
+   }
+
+   return SCIP_OKAY;
+}
+
+/** appends the restriction of a branching constraint to serialized restrictions */
+static
+SCIP_RETCODE serializeCons(
+   SCIP*                 scip,               /* SCIP data structure                                  */
+   SCIP_CONS*            cons,               /* branching constraint                                 */
+   int**                 data,               /* pointer to the serialized restrictions               */
+   int*                  ndata,              /* pointer to the number of entries of data             */
+   int*                  size                /* pointer to the size of data                          */
+   )
+{
+   const char* conshdlrname;
+
+   conshdlrname = SCIPconshdlrGetName(SCIPconsGetHdlr(cons));
+
+   if( strcmp(conshdlrname, "semiassign") == 0 )
+   {
+      SCIP_Bool* forbidden;
+      int nforbidden;
+      int i;
+
+      forbidden = SCIPgetForbiddenSemiassign(cons);
+
+      SCIP_CALL( ensureDataSize(data, size, *ndata + 3 + SCIPprobdataGetNLocations(scip)) );
+      nforbidden = 0;
+      for( i = 0; i < SCIPprobdataGetNLocations(scip); ++i )
+      {
+         if( forbidden[i] )
+            (*data)[*ndata + 3 + nforbidden++] = i;
+      }
+      (*data)[*ndata] = (int)CPMP_RESTRICTION_SEMIASSIGN;
+      (*data)[*ndata + 1] = SCIPgetLocationSemiassign(cons);
+      (*data)[*ndata + 2] = nforbidden;
+      *ndata += 3 + nforbidden;
+   }
+   else if( strcmp(conshdlrname, "median") == 0 )
+   {
+      SCIP_CALL( ensureDataSize(data, size, *ndata + 3) );
+      (*data)[*ndata] = (int)CPMP_RESTRICTION_MEDIAN;
+      (*data)[*ndata + 1] = SCIPgetMedianMedian(cons);
+      (*data)[*ndata + 2] = (int)SCIPgetTypeMedian(cons);
+      *ndata += 3;
+   }
+   else if( strcmp(conshdlrname, "samediff") == 0 )
+   {
+      SCIP_CALL( ensureDataSize(data, size, *ndata + 4) );
+      (*data)[*ndata] = (int)CPMP_RESTRICTION_SAMEDIFF;
+      SCIPgetLocationsSamediff(cons, &(*data)[*ndata + 1], &(*data)[*ndata + 2]);
+      (*data)[*ndata + 3] = (int)SCIPgetTypeSamediff(cons);
+      *ndata += 4;
+   }
+   else
+   {
+      /* linear constraints are the rows of open medians, which are recreated with their median constraints; leaving
+       * out any other constraint would only enlarge the subtree
+       */
+      return SCIP_OKAY;
+   }
+
+   ++(*data)[0];
+
+   return SCIP_OKAY;
+}
+
+
+/*
+ * Interface methods
+ */
+
+/** appends the branching constraints added on the path from a node up to the root (exclusively) to serialized
+ *  restrictions; data[0] is the number of restrictions and is increased accordingly
+ */
+SCIP_RETCODE SCIPserializePathCpmp(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_NODE*            node,               /**< node */
+   int**                 data,               /**< pointer to the serialized restrictions, reallocated if necessary */
+   int*                  ndata,              /**< pointer to the number of entries of data */
+   int*                  size                /**< pointer to the size of data */
+   )
+{
+   SCIP_CONS** conss;
+   int consssize;
+
+   assert(*ndata >= 1);
+
+   consssize = 16;
+   SCIP_CALL( SCIPallocBufferArray(scip, &conss, consssize) );
+
+   for( ; SCIPnodeGetDepth(node) > 0; node = SCIPnodeGetParent(node) )
+   {
+      int nconss;
+      int c;
+
+      SCIPnodeGetAddedConss(node, conss, &nconss, consssize);
+      if( nconss > consssize )
+      {
+         consssize = nconss;
+         SCIP_CALL( SCIPreallocBufferArray(scip, &conss, consssize) );
+         SCIPnodeGetAddedConss(node, conss, &nconss, consssize);
+      }
+
+      for( c = 0; c < nconss; ++c )
+      {
+         SCIP_CALL( serializeCons(scip, conss[c], data, ndata, size) );
+      }
+   }
+
+   SCIPfreeBufferArray(scip, &conss);
+
+   return SCIP_OKAY;
+}
+
+/** returns the position behind the serialized restriction at the given position */
+int SCIPnextRestrictionCpmp(
+   int*                  data,               /**< serialized restrictions */
+   int                   pos                 /**< position of a restriction */
+   )
+{
+   switch( data[pos] )
+   {
+   case CPMP_RESTRICTION_SEMIASSIGN:
+      return pos + 3 + data[pos + 2];
+   case CPMP_RESTRICTION_MEDIAN:
+      return pos + 3;
+   default:
+      assert(data[pos] == (int)CPMP_RESTRICTION_SAMEDIFF);
+      return pos + 4;
+   }
+}
+
+/** returns the position behind serialized restrictions */
+int SCIPgetRestrictionsEndCpmp(
+   int*                  data                /**< serialized restrictions */
+   )
+{
+   int pos;
+   int r;
+
+   pos = 1;
+   for( r = 0; r < data[0]; ++r )
+      pos = SCIPnextRestrictionCpmp(data, pos);
+
+   return pos;
+}
+
+/** adds serialized restrictions as branching constraints to a node */
+SCIP_RETCODE SCIPapplyRestrictionsCpmp(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_NODE*            node,               /**< node */
+   int*                  data,               /**< serialized restrictions */
+   const char*           prefix              /**< prefix of the names of the constraints */
+   )
+{
+   SCIP_Bool* forbidden;
+   int pos;
+   int r;
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &forbidden, SCIPprobdataGetNLocations(scip)) );
+
+   pos = 1;
+   for( r = 0; r < data[0]; ++r )
+   {
+      SCIP_CONS* cons;
+      char name[SCIP_MAXSTRLEN];
+
+      switch( data[pos] )
+      {
+      case CPMP_RESTRICTION_SEMIASSIGN:
+      {
+         int i;
+
+         BMSclearMemoryArray(forbidden, SCIPprobdataGetNLocations(scip));
+         for( i = 0; i < data[pos + 2]; ++i )
+            forbidden[data[pos + 3 + i]] = TRUE;
+
+         (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "%s_forbidden_%d", prefix, data[pos + 1]);
+         SCIP_CALL( SCIPcreateConsSemiassign(scip, &cons, name, data[pos + 1], forbidden, node) );
+         break;
+      }
+      case CPMP_RESTRICTION_MEDIAN:
+         (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "%s_%s_%d", prefix, data[pos + 2] == (int)CPMP_MEDIAN_CLOSED ?
+            "closed" : "open", data[pos + 1]);
+         SCIP_CALL( SCIPcreateConsMedian(scip, &cons, name, data[pos + 1], (CPMP_MEDIANTYPE)data[pos + 2], node) );
+         break;
+      case CPMP_RESTRICTION_SAMEDIFF:
+         (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "%s_%s_%d_%d", prefix, data[pos + 3] == (int)CPMP_SAMEDIFF_SAME ?
+            "same" : "differ", data[pos + 1], data[pos + 2]);
+         SCIP_CALL( SCIPcreateConsSamediff(scip, &cons, name, data[pos + 1], data[pos + 2],
+               (CPMP_SAMEDIFFTYPE)data[pos + 3], node) );
+         break;
+      default:
+         SCIPerrorMessage("unknown restriction type %d\n", data[pos]);
+         SCIPfreeBufferArray(scip, &forbidden);
+         return SCIP_INVALIDDATA;
+      }
+
+      SCIP_CALL( SCIPaddConsNode(scip, node, cons, NULL) );
+      SCIP_CALL( SCIPreleaseCons(scip, &cons) );
+
+      pos = SCIPnextRestrictionCpmp(data, pos);
+   }
+
+   SCIPfreeBufferArray(scip, &forbidden);
+
+   return SCIP_OKAY;
+}
@@ -0,0 +1,90 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   subtree_cpmp.h
+ * @brief  serialization of subtrees of the branch-and-price tree by their branching restrictions
+ * @author Christian Puchert
+ *
+ * The subtree of a node is given by the branching constraints on the path from the node up to the root. They are
+ * serialized into a flat integer array
+ *
+ *    [nrestrictions, restriction, ...]
+ *
+ * where a semiassign restriction is [CPMP_RESTRICTION_SEMIASSIGN, location, nforbidden, forbidden medians ...], a
+ * median restriction is [CPMP_RESTRICTION_MEDIAN, median, type] and a Ryan-Foster restriction is
+ * [CPMP_RESTRICTION_SAMEDIFF, location1, location2, type]. The arrays are allocated with plain (not SCIP) memory, so
+ * they may be passed between threads, and they may be written to files as they are.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __CPMP_SUBTREE_CPMP_H__
+#define __CPMP_SUBTREE_CPMP_H__
+
+
+#include "scip/scip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** type of a serialized branching restriction */
+enum CPMP_RestrictionType
+{
+   CPMP_RESTRICTION_SEMIASSIGN = 0,          /**< assignments of a location to some medians are forbidden */
+   CPMP_RESTRICTION_MEDIAN     = 1,          /**< a median is closed or open                               */
+   CPMP_RESTRICTION_SAMEDIFF   = 2           /**< two locations are in the same or in different clusters   */
+};
+typedef enum CPMP_RestrictionType CPMP_RESTRICTIONTYPE;
+
+/** appends the branching constraints added on the path from a node up to the root (exclusively) to serialized
+ *  restrictions; data[0] is the number of restrictions and is increased accordingly
+ */
+EXTERN
+SCIP_RETCODE SCIPserializePathCpmp(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_NODE*            node,               /**< node */
+   int**                 data,               /**< pointer to the serialized restrictions, reallocated if necessary */
+   int*                  ndata,              /**< pointer to the number of entries of data */
+   int*                  size                /**< pointer to the size of data */
+   );
+
+/** returns the position behind the serialized restriction at the given position */
+EXTERN
+int SCIPnextRestrictionCpmp(
+   int*                  data,               /**< serialized restrictions */
+   int                   pos                 /**< position of a restriction */
+   );
+
+/** returns the position behind serialized restrictions */
+EXTERN
+int SCIPgetRestrictionsEndCpmp(
+   int*                  data                /**< serialized restrictions */
+   );
+
+/** adds serialized restrictions as branching constraints to a node */
+EXTERN
+SCIP_RETCODE SCIPapplyRestrictionsCpmp(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_NODE*            node,               /**< node */
+   int*                  data,               /**< serialized restrictions */
+   const char*           prefix              /**< prefix of the names of the constraints */
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
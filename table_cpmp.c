@@ -0,0 +1,176 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   table_cpmp.c
+ * @brief  statistics table of the capacitated p-median problem example
+ * @author Christian Puchert
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+
+#include "pricer_cpmp.h"
+#include "table_cpmp.h"
+
+
+#define TABLE_NAME             "cpmp"
+#define TABLE_DESC             "cpmp pricing statistics table"
+#define TABLE_POSITION         10500                  /**< the position of the statistics table (after the pricers) */
+#define TABLE_EARLIEST_STAGE   SCIP_STAGE_SOLVING     /**< output of the statistics table is only printed from this stage onwards */
+
+
+/*
+ * Local methods
+ */
+
+/** returns the number of improving columns recorded in the reduced cost histogram */
+static
+SCIP_Longint countImproving(
+   const CPMP_PRICERSTATS* stats             /* pricer statistics                                    */
+   )
+{
+   SCIP_Longint count;
+   int b;
+
+   count = 0;
+   for( b = 0; b < CPMP_NRCBUCKETS; ++b )
+      count += stats->rchistogram[b];
+
+   return count;
+}
+
+
+/*
+ * Callback methods of statistics table
+ */
+
+/** output method of statistics table to output file stream 'file' */
+static
+SCIP_DECL_TABLEOUTPUT(tableOutputCpmp)
+{  /*lint --e{715}*/
+   const CPMP_PRICERSTATS* stats;
+
+   assert(scip != NULL);
+
+   if( SCIPfindPricer(scip, "cpmp") == NULL )
+      return SCIP_OKAY;
+
+   stats = SCIPpricerCpmpGetStats(scip);
+   assert(stats != NULL);
+
+   SCIPinfoMessage(scip, file, "CPMP Pricing Items :  Knapsacks  Locations   Positive  Oversized  Dominated    Bounded      Final  Avg.Final\n");
+   SCIPinfoMessage(scip, file, "  cpmp             : %10" SCIP_LONGINT_FORMAT " %10" SCIP_LONGINT_FORMAT " %10" SCIP_LONGINT_FORMAT
+      " %10" SCIP_LONGINT_FORMAT " %10" SCIP_LONGINT_FORMAT " %10" SCIP_LONGINT_FORMAT " %10" SCIP_LONGINT_FORMAT " %10.2f\n",
+      stats->nknapsacks, stats->nlocations, stats->npositive, stats->noversized, stats->ndominated, stats->nbounded,
+      stats->nitems, stats->nknapsacks > 0 ? (SCIP_Real)stats->nitems / stats->nknapsacks : 0.0);
+   SCIPinfoMessage(scip, file, "CPMP Column Gen.   :  LagBounds EarlyStops Misprices  RootLagBnd  LagIters Eliminated\n");
+   SCIPinfoMessage(scip, file, "  cpmp             : %10" SCIP_LONGINT_FORMAT " %10" SCIP_LONGINT_FORMAT " %9" SCIP_LONGINT_FORMAT
+      " %11.2f %9d %10d\n", stats->nlagrangebounds, stats->nearlystops, stats->nmisprices,
+      stats->rootlagrangebound, stats->nlagrangeiters, stats->neliminated);
+   SCIPinfoMessage(scip, file, "CPMP Pricing Rounds:     Rounds     Farkas    Columns Cols/Round   MaxCols\n");
+   SCIPinfoMessage(scip, file, "  cpmp             : %10" SCIP_LONGINT_FORMAT " %10" SCIP_LONGINT_FORMAT " %10" SCIP_LONGINT_FORMAT
+      " %10.2f %9d\n", stats->nrounds, stats->nfarkasrounds, stats->ncolumns,
+      stats->nrounds + stats->nfarkasrounds > 0 ? (SCIP_Real)stats->ncolumns / (stats->nrounds + stats->nfarkasrounds) : 0.0,
+      stats->maxroundcolumns);
+   SCIPinfoMessage(scip, file, "CPMP Knapsack Calls:      Cache   Specific       SCIP     Paired     Failed\n");
+   SCIPinfoMessage(scip, file, "  cpmp             : %10" SCIP_LONGINT_FORMAT " %10" SCIP_LONGINT_FORMAT " %10" SCIP_LONGINT_FORMAT
+      " %10" SCIP_LONGINT_FORMAT " %10" SCIP_LONGINT_FORMAT "\n", stats->ncachehits, stats->nspecificcalls, stats->nscipcalls,
+      stats->npairedcalls, stats->nfailed);
+   SCIPinfoMessage(scip, file, "CPMP Pricing Time  :      Duals      Setup      Solve  AddColumn   RootDone\n");
+   SCIPinfoMessage(scip, file, "  cpmp             : %10.2f %10.2f %10.2f %10.2f %10.2f\n", stats->dualtime, stats->setuptime,
+      stats->solvetime, stats->addtime, stats->roottime);
+   SCIPinfoMessage(scip, file, "CPMP Improving RC  :     <=-1e4  (-1e4,-1e3] (-1e3,-1e2] (-1e2,-10] (-10,-1]  (-1,0)        Min       Mean\n");
+   SCIPinfoMessage(scip, file, "  cpmp             : %10" SCIP_LONGINT_FORMAT " %12" SCIP_LONGINT_FORMAT " %11" SCIP_LONGINT_FORMAT
+      " %10" SCIP_LONGINT_FORMAT " %8" SCIP_LONGINT_FORMAT " %7" SCIP_LONGINT_FORMAT " %10.2f %10.2f\n",
+      stats->rchistogram[0], stats->rchistogram[1], stats->rchistogram[2], stats->rchistogram[3], stats->rchistogram[4],
+      stats->rchistogram[5], stats->minredcost, countImproving(stats) > 0 ? stats->sumredcost / countImproving(stats) : 0.0);
+
+   return SCIP_OKAY;
+}
+
+
+/*
+ * statistics table specific interface methods
+ */
+
+/** writes the cpmp pricing statistics as a JSON object to the given file, or to standard output if file is NULL */
+SCIP_RETCODE SCIPwriteStatisticsJsonCpmp(
+   SCIP*                 scip,               /**< SCIP data structure */
+   FILE*                 file                /**< output file, or NULL for standard output */
+   )
+{
+   const CPMP_PRICERSTATS* stats;
+   SCIP_Longint nimproving;
+   int b;
+
+   assert(scip != NULL);
+
+   if( SCIPfindPricer(scip, "cpmp") == NULL )
+   {
+      SCIPerrorMessage("cpmp pricer not found\n");
+      return SCIP_PLUGINNOTFOUND;
+   }
+
+   stats = SCIPpricerCpmpGetStats(scip);
+   assert(stats != NULL);
+
+   nimproving = countImproving(stats);
+
+   SCIPinfoMessage(scip, file, "{\n");
+   SCIPinfoMessage(scip, file, "  \"rounds\": {\"redcost\": %" SCIP_LONGINT_FORMAT ", \"farkas\": %" SCIP_LONGINT_FORMAT
+      ", \"columns\": %" SCIP_LONGINT_FORMAT ", \"maxroundcolumns\": %d},\n",
+      stats->nrounds, stats->nfarkasrounds, stats->ncolumns, stats->maxroundcolumns);
+   SCIPinfoMessage(scip, file, "  \"knapsacks\": {\"setup\": %" SCIP_LONGINT_FORMAT ", \"cache\": %" SCIP_LONGINT_FORMAT
+      ", \"specific\": %" SCIP_LONGINT_FORMAT ", \"scip\": %" SCIP_LONGINT_FORMAT ", \"paired\": %" SCIP_LONGINT_FORMAT
+      ", \"failed\": %" SCIP_LONGINT_FORMAT "},\n", stats->nknapsacks, stats->ncachehits, stats->nspecificcalls,
+      stats->nscipcalls, stats->npairedcalls, stats->nfailed);
+   SCIPinfoMessage(scip, file, "  \"items\": {\"locations\": %" SCIP_LONGINT_FORMAT ", \"positive\": %" SCIP_LONGINT_FORMAT
+      ", \"oversized\": %" SCIP_LONGINT_FORMAT ", \"dominated\": %" SCIP_LONGINT_FORMAT ", \"bounded\": %" SCIP_LONGINT_FORMAT
+      ", \"final\": %" SCIP_LONGINT_FORMAT ", \"avgfinal\": %.6g},\n", stats->nlocations, stats->npositive,
+      stats->noversized, stats->ndominated, stats->nbounded, stats->nitems,
+      stats->nknapsacks > 0 ? (SCIP_Real)stats->nitems / stats->nknapsacks : 0.0);
+   SCIPinfoMessage(scip, file, "  \"time\": {\"duals\": %.6g, \"setup\": %.6g, \"solve\": %.6g, \"addcolumn\": %.6g"
+      ", \"root\": %.6g},\n", stats->dualtime, stats->setuptime, stats->solvetime, stats->addtime, stats->roottime);
+
+   SCIPinfoMessage(scip, file, "  \"redcosts\": {\"histogram\": [");
+   for( b = 0; b < CPMP_NRCBUCKETS; ++b )
+      SCIPinfoMessage(scip, file, "%s%" SCIP_LONGINT_FORMAT, b > 0 ? ", " : "", stats->rchistogram[b]);
+   SCIPinfoMessage(scip, file, "], \"min\": %.6g, \"mean\": %.6g},\n", stats->minredcost,
+      nimproving > 0 ? stats->sumredcost / nimproving : 0.0);
+
+   SCIPinfoMessage(scip, file, "  \"columngeneration\": {\"lagrangebounds\": %" SCIP_LONGINT_FORMAT ", \"earlystops\": %"
+      SCIP_LONGINT_FORMAT ", \"misprices\": %" SCIP_LONGINT_FORMAT ", \"lagrangeiters\": %d, \"eliminated\": %d",
+      stats->nlagrangebounds, stats->nearlystops, stats->nmisprices, stats->nlagrangeiters, stats->neliminated);
+   if( SCIPisInfinity(scip, REALABS(stats->rootlagrangebound)) )
+      SCIPinfoMessage(scip, file, ", \"rootlagrangebound\": null}\n");
+   else
+      SCIPinfoMessage(scip, file, ", \"rootlagrangebound\": %.15g}\n", stats->rootlagrangebound);
+   SCIPinfoMessage(scip, file, "}\n");
+
+   return SCIP_OKAY;
+}
+
+/** creates the cpmp statistics table and includes it in SCIP */
+SCIP_RETCODE SCIPincludeTableCpmp(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_CALL( SCIPincludeTable(scip, TABLE_NAME, TABLE_DESC, TRUE,
+         NULL, NULL, NULL, NULL, NULL, NULL, tableOutputCpmp,
+         NULL, TABLE_POSITION, TABLE_EARLIEST_STAGE) );
+
+   return SCIP_OKAY;
+}
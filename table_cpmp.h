@@ -0,0 +1,51 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2018 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   table_cpmp.h
+ * @ingroup TABLES
+ * @brief  statistics table of the capacitated p-median problem example
+ * @author Christian Puchert
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __CPMP_TABLE_CPMP_H__
+#define __CPMP_TABLE_CPMP_H__
+
+
+#include "scip/scip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** creates the cpmp statistics table and includes it in SCIP */
+EXTERN
+SCIP_RETCODE SCIPincludeTableCpmp(
+   SCIP*                 scip                /**< SCIP data structure */
+   );
+
+/** writes the cpmp pricing statistics as a JSON object to the given file, or to standard output if file is NULL */
+EXTERN
+SCIP_RETCODE SCIPwriteStatisticsJsonCpmp(
+   SCIP*                 scip,               /**< SCIP data structure */
+   FILE*                 file                /**< output file, or NULL for standard output */
+   );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
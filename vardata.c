@@ -25,7 +25,7 @@
 #include "struct_vardata.h"
 
 
-/** frees user data of transformed variable (called when the transformed variable is freed) */
+/** frees user data of original or transformed variable (called when the variable is freed) */
 static
 SCIP_DECL_VARDELTRANS(freeVarData)
 {
@@ -40,6 +40,23 @@ SCIP_DECL_VARDELTRANS(freeVarData)
 }
 
 
+/** copies the user data of an original variable to its transformed variable */
+static
+SCIP_DECL_VARTRANS(transVarData)
+{
+   assert(scip != NULL);
+   assert(sourcedata != NULL);
+   assert(targetdata != NULL);
+
+   SCIP_CALL( SCIPallocMemory(scip, targetdata) );
+   (*targetdata)->median = sourcedata->median;
+   (*targetdata)->nlocations = sourcedata->nlocations;
+   SCIP_CALL( SCIPduplicateMemoryArray(scip, &(*targetdata)->locations, sourcedata->locations, sourcedata->nlocations) );
+
+   return SCIP_OKAY;
+}
+
+
 /** create variable data */
 SCIP_RETCODE SCIPcreateVarData(
    SCIP*                 scip,
@@ -63,9 +80,16 @@ SCIP_RETCODE SCIPcreateVarData(
    vardata->nlocations = nlocations;
    SCIP_CALL( SCIPduplicateMemoryArray(scip, &vardata->locations, locations, nlocations) );
 
-   /* add the variable data to the variable and set the destructor */
+   /* add the variable data to the variable and set the destructors; columns are usually transformed variables, but
+    * the ones of a solution handed over to the original problem are not
+    */
    SCIPvarSetData(var, vardata);
    SCIPvarSetDeltransData(var, freeVarData);
+   if( SCIPvarIsOriginal(var) )
+   {
+      SCIPvarSetDelorigData(var, freeVarData);
+      SCIPvarSetTransData(var, transVarData);
+   }
 
    return SCIP_OKAY;
 }
@@ -199,3 +223,36 @@ SCIP_Bool SCIPisLocationInCluster(
          return TRUE;
    return FALSE;
 }
+
+/** find a column of the problem which is not globally fixed to zero and represents a given cluster, or return NULL */
+SCIP_VAR* SCIPfindClusterVar(
+   SCIP*                 scip,
+   int                   median,
+   int*                  locations,
+   int                   nlocations
+   )
+{
+   SCIP_VAR** vars;
+   int nvars;
+   int i;
+   int l;
+
+   vars = SCIPgetVars(scip);
+   nvars = SCIPgetNVars(scip);
+
+   for( i = 0; i < nvars; ++i )
+   {
+      if( SCIPvarGetMedian(vars[i]) != median || SCIPvarGetNLocations(vars[i]) != nlocations
+         || SCIPvarGetUbGlobal(vars[i]) < 0.5 )
+         continue;
+
+      for( l = 0; l < nlocations; ++l )
+         if( !SCIPisLocationInCluster(vars[i], locations[l]) )
+            break;
+
+      if( l == nlocations )
+         return vars[i];
+   }
+
+   return NULL;
+}